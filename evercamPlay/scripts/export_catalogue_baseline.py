@@ -0,0 +1,89 @@
+#!/usr/bin/env python3
+"""Export the Evercam vendor/model catalogue to the baseline asset the app is seeded from.
+
+Usage: export_catalogue_baseline.py [output]
+
+The output defaults to src/main/assets/catalogue_baseline.json next to this script. Set
+EVERCAM_API_ID and EVERCAM_API_KEY if the API requires a key pair for the model list.
+Release builds run this through the exportCatalogueBaseline Gradle task.
+"""
+import json
+import os
+import sys
+import time
+import urllib.parse
+import urllib.request
+
+API_URL = "https://media.evercam.io/v1/"
+PAGE_LIMIT = 100
+DEFAULT_OUTPUT = os.path.join(os.path.dirname(os.path.abspath(__file__)), os.pardir,
+                              "src", "main", "assets", "catalogue_baseline.json")
+
+
+def get_json(path, params=None):
+    params = dict(params or {})
+    if os.environ.get("EVERCAM_API_ID") and os.environ.get("EVERCAM_API_KEY"):
+        params["api_id"] = os.environ["EVERCAM_API_ID"]
+        params["api_key"] = os.environ["EVERCAM_API_KEY"]
+    url = API_URL + path
+    if params:
+        url += "?" + urllib.parse.urlencode(params)
+    request = urllib.request.Request(url, headers={"Accept": "application/json"})
+    with urllib.request.urlopen(request, timeout=60) as response:
+        return json.loads(response.read().decode("utf-8"))
+
+
+def export_vendors():
+    # Ids are lower case, the same as CameraCatalogue.refreshVendors() stores them
+    return sorted(({"id": vendor["id"].lower(), "name": vendor["name"]}
+                   for vendor in get_json("vendors")["vendors"]),
+                  key=lambda vendor: vendor["id"])
+
+
+def export_models():
+    models = []
+    page = 0
+    while True:
+        result = get_json("models", {"limit": PAGE_LIMIT, "page": page})
+        for model in result["models"]:
+            defaults = model.get("defaults") or {}
+            snapshots = defaults.get("snapshots") or {}
+            basic_auth = (defaults.get("auth") or {}).get("basic") or {}
+            models.append({
+                "id": model["id"],
+                "vendor_id": model["vendor_id"].lower(),
+                "name": model["name"],
+                "jpg_url": snapshots.get("jpg") or "",
+                "h264_url": snapshots.get("h264") or "",
+                "username": basic_auth.get("username") or "",
+                "password": basic_auth.get("password") or "",
+                "onvif": bool(model.get("onvif")),
+                "ptz": bool(model.get("ptz")),
+            })
+        page += 1
+        if page >= result.get("pages", 0):
+            break
+    return sorted(models, key=lambda model: model["id"])
+
+
+def main():
+    output = sys.argv[1] if len(sys.argv) > 1 else DEFAULT_OUTPUT
+    vendors = export_vendors()
+    vendor_ids = set(vendor["id"] for vendor in vendors)
+    models = [model for model in export_models() if model["vendor_id"] in vendor_ids]
+    if not vendors or not models:
+        sys.exit("Empty catalogue returned, not writing " + output)
+
+    baseline = {
+        "generated_at": int(time.time() * 1000),
+        "vendors": vendors,
+        "models": models,
+    }
+    os.makedirs(os.path.dirname(os.path.abspath(output)), exist_ok=True)
+    with open(output, "w") as baseline_file:
+        json.dump(baseline, baseline_file, separators=(",", ":"), sort_keys=True)
+    print("Exported %d vendors and %d models to %s" % (len(vendors), len(models), output))
+
+
+if __name__ == "__main__":
+    main()
@@ -1,9 +1,12 @@
 package io.evercam.androidapp;
 
+import android.content.Intent;
 import android.os.Bundle;
+import android.os.Handler;
 import android.preference.ListPreference;
 import android.preference.Preference;
 import android.preference.Preference.OnPreferenceChangeListener;
+import android.preference.PreferenceCategory;
 import android.preference.PreferenceFragment;
 import android.support.v7.app.AppCompatActivity;
 import android.support.v7.widget.Toolbar;
@@ -13,6 +16,8 @@ import android.widget.ListView;
 
 import java.util.ArrayList;
 
+import io.evercam.androidapp.http.NetworkMetricsActivity;
+import io.evercam.androidapp.photoview.SnapshotCompactor;
 import io.evercam.androidapp.utils.Constants;
 import io.evercam.androidapp.utils.DataCollector;
 import io.evercam.androidapp.utils.PrefsManager;
@@ -70,7 +75,9 @@ public class CameraPrefsActivity extends AppCompatActivity {
             addPreferencesFromResource(R.xml.main_preference);
             setCameraNumbersForScreen(screenWidth);
             setUpSleepTime();
+            setUpSnapshotStorage();
             showAppVersion();
+            setUpNetworkMetrics();
 
             Preference showGuidePreference = getPreferenceManager().findPreference(PrefsManager.KEY_GUIDE);
             showGuidePreference.setOnPreferenceClickListener(new Preference.OnPreferenceClickListener() {
@@ -136,6 +143,32 @@ public class CameraPrefsActivity extends AppCompatActivity {
             });
         }
 
+        private void setUpSnapshotStorage() {
+            String[] keys = {PrefsManager.KEY_SNAPSHOT_QUOTA, PrefsManager
+                    .KEY_SNAPSHOT_CAMERA_QUOTA, PrefsManager.KEY_SNAPSHOT_EVICTION};
+            for (String key : keys) {
+                final ListPreference listPreference = (ListPreference)
+                        getPreferenceManager().findPreference(key);
+                listPreference.setSummary(listPreference.getEntry());
+                listPreference.setOnPreferenceChangeListener(new OnPreferenceChangeListener() {
+                    @Override
+                    public boolean onPreferenceChange(Preference preference, Object newValue) {
+                        int index = listPreference.findIndexOfValue(newValue.toString());
+                        listPreference.setSummary(listPreference.getEntries()[index]);
+
+                        //Apply the new limit once the preference value is saved
+                        new Handler().post(new Runnable() {
+                            @Override
+                            public void run() {
+                                SnapshotCompactor.launch(getActivity());
+                            }
+                        });
+                        return true;
+                    }
+                });
+            }
+        }
+
         private String getSummary(String entry) {
             if (entry.equals(getString(R.string.prefs_never))) {
                 return entry;
@@ -145,6 +178,22 @@ public class CameraPrefsActivity extends AppCompatActivity {
             }
         }
 
+        /**
+         * The network metrics screen is only for debug builds
+         */
+        private void setUpNetworkMetrics() {
+            Preference metricsPreference = getPreferenceManager().findPreference(PrefsManager
+                    .KEY_NETWORK_METRICS);
+            if (BuildConfig.DEBUG) {
+                metricsPreference.setIntent(new Intent(getActivity(), NetworkMetricsActivity
+                        .class));
+            } else {
+                PreferenceCategory aboutCategory = (PreferenceCategory) getPreferenceManager()
+                        .findPreference(PrefsManager.KEY_ABOUT);
+                aboutCategory.removePreference(metricsPreference);
+            }
+        }
+
         private void showAppVersion() {
             Preference aboutPrefs = (Preference)
                     getPreferenceManager().findPreference(PrefsManager.KEY_VERSION);
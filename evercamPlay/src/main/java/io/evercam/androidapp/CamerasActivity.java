@@ -48,7 +48,9 @@ import java.util.UUID;
 import java.util.concurrent.RejectedExecutionException;
 
 import de.hdodenhof.circleimageview.CircleImageView;
+import io.evercam.API;
 import io.evercam.androidapp.addeditcamera.AddCameraActivity;
+import io.evercam.androidapp.authentication.AccountStateCache;
 import io.evercam.androidapp.authentication.EvercamAccount;
 import io.evercam.androidapp.custom.AccountNavAdapter;
 import io.evercam.androidapp.custom.CameraLayout;
@@ -61,6 +63,8 @@ import io.evercam.androidapp.dto.EvercamCamera;
 import io.evercam.androidapp.dto.ImageLoadingStatus;
 import io.evercam.androidapp.feedback.LoadTimeFeedbackItem;
 import io.evercam.androidapp.publiccameras.PublicCamerasWebActivity;
+import io.evercam.androidapp.routing.RouteSelector;
+import io.evercam.androidapp.sharing.ShareListCache;
 import io.evercam.androidapp.tasks.CheckInternetTask;
 import io.evercam.androidapp.tasks.CheckKeyExpirationTask;
 import io.evercam.androidapp.tasks.LoadCameraListTask;
@@ -217,6 +221,8 @@ public class CamerasActivity extends ParentAppCompatActivity implements
 
             startCameraLoadingTask();
 
+        } else if (itemId == R.id.menu_map) {
+            startActivity(new Intent(this, CamerasMapActivity.class));
         } else {
             return super.onOptionsItemSelected(item);
         }
@@ -280,6 +286,10 @@ public class CamerasActivity extends ParentAppCompatActivity implements
             }
         } else if (requestCode == Constants.REQUEST_CODE_MANAGE_ACCOUNT) {
             reloadCameraList = (resultCode == Constants.RESULT_ACCOUNT_CHANGED);
+            if (reloadCameraList && showCachedCameraList()) {
+                //Cameras of the new account are already showing, refresh them quietly
+                reloadCameraList = false;
+            }
         } else if (requestCode == Constants.REQUEST_CODE_SHOW_GUIDE && resultCode == Constants.RESULT_TRUE) {
             showShowcaseView(onlyHasDemoCamera());
         }
@@ -513,7 +523,13 @@ public class CamerasActivity extends ParentAppCompatActivity implements
             public void onItemClick(AdapterView<?> parent, View view, int position, long id) {
                 final AppUser appUser = mUserListInNavDrawer.get(position);
                 Log.d(TAG, appUser.toString());
-                new CheckKeyExpirationTaskNavDrawer(appUser).executeOnExecutor(AsyncTask.THREAD_POOL_EXECUTOR);
+                //Switch straight away if the key was checked in the background recently
+                if (AccountStateCache.getKeyState(appUser.getUsername()) == AccountStateCache
+                        .KeyState.VALID) {
+                    switchToAccount(appUser);
+                } else {
+                    new CheckKeyExpirationTaskNavDrawer(appUser).executeOnExecutor(AsyncTask.THREAD_POOL_EXECUTOR);
+                }
             }
         });
     }
@@ -777,6 +793,9 @@ public class CamerasActivity extends ParentAppCompatActivity implements
 
         // clear real-time default app data
         AppData.reset();
+        ShareListCache.clear();
+        RouteSelector.clear();
+        AccountStateCache.clear();
 
         activity.finish();
         activity.startActivity(new Intent(activity, OnBoardingActivity.class));
@@ -878,6 +897,8 @@ public class CamerasActivity extends ParentAppCompatActivity implements
                 if (type == InternetCheckType.START) {
                     updateNavDrawerUserInfo();
                     startLoadingCameras();
+                    AccountStateCache.warmUp(CamerasActivity.this, new EvercamAccount
+                            (CamerasActivity.this).retrieveUserList());
                 } else if (type == InternetCheckType.RESTART) {
                     if (reloadCameraList) {
                         removeAllCameraViews();
@@ -1025,16 +1046,44 @@ public class CamerasActivity extends ParentAppCompatActivity implements
                 finish();
                 startActivity(new Intent(CamerasActivity.this, OnBoardingActivity.class));
             } else {
-                EvercamAccount evercamAccount = new EvercamAccount(getApplicationContext());
-                evercamAccount.updateDefaultUser(appUser.getEmail());
-                AppData.appUsers = evercamAccount.retrieveUserList();
+                switchToAccount(appUser);
+            }
+        }
+    }
 
-                getMixpanel().identifyUser(AppData.defaultUser.getUsername());
-                registerUserWithIntercom(AppData.defaultUser);
+    private void switchToAccount(AppUser appUser) {
+        EvercamAccount evercamAccount = new EvercamAccount(getApplicationContext());
+        evercamAccount.updateDefaultUser(appUser.getEmail());
+        AppData.appUsers = evercamAccount.retrieveUserList();
 
-                closeDrawer();
-                startLoadingCameras();
-            }
+        getMixpanel().identifyUser(AppData.defaultUser.getUsername());
+        registerUserWithIntercom(AppData.defaultUser);
+
+        closeDrawer();
+        if (showCachedCameraList()) {
+            updateNavDrawerUserInfo();
+            startCameraLoadingTask();
+        } else {
+            startLoadingCameras();
         }
     }
+
+    /**
+     * Show the cameras of the default user kept by {@link AccountStateCache}
+     *
+     * @return false if they are not cached, and have to be loaded
+     */
+    private boolean showCachedCameraList() {
+        AppUser defaultUser = AppData.defaultUser;
+        if (defaultUser == null) return false;
+        ArrayList<EvercamCamera> cameraList = AccountStateCache.getCameraList(defaultUser
+                .getUsername());
+        if (cameraList == null) return false;
+
+        API.setUserKeyPair(defaultUser.getApiKey(), defaultUser.getApiId());
+        AppData.evercamCameraList = cameraList;
+        removeAllCameraViews();
+        addAllCameraViews(false, true);
+        return true;
+    }
 }
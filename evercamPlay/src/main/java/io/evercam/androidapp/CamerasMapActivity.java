@@ -0,0 +1,36 @@
+package io.evercam.androidapp;
+
+import android.os.Bundle;
+import android.view.MenuItem;
+
+import io.evercam.androidapp.dto.AppData;
+
+/**
+ * All cameras with a location on a map, clustered when they are close together
+ */
+public class CamerasMapActivity extends ParentAppCompatActivity {
+    private final static String TAG = "CamerasMapActivity";
+
+    @Override
+    public void onCreate(Bundle savedInstanceState) {
+        super.onCreate(savedInstanceState);
+
+        setContentView(R.layout.activity_cameras_map);
+
+        setUpDefaultToolbar();
+
+        CamerasMapFragment mapFragment = (CamerasMapFragment) getSupportFragmentManager()
+                .findFragmentById(R.id.cameras_map);
+        mapFragment.setCameras(AppData.evercamCameraList);
+    }
+
+    @Override
+    public boolean onOptionsItemSelected(MenuItem item) {
+        int itemId = item.getItemId();
+
+        if (itemId == android.R.id.home) {
+            finish();
+        }
+        return true;
+    }
+}
@@ -0,0 +1,300 @@
+package io.evercam.androidapp;
+
+import android.graphics.Bitmap;
+import android.graphics.Canvas;
+import android.graphics.Color;
+import android.graphics.Paint;
+import android.graphics.drawable.Drawable;
+import android.os.Bundle;
+import android.util.Log;
+import android.util.SparseArray;
+
+import com.google.android.gms.maps.CameraUpdateFactory;
+import com.google.android.gms.maps.GoogleMap;
+import com.google.android.gms.maps.OnMapReadyCallback;
+import com.google.android.gms.maps.SupportMapFragment;
+import com.google.android.gms.maps.model.BitmapDescriptor;
+import com.google.android.gms.maps.model.BitmapDescriptorFactory;
+import com.google.android.gms.maps.model.LatLng;
+import com.google.android.gms.maps.model.LatLngBounds;
+import com.google.android.gms.maps.model.Marker;
+import com.google.android.gms.maps.model.MarkerOptions;
+import com.squareup.picasso.Picasso;
+import com.squareup.picasso.Target;
+
+import java.util.HashMap;
+import java.util.HashSet;
+import java.util.Iterator;
+import java.util.List;
+import java.util.Map;
+
+import io.evercam.androidapp.dto.EvercamCamera;
+import io.evercam.androidapp.map.GeoQuadTree;
+import io.evercam.androidapp.map.MarkerClusterer;
+import io.evercam.androidapp.video.VideoActivity;
+
+/**
+ * Map of the user's cameras that stays smooth with hundreds of them.
+ *
+ * Camera locations are kept in a {@link GeoQuadTree}. Each time the map settles, only
+ * the cameras inside the visible region are looked up and clustered for the zoom
+ * level, and markers are added and removed by difference with the ones already shown.
+ * Thumbnails are only loaded for single camera markers on screen, and cancelled when
+ * their marker goes away.
+ */
+public class CamerasMapFragment extends SupportMapFragment implements OnMapReadyCallback,
+        GoogleMap.OnCameraIdleListener, GoogleMap.OnMarkerClickListener {
+    private final static String TAG = "CamerasMapFragment";
+    private final static int CLUSTER_CELL_DP = 64;
+    private final static int CLUSTER_ICON_DP = 40;
+    private final static int THUMBNAIL_WIDTH_DP = 64;
+    private final static int THUMBNAIL_HEIGHT_DP = 48;
+    private final static int BOUNDS_PADDING_DP = 48;
+    private final static int CLUSTER_ZOOM_STEP = 2;
+
+    private GoogleMap map;
+    private boolean isMapLoaded = false;
+    private GeoQuadTree<CameraLocation> cameraIndex = new GeoQuadTree<>();
+    private final HashMap<String, Marker> markers = new HashMap<>();
+    /* Picasso only keeps weak references to targets */
+    private final HashMap<String, Target> thumbnailTargets = new HashMap<>();
+    private final SparseArray<BitmapDescriptor> clusterIcons = new SparseArray<>();
+
+    static class CameraLocation implements GeoQuadTree.Item {
+        final EvercamCamera camera;
+
+        CameraLocation(EvercamCamera camera) {
+            this.camera = camera;
+        }
+
+        @Override
+        public double getLatitude() {
+            return camera.getLatitude();
+        }
+
+        @Override
+        public double getLongitude() {
+            return camera.getLongitude();
+        }
+    }
+
+    @Override
+    public void onActivityCreated(Bundle savedInstanceState) {
+        super.onActivityCreated(savedInstanceState);
+        getMapAsync(this);
+    }
+
+    @Override
+    public void onMapReady(GoogleMap googleMap) {
+        map = googleMap;
+        map.setMapType(GoogleMap.MAP_TYPE_NORMAL);
+        map.setOnCameraIdleListener(this);
+        map.setOnMarkerClickListener(this);
+        map.setOnMapLoadedCallback(new GoogleMap.OnMapLoadedCallback() {
+            @Override
+            public void onMapLoaded() {
+                isMapLoaded = true;
+                zoomToCameras();
+            }
+        });
+    }
+
+    @Override
+    public void onDestroyView() {
+        clearMarkers();
+        map = null;
+        isMapLoaded = false;
+        super.onDestroyView();
+    }
+
+    /**
+     * Show these cameras, cameras without a location are left out
+     */
+    public void setCameras(List<EvercamCamera> cameras) {
+        GeoQuadTree<CameraLocation> index = new GeoQuadTree<>();
+        for (EvercamCamera camera : cameras) {
+            if (camera.getLatitude() != 0 || camera.getLongitude() != 0) {
+                index.add(new CameraLocation(camera));
+            }
+        }
+        cameraIndex = index;
+
+        clearMarkers();
+        if (isMapLoaded) {
+            zoomToCameras();
+        }
+    }
+
+    @Override
+    public void onCameraIdle() {
+        refreshMarkers();
+    }
+
+    @Override
+    public boolean onMarkerClick(Marker marker) {
+        Object tag = marker.getTag();
+        if (tag instanceof EvercamCamera) {
+            VideoActivity.startPlayingVideoForCamera(getActivity(),
+                    ((EvercamCamera) tag).getCameraId());
+        } else if (tag instanceof LatLngBounds) {
+            LatLngBounds bounds = (LatLngBounds) tag;
+            if (bounds.southwest.equals(bounds.northeast)) {
+                //All cameras of the cluster are at the same spot
+                map.animateCamera(CameraUpdateFactory.newLatLngZoom(marker.getPosition(),
+                        map.getCameraPosition().zoom + CLUSTER_ZOOM_STEP));
+            } else {
+                map.animateCamera(CameraUpdateFactory.newLatLngBounds(bounds,
+                        dpToPixels(BOUNDS_PADDING_DP)));
+            }
+        }
+        return true;
+    }
+
+    private void zoomToCameras() {
+        List<CameraLocation> locations = cameraIndex.query(-90, -180, 90, 180);
+        if (map == null || locations.isEmpty()) return;
+
+        map.moveCamera(CameraUpdateFactory.newLatLngBounds(getBounds(locations),
+                dpToPixels(BOUNDS_PADDING_DP)));
+        refreshMarkers();
+    }
+
+    /**
+     * Cluster the cameras in the visible region and update the markers that changed
+     */
+    private void refreshMarkers() {
+        if (map == null) return;
+
+        long startTime = System.currentTimeMillis();
+        LatLngBounds visibleBounds = map.getProjection().getVisibleRegion().latLngBounds;
+        List<CameraLocation> visibleCameras = cameraIndex.query(visibleBounds.southwest.latitude,
+                visibleBounds.southwest.longitude, visibleBounds.northeast.latitude,
+                visibleBounds.northeast.longitude);
+        int zoom = (int) map.getCameraPosition().zoom;
+        List<MarkerClusterer.Cluster<CameraLocation>> clusters = MarkerClusterer.cluster
+                (visibleCameras, zoom, dpToPixels(CLUSTER_CELL_DP));
+
+        HashSet<String> visibleKeys = new HashSet<>();
+        for (MarkerClusterer.Cluster<CameraLocation> cluster : clusters) {
+            String key;
+            if (cluster.isSingle()) {
+                key = "camera:" + cluster.getItems().get(0).camera.getCameraId();
+            } else {
+                //Include the count so the marker is replaced when the cluster changes
+                key = "cluster:" + zoom + ":" + cluster.getCellKey() + ":" + cluster.size();
+            }
+            visibleKeys.add(key);
+
+            if (!markers.containsKey(key)) {
+                markers.put(key, cluster.isSingle() ? addCameraMarker(key, cluster.getItems()
+                        .get(0).camera) : addClusterMarker(cluster));
+            }
+        }
+
+        Iterator<Map.Entry<String, Marker>> iterator = markers.entrySet().iterator();
+        while (iterator.hasNext()) {
+            Map.Entry<String, Marker> entry = iterator.next();
+            if (!visibleKeys.contains(entry.getKey())) {
+                removeMarker(entry.getKey(), entry.getValue());
+                iterator.remove();
+            }
+        }
+        Log.d(TAG, visibleCameras.size() + " of " + cameraIndex.size() + " cameras visible in "
+                + clusters.size() + " markers, " + (System.currentTimeMillis() - startTime) + "ms");
+    }
+
+    private Marker addCameraMarker(final String key, EvercamCamera camera) {
+        final Marker marker = map.addMarker(new MarkerOptions()
+                .position(new LatLng(camera.getLatitude(), camera.getLongitude()))
+                .title(camera.getName()));
+        marker.setTag(camera);
+
+        String thumbnailUrl = camera.getThumbnailUrl();
+        if (thumbnailUrl != null && !thumbnailUrl.isEmpty()) {
+            Target target = new Target() {
+                @Override
+                public void onBitmapLoaded(Bitmap bitmap, Picasso.LoadedFrom from) {
+                    //The marker may have been removed while loading
+                    if (markers.get(key) == marker) {
+                        marker.setIcon(BitmapDescriptorFactory.fromBitmap(bitmap));
+                    }
+                    thumbnailTargets.remove(key);
+                }
+
+                @Override
+                public void onBitmapFailed(Drawable errorDrawable) {
+                    thumbnailTargets.remove(key);
+                }
+
+                @Override
+                public void onPrepareLoad(Drawable placeHolderDrawable) {
+                }
+            };
+            thumbnailTargets.put(key, target);
+            Picasso.with(getActivity()).load(thumbnailUrl)
+                    .resize(dpToPixels(THUMBNAIL_WIDTH_DP), dpToPixels(THUMBNAIL_HEIGHT_DP))
+                    .centerCrop().into(target);
+        }
+        return marker;
+    }
+
+    private Marker addClusterMarker(MarkerClusterer.Cluster<CameraLocation> cluster) {
+        Marker marker = map.addMarker(new MarkerOptions()
+                .position(new LatLng(cluster.getLatitude(), cluster.getLongitude()))
+                .icon(getClusterIcon(cluster.size()))
+                .anchor(0.5f, 0.5f));
+        marker.setTag(getBounds(cluster.getItems()));
+        return marker;
+    }
+
+    private void removeMarker(String key, Marker marker) {
+        Target target = thumbnailTargets.remove(key);
+        if (target != null) {
+            Picasso.with(getActivity()).cancelRequest(target);
+        }
+        marker.remove();
+    }
+
+    private void clearMarkers() {
+        for (Map.Entry<String, Marker> entry : markers.entrySet()) {
+            removeMarker(entry.getKey(), entry.getValue());
+        }
+        markers.clear();
+    }
+
+    private BitmapDescriptor getClusterIcon(int count) {
+        BitmapDescriptor icon = clusterIcons.get(count);
+        if (icon == null) {
+            int size = dpToPixels(CLUSTER_ICON_DP);
+            Bitmap bitmap = Bitmap.createBitmap(size, size, Bitmap.Config.ARGB_8888);
+            Canvas canvas = new Canvas(bitmap);
+
+            Paint circlePaint = new Paint(Paint.ANTI_ALIAS_FLAG);
+            circlePaint.setColor(getResources().getColor(R.color.evercam_blue));
+            canvas.drawCircle(size / 2f, size / 2f, size / 2f, circlePaint);
+
+            Paint textPaint = new Paint(Paint.ANTI_ALIAS_FLAG);
+            textPaint.setColor(Color.WHITE);
+            textPaint.setTextAlign(Paint.Align.CENTER);
+            textPaint.setTextSize(size / 2.5f);
+            float textY = size / 2f - (textPaint.descent() + textPaint.ascent()) / 2;
+            canvas.drawText(String.valueOf(count), size / 2f, textY, textPaint);
+
+            icon = BitmapDescriptorFactory.fromBitmap(bitmap);
+            clusterIcons.put(count, icon);
+        }
+        return icon;
+    }
+
+    private static LatLngBounds getBounds(List<CameraLocation> locations) {
+        LatLngBounds.Builder builder = new LatLngBounds.Builder();
+        for (CameraLocation location : locations) {
+            builder.include(new LatLng(location.getLatitude(), location.getLongitude()));
+        }
+        return builder.build();
+    }
+
+    private int dpToPixels(int dp) {
+        return (int) (dp * getResources().getDisplayMetrics().density + 0.5f);
+    }
+}
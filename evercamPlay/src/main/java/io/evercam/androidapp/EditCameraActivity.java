@@ -24,18 +24,15 @@ import org.json.JSONException;
 
 import java.util.ArrayList;
 
-import io.evercam.Auth;
-import io.evercam.Defaults;
-import io.evercam.EvercamException;
-import io.evercam.Model;
 import io.evercam.PatchCameraBuilder;
-import io.evercam.Vendor;
 import io.evercam.androidapp.addeditcamera.AddCameraParentActivity;
 import io.evercam.androidapp.addeditcamera.ModelSelectorFragment;
 import io.evercam.androidapp.addeditcamera.ValidateHostInput;
 import io.evercam.androidapp.custom.CustomToast;
 import io.evercam.androidapp.custom.CustomedDialog;
 import io.evercam.androidapp.custom.PortCheckEditText;
+import io.evercam.androidapp.dto.CatalogueModel;
+import io.evercam.androidapp.dto.CatalogueVendor;
 import io.evercam.androidapp.dto.EvercamCamera;
 import io.evercam.androidapp.tasks.PatchCameraTask;
 import io.evercam.androidapp.tasks.PortCheckTask;
@@ -406,34 +403,37 @@ public class EditCameraActivity extends AddCameraParentActivity {
         return patchCameraBuilder;
     }
 
-    public void fillDefaults(Model model) {
-        try {
-            // FIXME: Sometimes vendor with no default model, contains default
-            // jpg url.
-            // TODO: Consider if no default values associated, clear defaults
-            // that has been filled.
-            Defaults defaults = model.getDefaults();
-            Auth basicAuth = defaults.getAuth(Auth.TYPE_BASIC);
-            if (basicAuth != null && cameraEdit == null) {
-                usernameEdit.setText(basicAuth.getUsername());
-                passwordEdit.setText(basicAuth.getPassword());
-            }
-            jpgUrlEdit.setText(defaults.getJpgURL());
-//            rtspUrlEdit.setText(defaults.getH264URL());
-
-            if (!model.getName().equals(Model.DEFAULT_MODEL_NAME)
-                    && !jpgUrlEdit.getText().toString().isEmpty()) {
-                //If user specified a specific model, make it not editable
-                jpgUrlEdit.setFocusable(false);
-                jpgUrlEdit.setClickable(true);
-            } else {
-                //For default model or
-                jpgUrlEdit.setFocusable(true);
-                jpgUrlEdit.setClickable(true);
-                jpgUrlEdit.setFocusableInTouchMode(true);
-            }
-        } catch (EvercamException e) {
-            Log.e(TAG, "Fill defaults: " + e.toString());
+    public void fillDefaults(CatalogueModel model) {
+        // FIXME: Sometimes vendor with no default model, contains default
+        // jpg url.
+        // TODO: Consider if no default values associated, clear defaults
+        // that has been filled.
+        boolean hasBasicAuth = !model.getUsername().isEmpty() || !model.getPassword().isEmpty();
+        if (hasBasicAuth && cameraEdit == null) {
+            usernameEdit.setText(model.getUsername());
+            passwordEdit.setText(model.getPassword());
+        }
+        jpgUrlEdit.setText(model.getJpgUrl());
+//        rtspUrlEdit.setText(model.getH264Url());
+
+        if (!model.isDefaultModel() && !jpgUrlEdit.getText().toString().isEmpty()) {
+            //If user specified a specific model, make it not editable
+            jpgUrlEdit.setFocusable(false);
+            jpgUrlEdit.setClickable(true);
+        } else {
+            //For default model or
+            jpgUrlEdit.setFocusable(true);
+            jpgUrlEdit.setClickable(true);
+            jpgUrlEdit.setFocusableInTouchMode(true);
+        }
+    }
+
+    /**
+     * Fill in the snapshot ending found by the snapshot test when none was given
+     */
+    public void onSnapshotEndingFound(String ending) {
+        if (jpgUrlEdit.getText().toString().isEmpty()) {
+            jpgUrlEdit.setText(ending);
         }
     }
 
@@ -476,13 +476,20 @@ public class EditCameraActivity extends AddCameraParentActivity {
 
             String externalUrl = getString(R.string.prefix_http) + externalHost + ":" + externalHttp;
 
+            String internalUrl = null;
+            String internalHost = cameraEdit.getInternalHost();
+            if (internalHost != null && !internalHost.isEmpty() && cameraEdit.getInternalHttp() > 0) {
+                internalUrl = getString(R.string.prefix_http) + internalHost + ":"
+                        + cameraEdit.getInternalHttp();
+            }
+
             new TestSnapshotTask(externalUrl, jpgUrl, username, password,
-                    EditCameraActivity.this,modelSelectorFragment.getVendorIdFromSpinner(),camera_exid).executeOnExecutor(AsyncTask
-                    .THREAD_POOL_EXECUTOR);
+                    EditCameraActivity.this,modelSelectorFragment.getVendorIdFromSpinner(),camera_exid)
+                    .setInternalUrl(internalUrl).executeOnExecutor(AsyncTask.THREAD_POOL_EXECUTOR);
         }
     }
 
-    public void buildSpinnerOnModelListResult(@NonNull ArrayList<Model> modelList) {
+    public void buildSpinnerOnModelListResult(@NonNull ArrayList<CatalogueModel> modelList) {
         if (cameraEdit != null && cameraEdit.hasModel()) {
             modelSelectorFragment.buildModelSpinner(modelList, cameraEdit.getModelId());
         } else {
@@ -490,7 +497,7 @@ public class EditCameraActivity extends AddCameraParentActivity {
         }
     }
 
-    public void buildSpinnerOnVendorListResult(@NonNull ArrayList<Vendor> vendorList) {
+    public void buildSpinnerOnVendorListResult(@NonNull ArrayList<CatalogueVendor> vendorList) {
         // If the camera has vendor, show as selected in spinner
         if (cameraEdit != null && !cameraEdit.getVendor().isEmpty()) {
             modelSelectorFragment.buildVendorSpinner(vendorList, cameraEdit.getVendor());
@@ -30,17 +30,18 @@ import com.google.android.gms.maps.SupportMapFragment;
 import com.google.android.gms.maps.model.BitmapDescriptorFactory;
 import com.google.android.gms.maps.model.LatLng;
 import com.google.android.gms.maps.model.MarkerOptions;
-import com.mashape.unirest.http.HttpResponse;
-import com.mashape.unirest.http.JsonNode;
-import com.mashape.unirest.http.Unirest;
-import com.mashape.unirest.http.exceptions.UnirestException;
-
 import org.json.JSONException;
 import org.json.JSONObject;
 
+import java.io.IOException;
+
 import io.evercam.PatchCameraBuilder;
 import io.evercam.androidapp.dto.EvercamCamera;
+import io.evercam.androidapp.http.SharedHttpClient;
 import io.evercam.androidapp.tasks.PatchCameraTask;
+import io.evercam.androidapp.utils.TimezoneLocator;
+import okhttp3.Request;
+import okhttp3.Response;
 
 public class EditCameraLocationActivity extends ParentAppCompatActivity implements OnMapReadyCallback, LocationListener {
 
@@ -63,6 +64,13 @@ public class EditCameraLocationActivity extends ParentAppCompatActivity implemen
 
         cameraToUpdate = ViewCameraActivity.evercamCamera;
 
+        AsyncTask.THREAD_POOL_EXECUTOR.execute(new Runnable() {
+            @Override
+            public void run() {
+                TimezoneLocator.loadGrid(getApplicationContext());
+            }
+        });
+
         setUpDefaultToolbar();
 
         SupportMapFragment mapFragment = (SupportMapFragment) getSupportFragmentManager()
@@ -221,7 +229,7 @@ public class EditCameraLocationActivity extends ParentAppCompatActivity implemen
 
                         mMap.addMarker(new MarkerOptions().position(latLng));
 
-                        new CallMashapeAsync().execute();
+                        updateTimezone();
 
                     } else {
 
@@ -244,45 +252,73 @@ public class EditCameraLocationActivity extends ParentAppCompatActivity implemen
                 tappedLatLng = latLng;
                 mMap.addMarker(new MarkerOptions().position(latLng).icon(BitmapDescriptorFactory.defaultMarker(BitmapDescriptorFactory.HUE_RED)));
 
-                new CallMashapeAsync().execute();
+                updateTimezone();
             }
         });
     }
 
-    private class CallMashapeAsync extends AsyncTask<String, Integer, HttpResponse<JsonNode>> {
+    /**
+     * Resolve the timezone of the tapped location from the grid asset if the build has
+     * one, then from the Google Time Zone API. Without either the timezone is left
+     * unchanged.
+     */
+    private void updateTimezone() {
+        timeZone = TimezoneLocator.locateInGrid(tappedLatLng.latitude, tappedLatLng.longitude);
+        Log.v("Time Zone", "Local: " + timeZone);
+
+        new CallMashapeAsync(tappedLatLng).execute();
+    }
+
+    private class CallMashapeAsync extends AsyncTask<String, Integer, String> {
+        private final LatLng latLng;
+
+        CallMashapeAsync(LatLng latLng) {
+            this.latLng = latLng;
+        }
 
-        protected HttpResponse<JsonNode> doInBackground(String... msg) {
+        protected String doInBackground(String... msg) {
 
-            HttpResponse<JsonNode> jsonResponse = null;
+            String jsonString = null;
             try {
-                String latitude = String.valueOf(tappedLatLng.latitude);
-                String longitude = String.valueOf(tappedLatLng.longitude);
-                jsonResponse = Unirest.get("https://maps.googleapis.com/maps/api/timezone/json?location=" + latitude + "," + longitude + "&timestamp=1482151170&key=AIzaSyAXwqGkwI87v4YoSGCq0FStNXr0")
-                        .asJson();
-                String str = jsonResponse.getBody().toString();
-                Log.v("json First", str);
-            } catch (UnirestException e) {
-                // TODO Auto-generated catch block
+                String latitude = String.valueOf(latLng.latitude);
+                String longitude = String.valueOf(latLng.longitude);
+                Request request = new Request.Builder().url("https://maps.googleapis.com/maps/api/timezone/json?location=" + latitude + "," + longitude + "&timestamp=1482151170&key=AIzaSyAXwqGkwI87v4YoSGCq0FStNXr0")
+                        .build();
+                Response response = SharedHttpClient.get().newCall(request).execute();
+                try {
+                    if (response.isSuccessful()) {
+                        jsonString = response.body().string();
+                        Log.v("json First", jsonString);
+                    }
+                } finally {
+                    response.close();
+                }
+            } catch (IOException e) {
                 e.printStackTrace();
             }
 
-            return jsonResponse;
+            return jsonString;
         }
 
         protected void onProgressUpdate(Integer... integers) {
         }
 
-        protected void onPostExecute(HttpResponse<JsonNode> response) {
-
-            String jsonString = response.getBody().toString();
+        protected void onPostExecute(String jsonString) {
+            //Offline or failed, keep the local result
+            if (jsonString == null) return;
+            //Ignore the answer if another location has been tapped since
+            if (latLng != tappedLatLng) return;
 
             try {
                 JSONObject jsonobj = new JSONObject(jsonString);
-                timeZone = jsonobj.getString("timeZoneId");
+                String remoteTimeZone = jsonobj.getString("timeZoneId");
 //                cameraToUpdate.setTimezone(timeZone);
 //                cameraToUpdate.setLatitude(tappedLatLng.latitude);
 //                cameraToUpdate.setLongitude(tappedLatLng.longitude);
-                Log.v("Time Zone", timeZone);
+                if (!remoteTimeZone.equals(timeZone)) {
+                    Log.d("Time Zone", "Local " + timeZone + " corrected to " + remoteTimeZone);
+                    timeZone = remoteTimeZone;
+                }
             } catch (JSONException e) {
                 e.printStackTrace();
             }
@@ -292,13 +328,16 @@ public class EditCameraLocationActivity extends ParentAppCompatActivity implemen
 
     private PatchCameraBuilder buildPatchCameraWithLocalCheck() {
 
-        cameraToUpdate.setTimezone(timeZone);
         cameraToUpdate.setLatitude(tappedLatLng.latitude);
         cameraToUpdate.setLongitude(tappedLatLng.longitude);
 
         PatchCameraBuilder patchCameraBuilder = new PatchCameraBuilder(cameraToUpdate.getCameraId());
 
-        patchCameraBuilder.setTimeZone(cameraToUpdate.getTimezone());
+        //Null if neither the grid nor Google knew the zone, keep the saved one then
+        if (timeZone != null) {
+            cameraToUpdate.setTimezone(timeZone);
+            patchCameraBuilder.setTimeZone(timeZone);
+        }
 
         patchCameraBuilder.setLocation(String.format("%.7f", tappedLatLng.latitude), String.format("%.7f", tappedLatLng.longitude));
 
@@ -12,10 +12,14 @@ import com.google.android.exoplayer2.util.Util;
 import com.google.android.gms.analytics.GoogleAnalytics;
 import com.google.android.gms.analytics.HitBuilders;
 import com.google.android.gms.analytics.Tracker;
+import com.squareup.picasso.Picasso;
 
 import java.util.HashMap;
 
 import io.evercam.androidapp.feedback.IntercomApi;
+import io.evercam.androidapp.http.OkHttp3Downloader;
+import io.evercam.androidapp.http.SharedHttpClient;
+import io.evercam.androidapp.routing.RouteSelector;
 import io.evercam.androidapp.utils.PropertyReader;
 import io.intercom.android.sdk.Intercom;
 
@@ -43,6 +47,10 @@ public class EvercamPlayApplication extends MultiDexApplication {
 
         userAgent = Util.getUserAgent(this, "Evercam");
 
+        SharedHttpClient.init(this);
+        Picasso.setSingletonInstance(new Picasso.Builder(this).downloader(new OkHttp3Downloader
+                (SharedHttpClient.get())).build());
+
         PropertyReader propertyReader = new PropertyReader(this);
 
         IntercomApi.ANDROID_API_KEY = propertyReader.getPropertyStr(PropertyReader.KEY_INTERCOM_ANDROID_KEY);
@@ -50,6 +58,8 @@ public class EvercamPlayApplication extends MultiDexApplication {
         IntercomApi.WEB_API_KEY = propertyReader.getPropertyStr(PropertyReader.KEY_INTERCOM_KEY);
         Intercom.initialize(this, IntercomApi.ANDROID_API_KEY, IntercomApi.APP_ID);
 
+        RouteSelector.init(this);
+
 //            // Redirect URL, just for temporary testing
 //            API.URL = "http://proxy.evr.cm:9292/v1/";
     }
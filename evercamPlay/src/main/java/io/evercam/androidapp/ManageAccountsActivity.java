@@ -21,6 +21,7 @@ import android.widget.ListView;
 import java.io.IOException;
 import java.util.ArrayList;
 
+import io.evercam.androidapp.authentication.AccountStateCache;
 import io.evercam.androidapp.authentication.EvercamAccount;
 import io.evercam.androidapp.custom.AccountItemAdapter;
 import io.evercam.androidapp.custom.CustomProgressDialog;
@@ -82,6 +83,13 @@ public class ManageAccountsActivity extends ParentAppCompatActivity {
                 openDefault.setOnClickListener(new OnClickListener() {
                     @Override
                     public void onClick(View v) {
+                        //Switch straight away if the key was checked in the background recently
+                        if (AccountStateCache.getKeyState(user.getUsername()) ==
+                                AccountStateCache.KeyState.VALID) {
+                            updateDefaultUser(user.getEmail(), true, dialog);
+                            return;
+                        }
+
                         //Check if stored API key and ID before switching account
                         new CheckKeyExpirationTaskAccount(user, optionListView, dialog)
                                 .executeOnExecutor(AsyncTask.THREAD_POOL_EXECUTOR);
@@ -15,6 +15,7 @@ import com.nineoldandroids.view.ViewHelper;
 
 import io.evercam.androidapp.dto.AppUser;
 import io.evercam.androidapp.feedback.MixpanelHelper;
+import io.evercam.androidapp.http.NetworkMetrics;
 import io.evercam.androidapp.utils.PropertyReader;
 import io.intercom.android.sdk.Intercom;
 import io.intercom.android.sdk.identity.Registration;
@@ -46,6 +47,7 @@ public class ParentAppCompatActivity extends AppCompatActivity {
     protected void onStop() {
         super.onStop();
 
+        NetworkMetrics.flush(getApplicationContext(), getMixpanel(), false);
         getMixpanel().flush();
     }
 
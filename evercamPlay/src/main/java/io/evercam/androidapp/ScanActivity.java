@@ -25,16 +25,19 @@ import android.widget.TextView;
 import android.widget.Toast;
 
 import com.badoo.mobile.util.WeakHandler;
-import com.mashape.unirest.http.Unirest;
-import com.mashape.unirest.http.exceptions.UnirestException;
 
-import java.io.InputStream;
+import java.io.File;
+import java.io.IOException;
 import java.util.ArrayList;
+import java.util.Locale;
 
 import io.evercam.androidapp.addeditcamera.AddCameraActivity;
+import io.evercam.androidapp.addeditcamera.CameraCatalogue;
 import io.evercam.androidapp.custom.CustomedDialog;
 import io.evercam.androidapp.dto.AppData;
 import io.evercam.androidapp.dto.EvercamCamera;
+import io.evercam.androidapp.http.SharedHttpClient;
+import io.evercam.androidapp.image.CatalogueImageCache;
 import io.evercam.androidapp.scan.AllDevicesActivity;
 import io.evercam.androidapp.scan.ScanResultAdapter;
 import io.evercam.androidapp.tasks.CheckInternetTask;
@@ -46,6 +49,8 @@ import io.evercam.network.discovery.Device;
 import io.evercam.network.discovery.DeviceInterface;
 import io.evercam.network.discovery.DiscoveredCamera;
 import io.evercam.network.query.EvercamQuery;
+import okhttp3.Request;
+import okhttp3.Response;
 
 public class ScanActivity extends ParentAppCompatActivity {
     private final String TAG = "ScanActivity";
@@ -408,16 +413,35 @@ public class ScanActivity extends ParentAppCompatActivity {
         protected Drawable doInBackground(Void... params) {
             discoveredCamera = EvercamQuery.fillDefaults(discoveredCamera);
 
+            //Use the shared thumbnail cache when the model is in the local catalogue
+            if (discoveredCamera.hasVendor() && discoveredCamera.hasModel()) {
+                String vendorId = discoveredCamera.getVendor().toLowerCase(Locale.UK);
+                String modelId = CameraCatalogue.getSearchIndex(ScanActivity.this)
+                        .matchModelId(vendorId, discoveredCamera.getModel());
+                if (modelId != null) {
+                    File thumbnailFile = CatalogueImageCache.getInstance(ScanActivity.this)
+                            .fetchThumbnail(vendorId, modelId);
+                    if (thumbnailFile != null) {
+                        return Drawable.createFromPath(thumbnailFile.getPath());
+                    }
+                }
+            }
+
             String thumbnailUrl = discoveredCamera.getModelThumbnail();
 
             Drawable drawable = null;
 
             if (!thumbnailUrl.isEmpty()) {
                 try {
-                    InputStream stream = Unirest.get(thumbnailUrl).asBinary().getRawBody();
-                    drawable = Drawable.createFromStream(stream, "src");
-                } catch (UnirestException e) {
-                    Log.e(TAG, e.getStackTrace()[0].toString());
+                    Response response = SharedHttpClient.get().newCall(new Request.Builder()
+                            .url(thumbnailUrl).build()).execute();
+                    try {
+                        drawable = Drawable.createFromStream(response.body().byteStream(), "src");
+                    } finally {
+                        response.close();
+                    }
+                } catch (IOException | IllegalArgumentException e) {
+                    Log.e(TAG, e.toString());
                 }
             }
 
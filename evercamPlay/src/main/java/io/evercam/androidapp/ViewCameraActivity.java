@@ -38,7 +38,6 @@ import com.mashape.unirest.http.HttpResponse;
 import com.mashape.unirest.http.JsonNode;
 import com.mashape.unirest.http.Unirest;
 import com.mashape.unirest.http.exceptions.UnirestException;
-import com.squareup.picasso.Picasso;
 
 import java.io.IOException;
 import java.util.ArrayList;
@@ -48,11 +47,11 @@ import java.util.Set;
 import java.util.TreeMap;
 
 import io.evercam.EvercamException;
-import io.evercam.Model;
 import io.evercam.Vendor;
 import io.evercam.androidapp.addeditcamera.ModelSelectorFragment;
 import io.evercam.androidapp.custom.CustomedDialog;
 import io.evercam.androidapp.dto.EvercamCamera;
+import io.evercam.androidapp.image.CatalogueImageCache;
 import io.evercam.androidapp.tasks.DeleteCameraTask;
 import io.evercam.androidapp.utils.Commons;
 import io.evercam.androidapp.utils.Constants;
@@ -297,17 +296,14 @@ public class ViewCameraActivity extends ParentAppCompatActivity implements OnMap
 
         if (!evercamCamera.getVendor().equals(getString(R.string.vendor_other))) {
             //Update vendor logo when vendor is selected
-            Picasso.with(this).load(Vendor.getLogoUrl(vendorId)
-            ).placeholder(android.R.color.transparent).into(vendorLogoImageView);
+            CatalogueImageCache.getInstance(this).loadLogo(this, vendorLogoImageView, vendorId);
 
         }else{
             vendorLogoImageView.setImageResource(android.R.color.transparent);
         }
 
-        Picasso.with(this)
-                .load(Model.getThumbnailUrl(vendorId, evercamCamera.getModelId()))
-                .placeholder(R.drawable.thumbnail_placeholder)
-                .into(modelThumbnailImageView);
+        CatalogueImageCache.getInstance(this).loadThumbnail(this, modelThumbnailImageView,
+                vendorId, evercamCamera.getModelId(), R.drawable.thumbnail_placeholder);
 
 //        Set<String> set = vendorMap.keySet();
 //        String[] vendorArray = Commons.joinStringArray(new String[]{getResources().getString(R
@@ -25,10 +25,6 @@ import android.view.KeyEvent;
 import java.util.ArrayList;
 
 import io.evercam.CameraBuilder;
-import io.evercam.Defaults;
-import io.evercam.EvercamException;
-import io.evercam.Model;
-import io.evercam.Vendor;
 import io.evercam.androidapp.EditCameraActivity;
 import io.evercam.androidapp.EvercamPlayApplication;
 import io.evercam.androidapp.R;
@@ -36,6 +32,8 @@ import io.evercam.androidapp.custom.CustomToast;
 import io.evercam.androidapp.custom.CustomedDialog;
 import io.evercam.androidapp.custom.ExplanationView;
 import io.evercam.androidapp.custom.PortCheckEditText;
+import io.evercam.androidapp.dto.CatalogueModel;
+import io.evercam.androidapp.dto.CatalogueVendor;
 import io.evercam.androidapp.tasks.AddCameraTask;
 import io.evercam.androidapp.tasks.PortCheckTask;
 import io.evercam.androidapp.tasks.TestSnapshotTask;
@@ -63,7 +61,7 @@ public class AddCameraActivity extends AddCameraParentActivity {
      */
     private ModelSelectorFragment mModelSelectorFragment;
     private SelectedModel mSelectedModel;
-    private Defaults mSelectedModelDefaults;
+    private CatalogueModel mSelectedModelDefaults;
 
     /**
      * Connect camera
@@ -308,8 +306,9 @@ public class AddCameraActivity extends AddCameraParentActivity {
                     String externalUrl = getString(R.string.prefix_http) + externalHost + ":" + externalHttp;
 
                     new TestSnapshotTask(externalUrl, jpgUrl, username, password,
-                            AddCameraActivity.this,mModelSelectorFragment.getVendorIdFromSpinner(),"").executeOnExecutor(AsyncTask
-                            .THREAD_POOL_EXECUTOR);
+                            AddCameraActivity.this,mModelSelectorFragment.getVendorIdFromSpinner(),"")
+                            .setInternalUrl(getDiscoveredInternalUrl())
+                            .executeOnExecutor(AsyncTask.THREAD_POOL_EXECUTOR);
                 }
             }
         });
@@ -472,23 +471,15 @@ public class AddCameraActivity extends AddCameraParentActivity {
         mRtspPathLayout.setVisibility(show ? View.VISIBLE : View.GONE);
     }
 
-    public void onDefaultsLoaded(Model model) {
-        if (model != null) {
-            try {
-                mSelectedModelDefaults = model.getDefaults();
-            } catch (EvercamException e) {
-                e.printStackTrace();
-            }
-        } else {
-            mSelectedModelDefaults = null;
-        }
+    public void onDefaultsLoaded(CatalogueModel model) {
+        mSelectedModelDefaults = model;
     }
 
-    public void buildSpinnerOnVendorListResult(@NonNull ArrayList<Vendor> vendorList) {
+    public void buildSpinnerOnVendorListResult(@NonNull ArrayList<CatalogueVendor> vendorList) {
         mModelSelectorFragment.buildVendorSpinner(vendorList, null);
     }
 
-    public void buildSpinnerOnModelListResult(ArrayList<Model> modelList) {
+    public void buildSpinnerOnModelListResult(ArrayList<CatalogueModel> modelList) {
         String autoPopulatedModel = null;
         if (mDiscoveredCamera != null && mDiscoveredCamera.hasModel()) {
             autoPopulatedModel = mDiscoveredCamera.getModel();
@@ -496,6 +487,26 @@ public class AddCameraActivity extends AddCameraParentActivity {
         mModelSelectorFragment.buildModelSpinner(modelList, autoPopulatedModel);
     }
 
+    /**
+     * @return the local address of the discovered camera, or null if not from a scan
+     */
+    public String getDiscoveredInternalUrl() {
+        if (mDiscoveredCamera != null && mDiscoveredCamera.hasHTTP()) {
+            return getString(R.string.prefix_http) + mDiscoveredCamera.getIP() + ":"
+                    + mDiscoveredCamera.getHttp();
+        }
+        return null;
+    }
+
+    /**
+     * Fill in the snapshot ending found by the snapshot test when none was given
+     */
+    public void onSnapshotEndingFound(String ending) {
+        if (mSnapshotPathEditText.getText().toString().isEmpty()) {
+            mSnapshotPathEditText.setText(ending);
+        }
+    }
+
     public boolean isFromDiscoverAndHasVendor() {
         return mDiscoveredCamera != null && mDiscoveredCamera.hasVendor();
     }
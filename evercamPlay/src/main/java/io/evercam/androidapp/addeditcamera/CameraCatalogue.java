@@ -0,0 +1,151 @@
+package io.evercam.androidapp.addeditcamera;
+
+import android.content.Context;
+import android.util.Log;
+
+import org.json.JSONException;
+
+import java.io.ByteArrayOutputStream;
+import java.io.IOException;
+import java.io.InputStream;
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.Locale;
+
+import io.evercam.EvercamException;
+import io.evercam.Model;
+import io.evercam.Vendor;
+import io.evercam.androidapp.dal.DbCatalogue;
+import io.evercam.androidapp.dto.CatalogueModel;
+import io.evercam.androidapp.dto.CatalogueVendor;
+import io.evercam.androidapp.utils.PrefsManager;
+
+/**
+ * Keeps the local vendor/model catalogue in DbCatalogue up to date.
+ *
+ * On first use the catalogue is seeded from the baseline snapshot in assets, which release
+ * builds export from the API (see scripts/export_catalogue_baseline.py). After that the vendor list is refetched at most once a day, and a vendor's
+ * models at most once a week when the vendor is selected. Only differences are written,
+ * and the catalogue version in PrefsManager is increased whenever something changed.
+ *
+ * All methods do database or network work and must be called off the main thread.
+ */
+public class CameraCatalogue {
+    private final static String TAG = "CameraCatalogue";
+    public final static long VENDOR_REFRESH_INTERVAL_MS = 24 * 60 * 60 * 1000L;
+    public final static long MODEL_REFRESH_INTERVAL_MS = 7 * 24 * 60 * 60 * 1000L;
+
+    private static CatalogueSearchIndex searchIndex;
+    private static int searchIndexVersion = -1;
+
+    public static synchronized void importBaselineIfEmpty(Context context) {
+        DbCatalogue dbCatalogue = new DbCatalogue(context);
+        if (dbCatalogue.getVendorCount() > 0) return;
+
+        try {
+            //Debug builds don't run the export, the first refresh fills the catalogue instead
+            if (!Arrays.asList(context.getAssets().list("")).contains(CatalogueBaseline.ASSET_NAME)) {
+                Log.d(TAG, "No baseline catalogue in this build");
+                return;
+            }
+
+            CatalogueBaseline baseline = CatalogueBaseline.parse(readAsset(context,
+                    CatalogueBaseline.ASSET_NAME));
+            dbCatalogue.applyVendorDelta(baseline.getVendorList());
+            for (String vendorId : baseline.getModelsByVendor().keySet()) {
+                dbCatalogue.applyModelDelta(vendorId, baseline.getModelsByVendor().get(vendorId),
+                        baseline.getGeneratedAt());
+            }
+
+            //Leave the vendor refresh time at 0 so the baseline is brought up to date soon
+            PrefsManager.increaseCatalogueVersion(context);
+            Log.d(TAG, "Imported baseline catalogue: " + baseline.getVendorList().size()
+                    + " vendors, " + baseline.getModelCount() + " models");
+        } catch (IOException | JSONException e) {
+            Log.e(TAG, "Failed to import baseline catalogue: " + e.toString());
+        }
+    }
+
+    /**
+     * @return the search index over the local catalogue, rebuilt if the catalogue changed
+     */
+    public static synchronized CatalogueSearchIndex getSearchIndex(Context context) {
+        int version = PrefsManager.getCatalogueVersion(context);
+        if (searchIndex == null || searchIndexVersion != version) {
+            DbCatalogue dbCatalogue = new DbCatalogue(context);
+            long startTime = System.currentTimeMillis();
+            searchIndex = new CatalogueSearchIndex(dbCatalogue.getVendors(),
+                    dbCatalogue.getAllModels());
+            searchIndexVersion = version;
+            Log.d(TAG, "Indexed " + searchIndex.size() + " catalogue entries in "
+                    + (System.currentTimeMillis() - startTime) + "ms");
+        }
+        return searchIndex;
+    }
+
+    public static boolean isVendorListStale(Context context) {
+        return System.currentTimeMillis() - PrefsManager.getCatalogueRefreshedAt(context)
+                > VENDOR_REFRESH_INTERVAL_MS;
+    }
+
+    public static boolean isModelListStale(CatalogueVendor vendor) {
+        return System.currentTimeMillis() - vendor.getModelsRefreshedAt() > MODEL_REFRESH_INTERVAL_MS;
+    }
+
+    /**
+     * Fetch the vendor list and apply the differences
+     *
+     * @return the number of vendors added, renamed or removed
+     */
+    public static synchronized int refreshVendors(Context context) throws EvercamException {
+        ArrayList<CatalogueVendor> vendorList = new ArrayList<>();
+        for (Vendor vendor : Vendor.getAll()) {
+            vendorList.add(new CatalogueVendor(vendor.getId().toLowerCase(Locale.UK),
+                    vendor.getName()));
+        }
+
+        int changeCount = new DbCatalogue(context).applyVendorDelta(vendorList);
+        PrefsManager.setCatalogueRefreshedAt(context, System.currentTimeMillis());
+        if (changeCount > 0) {
+            PrefsManager.increaseCatalogueVersion(context);
+        }
+        Log.d(TAG, "Vendor list refreshed, " + changeCount + " changes");
+        return changeCount;
+    }
+
+    /**
+     * Fetch the models of a vendor and apply the differences
+     *
+     * @return the number of models added, changed or removed
+     */
+    public static synchronized int refreshModels(Context context, String vendorId)
+            throws EvercamException {
+        ArrayList<CatalogueModel> modelList = new ArrayList<>();
+        for (Model model : Model.getAllByVendorId(vendorId)) {
+            modelList.add(CatalogueModel.fromModel(model));
+        }
+
+        int changeCount = new DbCatalogue(context).applyModelDelta(vendorId, modelList,
+                System.currentTimeMillis());
+        if (changeCount > 0) {
+            PrefsManager.increaseCatalogueVersion(context);
+        }
+        Log.d(TAG, "Models of " + vendorId + " refreshed, " + changeCount + " changes");
+        return changeCount;
+    }
+
+    private static String readAsset(Context context, String fileName) throws IOException {
+        InputStream inputStream = context.getAssets().open(fileName);
+        try {
+            ByteArrayOutputStream outputStream = new ByteArrayOutputStream();
+            byte[] buffer = new byte[8192];
+            int length;
+            while ((length = inputStream.read(buffer)) != -1) {
+                outputStream.write(buffer, 0, length);
+            }
+            return outputStream.toString("UTF-8");
+        } finally {
+            inputStream.close();
+        }
+    }
+}
@@ -0,0 +1,78 @@
+package io.evercam.androidapp.addeditcamera;
+
+import org.json.JSONArray;
+import org.json.JSONException;
+import org.json.JSONObject;
+
+import java.util.ArrayList;
+import java.util.HashMap;
+
+import io.evercam.androidapp.dto.CatalogueModel;
+import io.evercam.androidapp.dto.CatalogueVendor;
+
+/**
+ * The catalogue snapshot shipped in assets, written by scripts/export_catalogue_baseline.py
+ */
+public class CatalogueBaseline {
+    public final static String ASSET_NAME = "catalogue_baseline.json";
+
+    private final long generatedAt;
+    private final ArrayList<CatalogueVendor> vendorList = new ArrayList<>();
+    private final HashMap<String, ArrayList<CatalogueModel>> modelsByVendor = new HashMap<>();
+    private int modelCount = 0;
+
+    private CatalogueBaseline(long generatedAt) {
+        this.generatedAt = generatedAt;
+    }
+
+    public static CatalogueBaseline parse(String json) throws JSONException {
+        JSONObject baselineJson = new JSONObject(json);
+        CatalogueBaseline baseline = new CatalogueBaseline(baselineJson.getLong("generated_at"));
+
+        JSONArray vendorArray = baselineJson.getJSONArray("vendors");
+        for (int index = 0; index < vendorArray.length(); index++) {
+            JSONObject vendorJson = vendorArray.getJSONObject(index);
+            baseline.vendorList.add(new CatalogueVendor(vendorJson.getString("id"),
+                    vendorJson.getString("name")));
+        }
+
+        JSONArray modelArray = baselineJson.getJSONArray("models");
+        for (int index = 0; index < modelArray.length(); index++) {
+            CatalogueModel model = getModelFromJson(modelArray.getJSONObject(index));
+            if (!baseline.modelsByVendor.containsKey(model.getVendorId())) {
+                baseline.modelsByVendor.put(model.getVendorId(), new ArrayList<CatalogueModel>());
+            }
+            baseline.modelsByVendor.get(model.getVendorId()).add(model);
+            baseline.modelCount++;
+        }
+        return baseline;
+    }
+
+    public long getGeneratedAt() {
+        return generatedAt;
+    }
+
+    public ArrayList<CatalogueVendor> getVendorList() {
+        return vendorList;
+    }
+
+    public HashMap<String, ArrayList<CatalogueModel>> getModelsByVendor() {
+        return modelsByVendor;
+    }
+
+    public int getModelCount() {
+        return modelCount;
+    }
+
+    private static CatalogueModel getModelFromJson(JSONObject modelJson) throws JSONException {
+        CatalogueModel model = new CatalogueModel(modelJson.getString("id"),
+                modelJson.getString("vendor_id"), modelJson.getString("name"));
+        model.setJpgUrl(modelJson.optString("jpg_url"));
+        model.setH264Url(modelJson.optString("h264_url"));
+        model.setUsername(modelJson.optString("username"));
+        model.setPassword(modelJson.optString("password"));
+        model.setOnvif(modelJson.optBoolean("onvif"));
+        model.setPtz(modelJson.optBoolean("ptz"));
+        return model;
+    }
+}
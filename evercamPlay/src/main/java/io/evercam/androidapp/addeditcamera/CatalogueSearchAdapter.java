@@ -0,0 +1,60 @@
+package io.evercam.androidapp.addeditcamera;
+
+import android.content.Context;
+import android.widget.ArrayAdapter;
+import android.widget.Filter;
+
+import java.util.ArrayList;
+import java.util.List;
+
+/**
+ * Search-as-you-type suggestions for the vendor/model selector, backed by
+ * CatalogueSearchIndex. Filtering runs on the Filter's worker thread, so the index
+ * is built there the first time and after every catalogue change.
+ */
+public class CatalogueSearchAdapter extends ArrayAdapter<CatalogueSearchIndex.Result> {
+    private final static int MAX_SUGGESTIONS = 20;
+
+    private final Context applicationContext;
+    private final Filter filter = new Filter() {
+        @Override
+        protected FilterResults performFiltering(CharSequence constraint) {
+            FilterResults filterResults = new FilterResults();
+            if (constraint != null) {
+                List<CatalogueSearchIndex.Result> results = CameraCatalogue
+                        .getSearchIndex(applicationContext)
+                        .search(constraint.toString(), MAX_SUGGESTIONS);
+                filterResults.values = results;
+                filterResults.count = results.size();
+            }
+            return filterResults;
+        }
+
+        @Override
+        @SuppressWarnings("unchecked")
+        protected void publishResults(CharSequence constraint, FilterResults filterResults) {
+            setNotifyOnChange(false);
+            clear();
+            if (filterResults.values != null) {
+                addAll((List<CatalogueSearchIndex.Result>) filterResults.values);
+            }
+            notifyDataSetChanged();
+        }
+
+        @Override
+        public CharSequence convertResultToString(Object resultValue) {
+            return resultValue.toString();
+        }
+    };
+
+    public CatalogueSearchAdapter(Context context) {
+        super(context, android.R.layout.simple_dropdown_item_1line,
+                new ArrayList<CatalogueSearchIndex.Result>());
+        this.applicationContext = context.getApplicationContext();
+    }
+
+    @Override
+    public Filter getFilter() {
+        return filter;
+    }
+}
@@ -0,0 +1,429 @@
+package io.evercam.androidapp.addeditcamera;
+
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.Collections;
+import java.util.Comparator;
+import java.util.HashMap;
+import java.util.List;
+import java.util.Locale;
+
+import io.evercam.androidapp.dto.CatalogueModel;
+import io.evercam.androidapp.dto.CatalogueVendor;
+
+/**
+ * In-memory search index over the vendor/model catalogue for search-as-you-type.
+ *
+ * Vendors and models are both entries, so vendors whose models haven't been fetched yet
+ * can still be found. Vendor names, model names and model ids are split into lower case
+ * alphanumeric tokens, which are kept in one sorted array so every query token is a binary
+ * search for its prefix range. An entry matches when all query tokens match. If that finds
+ * too few entries, trigrams of the query are looked up to tolerate typos and missing
+ * separators.
+ *
+ * The index is immutable and built off the main thread, searching it is cheap enough to
+ * run on every keystroke.
+ */
+public class CatalogueSearchIndex {
+    private static final int ALPHABET_SIZE = 36;
+    private static final int TRIGRAM_COUNT = ALPHABET_SIZE * ALPHABET_SIZE * ALPHABET_SIZE;
+    /* Share of the query trigrams an entry needs for a fuzzy match */
+    private static final float FUZZY_MATCH_RATIO = 0.6f;
+    /* Trigram similarity a discovered model string needs to be mapped to a model */
+    private static final float DISCOVERED_MATCH_RATIO = 0.7f;
+
+    private static final int SCORE_EXACT_TOKEN = 3;
+    private static final int SCORE_PREFIX_TOKEN = 2;
+
+    /* The model of each entry, null for vendor entries */
+    private final CatalogueModel[] models;
+    private final String[] vendorIds;
+    private final String[] vendorNames;
+    private final String[] compactModelNames;
+    private final String[] compactModelIds;
+
+    /* Sorted tokens and the entry each one belongs to */
+    private final String[] tokens;
+    private final int[] tokenEntries;
+    /* Entries containing each trigram, indexed by trigramKey() */
+    private final int[][] trigramEntries;
+
+    public static class Result {
+        private final CatalogueModel model;
+        private final String vendorId;
+        private final String vendorName;
+        private final int score;
+
+        Result(CatalogueModel model, String vendorId, String vendorName, int score) {
+            this.model = model;
+            this.vendorId = vendorId;
+            this.vendorName = vendorName;
+            this.score = score;
+        }
+
+        /**
+         * @return the matched model, or null if the result is a vendor
+         */
+        public CatalogueModel getModel() {
+            return model;
+        }
+
+        public boolean isVendor() {
+            return model == null;
+        }
+
+        public String getVendorId() {
+            return vendorId;
+        }
+
+        public String getVendorName() {
+            return vendorName;
+        }
+
+        public int getScore() {
+            return score;
+        }
+
+        @Override
+        public String toString() {
+            return isVendor() ? vendorName : vendorName + " " + model.getName();
+        }
+    }
+
+    public CatalogueSearchIndex(List<CatalogueVendor> vendorList, List<CatalogueModel> modelList) {
+        HashMap<String, String> vendorNameMap = new HashMap<>();
+        for (CatalogueVendor vendor : vendorList) {
+            vendorNameMap.put(vendor.getId(), vendor.getName());
+        }
+
+        int entryCount = vendorList.size() + modelList.size();
+        models = new CatalogueModel[entryCount];
+        vendorIds = new String[entryCount];
+        vendorNames = new String[entryCount];
+        compactModelNames = new String[entryCount];
+        compactModelIds = new String[entryCount];
+
+        final ArrayList<String> tokenList = new ArrayList<>();
+        ArrayList<Integer> tokenEntryList = new ArrayList<>();
+        ArrayList<ArrayList<Integer>> trigramLists = new ArrayList<>(
+                Collections.<ArrayList<Integer>>nCopies(TRIGRAM_COUNT, null));
+
+        for (int entryIndex = 0; entryIndex < entryCount; entryIndex++) {
+            ArrayList<String> entryTokens = new ArrayList<>();
+            if (entryIndex < vendorList.size()) {
+                CatalogueVendor vendor = vendorList.get(entryIndex);
+                vendorIds[entryIndex] = vendor.getId();
+                vendorNames[entryIndex] = vendor.getName();
+                compactModelNames[entryIndex] = "";
+                compactModelIds[entryIndex] = "";
+                addTokens(entryTokens, vendor.getName());
+                addTokens(entryTokens, vendor.getId());
+            } else {
+                CatalogueModel model = modelList.get(entryIndex - vendorList.size());
+                String vendorName = vendorNameMap.get(model.getVendorId());
+                models[entryIndex] = model;
+                vendorIds[entryIndex] = model.getVendorId();
+                vendorNames[entryIndex] = vendorName != null ? vendorName : model.getVendorId();
+                compactModelNames[entryIndex] = compact(model.getName());
+                compactModelIds[entryIndex] = compact(stripVendorPrefix(model.getId(),
+                        model.getVendorId()));
+                addTokens(entryTokens, vendorNames[entryIndex]);
+                addTokens(entryTokens, model.getName());
+                addTokens(entryTokens, model.getId());
+                addToken(entryTokens, compactModelNames[entryIndex]);
+            }
+            for (String token : entryTokens) {
+                tokenList.add(token);
+                tokenEntryList.add(entryIndex);
+            }
+
+            addTrigrams(trigramLists, entryIndex, compactModelNames[entryIndex]);
+            addTrigrams(trigramLists, entryIndex, compactModelIds[entryIndex]);
+            addTrigrams(trigramLists, entryIndex, compact(vendorNames[entryIndex]));
+        }
+
+        Integer[] order = new Integer[tokenList.size()];
+        for (int index = 0; index < order.length; index++) {
+            order[index] = index;
+        }
+        Arrays.sort(order, new Comparator<Integer>() {
+            @Override
+            public int compare(Integer left, Integer right) {
+                return tokenList.get(left).compareTo(tokenList.get(right));
+            }
+        });
+        tokens = new String[order.length];
+        tokenEntries = new int[order.length];
+        for (int index = 0; index < order.length; index++) {
+            tokens[index] = tokenList.get(order[index]);
+            tokenEntries[index] = tokenEntryList.get(order[index]);
+        }
+
+        trigramEntries = new int[TRIGRAM_COUNT][];
+        for (int key = 0; key < TRIGRAM_COUNT; key++) {
+            ArrayList<Integer> trigramList = trigramLists.get(key);
+            if (trigramList != null) {
+                trigramEntries[key] = toIntArray(trigramList);
+            }
+        }
+    }
+
+    public int size() {
+        return models.length;
+    }
+
+    /**
+     * @return up to limit vendors and models matching the query, best matches first
+     */
+    public List<Result> search(String query, int limit) {
+        ArrayList<String> queryTokens = new ArrayList<>();
+        addTokens(queryTokens, query);
+        if (queryTokens.isEmpty() || limit <= 0) {
+            return new ArrayList<>();
+        }
+
+        int entryCount = models.length;
+        int[] scores = new int[entryCount];
+        int[] matchedTokenCounts = new int[entryCount];
+        int[] lastMatchedToken = new int[entryCount];
+        Arrays.fill(lastMatchedToken, -1);
+
+        for (int queryIndex = 0; queryIndex < queryTokens.size(); queryIndex++) {
+            String queryToken = queryTokens.get(queryIndex);
+            int from = lowerBound(queryToken);
+            for (int index = from; index < tokens.length && tokens[index].startsWith(queryToken);
+                 index++) {
+                int entryIndex = tokenEntries[index];
+                int tokenScore = tokens[index].length() == queryToken.length() ?
+                        SCORE_EXACT_TOKEN : SCORE_PREFIX_TOKEN;
+                if (lastMatchedToken[entryIndex] != queryIndex) {
+                    lastMatchedToken[entryIndex] = queryIndex;
+                    matchedTokenCounts[entryIndex]++;
+                    scores[entryIndex] += tokenScore;
+                } else if (tokenScore == SCORE_EXACT_TOKEN) {
+                    scores[entryIndex] += SCORE_EXACT_TOKEN - SCORE_PREFIX_TOKEN;
+                }
+            }
+        }
+
+        ArrayList<Result> results = new ArrayList<>();
+        boolean[] isIncluded = new boolean[entryCount];
+        for (int entryIndex = 0; entryIndex < entryCount; entryIndex++) {
+            if (matchedTokenCounts[entryIndex] == queryTokens.size()) {
+                isIncluded[entryIndex] = true;
+                results.add(createResult(entryIndex, scores[entryIndex]));
+            }
+        }
+
+        if (results.size() < limit) {
+            addFuzzyResults(compact(query), isIncluded, results);
+        }
+
+        Collections.sort(results, new Comparator<Result>() {
+            @Override
+            public int compare(Result left, Result right) {
+                if (left.score != right.score) return right.score - left.score;
+                return left.toString().compareToIgnoreCase(right.toString());
+            }
+        });
+        return results.size() > limit ? new ArrayList<>(results.subList(0, limit)) : results;
+    }
+
+    /**
+     * Map a model string reported by a discovered camera, e.g. "DS-2CD2032-I", to the
+     * id of a catalogue model of the same vendor
+     *
+     * @return the model id, or null if no model is close enough
+     */
+    public String matchModelId(String vendorId, String discoveredModel) {
+        String compactQuery = compact(discoveredModel);
+        if (compactQuery.isEmpty()) return null;
+
+        String bestModelId = null;
+        float bestSimilarity = DISCOVERED_MATCH_RATIO;
+        for (int entryIndex = 0; entryIndex < models.length; entryIndex++) {
+            CatalogueModel model = models[entryIndex];
+            if (model == null || !model.getVendorId().equalsIgnoreCase(vendorId)) continue;
+
+            if (compactQuery.equals(compactModelNames[entryIndex])
+                    || compactQuery.equals(compactModelIds[entryIndex])) {
+                return model.getId();
+            }
+            float similarity = Math.max(similarity(compactQuery, compactModelNames[entryIndex]),
+                    similarity(compactQuery, compactModelIds[entryIndex]));
+            if (similarity >= bestSimilarity) {
+                bestSimilarity = similarity;
+                bestModelId = model.getId();
+            }
+        }
+        return bestModelId;
+    }
+
+    private void addFuzzyResults(String compactQuery, boolean[] isIncluded,
+                                 ArrayList<Result> results) {
+        int[] queryTrigrams = trigramKeys(compactQuery);
+        if (queryTrigrams.length == 0) return;
+
+        int[] hitCounts = new int[models.length];
+        for (int key : queryTrigrams) {
+            int[] entryIndexes = trigramEntries[key];
+            if (entryIndexes == null) continue;
+            for (int entryIndex : entryIndexes) {
+                hitCounts[entryIndex]++;
+            }
+        }
+
+        int minHits = Math.max(1, (int) Math.ceil(queryTrigrams.length * FUZZY_MATCH_RATIO));
+        for (int entryIndex = 0; entryIndex < models.length; entryIndex++) {
+            if (!isIncluded[entryIndex] && hitCounts[entryIndex] >= minHits) {
+                //Rank fuzzy matches below all token matches
+                results.add(createResult(entryIndex, hitCounts[entryIndex] - queryTrigrams.length));
+            }
+        }
+    }
+
+    private Result createResult(int entryIndex, int score) {
+        return new Result(models[entryIndex], vendorIds[entryIndex], vendorNames[entryIndex],
+                score);
+    }
+
+    private int lowerBound(String key) {
+        int low = 0;
+        int high = tokens.length;
+        while (low < high) {
+            int middle = (low + high) >>> 1;
+            if (tokens[middle].compareTo(key) < 0) {
+                low = middle + 1;
+            } else {
+                high = middle;
+            }
+        }
+        return low;
+    }
+
+    /**
+     * Dice coefficient of the trigram sets of two compact strings
+     */
+    static float similarity(String first, String second) {
+        int[] firstTrigrams = trigramKeys(first);
+        int[] secondTrigrams = trigramKeys(second);
+        if (firstTrigrams.length == 0 || secondTrigrams.length == 0) return 0;
+
+        int common = 0;
+        int firstIndex = 0;
+        int secondIndex = 0;
+        while (firstIndex < firstTrigrams.length && secondIndex < secondTrigrams.length) {
+            if (firstTrigrams[firstIndex] == secondTrigrams[secondIndex]) {
+                common++;
+                firstIndex++;
+                secondIndex++;
+            } else if (firstTrigrams[firstIndex] < secondTrigrams[secondIndex]) {
+                firstIndex++;
+            } else {
+                secondIndex++;
+            }
+        }
+        return 2f * common / (firstTrigrams.length + secondTrigrams.length);
+    }
+
+    /**
+     * @return the distinct trigram keys of a compact string, sorted
+     */
+    static int[] trigramKeys(String compact) {
+        if (compact.length() < 3) return new int[0];
+
+        int[] keys = new int[compact.length() - 2];
+        for (int index = 0; index < keys.length; index++) {
+            keys[index] = trigramKey(compact.charAt(index), compact.charAt(index + 1),
+                    compact.charAt(index + 2));
+        }
+        Arrays.sort(keys);
+
+        int distinctCount = 0;
+        for (int index = 0; index < keys.length; index++) {
+            if (index == 0 || keys[index] != keys[index - 1]) {
+                keys[distinctCount++] = keys[index];
+            }
+        }
+        return Arrays.copyOf(keys, distinctCount);
+    }
+
+    private static int trigramKey(char first, char second, char third) {
+        return (charIndex(first) * ALPHABET_SIZE + charIndex(second)) * ALPHABET_SIZE
+                + charIndex(third);
+    }
+
+    private static int charIndex(char character) {
+        return character <= '9' ? character - '0' : character - 'a' + 10;
+    }
+
+    /**
+     * Lower case letters and digits only, e.g. "DS-2CD2032-I" becomes "ds2cd2032i"
+     */
+    static String compact(String text) {
+        if (text == null) return "";
+
+        StringBuilder builder = new StringBuilder(text.length());
+        for (char character : text.toLowerCase(Locale.UK).toCharArray()) {
+            if (isIndexable(character)) {
+                builder.append(character);
+            }
+        }
+        return builder.toString();
+    }
+
+    private static boolean isIndexable(char character) {
+        return (character >= 'a' && character <= 'z') || (character >= '0' && character <= '9');
+    }
+
+    private static void addTokens(List<String> tokenList, String text) {
+        if (text == null) return;
+
+        StringBuilder builder = new StringBuilder();
+        for (char character : text.toLowerCase(Locale.UK).toCharArray()) {
+            if (isIndexable(character)) {
+                builder.append(character);
+            } else if (builder.length() > 0) {
+                addToken(tokenList, builder.toString());
+                builder.setLength(0);
+            }
+        }
+        if (builder.length() > 0) {
+            addToken(tokenList, builder.toString());
+        }
+    }
+
+    private static void addToken(List<String> tokenList, String token) {
+        if (!token.isEmpty() && !tokenList.contains(token)) {
+            tokenList.add(token);
+        }
+    }
+
+    private static void addTrigrams(ArrayList<ArrayList<Integer>> trigramLists, int entryIndex,
+                                    String compact) {
+        for (int key : trigramKeys(compact)) {
+            ArrayList<Integer> entryIndexes = trigramLists.get(key);
+            if (entryIndexes == null) {
+                entryIndexes = new ArrayList<>();
+                trigramLists.set(key, entryIndexes);
+            }
+            //Entries are added in order, so a duplicate can only be the last one
+            if (entryIndexes.isEmpty() || entryIndexes.get(entryIndexes.size() - 1) != entryIndex) {
+                entryIndexes.add(entryIndex);
+            }
+        }
+    }
+
+    private static String stripVendorPrefix(String modelId, String vendorId) {
+        String prefix = vendorId + "_";
+        return modelId.startsWith(prefix) ? modelId.substring(prefix.length()) : modelId;
+    }
+
+    private static int[] toIntArray(List<Integer> list) {
+        int[] array = new int[list.size()];
+        for (int index = 0; index < array.length; index++) {
+            array[index] = list.get(index);
+        }
+        return array;
+    }
+}
@@ -1,5 +1,6 @@
 package io.evercam.androidapp.addeditcamera;
 
+import android.content.Context;
 import android.os.AsyncTask;
 import android.os.Bundle;
 import android.support.annotation.Nullable;
@@ -10,11 +11,10 @@ import android.view.View;
 import android.view.ViewGroup;
 import android.widget.AdapterView;
 import android.widget.ArrayAdapter;
+import android.widget.AutoCompleteTextView;
 import android.widget.ImageView;
 import android.widget.Spinner;
 
-import com.squareup.picasso.Picasso;
-
 import java.util.ArrayList;
 import java.util.Collection;
 import java.util.Locale;
@@ -24,11 +24,14 @@ import java.util.TreeMap;
 
 import io.evercam.EvercamException;
 import io.evercam.Model;
-import io.evercam.Vendor;
 import io.evercam.androidapp.EditCameraActivity;
 import io.evercam.androidapp.EvercamPlayApplication;
 import io.evercam.androidapp.R;
 import io.evercam.androidapp.custom.CustomedDialog;
+import io.evercam.androidapp.dal.DbCatalogue;
+import io.evercam.androidapp.dto.CatalogueModel;
+import io.evercam.androidapp.dto.CatalogueVendor;
+import io.evercam.androidapp.image.CatalogueImageCache;
 import io.evercam.androidapp.utils.Commons;
 
 public class ModelSelectorFragment extends Fragment {
@@ -40,12 +43,15 @@ public class ModelSelectorFragment extends Fragment {
     private int modelSavedSelectedPosition = 0;
 
     private ImageView modelExplanationImageButton;
+    private AutoCompleteTextView searchEditText;
     private Spinner vendorSpinner;
     private Spinner modelSpinner;
     private TreeMap<String, String> vendorMap;
     private TreeMap<String, String> vendorMapIdAsKey;
     private TreeMap<String, String> modelMap;
-    private ArrayList<Model> modelListGlobal;
+    private ArrayList<CatalogueModel> modelListGlobal = new ArrayList<>();
+    /* Model to select once the selected vendor's models are loaded */
+    private String pendingModelId;
 
     @Nullable
     @Override
@@ -55,6 +61,7 @@ public class ModelSelectorFragment extends Fragment {
         vendorSpinner = (Spinner) rootView.findViewById(R.id.vendor_spinner);
         modelSpinner = (Spinner) rootView.findViewById(R.id.model_spinner);
         modelExplanationImageButton = (ImageView) rootView.findViewById(R.id.model_explanation_btn);
+        searchEditText = (AutoCompleteTextView) rootView.findViewById(R.id.model_search_edit_text);
 
         final ImageView vendorLogoImageView = (ImageView) rootView.findViewById(R.id.vendor_logo_image_view);
         final ImageView modelThumbnailImageView = (ImageView) rootView.findViewById(R.id.model_thumbnail_image_view);
@@ -78,6 +85,15 @@ public class ModelSelectorFragment extends Fragment {
             }
         });
 
+        searchEditText.setAdapter(new CatalogueSearchAdapter(getActivity()));
+        searchEditText.setOnItemClickListener(new AdapterView.OnItemClickListener() {
+            @Override
+            public void onItemClick(AdapterView<?> parent, View view, int position, long id) {
+                onSearchResultSelected((CatalogueSearchIndex.Result) parent.getItemAtPosition
+                        (position));
+            }
+        });
+
         vendorSpinner.setOnItemSelectedListener(new AdapterView.OnItemSelectedListener() {
             @Override
             public void onItemSelected(AdapterView<?> parentView, View selectedItemView, int
@@ -85,22 +101,22 @@ public class ModelSelectorFragment extends Fragment {
                 if (position == 0) {
                     //User selected Unknown/Other
                     vendorLogoImageView.setImageResource(android.R.color.transparent);
-                    buildModelSpinner(new ArrayList<Model>(), null);
+                    buildModelSpinner(new ArrayList<CatalogueModel>(), null);
                 } else {
                     String vendorName = vendorSpinner.getSelectedItem().toString();
                     String vendorId = vendorMap.get(vendorName).toLowerCase(Locale.UK);
 
                     if (!vendorName.equals(getString(R.string.vendor_other))) {
                         //Update vendor logo when vendor is selected
-                        Picasso.with(getActivity()).load(Vendor.getLogoUrl(vendorId)
-                        ).placeholder(android.R.color.transparent).into(vendorLogoImageView);
+                        CatalogueImageCache.getInstance(getActivity()).loadLogo(getActivity(),
+                                vendorLogoImageView, vendorId);
 
                         new RequestModelListTask(vendorId).executeOnExecutor(AsyncTask
                                 .THREAD_POOL_EXECUTOR);
                     } else {
                         //User selected Other
                         vendorLogoImageView.setImageResource(android.R.color.transparent);
-                        buildModelSpinner(new ArrayList<Model>(), null);
+                        buildModelSpinner(new ArrayList<CatalogueModel>(), null);
 //                        modelSpinner.setEnabled(false);
                     }
                 }
@@ -126,7 +142,7 @@ public class ModelSelectorFragment extends Fragment {
                         getAddActivity().onDefaultsLoaded(null);
                     }
                 } else {
-                    for (Model model : modelListGlobal) {
+                    for (CatalogueModel model : modelListGlobal) {
 
                             if (model.getId().equals(modelId)){
                                 int objectIndex =  modelListGlobal.indexOf(model);
@@ -147,10 +163,9 @@ public class ModelSelectorFragment extends Fragment {
                     modelThumbnailImageView.setImageResource(R.drawable.thumbnail_placeholder);
                 } else {
                     //Update model logo when model is selected
-                    Picasso.with(getActivity())
-                            .load(Model.getThumbnailUrl(vendorId, modelId))
-                            .placeholder(R.drawable.thumbnail_placeholder)
-                            .into(modelThumbnailImageView);
+                    CatalogueImageCache.getInstance(getActivity()).loadThumbnail(getActivity(),
+                            modelThumbnailImageView, vendorId, modelId,
+                            R.drawable.thumbnail_placeholder);
                 }
 
                 if (isAddEditActivity()) {
@@ -176,7 +191,7 @@ public class ModelSelectorFragment extends Fragment {
         outState.putInt(MODEL_SPINNER_KEY, modelSpinner.getSelectedItemPosition());
     }
 
-    public void buildVendorSpinner(ArrayList<Vendor> vendorList, String selectedVendor) {
+    public void buildVendorSpinner(ArrayList<CatalogueVendor> vendorList, String selectedVendor) {
         if (vendorMap == null) {
             vendorMap = new TreeMap<>();
         }
@@ -186,13 +201,15 @@ public class ModelSelectorFragment extends Fragment {
         }
 
         if (vendorList != null) {
-            for (Vendor vendor : vendorList) {
-                try {
-                    vendorMap.put(vendor.getName(), vendor.getId());
-                    vendorMapIdAsKey.put(vendor.getId(), vendor.getName());
-                } catch (EvercamException e) {
-                    Log.e(TAG, e.toString());
-                }
+            //Keep the user's selection when the list is rebuilt after a catalogue refresh
+            if (selectedVendor == null && vendorSpinner.getSelectedItemPosition() > 0) {
+                selectedVendor = vendorSpinner.getSelectedItem().toString();
+            }
+            vendorMap.clear();
+            vendorMapIdAsKey.clear();
+            for (CatalogueVendor vendor : vendorList) {
+                vendorMap.put(vendor.getName(), vendor.getId());
+                vendorMapIdAsKey.put(vendor.getId(), vendor.getName());
             }
         }
 
@@ -228,7 +245,7 @@ public class ModelSelectorFragment extends Fragment {
         }
     }
 
-    public void buildModelSpinner(ArrayList<Model> modelList, String selectedModel) {
+    public void buildModelSpinner(ArrayList<CatalogueModel> modelList, String selectedModel) {
         if (modelMap == null) {
             modelMap = new TreeMap<>();
         }
@@ -242,12 +259,8 @@ public class ModelSelectorFragment extends Fragment {
             } else {
                 modelSpinner.setEnabled(true);
 
-                for (Model model : modelList) {
-                    try {
-                        modelMap.put(model.getId(), model.getName());
-                    } catch (EvercamException e) {
-                        Log.e(TAG, e.toString());
-                    }
+                for (CatalogueModel model : modelList) {
+                    modelMap.put(model.getId(), model.getName());
                 }
             }
         }
@@ -278,6 +291,11 @@ public class ModelSelectorFragment extends Fragment {
         spinnerArrayAdapter.setDropDownViewResource(R.layout.spinner);
         modelSpinner.setAdapter(spinnerArrayAdapter);
 
+        if (pendingModelId != null && modelMap.containsKey(pendingModelId)) {
+            selectedModel = pendingModelId;
+            pendingModelId = null;
+        }
+
         int selectedPosition = 0;
         if (selectedModel != null) {
             if (modelMap.get(selectedModel) != null) {
@@ -354,7 +372,31 @@ public class ModelSelectorFragment extends Fragment {
     }
 
     public void loadVendors() {
-        new RequestVendorListTask().executeOnExecutor(AsyncTask.THREAD_POOL_EXECUTOR);
+        new RequestVendorListTask(getActivity()).executeOnExecutor(AsyncTask.THREAD_POOL_EXECUTOR);
+    }
+
+    /**
+     * Select the vendor of a search result, and its model once the vendor's models are
+     * loaded
+     */
+    private void onSearchResultSelected(CatalogueSearchIndex.Result result) {
+        searchEditText.setText("");
+        pendingModelId = result.isVendor() ? null : result.getModel().getId();
+
+        if (result.getVendorId().equals(getVendorIdFromSpinner())) {
+            if (pendingModelId != null && !modelListGlobal.isEmpty()) {
+                buildModelList(modelListGlobal);
+            }
+            return;
+        }
+
+        String vendorName = vendorMapIdAsKey.get(result.getVendorId());
+        @SuppressWarnings("unchecked")
+        ArrayAdapter<String> vendorAdapter = (ArrayAdapter<String>) vendorSpinner.getAdapter();
+        int vendorPosition = vendorName == null ? -1 : vendorAdapter.getPosition(vendorName);
+        if (vendorPosition > 0) {
+            vendorSpinner.setSelection(vendorPosition);
+        }
     }
 
     public void hideModelQuestionMark() {
@@ -377,11 +419,25 @@ public class ModelSelectorFragment extends Fragment {
         return ((AddCameraActivity) getActivity());
     }
 
-    class RequestModelListTask extends AsyncTask<Void, Void, ArrayList<Model>> {
+    /**
+     * Shows the vendor's models from the local catalogue, then refreshes them if they
+     * were never fetched or are more than a week old
+     */
+    class RequestModelListTask extends AsyncTask<Void, ArrayList<CatalogueModel>,
+            ArrayList<CatalogueModel>> {
         private String vendorId;
+        private Context context;
+        private String discoveredModel;
+        private String discoveredModelId;
+        private boolean isDiscoveredModelApplied = false;
 
         public RequestModelListTask(String vendorId) {
             this.vendorId = vendorId;
+            this.context = getActivity().getApplicationContext();
+            if (isAddActivity() && getAddActivity().getDiscoveredCamera() != null
+                    && getAddActivity().getDiscoveredCamera().hasModel()) {
+                discoveredModel = getAddActivity().getDiscoveredCamera().getModel();
+            }
         }
 
         @Override
@@ -391,9 +447,23 @@ public class ModelSelectorFragment extends Fragment {
         }
 
         @Override
-        protected ArrayList<Model> doInBackground(Void... params) {
+        protected ArrayList<CatalogueModel> doInBackground(Void... params) {
+            DbCatalogue dbCatalogue = new DbCatalogue(context);
+            CatalogueVendor vendor = dbCatalogue.getVendor(vendorId);
+            if (vendor != null && vendor.hasModels()) {
+                matchDiscoveredModel();
+                publishProgress(dbCatalogue.getModels(vendorId));
+                if (!CameraCatalogue.isModelListStale(vendor)) {
+                    return null;
+                }
+            }
+
             try {
-                return Model.getAllByVendorId(vendorId);
+                int changeCount = CameraCatalogue.refreshModels(context, vendorId);
+                if (changeCount > 0 || vendor == null || !vendor.hasModels()) {
+                    matchDiscoveredModel();
+                    return dbCatalogue.getModels(vendorId);
+                }
             } catch (EvercamException e) {
                 EvercamPlayApplication.sendCaughtException(getActivity(),
                         e.toString() + " " + "with vendor id: " + vendorId);
@@ -403,41 +473,110 @@ public class ModelSelectorFragment extends Fragment {
         }
 
         @Override
-        protected void onPostExecute(ArrayList<Model> modelList) {
+        protected void onProgressUpdate(ArrayList<CatalogueModel>... modelLists) {
+            onModelListLoaded(modelLists[0]);
+        }
+
+        @Override
+        protected void onPostExecute(ArrayList<CatalogueModel> modelList) {
             if (modelList != null) {
+                onModelListLoaded(modelList);
+            }
+        }
+
+        /**
+         * Map the model string reported by the discovered camera, which rarely equals
+         * the catalogue model id, to the closest model of the vendor
+         */
+        private void matchDiscoveredModel() {
+            if (discoveredModel != null && discoveredModelId == null) {
+                discoveredModelId = CameraCatalogue.getSearchIndex(context).matchModelId
+                        (vendorId, discoveredModel);
+            }
+        }
+
+        private void onModelListLoaded(ArrayList<CatalogueModel> modelList) {
+            //Ignore the result if the user has selected another vendor in the meantime
+            if (isAdded() && vendorId.equals(getVendorIdFromSpinner())) {
+                prefetchThumbnails(vendorId, modelList);
+                if (discoveredModelId != null && !isDiscoveredModelApplied) {
+                    pendingModelId = discoveredModelId;
+                    isDiscoveredModelApplied = true;
+                }
                 modelListGlobal = modelList;
                 buildModelList(modelList);
             }
         }
     }
 
-    class RequestVendorListTask extends AsyncTask<Void, Void, ArrayList<Vendor>> {
+    /**
+     * Shows the vendors from the local catalogue, then refreshes the list once a day
+     */
+    class RequestVendorListTask extends AsyncTask<Void, ArrayList<CatalogueVendor>,
+            ArrayList<CatalogueVendor>> {
+        private Context context;
+
+        public RequestVendorListTask(Context context) {
+            this.context = context.getApplicationContext();
+        }
+
+        @Override
+        protected void onProgressUpdate(ArrayList<CatalogueVendor>... vendorLists) {
+            onVendorListLoaded(vendorLists[0]);
+        }
 
         @Override
-        protected void onPostExecute(ArrayList<Vendor> vendorList) {
+        protected void onPostExecute(ArrayList<CatalogueVendor> vendorList) {
             if (vendorList != null) {
-                if (isAddEditActivity()) {
-                    getAddEditActivity().buildSpinnerOnVendorListResult(vendorList);
-                } else if (isAddActivity()) {
-                    getAddActivity().buildSpinnerOnVendorListResult(vendorList);
-                }
-            } else {
-                Log.e(TAG, "Vendor list is null");
+                onVendorListLoaded(vendorList);
             }
         }
 
         @Override
-        protected ArrayList<Vendor> doInBackground(Void... params) {
+        protected ArrayList<CatalogueVendor> doInBackground(Void... params) {
+            CameraCatalogue.importBaselineIfEmpty(context);
+
+            DbCatalogue dbCatalogue = new DbCatalogue(context);
+            ArrayList<CatalogueVendor> vendorList = dbCatalogue.getVendors();
+            boolean isEmpty = vendorList.isEmpty();
+            if (!isEmpty) {
+                publishProgress(vendorList);
+                if (!CameraCatalogue.isVendorListStale(context)) {
+                    return null;
+                }
+            }
+
             try {
-                return Vendor.getAll();
+                if (CameraCatalogue.refreshVendors(context) > 0 || isEmpty) {
+                    return dbCatalogue.getVendors();
+                }
             } catch (EvercamException e) {
                 Log.e(TAG, e.toString());
             }
+            if (isEmpty) {
+                Log.e(TAG, "Vendor list is empty");
+            }
             return null;
         }
+
+        private void onVendorListLoaded(ArrayList<CatalogueVendor> vendorList) {
+            if (!isAdded()) return;
+
+            ArrayList<String> vendorIds = new ArrayList<>();
+            for (CatalogueVendor vendor : vendorList) {
+                vendorIds.add(vendor.getId());
+            }
+            CatalogueImageCache.getInstance(context).prefetchLogos(vendorIds);
+
+            if (isAddEditActivity()) {
+                getAddEditActivity().buildSpinnerOnVendorListResult(vendorList);
+            } else if (isAddActivity()) {
+                getAddActivity().buildSpinnerOnVendorListResult(vendorList);
+            }
+        }
     }
 
-    class RequestDefaultsTask extends AsyncTask<Void, Void, Model> {
+    class RequestDefaultsTask extends AsyncTask<Void, Void, CatalogueModel> {
         private String vendorId;
         private String modelName;
 
@@ -454,11 +593,11 @@ public class ModelSelectorFragment extends Fragment {
         }
 
         @Override
-        protected Model doInBackground(Void... params) {
+        protected CatalogueModel doInBackground(Void... params) {
             try {
                 ArrayList<Model> modelList = Model.getAll(modelName, vendorId);
                 if (modelList.size() > 0) {
-                    return modelList.get(0);
+                    return CatalogueModel.fromModel(modelList.get(0));
                 }
             } catch (EvercamException e) {
                 Log.e(TAG, e.toString());
@@ -467,7 +606,7 @@ public class ModelSelectorFragment extends Fragment {
         }
 
         @Override
-        protected void onPostExecute(Model model) {
+        protected void onPostExecute(CatalogueModel model) {
             if (model != null) {
                 if (isAddEditActivity()) {
                     getAddEditActivity().fillDefaults(model);
@@ -478,7 +617,15 @@ public class ModelSelectorFragment extends Fragment {
         }
     }
 
-    private void buildModelList(ArrayList<Model> modelList) {
+    private void prefetchThumbnails(String vendorId, ArrayList<CatalogueModel> modelList) {
+        ArrayList<String> modelIds = new ArrayList<>();
+        for (CatalogueModel model : modelList) {
+            modelIds.add(model.getId());
+        }
+        CatalogueImageCache.getInstance(getActivity()).prefetchThumbnails(vendorId, modelIds);
+    }
+
+    private void buildModelList(ArrayList<CatalogueModel> modelList) {
         if (isAddEditActivity()) {
             getAddEditActivity().buildSpinnerOnModelListResult(modelList);
         } else if (isAddActivity()) {
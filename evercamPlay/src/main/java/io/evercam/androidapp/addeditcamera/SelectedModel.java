@@ -2,9 +2,7 @@ package io.evercam.androidapp.addeditcamera;
 
 import java.io.Serializable;
 
-import io.evercam.Auth;
-import io.evercam.Defaults;
-import io.evercam.EvercamException;
+import io.evercam.androidapp.dto.CatalogueModel;
 
 public class SelectedModel implements Serializable {
     private String modelId = "";
@@ -16,25 +14,17 @@ public class SelectedModel implements Serializable {
     private String defaultUsername = "";
     private String defaultPassword = "";
 
-    public SelectedModel(String modelId, String modelName, String vendorId, String vendorName, Defaults defaults) {
+    public SelectedModel(String modelId, String modelName, String vendorId, String vendorName, CatalogueModel defaults) {
         setModelId(modelId);
         setModelName(modelName);
         setVendorId(vendorId);
         setVendorName(vendorName);
 
         if (defaults != null) {
-            try {
-                setDefaultJpgUrl(defaults.getJpgURL());
-//                setDefaultRtspUrl(defaults.getH264URL());
-
-                Auth auth = defaults.getAuth(Auth.TYPE_BASIC);
-                if (auth != null) {
-                    setDefaultUsername(auth.getUsername());
-                    setDefaultPassword(auth.getPassword());
-                }
-            } catch (EvercamException e) {
-                e.printStackTrace();
-            }
+            setDefaultJpgUrl(defaults.getJpgUrl());
+//            setDefaultRtspUrl(defaults.getH264Url());
+            setDefaultUsername(defaults.getUsername());
+            setDefaultPassword(defaults.getPassword());
         }
     }
 
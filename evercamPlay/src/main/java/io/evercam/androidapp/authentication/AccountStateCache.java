@@ -0,0 +1,178 @@
+package io.evercam.androidapp.authentication;
+
+import android.content.Context;
+import android.util.Log;
+
+import java.io.IOException;
+import java.util.ArrayList;
+import java.util.HashMap;
+import java.util.LinkedHashMap;
+import java.util.List;
+import java.util.Map;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.TimeUnit;
+
+import io.evercam.API;
+import io.evercam.androidapp.dal.DbCamera;
+import io.evercam.androidapp.dto.AppUser;
+import io.evercam.androidapp.dto.EvercamCamera;
+import io.evercam.androidapp.http.SharedHttpClient;
+import io.evercam.androidapp.image.VolleyRequest;
+import okhttp3.HttpUrl;
+import okhttp3.OkHttpClient;
+import okhttp3.Request;
+import okhttp3.Response;
+
+/**
+ * Keeps the state of every signed in account ready, so switching account is instant.
+ *
+ * The camera lists of the most recently used accounts are kept in memory, backed by
+ * the per owner rows in {@link DbCamera}, and the first thumbnails of each list are
+ * prefetched. API keys of all accounts are checked in parallel in the background, so
+ * a switch to an account whose key was recently found valid needs no request at all.
+ */
+public class AccountStateCache {
+    private final static String TAG = "AccountStateCache";
+    private final static int MAX_ACCOUNTS = 4;
+    private final static int PREFETCH_THUMBNAIL_COUNT = 12;
+    /* How long a key check is trusted for */
+    private final static long KEY_CHECK_VALID_MS = TimeUnit.MINUTES.toMillis(30);
+    private final static int KEY_CHECK_TIMEOUT_SECONDS = 10;
+
+    public enum KeyState {
+        VALID, EXPIRED, UNKNOWN
+    }
+
+    private final static LinkedHashMap<String, ArrayList<EvercamCamera>> cameraLists =
+            new LinkedHashMap<String, ArrayList<EvercamCamera>>(MAX_ACCOUNTS, 0.75f, true) {
+                @Override
+                protected boolean removeEldestEntry(Map.Entry<String,
+                        ArrayList<EvercamCamera>> eldest) {
+                    return size() > MAX_ACCOUNTS;
+                }
+            };
+    private final static HashMap<String, KeyState> keyStates = new HashMap<>();
+    private final static HashMap<String, Long> keyCheckedTimes = new HashMap<>();
+
+    private final static ExecutorService executor = Executors.newFixedThreadPool(MAX_ACCOUNTS);
+    private static OkHttpClient client;
+
+    /**
+     * @return the camera list of the account kept in memory, or null
+     */
+    public static synchronized ArrayList<EvercamCamera> getCameraList(String username) {
+        return cameraLists.get(username);
+    }
+
+    public static synchronized void putCameraList(String username,
+                                                  ArrayList<EvercamCamera> cameraList) {
+        cameraLists.put(username, cameraList);
+    }
+
+    /**
+     * @return whether the key was found valid or expired by a recent check, UNKNOWN
+     * if it has not been checked recently
+     */
+    public static synchronized KeyState getKeyState(String username) {
+        Long checkedTime = keyCheckedTimes.get(username);
+        if (checkedTime == null || System.currentTimeMillis() - checkedTime > KEY_CHECK_VALID_MS) {
+            return KeyState.UNKNOWN;
+        }
+        return keyStates.get(username);
+    }
+
+    private static synchronized void putKeyState(String username, KeyState keyState) {
+        if (keyState == KeyState.UNKNOWN) return;
+        keyStates.put(username, keyState);
+        keyCheckedTimes.put(username, System.currentTimeMillis());
+    }
+
+    public static synchronized void remove(String username) {
+        cameraLists.remove(username);
+        keyStates.remove(username);
+        keyCheckedTimes.remove(username);
+    }
+
+    public static synchronized void clear() {
+        cameraLists.clear();
+        keyStates.clear();
+        keyCheckedTimes.clear();
+    }
+
+    /**
+     * Check the keys of all accounts and load their camera lists in the background,
+     * skipping accounts that are already warm
+     */
+    public static void warmUp(Context context, List<AppUser> users) {
+        final Context appContext = context.getApplicationContext();
+        for (final AppUser user : users) {
+            final String username = user.getUsername();
+            final boolean needsKeyCheck = getKeyState(username) == KeyState.UNKNOWN;
+            final boolean needsCameraList = getCameraList(username) == null;
+            if (!needsKeyCheck && !needsCameraList) continue;
+
+            executor.execute(new Runnable() {
+                @Override
+                public void run() {
+                    if (needsKeyCheck) {
+                        putKeyState(username, checkKey(user));
+                    }
+                    if (needsCameraList && getKeyState(username) != KeyState.EXPIRED) {
+                        ArrayList<EvercamCamera> cameraList = new DbCamera(appContext)
+                                .getCamerasByOwner(username, 500);
+                        if (!cameraList.isEmpty()) {
+                            putCameraList(username, cameraList);
+                            prefetchThumbnails(appContext, cameraList);
+                        }
+                    }
+                }
+            });
+        }
+    }
+
+    /**
+     * Validate the key of the account without touching the key pair the API is using
+     * for the current account
+     */
+    static KeyState checkKey(AppUser user) {
+        HttpUrl url = HttpUrl.parse(API.URL + "users/" + user.getUsername());
+        if (url == null) return KeyState.UNKNOWN;
+        url = url.newBuilder().addQueryParameter("api_key", user.getApiKey())
+                .addQueryParameter("api_id", user.getApiId()).build();
+
+        Response response = null;
+        try {
+            response = getClient().newCall(new Request.Builder().url(url)
+                    .header("Accept", "application/json").build()).execute();
+            if (response.isSuccessful()) return KeyState.VALID;
+            if (response.code() == 401 || response.code() == 403) return KeyState.EXPIRED;
+        } catch (IOException e) {
+            Log.e(TAG, e.toString());
+        } finally {
+            if (response != null) response.close();
+        }
+        return KeyState.UNKNOWN;
+    }
+
+    private static void prefetchThumbnails(Context context, List<EvercamCamera> cameraList) {
+        int maxWidth = context.getResources().getDisplayMetrics().widthPixels / 2;
+        int count = 0;
+        for (EvercamCamera camera : cameraList) {
+            if (count++ >= PREFETCH_THUMBNAIL_COUNT) break;
+            if (camera.hasThumbnailUrl()) {
+                VolleyRequest.prefetchImage(context, camera.getThumbnailUrl(), maxWidth,
+                        (int) (maxWidth / 1.25));
+            }
+        }
+    }
+
+    private static synchronized OkHttpClient getClient() {
+        if (client == null) {
+            client = SharedHttpClient.get().newBuilder()
+                    .connectTimeout(KEY_CHECK_TIMEOUT_SECONDS, TimeUnit.SECONDS)
+                    .readTimeout(KEY_CHECK_TIMEOUT_SECONDS, TimeUnit.SECONDS).build();
+        }
+        return client;
+    }
+}
@@ -58,6 +58,10 @@ public class EvercamAccount {
         final Account account = getAccountByEmail(email);
 
         String isDefaultString = mAccountManager.getUserData(account, KEY_IS_DEFAULT);
+        String username = mAccountManager.getUserData(account, KEY_USERNAME);
+        if (username != null) {
+            AccountStateCache.remove(username);
+        }
         //If removing default user, clear the static user object
         if (isDefaultString.equals(TRUE)) {
             AppData.defaultUser = null;
@@ -20,6 +20,8 @@ import io.evercam.androidapp.dto.EvercamCamera;
 import io.evercam.androidapp.dto.ImageLoadingStatus;
 import io.evercam.androidapp.image.ImageResponseListener;
 import io.evercam.androidapp.image.VolleyRequest;
+import io.evercam.androidapp.routing.RouteSelector;
+import io.evercam.androidapp.routing.RouteTable;
 import io.evercam.androidapp.video.VideoActivity;
 
 public class CameraLayout extends LinearLayout implements ImageResponseListener {
@@ -152,7 +154,23 @@ public class CameraLayout extends LinearLayout implements ImageResponseListener
         if (evercamCamera.hasThumbnailUrl()) {
 
             final String thumbnailUrl = evercamCamera.getThumbnailUrl();
-            VolleyRequest.loadImage(context, thumbnailUrl, this, this);
+            //Fetch a live image straight from the camera when that is the faster route
+            RouteTable.Decision decision = evercamCamera.isOnline() ? RouteSelector
+                    .getDecision(context, evercamCamera) : null;
+            if (decision != null && decision.isVerified() && decision.getRoute() != RouteTable
+                    .Route.CLOUD) {
+                final RouteTable.Route route = decision.getRoute();
+                VolleyRequest.loadCameraImage(context, RouteSelector.getSnapshotUrl
+                        (evercamCamera, route), RouteSelector.getAuthorization(evercamCamera,
+                        route), thumbnailUrl, this, this, new Runnable() {
+                    @Override
+                    public void run() {
+                        RouteSelector.reportFailure(context, evercamCamera, route);
+                    }
+                });
+            } else {
+                VolleyRequest.loadImage(context, thumbnailUrl, this, this);
+            }
 
             if (!evercamCamera.isOnline()) {
                 showGreyImage();
@@ -18,8 +18,11 @@ public class DatabaseMaster extends SQLiteOpenHelper {
     // Version 12: Added HLS URL in camera object
     // Version 13: Added model ID
     // Version 14: Replaced camera status with isOnline
+    // Version 16: Added snapshot index table
+    // Version 17: Added model and camera capability tables
+    // Version 18: Added vendor and model catalogue tables
     private static final String TAG = "DatabaseMaster";
-    private static final int DATABASE_VERSION = 15;
+    private static final int DATABASE_VERSION = 18;
     private static final String DATABASE_NAME = "evercamdata";
     private Context context = null;
 
@@ -32,10 +35,16 @@ public class DatabaseMaster extends SQLiteOpenHelper {
     public void onCreate(SQLiteDatabase db) {
 
         new DbCamera(this.context).onCreateCustom(db);
+        new DbSnapshot(this.context).onCreateCustom(db);
+        new DbCapability(this.context).onCreateCustom(db);
+        new DbCatalogue(this.context).onCreateCustom(db);
     }
 
     @Override
     public void onUpgrade(SQLiteDatabase db, int oldVersion, int newVersion) {
         new DbCamera(context).onUpgradeCustom(db, oldVersion, newVersion);
+        new DbSnapshot(context).onUpgradeCustom(db, oldVersion, newVersion);
+        new DbCapability(context).onUpgradeCustom(db, oldVersion, newVersion);
+        new DbCatalogue(context).onUpgradeCustom(db, oldVersion, newVersion);
     }
 }
@@ -0,0 +1,127 @@
+package io.evercam.androidapp.dal;
+
+import android.content.ContentValues;
+import android.content.Context;
+import android.database.Cursor;
+import android.database.sqlite.SQLiteDatabase;
+
+import java.util.ArrayList;
+
+import io.evercam.PTZPreset;
+import io.evercam.androidapp.dto.CameraCapability;
+
+/**
+ * Cached PTZ capabilities, one table per model (ONVIF, PTZ) and one per camera
+ * (rights, presets), so VideoActivity can render the PTZ controls without waiting
+ * for the Evercam API.
+ */
+public class DbCapability extends DatabaseMaster {
+    public static final String TABLE_MODEL_CAPABILITY = "evercammodelcapability";
+    public static final String TABLE_CAMERA_CAPABILITY = "evercamcameracapability";
+
+    private final String TAG = "evercamplay-DbCapability";
+    private final String KEY_MODEL_ID = "modelId";
+    private final String KEY_IS_ONVIF = "isOnvif";
+    private final String KEY_IS_PTZ = "isPtz";
+    private final String KEY_CAMERA_ID = "cameraId";
+    private final String KEY_FULL_RIGHTS = "fullRights";
+    private final String KEY_PRESETS = "presets";
+    private final String KEY_CHECKED_AT = "checkedAt";
+
+    public DbCapability(Context context) {
+        super(context);
+    }
+
+    public void onCreateCustom(SQLiteDatabase db) {
+        String CREATE_TABLE_MODEL_CAPABILITY = "CREATE TABLE " + TABLE_MODEL_CAPABILITY + "(" +
+                KEY_MODEL_ID + " TEXT PRIMARY KEY" + "," +
+                KEY_IS_ONVIF + " INTEGER NOT NULL DEFAULT 0" + "," +
+                KEY_IS_PTZ + " INTEGER NOT NULL DEFAULT 0" + "," +
+                KEY_CHECKED_AT + " INTEGER NOT NULL DEFAULT 0" + ")";
+        String CREATE_TABLE_CAMERA_CAPABILITY = "CREATE TABLE " + TABLE_CAMERA_CAPABILITY + "(" +
+                KEY_CAMERA_ID + " TEXT PRIMARY KEY" + "," +
+                KEY_FULL_RIGHTS + " INTEGER NOT NULL DEFAULT 0" + "," +
+                KEY_PRESETS + " TEXT NOT NULL DEFAULT '[]'" + "," +
+                KEY_CHECKED_AT + " INTEGER NOT NULL DEFAULT 0" + ")";
+        db.execSQL(CREATE_TABLE_MODEL_CAPABILITY);
+        db.execSQL(CREATE_TABLE_CAMERA_CAPABILITY);
+    }
+
+    public void onUpgradeCustom(SQLiteDatabase db, int oldVersion, int newVersion) {
+        db.execSQL("DROP TABLE IF EXISTS " + TABLE_MODEL_CAPABILITY);
+        db.execSQL("DROP TABLE IF EXISTS " + TABLE_CAMERA_CAPABILITY);
+        onCreateCustom(db);
+    }
+
+    /**
+     * @return the cached capability, with zero check times for anything not cached yet
+     */
+    public CameraCapability getCapability(String cameraId, String modelId) {
+        CameraCapability capability = new CameraCapability(cameraId, modelId);
+        SQLiteDatabase db = this.getReadableDatabase();
+
+        Cursor modelCursor = db.query(TABLE_MODEL_CAPABILITY, new String[]{KEY_IS_ONVIF,
+                KEY_IS_PTZ, KEY_CHECKED_AT}, KEY_MODEL_ID + " = ?", new String[]{modelId}, null,
+                null, null);
+        if (modelCursor.moveToFirst()) {
+            capability.setModelCapability(modelCursor.getInt(0) == 1, modelCursor.getInt(1) == 1,
+                    modelCursor.getLong(2));
+        }
+        modelCursor.close();
+
+        Cursor cameraCursor = db.query(TABLE_CAMERA_CAPABILITY, new String[]{KEY_FULL_RIGHTS,
+                KEY_PRESETS, KEY_CHECKED_AT}, KEY_CAMERA_ID + " = ?", new String[]{cameraId},
+                null, null, null);
+        if (cameraCursor.moveToFirst()) {
+            capability.setCameraCapability(cameraCursor.getInt(0) == 1,
+                    CameraCapability.getPresetsFromJson(cameraCursor.getString(1)),
+                    cameraCursor.getLong(2));
+        }
+        cameraCursor.close();
+        db.close();
+
+        return capability;
+    }
+
+    public void saveCapability(CameraCapability capability) {
+        SQLiteDatabase db = this.getWritableDatabase();
+        db.beginTransaction();
+        try {
+            if (capability.getModelCheckedAt() > 0) {
+                ContentValues modelValues = new ContentValues();
+                modelValues.put(KEY_MODEL_ID, capability.getModelId());
+                modelValues.put(KEY_IS_ONVIF, capability.isOnvif() ? 1 : 0);
+                modelValues.put(KEY_IS_PTZ, capability.isPtz() ? 1 : 0);
+                modelValues.put(KEY_CHECKED_AT, capability.getModelCheckedAt());
+                db.insertWithOnConflict(TABLE_MODEL_CAPABILITY, null, modelValues,
+                        SQLiteDatabase.CONFLICT_REPLACE);
+            }
+            if (capability.getCameraCheckedAt() > 0) {
+                ContentValues cameraValues = new ContentValues();
+                cameraValues.put(KEY_CAMERA_ID, capability.getCameraId());
+                cameraValues.put(KEY_FULL_RIGHTS, capability.hasFullRights() ? 1 : 0);
+                cameraValues.put(KEY_PRESETS, capability.getPresetsJson());
+                cameraValues.put(KEY_CHECKED_AT, capability.getCameraCheckedAt());
+                db.insertWithOnConflict(TABLE_CAMERA_CAPABILITY, null, cameraValues,
+                        SQLiteDatabase.CONFLICT_REPLACE);
+            }
+            db.setTransactionSuccessful();
+        } finally {
+            db.endTransaction();
+            db.close();
+        }
+    }
+
+    /**
+     * Update the cached presets after the user created one, keeping the other fields
+     */
+    public void updatePresets(String cameraId, ArrayList<PTZPreset> presetList) {
+        ContentValues values = new ContentValues();
+        values.put(KEY_PRESETS, CameraCapability.toPresetsJson(presetList));
+
+        SQLiteDatabase db = this.getWritableDatabase();
+        db.update(TABLE_CAMERA_CAPABILITY, values, KEY_CAMERA_ID + " = ?",
+                new String[]{cameraId});
+        db.close();
+    }
+}
@@ -0,0 +1,253 @@
+package io.evercam.androidapp.dal;
+
+import android.content.ContentValues;
+import android.content.Context;
+import android.database.Cursor;
+import android.database.sqlite.SQLiteDatabase;
+
+import java.util.ArrayList;
+import java.util.HashMap;
+import java.util.List;
+
+import io.evercam.androidapp.dto.CatalogueModel;
+import io.evercam.androidapp.dto.CatalogueVendor;
+import io.evercam.androidapp.utils.PrefsManager;
+
+/**
+ * Local copy of the Evercam vendor/model catalogue used by the model selector, so it
+ * can be shown instantly and offline. Refreshes are applied as deltas: only rows
+ * that were added, changed or removed are written.
+ */
+public class DbCatalogue extends DatabaseMaster {
+    public static final String TABLE_VENDOR = "evercamvendor";
+    public static final String TABLE_MODEL = "evercammodel";
+
+    private final String TAG = "evercamplay-DbCatalogue";
+    private final String KEY_ID = "id";
+    private final String KEY_VENDOR_ID = "vendorId";
+    private final String KEY_NAME = "name";
+    private final String KEY_MODELS_REFRESHED_AT = "modelsRefreshedAt";
+    private final String KEY_JPG_URL = "jpgUrl";
+    private final String KEY_H264_URL = "h264Url";
+    private final String KEY_USERNAME = "username";
+    private final String KEY_PASSWORD = "password";
+    private final String KEY_IS_ONVIF = "isOnvif";
+    private final String KEY_IS_PTZ = "isPtz";
+
+    private final String[] MODEL_COLUMNS = new String[]{KEY_ID, KEY_VENDOR_ID, KEY_NAME,
+            KEY_JPG_URL, KEY_H264_URL, KEY_USERNAME, KEY_PASSWORD, KEY_IS_ONVIF, KEY_IS_PTZ};
+
+    private final Context context;
+
+    public DbCatalogue(Context context) {
+        super(context);
+        this.context = context;
+    }
+
+    public void onCreateCustom(SQLiteDatabase db) {
+        String CREATE_TABLE_VENDOR = "CREATE TABLE " + TABLE_VENDOR + "(" +
+                KEY_ID + " TEXT PRIMARY KEY" + "," +
+                KEY_NAME + " TEXT NOT NULL" + "," +
+                KEY_MODELS_REFRESHED_AT + " INTEGER NOT NULL DEFAULT 0" + ")";
+        String CREATE_TABLE_MODEL = "CREATE TABLE " + TABLE_MODEL + "(" +
+                KEY_ID + " TEXT PRIMARY KEY" + "," +
+                KEY_VENDOR_ID + " TEXT NOT NULL" + "," +
+                KEY_NAME + " TEXT NOT NULL" + "," +
+                KEY_JPG_URL + " TEXT NOT NULL DEFAULT ''" + "," +
+                KEY_H264_URL + " TEXT NOT NULL DEFAULT ''" + "," +
+                KEY_USERNAME + " TEXT NOT NULL DEFAULT ''" + "," +
+                KEY_PASSWORD + " TEXT NOT NULL DEFAULT ''" + "," +
+                KEY_IS_ONVIF + " INTEGER NOT NULL DEFAULT 0" + "," +
+                KEY_IS_PTZ + " INTEGER NOT NULL DEFAULT 0" + ")";
+        db.execSQL(CREATE_TABLE_VENDOR);
+        db.execSQL(CREATE_TABLE_MODEL);
+        db.execSQL("CREATE INDEX idx_model_vendor ON " + TABLE_MODEL + "(" + KEY_VENDOR_ID + ")");
+    }
+
+    public void onUpgradeCustom(SQLiteDatabase db, int oldVersion, int newVersion) {
+        db.execSQL("DROP TABLE IF EXISTS " + TABLE_VENDOR);
+        db.execSQL("DROP TABLE IF EXISTS " + TABLE_MODEL);
+        onCreateCustom(db);
+        //The refresh time no longer matches the empty tables
+        PrefsManager.resetCatalogue(context);
+    }
+
+    public int getVendorCount() {
+        SQLiteDatabase db = this.getReadableDatabase();
+        Cursor cursor = db.rawQuery("SELECT COUNT(*) FROM " + TABLE_VENDOR, null);
+        int count = 0;
+        if (cursor.moveToFirst()) {
+            count = cursor.getInt(0);
+        }
+        cursor.close();
+        db.close();
+        return count;
+    }
+
+    public ArrayList<CatalogueVendor> getVendors() {
+        ArrayList<CatalogueVendor> vendorList = new ArrayList<>();
+        SQLiteDatabase db = this.getReadableDatabase();
+        Cursor cursor = db.query(TABLE_VENDOR, new String[]{KEY_ID, KEY_NAME,
+                KEY_MODELS_REFRESHED_AT}, null, null, null, null, KEY_NAME + " ASC");
+        if (cursor.moveToFirst()) {
+            do {
+                CatalogueVendor vendor = new CatalogueVendor(cursor.getString(0),
+                        cursor.getString(1));
+                vendor.setModelsRefreshedAt(cursor.getLong(2));
+                vendorList.add(vendor);
+            } while (cursor.moveToNext());
+        }
+        cursor.close();
+        db.close();
+        return vendorList;
+    }
+
+    /**
+     * @return the vendor with the given id, or null if it isn't in the catalogue
+     */
+    public CatalogueVendor getVendor(String vendorId) {
+        CatalogueVendor vendor = null;
+        SQLiteDatabase db = this.getReadableDatabase();
+        Cursor cursor = db.query(TABLE_VENDOR, new String[]{KEY_ID, KEY_NAME,
+                KEY_MODELS_REFRESHED_AT}, KEY_ID + " = ?", new String[]{vendorId}, null, null, null);
+        if (cursor.moveToFirst()) {
+            vendor = new CatalogueVendor(cursor.getString(0), cursor.getString(1));
+            vendor.setModelsRefreshedAt(cursor.getLong(2));
+        }
+        cursor.close();
+        db.close();
+        return vendor;
+    }
+
+    public ArrayList<CatalogueModel> getModels(String vendorId) {
+        return queryModels(KEY_VENDOR_ID + " = ?", new String[]{vendorId});
+    }
+
+    public ArrayList<CatalogueModel> getAllModels() {
+        return queryModels(null, null);
+    }
+
+    /**
+     * Replace the vendor list, keeping the model refresh times of existing vendors
+     * and removing the models of vendors that no longer exist.
+     *
+     * @return the number of vendors added, renamed or removed
+     */
+    public int applyVendorDelta(List<CatalogueVendor> vendorList) {
+        HashMap<String, CatalogueVendor> storedVendors = new HashMap<>();
+        for (CatalogueVendor vendor : getVendors()) {
+            storedVendors.put(vendor.getId(), vendor);
+        }
+
+        int changeCount = 0;
+        SQLiteDatabase db = this.getWritableDatabase();
+        db.beginTransaction();
+        try {
+            for (CatalogueVendor vendor : vendorList) {
+                CatalogueVendor storedVendor = storedVendors.remove(vendor.getId());
+                if (storedVendor == null) {
+                    ContentValues values = new ContentValues();
+                    values.put(KEY_ID, vendor.getId());
+                    values.put(KEY_NAME, vendor.getName());
+                    db.insert(TABLE_VENDOR, null, values);
+                    changeCount++;
+                } else if (!storedVendor.isSameAs(vendor)) {
+                    ContentValues values = new ContentValues();
+                    values.put(KEY_NAME, vendor.getName());
+                    db.update(TABLE_VENDOR, values, KEY_ID + " = ?", new String[]{vendor.getId()});
+                    changeCount++;
+                }
+            }
+            for (String removedVendorId : storedVendors.keySet()) {
+                db.delete(TABLE_VENDOR, KEY_ID + " = ?", new String[]{removedVendorId});
+                db.delete(TABLE_MODEL, KEY_VENDOR_ID + " = ?", new String[]{removedVendorId});
+                changeCount++;
+            }
+            db.setTransactionSuccessful();
+        } finally {
+            db.endTransaction();
+            db.close();
+        }
+        return changeCount;
+    }
+
+    /**
+     * Replace the models of one vendor and record when they were fetched
+     *
+     * @return the number of models added, changed or removed
+     */
+    public int applyModelDelta(String vendorId, List<CatalogueModel> modelList, long refreshedAt) {
+        HashMap<String, CatalogueModel> storedModels = new HashMap<>();
+        for (CatalogueModel model : getModels(vendorId)) {
+            storedModels.put(model.getId(), model);
+        }
+
+        int changeCount = 0;
+        SQLiteDatabase db = this.getWritableDatabase();
+        db.beginTransaction();
+        try {
+            for (CatalogueModel model : modelList) {
+                CatalogueModel storedModel = storedModels.remove(model.getId());
+                if (storedModel == null || !storedModel.isSameAs(model)) {
+                    db.insertWithOnConflict(TABLE_MODEL, null, getContentValueFrom(model),
+                            SQLiteDatabase.CONFLICT_REPLACE);
+                    changeCount++;
+                }
+            }
+            for (String removedModelId : storedModels.keySet()) {
+                db.delete(TABLE_MODEL, KEY_ID + " = ?", new String[]{removedModelId});
+                changeCount++;
+            }
+
+            ContentValues vendorValues = new ContentValues();
+            vendorValues.put(KEY_MODELS_REFRESHED_AT, refreshedAt);
+            db.update(TABLE_VENDOR, vendorValues, KEY_ID + " = ?", new String[]{vendorId});
+            db.setTransactionSuccessful();
+        } finally {
+            db.endTransaction();
+            db.close();
+        }
+        return changeCount;
+    }
+
+    private ArrayList<CatalogueModel> queryModels(String selection, String[] selectionArgs) {
+        ArrayList<CatalogueModel> modelList = new ArrayList<>();
+        SQLiteDatabase db = this.getReadableDatabase();
+        Cursor cursor = db.query(TABLE_MODEL, MODEL_COLUMNS, selection, selectionArgs, null, null,
+                KEY_NAME + " ASC");
+        if (cursor.moveToFirst()) {
+            do {
+                modelList.add(getModelFromCursor(cursor));
+            } while (cursor.moveToNext());
+        }
+        cursor.close();
+        db.close();
+        return modelList;
+    }
+
+    private ContentValues getContentValueFrom(CatalogueModel model) {
+        ContentValues values = new ContentValues();
+        values.put(KEY_ID, model.getId());
+        values.put(KEY_VENDOR_ID, model.getVendorId());
+        values.put(KEY_NAME, model.getName());
+        values.put(KEY_JPG_URL, model.getJpgUrl());
+        values.put(KEY_H264_URL, model.getH264Url());
+        values.put(KEY_USERNAME, model.getUsername());
+        values.put(KEY_PASSWORD, model.getPassword());
+        values.put(KEY_IS_ONVIF, model.isOnvif() ? 1 : 0);
+        values.put(KEY_IS_PTZ, model.isPtz() ? 1 : 0);
+        return values;
+    }
+
+    private CatalogueModel getModelFromCursor(Cursor cursor) {
+        CatalogueModel model = new CatalogueModel(cursor.getString(0), cursor.getString(1),
+                cursor.getString(2));
+        model.setJpgUrl(cursor.getString(3));
+        model.setH264Url(cursor.getString(4));
+        model.setUsername(cursor.getString(5));
+        model.setPassword(cursor.getString(6));
+        model.setOnvif(cursor.getInt(7) == 1);
+        model.setPtz(cursor.getInt(8) == 1);
+        return model;
+    }
+}
@@ -0,0 +1,188 @@
+package io.evercam.androidapp.dal;
+
+import android.content.ContentValues;
+import android.content.Context;
+import android.database.Cursor;
+import android.database.sqlite.SQLiteDatabase;
+
+import java.util.ArrayList;
+import java.util.HashMap;
+import java.util.List;
+
+import io.evercam.androidapp.dto.SavedSnapshot;
+
+/**
+ * Index of the snapshots saved under Pictures/Evercam/Evercam Play, used to enforce
+ * snapshot storage quotas without scanning the snapshot folders.
+ */
+public class DbSnapshot extends DatabaseMaster {
+    public static final String TABLE_SNAPSHOT = "evercamsnapshot";
+    /* Snapshots younger than this haven't had the chance to be viewed yet */
+    private static final long RECENT_SNAPSHOT_MS = 24 * 60 * 60 * 1000;
+
+    private final String TAG = "evercamplay-DbSnapshot";
+    private final String KEY_PATH = "path";
+    private final String KEY_CAMERA_ID = "cameraId";
+    private final String KEY_SIZE = "size";
+    private final String KEY_CREATED_AT = "createdAt";
+    private final String KEY_LAST_VIEWED_AT = "lastViewedAt";
+    private final String KEY_VIEW_COUNT = "viewCount";
+
+    public enum EvictionOrder {
+        OLDEST, LEAST_VIEWED
+    }
+
+    public DbSnapshot(Context context) {
+        super(context);
+    }
+
+    public void onCreateCustom(SQLiteDatabase db) {
+        String CREATE_TABLE_SNAPSHOTS = "CREATE TABLE IF NOT EXISTS " + TABLE_SNAPSHOT + "(" +
+                KEY_PATH + " TEXT PRIMARY KEY" + "," +
+                KEY_CAMERA_ID + " TEXT NOT NULL" + "," +
+                KEY_SIZE + " INTEGER NOT NULL DEFAULT 0" + "," +
+                KEY_CREATED_AT + " INTEGER NOT NULL DEFAULT 0" + "," +
+                KEY_LAST_VIEWED_AT + " INTEGER NOT NULL DEFAULT 0" + "," +
+                KEY_VIEW_COUNT + " INTEGER NOT NULL DEFAULT 0" + ")";
+        db.execSQL(CREATE_TABLE_SNAPSHOTS);
+        db.execSQL("CREATE INDEX IF NOT EXISTS idx_snapshot_camera ON " + TABLE_SNAPSHOT + "(" +
+                KEY_CAMERA_ID + ")");
+    }
+
+    public void onUpgradeCustom(SQLiteDatabase db, int oldVersion, int newVersion) {
+        //Unlike the cached Evercam data, the index can't be fetched again, so keep it
+        onCreateCustom(db);
+    }
+
+    public void addSnapshot(SavedSnapshot snapshot) {
+        SQLiteDatabase db = this.getWritableDatabase();
+        db.insertWithOnConflict(TABLE_SNAPSHOT, null, getContentValueFrom(snapshot),
+                SQLiteDatabase.CONFLICT_REPLACE);
+        db.close();
+    }
+
+    /**
+     * Insert snapshots found on storage in one transaction, keeping the view
+     * statistics of any snapshot that is already indexed.
+     */
+    public void addSnapshots(List<SavedSnapshot> snapshots) {
+        SQLiteDatabase db = this.getWritableDatabase();
+        db.beginTransaction();
+        try {
+            for (SavedSnapshot snapshot : snapshots) {
+                db.insertWithOnConflict(TABLE_SNAPSHOT, null, getContentValueFrom(snapshot),
+                        SQLiteDatabase.CONFLICT_IGNORE);
+            }
+            db.setTransactionSuccessful();
+        } finally {
+            db.endTransaction();
+            db.close();
+        }
+    }
+
+    public void markViewed(String path) {
+        SQLiteDatabase db = this.getWritableDatabase();
+        db.execSQL("UPDATE " + TABLE_SNAPSHOT + " SET " + KEY_VIEW_COUNT + " = " +
+                        KEY_VIEW_COUNT + " + 1, " + KEY_LAST_VIEWED_AT + " = ? WHERE " +
+                        KEY_PATH + " = ?",
+                new Object[]{System.currentTimeMillis(), path});
+        db.close();
+    }
+
+    /**
+     * Delete the index rows for all given paths in one transaction
+     */
+    public void deleteSnapshots(List<String> paths) {
+        if (paths.isEmpty()) return;
+
+        SQLiteDatabase db = this.getWritableDatabase();
+        db.beginTransaction();
+        try {
+            for (String path : paths) {
+                db.delete(TABLE_SNAPSHOT, KEY_PATH + " = ?", new String[]{path});
+            }
+            db.setTransactionSuccessful();
+        } finally {
+            db.endTransaction();
+            db.close();
+        }
+    }
+
+    /**
+     * @return total indexed snapshot size in bytes, keyed by camera id
+     */
+    public HashMap<String, Long> getSizeByCamera() {
+        HashMap<String, Long> sizeMap = new HashMap<>();
+
+        SQLiteDatabase db = this.getReadableDatabase();
+        Cursor cursor = db.rawQuery("SELECT " + KEY_CAMERA_ID + ", SUM(" + KEY_SIZE + ") FROM "
+                + TABLE_SNAPSHOT + " GROUP BY " + KEY_CAMERA_ID, null);
+        if (cursor.moveToFirst()) {
+            do {
+                sizeMap.put(cursor.getString(0), cursor.getLong(1));
+            } while (cursor.moveToNext());
+        }
+        cursor.close();
+        db.close();
+
+        return sizeMap;
+    }
+
+    /**
+     * Return snapshots in the order they should be evicted
+     *
+     * @param cameraId the camera to select from, or null for all cameras
+     */
+    public ArrayList<SavedSnapshot> getEvictionCandidates(String cameraId, EvictionOrder order) {
+        String orderBy;
+        if (order == EvictionOrder.LEAST_VIEWED) {
+            //Recent snapshots go last, then the least viewed and least recently used first
+            long recentSince = System.currentTimeMillis() - RECENT_SNAPSHOT_MS;
+            orderBy = "(" + KEY_CREATED_AT + " > " + recentSince + ") ASC, " +
+                    KEY_VIEW_COUNT + " ASC, " +
+                    "MAX(" + KEY_LAST_VIEWED_AT + ", " + KEY_CREATED_AT + ") ASC";
+        } else {
+            orderBy = KEY_CREATED_AT + " ASC";
+        }
+
+        String selection = cameraId == null ? null : KEY_CAMERA_ID + " = ?";
+        String[] selectionArgs = cameraId == null ? null : new String[]{cameraId};
+
+        ArrayList<SavedSnapshot> snapshotList = new ArrayList<>();
+        SQLiteDatabase db = this.getReadableDatabase();
+        Cursor cursor = db.query(TABLE_SNAPSHOT, new String[]{KEY_PATH, KEY_CAMERA_ID, KEY_SIZE,
+                        KEY_CREATED_AT, KEY_LAST_VIEWED_AT, KEY_VIEW_COUNT}, selection, selectionArgs,
+                null, null, orderBy);
+        if (cursor.moveToFirst()) {
+            do {
+                snapshotList.add(getSnapshotFromCursor(cursor));
+            } while (cursor.moveToNext());
+        }
+        cursor.close();
+        db.close();
+
+        return snapshotList;
+    }
+
+    private ContentValues getContentValueFrom(SavedSnapshot snapshot) {
+        ContentValues values = new ContentValues();
+        values.put(KEY_PATH, snapshot.getPath());
+        values.put(KEY_CAMERA_ID, snapshot.getCameraId());
+        values.put(KEY_SIZE, snapshot.getSize());
+        values.put(KEY_CREATED_AT, snapshot.getCreatedAt());
+        values.put(KEY_LAST_VIEWED_AT, snapshot.getLastViewedAt());
+        values.put(KEY_VIEW_COUNT, snapshot.getViewCount());
+        return values;
+    }
+
+    private SavedSnapshot getSnapshotFromCursor(Cursor cursor) {
+        SavedSnapshot snapshot = new SavedSnapshot();
+        snapshot.setPath(cursor.getString(0));
+        snapshot.setCameraId(cursor.getString(1));
+        snapshot.setSize(cursor.getLong(2));
+        snapshot.setCreatedAt(cursor.getLong(3));
+        snapshot.setLastViewedAt(cursor.getLong(4));
+        snapshot.setViewCount(cursor.getInt(5));
+        return snapshot;
+    }
+}
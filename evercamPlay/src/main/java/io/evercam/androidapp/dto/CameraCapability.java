@@ -0,0 +1,157 @@
+package io.evercam.androidapp.dto;
+
+import android.util.Log;
+
+import org.json.JSONArray;
+import org.json.JSONException;
+import org.json.JSONObject;
+
+import java.util.ArrayList;
+
+import io.evercam.PTZPreset;
+
+/**
+ * What the user can do with a camera's PTZ controls, as last checked with the Evercam API.
+ *
+ * The ONVIF and PTZ flags belong to the camera model and rarely change, so they are kept
+ * for a week. Rights and presets belong to the camera and are revalidated after an hour.
+ */
+public class CameraCapability {
+    private final static String TAG = "CameraCapability";
+    public final static long MODEL_TTL_MS = 7 * 24 * 60 * 60 * 1000L;
+    public final static long CAMERA_TTL_MS = 60 * 60 * 1000L;
+
+    private final static String KEY_PRESET_TOKEN = "token";
+    private final static String KEY_PRESET_NAME = "Name";
+
+    private String cameraId = "";
+    private String modelId = "";
+    private boolean isOnvif = false;
+    private boolean isPtz = false;
+    /* When the model flags were last fetched, 0 if never */
+    private long modelCheckedAt = 0;
+    private boolean hasFullRights = false;
+    private ArrayList<PTZPreset> presetList = new ArrayList<>();
+    /* When the rights and presets were last fetched, 0 if never */
+    private long cameraCheckedAt = 0;
+
+    public CameraCapability(String cameraId, String modelId) {
+        this.cameraId = cameraId;
+        this.modelId = modelId;
+    }
+
+    /**
+     * Whether the PTZ controls should be shown
+     */
+    public boolean hasPtzControl() {
+        return isOnvif && isPtz && hasFullRights;
+    }
+
+    public boolean isModelStale(long nowMs) {
+        return nowMs - modelCheckedAt > MODEL_TTL_MS;
+    }
+
+    public boolean isCameraStale(long nowMs) {
+        return nowMs - cameraCheckedAt > CAMERA_TTL_MS;
+    }
+
+    public boolean isStale(long nowMs) {
+        return isModelStale(nowMs) || (isOnvif && isPtz && isCameraStale(nowMs));
+    }
+
+    /**
+     * Whether anything was cached, i.e. the controls can be rendered before revalidation
+     */
+    public boolean isKnown() {
+        return modelCheckedAt > 0;
+    }
+
+    public String getCameraId() {
+        return cameraId;
+    }
+
+    public String getModelId() {
+        return modelId;
+    }
+
+    public boolean isOnvif() {
+        return isOnvif;
+    }
+
+    public boolean isPtz() {
+        return isPtz;
+    }
+
+    public long getModelCheckedAt() {
+        return modelCheckedAt;
+    }
+
+    public void setModelCapability(boolean isOnvif, boolean isPtz, long checkedAt) {
+        this.isOnvif = isOnvif;
+        this.isPtz = isPtz;
+        this.modelCheckedAt = checkedAt;
+    }
+
+    public boolean hasFullRights() {
+        return hasFullRights;
+    }
+
+    public ArrayList<PTZPreset> getPresetList() {
+        return presetList;
+    }
+
+    public long getCameraCheckedAt() {
+        return cameraCheckedAt;
+    }
+
+    public void setCameraCapability(boolean hasFullRights, ArrayList<PTZPreset> presetList,
+                                    long checkedAt) {
+        this.hasFullRights = hasFullRights;
+        this.presetList = presetList;
+        this.cameraCheckedAt = checkedAt;
+    }
+
+    public String getPresetsJson() {
+        return toPresetsJson(presetList);
+    }
+
+    public static String toPresetsJson(ArrayList<PTZPreset> presets) {
+        JSONArray presetArray = new JSONArray();
+        try {
+            for (PTZPreset preset : presets) {
+                presetArray.put(new JSONObject().put(KEY_PRESET_TOKEN, preset.getToken())
+                        .put(KEY_PRESET_NAME, preset.getName()));
+            }
+        } catch (JSONException e) {
+            Log.e(TAG, e.toString());
+        }
+        return presetArray.toString();
+    }
+
+    public static ArrayList<PTZPreset> getPresetsFromJson(String presetsJson) {
+        ArrayList<PTZPreset> presets = new ArrayList<>();
+        try {
+            JSONArray presetArray = new JSONArray(presetsJson);
+            for (int index = 0; index < presetArray.length(); index++) {
+                presets.add(new PTZPreset(presetArray.getJSONObject(index)));
+            }
+        } catch (JSONException e) {
+            Log.e(TAG, e.toString());
+        }
+        return presets;
+    }
+
+    /**
+     * Exclude presets with token >= 33 and only keep those user defined presets
+     */
+    public static ArrayList<PTZPreset> getCustomPresets(ArrayList<PTZPreset> allPresets) {
+        ArrayList<PTZPreset> customPresets = new ArrayList<>();
+        for (PTZPreset preset : allPresets) {
+            int tokenInt = Integer.valueOf(preset.getToken());
+            if (tokenInt < 33) {
+                customPresets.add(preset);
+            }
+        }
+        return customPresets;
+    }
+}
@@ -0,0 +1,121 @@
+package io.evercam.androidapp.dto;
+
+import io.evercam.Auth;
+import io.evercam.Defaults;
+import io.evercam.EvercamException;
+import io.evercam.Model;
+
+/**
+ * A camera model with its default URLs and credentials, as stored in the local
+ * vendor/model catalogue
+ */
+public class CatalogueModel {
+    private String id = "";
+    private String vendorId = "";
+    private String name = "";
+    private String jpgUrl = "";
+    private String h264Url = "";
+    private String username = "";
+    private String password = "";
+    private boolean isOnvif = false;
+    private boolean isPtz = false;
+
+    public CatalogueModel(String id, String vendorId, String name) {
+        this.id = id;
+        this.vendorId = vendorId;
+        this.name = name;
+    }
+
+    public static CatalogueModel fromModel(Model model) throws EvercamException {
+        CatalogueModel catalogueModel = new CatalogueModel(model.getId(), model.getVendorId(),
+                model.getName());
+        Defaults defaults = model.getDefaults();
+        if (defaults != null) {
+            catalogueModel.jpgUrl = notNull(defaults.getJpgURL());
+            catalogueModel.h264Url = notNull(defaults.getH264URL());
+            Auth basicAuth = defaults.getAuth(Auth.TYPE_BASIC);
+            if (basicAuth != null) {
+                catalogueModel.username = notNull(basicAuth.getUsername());
+                catalogueModel.password = notNull(basicAuth.getPassword());
+            }
+        }
+        catalogueModel.isOnvif = model.isOnvif();
+        catalogueModel.isPtz = model.isPTZ();
+        return catalogueModel;
+    }
+
+    private static String notNull(String value) {
+        return value == null ? "" : value;
+    }
+
+    public boolean isDefaultModel() {
+        return name.equals(Model.DEFAULT_MODEL_NAME);
+    }
+
+    public boolean isSameAs(CatalogueModel other) {
+        return id.equals(other.id) && vendorId.equals(other.vendorId) && name.equals(other.name)
+                && jpgUrl.equals(other.jpgUrl) && h264Url.equals(other.h264Url)
+                && username.equals(other.username) && password.equals(other.password)
+                && isOnvif == other.isOnvif && isPtz == other.isPtz;
+    }
+
+    public String getId() {
+        return id;
+    }
+
+    public String getVendorId() {
+        return vendorId;
+    }
+
+    public String getName() {
+        return name;
+    }
+
+    public String getJpgUrl() {
+        return jpgUrl;
+    }
+
+    public void setJpgUrl(String jpgUrl) {
+        this.jpgUrl = jpgUrl;
+    }
+
+    public String getH264Url() {
+        return h264Url;
+    }
+
+    public void setH264Url(String h264Url) {
+        this.h264Url = h264Url;
+    }
+
+    public String getUsername() {
+        return username;
+    }
+
+    public void setUsername(String username) {
+        this.username = username;
+    }
+
+    public String getPassword() {
+        return password;
+    }
+
+    public void setPassword(String password) {
+        this.password = password;
+    }
+
+    public boolean isOnvif() {
+        return isOnvif;
+    }
+
+    public void setOnvif(boolean isOnvif) {
+        this.isOnvif = isOnvif;
+    }
+
+    public boolean isPtz() {
+        return isPtz;
+    }
+
+    public void setPtz(boolean isPtz) {
+        this.isPtz = isPtz;
+    }
+}
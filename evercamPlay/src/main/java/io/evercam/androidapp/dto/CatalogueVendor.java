@@ -0,0 +1,40 @@
+package io.evercam.androidapp.dto;
+
+/**
+ * A camera vendor in the local vendor/model catalogue
+ */
+public class CatalogueVendor {
+    private String id = "";
+    private String name = "";
+    /* When the vendor's models were last fetched, 0 if never */
+    private long modelsRefreshedAt = 0;
+
+    public CatalogueVendor(String id, String name) {
+        this.id = id;
+        this.name = name;
+    }
+
+    public String getId() {
+        return id;
+    }
+
+    public String getName() {
+        return name;
+    }
+
+    public long getModelsRefreshedAt() {
+        return modelsRefreshedAt;
+    }
+
+    public void setModelsRefreshedAt(long modelsRefreshedAt) {
+        this.modelsRefreshedAt = modelsRefreshedAt;
+    }
+
+    public boolean hasModels() {
+        return modelsRefreshedAt > 0;
+    }
+
+    public boolean isSameAs(CatalogueVendor other) {
+        return id.equals(other.id) && name.equals(other.name);
+    }
+}
@@ -0,0 +1,72 @@
+package io.evercam.androidapp.dto;
+
+/**
+ * A snapshot saved on device storage, as recorded in the local snapshot index
+ */
+public class SavedSnapshot {
+    private String path = "";
+    private String cameraId = "";
+    private long size = 0;
+    private long createdAt = 0;
+    private long lastViewedAt = 0;
+    private int viewCount = 0;
+
+    public SavedSnapshot() {
+
+    }
+
+    public SavedSnapshot(String path, String cameraId, long size, long createdAt) {
+        this.path = path;
+        this.cameraId = cameraId;
+        this.size = size;
+        this.createdAt = createdAt;
+    }
+
+    public String getPath() {
+        return path;
+    }
+
+    public void setPath(String path) {
+        this.path = path;
+    }
+
+    public String getCameraId() {
+        return cameraId;
+    }
+
+    public void setCameraId(String cameraId) {
+        this.cameraId = cameraId;
+    }
+
+    public long getSize() {
+        return size;
+    }
+
+    public void setSize(long size) {
+        this.size = size;
+    }
+
+    public long getCreatedAt() {
+        return createdAt;
+    }
+
+    public void setCreatedAt(long createdAt) {
+        this.createdAt = createdAt;
+    }
+
+    public long getLastViewedAt() {
+        return lastViewedAt;
+    }
+
+    public void setLastViewedAt(long lastViewedAt) {
+        this.lastViewedAt = lastViewedAt;
+    }
+
+    public int getViewCount() {
+        return viewCount;
+    }
+
+    public void setViewCount(int viewCount) {
+        this.viewCount = viewCount;
+    }
+}
@@ -0,0 +1,116 @@
+package io.evercam.androidapp.feedback;
+
+import android.content.Context;
+import android.util.Log;
+
+import org.json.JSONException;
+import org.json.JSONObject;
+
+import java.util.HashMap;
+
+import io.evercam.androidapp.http.EndpointMetrics;
+import io.evercam.androidapp.http.LatencyHistogram;
+
+/**
+ * Request metrics of one endpoint since the last export, times in milliseconds
+ */
+public class NetworkMetricsFeedbackItem extends FeedbackItem {
+    private final static String TAG = "NetworkMetricsFeedbackItem";
+
+    private String endpoint = "";
+    private Long requests;
+    private Long failures;
+    private Long cache_hits;
+    private Long bytes_sent;
+    private Long bytes_received;
+    private Float total_p50;
+    private Float total_p90;
+    private Float total_p99;
+    private Float total_max;
+    private Float ttfb_p50;
+    private Float ttfb_p90;
+    private Float ttfb_p99;
+    private Float dns_p50;
+    private Float connect_p50;
+    private Float tls_p50;
+    private Long new_connections;
+
+    public NetworkMetricsFeedbackItem(Context context, String username, EndpointMetrics
+            .Snapshot snapshot) {
+        super(context, username);
+        this.endpoint = snapshot.getEndpoint();
+        this.requests = snapshot.getRequests();
+        this.failures = snapshot.getFailures();
+        this.cache_hits = snapshot.getCacheHits();
+        this.bytes_sent = snapshot.getBytesSent();
+        this.bytes_received = snapshot.getBytesReceived();
+        LatencyHistogram.Snapshot total = snapshot.getTotal();
+        this.total_p50 = toMs(total.getPercentileUs(50));
+        this.total_p90 = toMs(total.getPercentileUs(90));
+        this.total_p99 = toMs(total.getPercentileUs(99));
+        this.total_max = toMs(total.getMaxUs());
+        LatencyHistogram.Snapshot ttfb = snapshot.getTtfb();
+        this.ttfb_p50 = toMs(ttfb.getPercentileUs(50));
+        this.ttfb_p90 = toMs(ttfb.getPercentileUs(90));
+        this.ttfb_p99 = toMs(ttfb.getPercentileUs(99));
+        this.dns_p50 = toMs(snapshot.getDns().getPercentileUs(50));
+        this.connect_p50 = toMs(snapshot.getConnect().getPercentileUs(50));
+        this.tls_p50 = toMs(snapshot.getTls().getPercentileUs(50));
+        this.new_connections = snapshot.getConnect().getCount();
+    }
+
+    private static Float toMs(long durationUs) {
+        return durationUs / 1000f;
+    }
+
+    public String toJson() {
+        JSONObject jsonObject;
+        try {
+            jsonObject = getBaseJsonObject();
+            jsonObject.put("endpoint", endpoint);
+            jsonObject.put("requests", requests);
+            jsonObject.put("failures", failures);
+            jsonObject.put("cache_hits", cache_hits);
+            jsonObject.put("bytes_sent", bytes_sent);
+            jsonObject.put("bytes_received", bytes_received);
+            jsonObject.put("total_p50", total_p50);
+            jsonObject.put("total_p90", total_p90);
+            jsonObject.put("total_p99", total_p99);
+            jsonObject.put("total_max", total_max);
+            jsonObject.put("ttfb_p50", ttfb_p50);
+            jsonObject.put("ttfb_p90", ttfb_p90);
+            jsonObject.put("ttfb_p99", ttfb_p99);
+            jsonObject.put("dns_p50", dns_p50);
+            jsonObject.put("connect_p50", connect_p50);
+            jsonObject.put("tls_p50", tls_p50);
+            jsonObject.put("new_connections", new_connections);
+            return jsonObject.toString();
+        } catch (JSONException e) {
+            Log.e(TAG, e.toString());
+        }
+        return "";
+    }
+
+    @Override
+    public HashMap<String, Object> toHashMap() {
+        HashMap<String, Object> event = super.toHashMap();
+        event.put("endpoint", endpoint);
+        event.put("requests", requests);
+        event.put("failures", failures);
+        event.put("cache_hits", cache_hits);
+        event.put("bytes_sent", bytes_sent);
+        event.put("bytes_received", bytes_received);
+        event.put("total_p50", total_p50);
+        event.put("total_p90", total_p90);
+        event.put("total_p99", total_p99);
+        event.put("total_max", total_max);
+        event.put("ttfb_p50", ttfb_p50);
+        event.put("ttfb_p90", ttfb_p90);
+        event.put("ttfb_p99", ttfb_p99);
+        event.put("dns_p50", dns_p50);
+        event.put("connect_p50", connect_p50);
+        event.put("tls_p50", tls_p50);
+        event.put("new_connections", new_connections);
+        return event;
+    }
+}
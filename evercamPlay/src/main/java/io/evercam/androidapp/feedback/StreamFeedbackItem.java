@@ -8,6 +8,7 @@ import org.json.JSONObject;
 
 import java.util.HashMap;
 
+import io.evercam.androidapp.player.PlaybackMetrics;
 import io.evercam.androidapp.utils.Constants;
 
 
@@ -15,6 +16,7 @@ public class StreamFeedbackItem extends FeedbackItem {
     private final static String TAG = "StreamFeedbackItem";
     public final static String TYPE_JPG = "jpg";
     public final static String TYPE_HLS = "hls";
+    public final static String TYPE_RTSP = "rtsp";
 
     //Camera stream details;
     private String url = "";
@@ -23,6 +25,15 @@ public class StreamFeedbackItem extends FeedbackItem {
     private Boolean is_success;
     private Float load_time;
 
+    //Playback quality of experience, only set for finished HLS sessions
+    private Long startup_time;
+    private Integer rebuffer_count;
+    private Float rebuffer_ratio;
+    private Float dropped_frames_per_minute;
+    private Integer bitrate_switches;
+    private Long bandwidth_estimate;
+    private Long watch_time;
+
     public StreamFeedbackItem(Context context, String username, Boolean isSuccess) {
         super(context, username);
         this.is_success = isSuccess;
@@ -48,6 +59,16 @@ public class StreamFeedbackItem extends FeedbackItem {
         this.load_time = loadTime;
     }
 
+    public void setPlaybackMetrics(PlaybackMetrics metrics) {
+        this.startup_time = metrics.getStartupTimeMs() < 0 ? null : metrics.getStartupTimeMs();
+        this.rebuffer_count = metrics.getRebufferCount();
+        this.rebuffer_ratio = metrics.getRebufferRatio();
+        this.dropped_frames_per_minute = metrics.getDroppedFramesPerMinute();
+        this.bitrate_switches = metrics.getBitrateSwitches();
+        this.bandwidth_estimate = metrics.getBandwidthEstimate();
+        this.watch_time = metrics.getPlayingTimeMs() + metrics.getRebufferTimeMs();
+    }
+
     public Float getLoad_time() {
         return load_time;
     }
@@ -72,6 +93,13 @@ public class StreamFeedbackItem extends FeedbackItem {
             jsonObject.put("is_success", is_success);
             jsonObject.put("load_time", load_time);
             jsonObject.put("type", type);
+            jsonObject.put("startup_time", startup_time);
+            jsonObject.put("rebuffer_count", rebuffer_count);
+            jsonObject.put("rebuffer_ratio", rebuffer_ratio);
+            jsonObject.put("dropped_frames_per_minute", dropped_frames_per_minute);
+            jsonObject.put("bitrate_switches", bitrate_switches);
+            jsonObject.put("bandwidth_estimate", bandwidth_estimate);
+            jsonObject.put("watch_time", watch_time);
             return jsonObject.toString();
         } catch (JSONException e) {
             Log.e(TAG, e.toString());
@@ -87,6 +115,13 @@ public class StreamFeedbackItem extends FeedbackItem {
         event.put("is_success", is_success);
         event.put("load_time", load_time);
         event.put("type", type);
+        event.put("startup_time", startup_time);
+        event.put("rebuffer_count", rebuffer_count);
+        event.put("rebuffer_ratio", rebuffer_ratio);
+        event.put("dropped_frames_per_minute", dropped_frames_per_minute);
+        event.put("bitrate_switches", bitrate_switches);
+        event.put("bandwidth_estimate", bandwidth_estimate);
+        event.put("watch_time", watch_time);
         return event;
     }
 }
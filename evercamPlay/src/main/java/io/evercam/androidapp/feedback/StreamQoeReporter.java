@@ -0,0 +1,74 @@
+package io.evercam.androidapp.feedback;
+
+import android.util.Log;
+
+import org.json.JSONException;
+import org.json.JSONObject;
+
+import java.util.ArrayDeque;
+import java.util.ArrayList;
+
+import io.evercam.androidapp.R;
+
+/**
+ * Keeps finished playback sessions in a bounded ring buffer and sends them to Mixpanel
+ * in batches, so stream quality can be tracked per camera and network type without an
+ * upload after every camera switch.
+ *
+ * When the buffer is full the oldest session is dropped.
+ */
+public class StreamQoeReporter {
+    private final static String TAG = "StreamQoeReporter";
+    private final static int CAPACITY = 50;
+    private final static int BATCH_SIZE = 10;
+
+    private static final ArrayDeque<StreamFeedbackItem> sessions = new ArrayDeque<>(CAPACITY);
+
+    public static void record(MixpanelHelper mixpanel, StreamFeedbackItem item) {
+        boolean batchReady;
+        synchronized (sessions) {
+            if (sessions.size() == CAPACITY) {
+                sessions.pollFirst();
+            }
+            sessions.addLast(item);
+            batchReady = sessions.size() >= BATCH_SIZE;
+        }
+
+        if (batchReady) {
+            flush(mixpanel, false);
+        }
+    }
+
+    /**
+     * Send everything buffered
+     *
+     * @param force false to only send when at least a full batch is buffered
+     */
+    public static void flush(MixpanelHelper mixpanel, boolean force) {
+        if (mixpanel == null) return;
+
+        ArrayList<StreamFeedbackItem> batch = new ArrayList<>();
+        synchronized (sessions) {
+            if (!force && sessions.size() < BATCH_SIZE) return;
+            batch.addAll(sessions);
+            sessions.clear();
+        }
+        if (batch.isEmpty()) return;
+
+        for (StreamFeedbackItem item : batch) {
+            try {
+                mixpanel.sendEvent(R.string.mixpanel_event_stream_quality, new JSONObject(item.toJson()));
+            } catch (JSONException e) {
+                Log.e(TAG, e.toString());
+            }
+        }
+        mixpanel.flush();
+        Log.d(TAG, "Sent " + batch.size() + " stream sessions");
+    }
+
+    public static int getBufferedCount() {
+        synchronized (sessions) {
+            return sessions.size();
+        }
+    }
+}
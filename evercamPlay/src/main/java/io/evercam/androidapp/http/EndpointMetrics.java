@@ -0,0 +1,112 @@
+package io.evercam.androidapp.http;
+
+import java.util.concurrent.atomic.AtomicLong;
+
+/**
+ * Timings and counters of the requests to one normalized endpoint, all lock free.
+ *
+ * DNS, connect and TLS are only recorded when the request opened a new connection, TTFB
+ * is from the request being sent to the response headers, and total is from the call
+ * starting to the body being read.
+ */
+public class EndpointMetrics {
+    private final String endpoint;
+    final LatencyHistogram dns = new LatencyHistogram();
+    final LatencyHistogram connect = new LatencyHistogram();
+    final LatencyHistogram tls = new LatencyHistogram();
+    final LatencyHistogram ttfb = new LatencyHistogram();
+    final LatencyHistogram total = new LatencyHistogram();
+    final AtomicLong requests = new AtomicLong();
+    final AtomicLong failures = new AtomicLong();
+    final AtomicLong cacheHits = new AtomicLong();
+    final AtomicLong bytesSent = new AtomicLong();
+    final AtomicLong bytesReceived = new AtomicLong();
+
+    EndpointMetrics(String endpoint) {
+        this.endpoint = endpoint;
+    }
+
+    public String getEndpoint() {
+        return endpoint;
+    }
+
+    /**
+     * @param reset true to start the counts over, as after an export
+     */
+    public Snapshot snapshot(boolean reset) {
+        return new Snapshot(this, reset);
+    }
+
+    public static class Snapshot {
+        private final String endpoint;
+        private final LatencyHistogram.Snapshot dns;
+        private final LatencyHistogram.Snapshot connect;
+        private final LatencyHistogram.Snapshot tls;
+        private final LatencyHistogram.Snapshot ttfb;
+        private final LatencyHistogram.Snapshot total;
+        private final long requests;
+        private final long failures;
+        private final long cacheHits;
+        private final long bytesSent;
+        private final long bytesReceived;
+
+        private Snapshot(EndpointMetrics metrics, boolean reset) {
+            endpoint = metrics.endpoint;
+            dns = reset ? metrics.dns.drain() : metrics.dns.snapshot();
+            connect = reset ? metrics.connect.drain() : metrics.connect.snapshot();
+            tls = reset ? metrics.tls.drain() : metrics.tls.snapshot();
+            ttfb = reset ? metrics.ttfb.drain() : metrics.ttfb.snapshot();
+            total = reset ? metrics.total.drain() : metrics.total.snapshot();
+            requests = reset ? metrics.requests.getAndSet(0) : metrics.requests.get();
+            failures = reset ? metrics.failures.getAndSet(0) : metrics.failures.get();
+            cacheHits = reset ? metrics.cacheHits.getAndSet(0) : metrics.cacheHits.get();
+            bytesSent = reset ? metrics.bytesSent.getAndSet(0) : metrics.bytesSent.get();
+            bytesReceived = reset ? metrics.bytesReceived.getAndSet(0) : metrics.bytesReceived
+                    .get();
+        }
+
+        public String getEndpoint() {
+            return endpoint;
+        }
+
+        public LatencyHistogram.Snapshot getDns() {
+            return dns;
+        }
+
+        public LatencyHistogram.Snapshot getConnect() {
+            return connect;
+        }
+
+        public LatencyHistogram.Snapshot getTls() {
+            return tls;
+        }
+
+        public LatencyHistogram.Snapshot getTtfb() {
+            return ttfb;
+        }
+
+        public LatencyHistogram.Snapshot getTotal() {
+            return total;
+        }
+
+        public long getRequests() {
+            return requests;
+        }
+
+        public long getFailures() {
+            return failures;
+        }
+
+        public long getCacheHits() {
+            return cacheHits;
+        }
+
+        public long getBytesSent() {
+            return bytesSent;
+        }
+
+        public long getBytesReceived() {
+            return bytesReceived;
+        }
+    }
+}
@@ -0,0 +1,135 @@
+package io.evercam.androidapp.http;
+
+import java.util.concurrent.atomic.AtomicLong;
+import java.util.concurrent.atomic.AtomicLongArray;
+
+/**
+ * A lock free log-linear histogram of durations in microseconds, in the style of
+ * HdrHistogram: each power of two range is split in 16 buckets, so any percentile is
+ * within about 6% of the exact value while the whole histogram is 3KB.
+ *
+ * Recording only touches atomics and never allocates, so it can run on every request.
+ * Values over about 134 seconds are counted in the last bucket.
+ */
+public class LatencyHistogram {
+    private final static int SUB_BUCKET_BITS = 4;
+    private final static int SUB_BUCKET_COUNT = 1 << SUB_BUCKET_BITS;
+    private final static int MAX_MAGNITUDE = 26;
+    final static int BUCKET_COUNT = SUB_BUCKET_COUNT * (MAX_MAGNITUDE - SUB_BUCKET_BITS + 2);
+    final static long MAX_VALUE = (1L << (MAX_MAGNITUDE + 1)) - 1;
+
+    private final AtomicLongArray buckets = new AtomicLongArray(BUCKET_COUNT);
+    private final AtomicLong sum = new AtomicLong();
+    private final AtomicLong max = new AtomicLong();
+
+    public void record(long valueUs) {
+        long value = Math.min(Math.max(valueUs, 0), MAX_VALUE);
+        buckets.incrementAndGet(indexOf(value));
+        sum.addAndGet(value);
+        long currentMax;
+        while (value > (currentMax = max.get())) {
+            if (max.compareAndSet(currentMax, value)) break;
+        }
+    }
+
+    /**
+     * @return a copy of the counts so far, the histogram keeps recording meanwhile
+     */
+    public Snapshot snapshot() {
+        return snapshot(false);
+    }
+
+    /**
+     * @return the counts so far, starting the histogram over. A value recorded at the same
+     * time lands in either this snapshot or the next one.
+     */
+    public Snapshot drain() {
+        return snapshot(true);
+    }
+
+    private Snapshot snapshot(boolean reset) {
+        long[] counts = new long[BUCKET_COUNT];
+        for (int index = 0; index < BUCKET_COUNT; index++) {
+            counts[index] = reset ? buckets.getAndSet(index, 0) : buckets.get(index);
+        }
+        long snapshotSum = reset ? sum.getAndSet(0) : sum.get();
+        long snapshotMax = reset ? max.getAndSet(0) : max.get();
+        return new Snapshot(counts, snapshotSum, snapshotMax);
+    }
+
+    static int indexOf(long value) {
+        if (value < SUB_BUCKET_COUNT) return (int) value;
+        int magnitude = 63 - Long.numberOfLeadingZeros(value);
+        int shift = magnitude - SUB_BUCKET_BITS;
+        int subBucket = (int) (value >> shift) - SUB_BUCKET_COUNT;
+        return SUB_BUCKET_COUNT * (shift + 1) + subBucket;
+    }
+
+    /**
+     * @return the smallest value counted in the bucket
+     */
+    static long lowestValueAt(int index) {
+        if (index < SUB_BUCKET_COUNT) return index;
+        int shift = index / SUB_BUCKET_COUNT - 1;
+        int subBucket = index % SUB_BUCKET_COUNT;
+        return (long) (SUB_BUCKET_COUNT + subBucket) << shift;
+    }
+
+    /**
+     * @return the largest value counted in the bucket
+     */
+    static long highestValueAt(int index) {
+        if (index < SUB_BUCKET_COUNT) return index;
+        int shift = index / SUB_BUCKET_COUNT - 1;
+        return lowestValueAt(index) + (1L << shift) - 1;
+    }
+
+    public static class Snapshot {
+        private final long[] counts;
+        private final long count;
+        private final long sum;
+        private final long max;
+
+        Snapshot(long[] counts, long sum, long max) {
+            this.counts = counts;
+            long total = 0;
+            for (long bucketCount : counts) {
+                total += bucketCount;
+            }
+            this.count = total;
+            this.sum = sum;
+            this.max = max;
+        }
+
+        public long getCount() {
+            return count;
+        }
+
+        public long getMeanUs() {
+            return count == 0 ? 0 : sum / count;
+        }
+
+        public long getMaxUs() {
+            return max;
+        }
+
+        /**
+         * @param percentile from 0 to 100
+         * @return the middle of the bucket holding the percentile, capped by the maximum
+         */
+        public long getPercentileUs(double percentile) {
+            if (count == 0) return 0;
+            long rank = Math.max(1, (long) Math.ceil(count * Math.min(percentile, 100) / 100));
+            if (rank >= count) return max;
+            long seen = 0;
+            for (int index = 0; index < counts.length; index++) {
+                seen += counts[index];
+                if (seen >= rank) {
+                    long middle = (lowestValueAt(index) + highestValueAt(index)) / 2;
+                    return Math.min(middle, max);
+                }
+            }
+            return max;
+        }
+    }
+}
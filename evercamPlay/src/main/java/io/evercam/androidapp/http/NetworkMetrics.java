@@ -0,0 +1,156 @@
+package io.evercam.androidapp.http;
+
+import android.content.Context;
+import android.util.Log;
+
+import org.json.JSONException;
+import org.json.JSONObject;
+
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.Collections;
+import java.util.Comparator;
+import java.util.HashSet;
+import java.util.List;
+import java.util.Locale;
+import java.util.concurrent.ConcurrentHashMap;
+import java.util.concurrent.atomic.AtomicLong;
+
+import io.evercam.androidapp.R;
+import io.evercam.androidapp.dto.AppData;
+import io.evercam.androidapp.feedback.MixpanelHelper;
+import io.evercam.androidapp.feedback.NetworkMetricsFeedbackItem;
+import okhttp3.HttpUrl;
+
+/**
+ * Request metrics of the shared HTTP client by normalized endpoint, kept in memory and
+ * sent to Mixpanel in batches.
+ *
+ * Evercam URLs are reduced to their path with ids replaced, so all thumbnails count as
+ * /cameras/{id}/thumbnail. Requests straight to cameras count as one camera endpoint
+ * and other services by name, which keeps the number of endpoints small.
+ */
+public class NetworkMetrics {
+    private final static String TAG = "NetworkMetrics";
+    private final static int MAX_ENDPOINTS = 64;
+    /* Requests made before the metrics are worth sending */
+    private final static int BATCH_REQUESTS = 200;
+    private final static String EVERCAM_DOMAIN = "evercam.io";
+    final static String ID = "{id}";
+    final static String ENDPOINT_CAMERA = "camera";
+    final static String ENDPOINT_OTHER = "other";
+
+    /* Path segments kept as they are, any other segment is an id */
+    private final static HashSet<String> PATH_WORDS = new HashSet<>(Arrays.asList("cameras",
+            "users", "shares", "requests", "transfer", "rights", "recordings", "snapshots",
+            "snapshot", "live", "thumbnail", "jpg", "mjpeg", "latest", "oldest", "range",
+            "days", "hours", "nearest", "ptz", "presets", "home", "relative", "continuous",
+            "stop", "start", "create", "go", "port-check", "test", "vendors", "models",
+            "public", "logs", "apps", "archives", "timelapses", "cloud-recordings", "nvr",
+            "auth", "credentials", "me", "socket", "websocket", "hls", "index.m3u8"));
+
+    /* Third party services by domain */
+    private final static String[][] SERVICES = {{"gravatar.com", "gravatar"},
+            {"googleapis.com", "google"}, {"amazonaws.com", "s3"}, {"intercom.io", "intercom"}};
+
+    private final static ConcurrentHashMap<String, EndpointMetrics> endpoints = new
+            ConcurrentHashMap<>();
+    private final static AtomicLong requestsSinceExport = new AtomicLong();
+
+    public static EndpointMetrics get(HttpUrl url) {
+        String endpoint = normalize(url);
+        EndpointMetrics metrics = endpoints.get(endpoint);
+        if (metrics == null) {
+            if (endpoints.size() >= MAX_ENDPOINTS) {
+                endpoint = ENDPOINT_OTHER;
+            }
+            EndpointMetrics newMetrics = new EndpointMetrics(endpoint);
+            metrics = endpoints.putIfAbsent(endpoint, newMetrics);
+            if (metrics == null) {
+                metrics = newMetrics;
+            }
+        }
+        return metrics;
+    }
+
+    static String normalize(HttpUrl url) {
+        String host = url.host().toLowerCase(Locale.ENGLISH);
+        if (host.equals(EVERCAM_DOMAIN) || host.endsWith("." + EVERCAM_DOMAIN)) {
+            return normalizePath(url.pathSegments());
+        }
+        for (String[] service : SERVICES) {
+            if (host.equals(service[0]) || host.endsWith("." + service[0])) {
+                return service[1];
+            }
+        }
+        return ENDPOINT_CAMERA;
+    }
+
+    private static String normalizePath(List<String> segments) {
+        StringBuilder path = new StringBuilder();
+        for (int index = 0; index < segments.size(); index++) {
+            String segment = segments.get(index).toLowerCase(Locale.ENGLISH);
+            if (segment.isEmpty()) continue;
+            //The API version
+            if (index == 0 && segment.matches("v\\d+")) continue;
+            path.append('/').append(PATH_WORDS.contains(segment) ? segment : ID);
+        }
+        return path.length() == 0 ? "/" : path.toString();
+    }
+
+    static void onRequest() {
+        requestsSinceExport.incrementAndGet();
+    }
+
+    /**
+     * @param reset true to start all counts over
+     * @return the metrics of every endpoint, by endpoint name
+     */
+    public static List<EndpointMetrics.Snapshot> snapshot(boolean reset) {
+        ArrayList<EndpointMetrics.Snapshot> snapshots = new ArrayList<>();
+        for (EndpointMetrics metrics : endpoints.values()) {
+            snapshots.add(metrics.snapshot(reset));
+        }
+        Collections.sort(snapshots, new Comparator<EndpointMetrics.Snapshot>() {
+            @Override
+            public int compare(EndpointMetrics.Snapshot first, EndpointMetrics.Snapshot second) {
+                return first.getEndpoint().compareTo(second.getEndpoint());
+            }
+        });
+        return snapshots;
+    }
+
+    public static void clear() {
+        snapshot(true);
+        requestsSinceExport.set(0);
+    }
+
+    /**
+     * Send the metrics of each endpoint with requests since the last export, then start
+     * the counts over
+     *
+     * @param force false to only send once enough requests have finished
+     */
+    public static void flush(Context context, MixpanelHelper mixpanel, boolean force) {
+        if (mixpanel == null) return;
+        if (!force && requestsSinceExport.get() < BATCH_REQUESTS) return;
+        requestsSinceExport.set(0);
+
+        String username = AppData.defaultUser != null ? AppData.defaultUser.getUsername() : "";
+        int sentCount = 0;
+        for (EndpointMetrics.Snapshot snapshot : snapshot(true)) {
+            if (snapshot.getRequests() == 0) continue;
+            try {
+                NetworkMetricsFeedbackItem item = new NetworkMetricsFeedbackItem(context,
+                        username, snapshot);
+                mixpanel.sendEvent(R.string.mixpanel_event_network_metrics, new JSONObject
+                        (item.toJson()));
+                sentCount++;
+            } catch (JSONException e) {
+                Log.e(TAG, e.toString());
+            }
+        }
+        mixpanel.flush();
+        Log.d(TAG, "Sent metrics of " + sentCount + " endpoints");
+    }
+}
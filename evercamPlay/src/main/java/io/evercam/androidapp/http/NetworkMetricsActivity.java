@@ -0,0 +1,110 @@
+package io.evercam.androidapp.http;
+
+import android.os.Bundle;
+import android.os.Handler;
+import android.text.format.Formatter;
+import android.view.Menu;
+import android.view.MenuItem;
+import android.widget.TextView;
+
+import java.util.List;
+import java.util.Locale;
+
+import io.evercam.androidapp.ParentAppCompatActivity;
+import io.evercam.androidapp.R;
+
+/**
+ * Debug screen showing the {@link NetworkMetrics} of each endpoint, refreshed every second
+ */
+public class NetworkMetricsActivity extends ParentAppCompatActivity {
+    private final static long REFRESH_INTERVAL_MS = 1000;
+
+    private TextView metricsTextView;
+    private final Handler handler = new Handler();
+    private final Runnable refreshRunnable = new Runnable() {
+        @Override
+        public void run() {
+            showMetrics();
+            handler.postDelayed(this, REFRESH_INTERVAL_MS);
+        }
+    };
+
+    @Override
+    protected void onCreate(Bundle savedInstanceState) {
+        super.onCreate(savedInstanceState);
+
+        setContentView(R.layout.activity_network_metrics);
+
+        setUpDefaultToolbar();
+
+        metricsTextView = (TextView) findViewById(R.id.network_metrics_text);
+    }
+
+    @Override
+    protected void onResume() {
+        super.onResume();
+        handler.post(refreshRunnable);
+    }
+
+    @Override
+    protected void onPause() {
+        super.onPause();
+        handler.removeCallbacks(refreshRunnable);
+    }
+
+    @Override
+    public boolean onCreateOptionsMenu(Menu menu) {
+        getMenuInflater().inflate(R.menu.activity_network_metrics, menu);
+        return true;
+    }
+
+    @Override
+    public boolean onOptionsItemSelected(MenuItem item) {
+        switch (item.getItemId()) {
+            case android.R.id.home:
+                finish();
+                return true;
+            case R.id.action_send_metrics:
+                NetworkMetrics.flush(getApplicationContext(), getMixpanel(), true);
+                showMetrics();
+                return true;
+            case R.id.action_clear_metrics:
+                NetworkMetrics.clear();
+                showMetrics();
+                return true;
+            default:
+                return super.onOptionsItemSelected(item);
+        }
+    }
+
+    private void showMetrics() {
+        List<EndpointMetrics.Snapshot> snapshots = NetworkMetrics.snapshot(false);
+        StringBuilder text = new StringBuilder();
+        for (EndpointMetrics.Snapshot snapshot : snapshots) {
+            if (snapshot.getRequests() == 0) continue;
+            text.append(snapshot.getEndpoint()).append('\n');
+            text.append(String.format(Locale.ENGLISH, "  requests %d  failed %d  cached %d\n",
+                    snapshot.getRequests(), snapshot.getFailures(), snapshot.getCacheHits()));
+            text.append("  received ").append(Formatter.formatShortFileSize(this, snapshot
+                    .getBytesReceived())).append("  sent ").append(Formatter
+                    .formatShortFileSize(this, snapshot.getBytesSent())).append('\n');
+            appendLatency(text, "total", snapshot.getTotal());
+            appendLatency(text, "ttfb", snapshot.getTtfb());
+            appendLatency(text, "dns", snapshot.getDns());
+            appendLatency(text, "connect", snapshot.getConnect());
+            appendLatency(text, "tls", snapshot.getTls());
+            text.append('\n');
+        }
+        metricsTextView.setText(text.length() > 0 ? text : getString(R.string
+                .msg_no_network_metrics));
+    }
+
+    private static void appendLatency(StringBuilder text, String name, LatencyHistogram
+            .Snapshot latency) {
+        if (latency.getCount() == 0) return;
+        text.append(String.format(Locale.ENGLISH, "  %-8s p50 %.0f  p90 %.0f  p99 %.0f  " +
+                "max %.0f ms (%d)\n", name, latency.getPercentileUs(50) / 1000f, latency
+                .getPercentileUs(90) / 1000f, latency.getPercentileUs(99) / 1000f, latency
+                .getMaxUs() / 1000f, latency.getCount()));
+    }
+}
@@ -0,0 +1,272 @@
+package io.evercam.androidapp.http;
+
+import java.io.IOException;
+import java.net.InetAddress;
+import java.net.InetSocketAddress;
+import java.net.Socket;
+import java.net.SocketAddress;
+import java.net.UnknownHostException;
+import java.util.List;
+import java.util.concurrent.TimeUnit;
+
+import javax.net.SocketFactory;
+
+import okhttp3.Connection;
+import okhttp3.Dns;
+import okhttp3.Interceptor;
+import okhttp3.MediaType;
+import okhttp3.OkHttpClient;
+import okhttp3.Request;
+import okhttp3.RequestBody;
+import okhttp3.Response;
+import okhttp3.ResponseBody;
+import okio.Buffer;
+import okio.BufferedSource;
+import okio.ForwardingSource;
+import okio.Okio;
+
+/**
+ * Records the {@link NetworkMetrics} of every call of a client.
+ *
+ * OkHttp 3.6 has no event listener, so the phases are timed from the hooks it does have:
+ * DNS lookups through a timing {@link Dns}, TCP connects through a timing socket factory,
+ * and the request being sent and the headers received through a network interceptor.
+ * A call runs entirely on one thread, so they meet in a thread local. TLS is what is left
+ * of setting up a new connection once DNS and connect are taken out.
+ */
+public class NetworkMetricsInterceptor implements Interceptor {
+    private final static String CONTENT_TYPE_STREAM = "multipart";
+    private final static int CODE_SWITCHING_PROTOCOLS = 101;
+
+    private final static ThreadLocal<CallTimings> timings = new ThreadLocal<CallTimings>() {
+        @Override
+        protected CallTimings initialValue() {
+            return new CallTimings();
+        }
+    };
+
+    private static class CallTimings {
+        long dnsNs;
+        long connectNs;
+        /* When the first request of the call was sent, redirects send more */
+        long networkStartNs;
+        long ttfbNs;
+        boolean isTls;
+
+        void reset() {
+            dnsNs = 0;
+            connectNs = 0;
+            networkStartNs = 0;
+            ttfbNs = 0;
+            isTls = false;
+        }
+    }
+
+    /**
+     * Add the metrics hooks to a client being built
+     */
+    public static OkHttpClient.Builder install(OkHttpClient.Builder builder) {
+        return builder.dns(TIMING_DNS)
+                .socketFactory(new TimingSocketFactory())
+                .addInterceptor(new NetworkMetricsInterceptor())
+                .addNetworkInterceptor(NETWORK_INTERCEPTOR);
+    }
+
+    @Override
+    public Response intercept(Chain chain) throws IOException {
+        Request request = chain.request();
+        EndpointMetrics metrics = NetworkMetrics.get(request.url());
+        CallTimings callTimings = timings.get();
+        callTimings.reset();
+        long startNs = System.nanoTime();
+        metrics.requests.incrementAndGet();
+        NetworkMetrics.onRequest();
+
+        RequestBody requestBody = request.body();
+        if (requestBody != null && requestBody.contentLength() > 0) {
+            metrics.bytesSent.addAndGet(requestBody.contentLength());
+        }
+
+        Response response;
+        try {
+            response = chain.proceed(request);
+        } catch (IOException e) {
+            metrics.failures.incrementAndGet();
+            metrics.total.record(toUs(System.nanoTime() - startNs));
+            throw e;
+        }
+
+        if (response.networkResponse() == null) {
+            metrics.cacheHits.incrementAndGet();
+            return response;
+        }
+        if (callTimings.networkStartNs > 0) {
+            //A socket connected during the call means the connection is new
+            if (callTimings.connectNs > 0) {
+                metrics.dns.record(toUs(callTimings.dnsNs));
+                metrics.connect.record(toUs(callTimings.connectNs));
+                if (callTimings.isTls) {
+                    metrics.tls.record(toUs(callTimings.networkStartNs - startNs
+                            - callTimings.dnsNs - callTimings.connectNs));
+                }
+            }
+            metrics.ttfb.record(toUs(callTimings.ttfbNs));
+        }
+        if (response.code() >= 400) {
+            metrics.failures.incrementAndGet();
+        }
+
+        //Web sockets and MJPEG streams never finish, their total is the time to the headers
+        MediaType contentType = response.body() != null ? response.body().contentType() : null;
+        if (response.body() == null || response.code() == CODE_SWITCHING_PROTOCOLS ||
+                (contentType != null && contentType.type().equals(CONTENT_TYPE_STREAM))) {
+            metrics.total.record(toUs(System.nanoTime() - startNs));
+            return response;
+        }
+        return response.newBuilder().body(new MeteredBody(response.body(), metrics, startNs))
+                .build();
+    }
+
+    private static long toUs(long durationNs) {
+        return TimeUnit.NANOSECONDS.toMicros(Math.max(0, durationNs));
+    }
+
+    private final static Interceptor NETWORK_INTERCEPTOR = new Interceptor() {
+        @Override
+        public Response intercept(Chain chain) throws IOException {
+            CallTimings callTimings = timings.get();
+            long startNs = System.nanoTime();
+            if (callTimings.networkStartNs == 0) {
+                callTimings.networkStartNs = startNs;
+                Connection connection = chain.connection();
+                callTimings.isTls = connection != null && connection.handshake() != null;
+            }
+            Response response = chain.proceed(chain.request());
+            callTimings.ttfbNs = System.nanoTime() - startNs;
+            return response;
+        }
+    };
+
+    private final static Dns TIMING_DNS = new Dns() {
+        @Override
+        public List<InetAddress> lookup(String hostname) throws UnknownHostException {
+            long startNs = System.nanoTime();
+            try {
+                return Dns.SYSTEM.lookup(hostname);
+            } finally {
+                timings.get().dnsNs += System.nanoTime() - startNs;
+            }
+        }
+    };
+
+    private static class TimingSocketFactory extends SocketFactory {
+        @Override
+        public Socket createSocket() {
+            return new Socket() {
+                @Override
+                public void connect(SocketAddress endpoint, int timeout) throws IOException {
+                    long startNs = System.nanoTime();
+                    try {
+                        super.connect(endpoint, timeout);
+                    } finally {
+                        timings.get().connectNs += System.nanoTime() - startNs;
+                    }
+                }
+            };
+        }
+
+        @Override
+        public Socket createSocket(String host, int port) throws IOException {
+            Socket socket = createSocket();
+            socket.connect(new InetSocketAddress(host, port));
+            return socket;
+        }
+
+        @Override
+        public Socket createSocket(String host, int port, InetAddress localHost, int
+                localPort) throws IOException {
+            Socket socket = createSocket();
+            socket.bind(new InetSocketAddress(localHost, localPort));
+            socket.connect(new InetSocketAddress(host, port));
+            return socket;
+        }
+
+        @Override
+        public Socket createSocket(InetAddress host, int port) throws IOException {
+            Socket socket = createSocket();
+            socket.connect(new InetSocketAddress(host, port));
+            return socket;
+        }
+
+        @Override
+        public Socket createSocket(InetAddress address, int port, InetAddress localAddress,
+                                   int localPort) throws IOException {
+            Socket socket = createSocket();
+            socket.bind(new InetSocketAddress(localAddress, localPort));
+            socket.connect(new InetSocketAddress(address, port));
+            return socket;
+        }
+    }
+
+    /**
+     * Counts the bytes read and records the total time once the body is read or closed
+     */
+    private static class MeteredBody extends ResponseBody {
+        private final ResponseBody body;
+        private final BufferedSource source;
+
+        MeteredBody(ResponseBody body, final EndpointMetrics metrics, final long startNs) {
+            this.body = body;
+            this.source = Okio.buffer(new ForwardingSource(body.source()) {
+                private boolean isFinished = false;
+
+                @Override
+                public long read(Buffer sink, long byteCount) throws IOException {
+                    long read;
+                    try {
+                        read = super.read(sink, byteCount);
+                    } catch (IOException e) {
+                        finish(true);
+                        throw e;
+                    }
+                    if (read == -1) {
+                        finish(false);
+                    } else {
+                        metrics.bytesReceived.addAndGet(read);
+                    }
+                    return read;
+                }
+
+                @Override
+                public void close() throws IOException {
+                    finish(false);
+                    super.close();
+                }
+
+                private void finish(boolean isFailed) {
+                    if (isFinished) return;
+                    isFinished = true;
+                    if (isFailed) {
+                        metrics.failures.incrementAndGet();
+                    }
+                    metrics.total.record(toUs(System.nanoTime() - startNs));
+                }
+            });
+        }
+
+        @Override
+        public MediaType contentType() {
+            return body.contentType();
+        }
+
+        @Override
+        public long contentLength() {
+            return body.contentLength();
+        }
+
+        @Override
+        public BufferedSource source() {
+            return source;
+        }
+    }
+}
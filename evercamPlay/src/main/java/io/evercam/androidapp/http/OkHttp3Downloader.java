@@ -0,0 +1,62 @@
+package io.evercam.androidapp.http;
+
+import android.net.Uri;
+
+import com.squareup.picasso.Downloader;
+import com.squareup.picasso.NetworkPolicy;
+
+import java.io.IOException;
+
+import okhttp3.CacheControl;
+import okhttp3.OkHttpClient;
+import okhttp3.Request;
+import okhttp3.Response;
+import okhttp3.ResponseBody;
+
+/**
+ * Picasso downloader over the {@link SharedHttpClient}, its HTTP cache serving as
+ * Picasso's disk cache
+ */
+public class OkHttp3Downloader implements Downloader {
+    private final OkHttpClient client;
+
+    public OkHttp3Downloader(OkHttpClient client) {
+        this.client = client;
+    }
+
+    @Override
+    public Response load(Uri uri, int networkPolicy) throws IOException {
+        Request.Builder builder = new Request.Builder().url(uri.toString());
+        if (networkPolicy != 0) {
+            if (NetworkPolicy.isOfflineOnly(networkPolicy)) {
+                builder.cacheControl(CacheControl.FORCE_CACHE);
+            } else {
+                CacheControl.Builder cacheControl = new CacheControl.Builder();
+                if (!NetworkPolicy.shouldReadFromDiskCache(networkPolicy)) {
+                    cacheControl.noCache();
+                }
+                if (!NetworkPolicy.shouldWriteToDiskCache(networkPolicy)) {
+                    cacheControl.noStore();
+                }
+                builder.cacheControl(cacheControl.build());
+            }
+        }
+
+        okhttp3.Response response = client.newCall(builder.build()).execute();
+        int responseCode = response.code();
+        if (responseCode >= 300) {
+            response.body().close();
+            throw new ResponseException(responseCode + " " + response.message(),
+                    networkPolicy, responseCode);
+        }
+
+        boolean isFromCache = response.cacheResponse() != null;
+        ResponseBody body = response.body();
+        return new Response(body.byteStream(), isFromCache, body.contentLength());
+    }
+
+    @Override
+    public void shutdown() {
+        //The client is shared with the rest of the app and outlives Picasso
+    }
+}
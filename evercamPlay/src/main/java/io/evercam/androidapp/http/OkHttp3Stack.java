@@ -0,0 +1,127 @@
+package io.evercam.androidapp.http;
+
+import com.android.volley.AuthFailureError;
+import com.android.volley.Request;
+import com.android.volley.toolbox.HttpStack;
+
+import org.apache.http.HttpResponse;
+import org.apache.http.ProtocolVersion;
+import org.apache.http.entity.BasicHttpEntity;
+import org.apache.http.message.BasicHeader;
+import org.apache.http.message.BasicHttpResponse;
+import org.apache.http.message.BasicStatusLine;
+
+import java.io.IOException;
+import java.util.Map;
+import java.util.concurrent.TimeUnit;
+
+import okhttp3.Headers;
+import okhttp3.MediaType;
+import okhttp3.OkHttpClient;
+import okhttp3.Protocol;
+import okhttp3.RequestBody;
+import okhttp3.Response;
+import okhttp3.ResponseBody;
+
+/**
+ * Volley transport over the {@link SharedHttpClient}, replacing HurlStack
+ */
+public class OkHttp3Stack implements HttpStack {
+    private final OkHttpClient client;
+
+    public OkHttp3Stack(OkHttpClient client) {
+        this.client = client;
+    }
+
+    @Override
+    public HttpResponse performRequest(Request<?> request, Map<String, String>
+            additionalHeaders) throws IOException, AuthFailureError {
+        int timeoutMs = request.getTimeoutMs();
+        OkHttpClient requestClient = client.newBuilder()
+                .connectTimeout(timeoutMs, TimeUnit.MILLISECONDS)
+                .readTimeout(timeoutMs, TimeUnit.MILLISECONDS)
+                .writeTimeout(timeoutMs, TimeUnit.MILLISECONDS)
+                .build();
+
+        okhttp3.Request.Builder builder = new okhttp3.Request.Builder().url(request.getUrl());
+        for (Map.Entry<String, String> header : request.getHeaders().entrySet()) {
+            builder.addHeader(header.getKey(), header.getValue());
+        }
+        for (Map.Entry<String, String> header : additionalHeaders.entrySet()) {
+            builder.addHeader(header.getKey(), header.getValue());
+        }
+        setMethod(builder, request);
+
+        Response response = requestClient.newCall(builder.build()).execute();
+
+        ProtocolVersion protocolVersion = response.protocol() == Protocol.HTTP_1_0 ? new
+                ProtocolVersion("HTTP", 1, 0) : new ProtocolVersion("HTTP", 1, 1);
+        BasicHttpResponse httpResponse = new BasicHttpResponse(new BasicStatusLine
+                (protocolVersion, response.code(), response.message()));
+        httpResponse.setEntity(toEntity(response));
+        Headers headers = response.headers();
+        for (int index = 0; index < headers.size(); index++) {
+            httpResponse.addHeader(new BasicHeader(headers.name(index), headers.value(index)));
+        }
+        return httpResponse;
+    }
+
+    private static BasicHttpEntity toEntity(Response response) {
+        BasicHttpEntity entity = new BasicHttpEntity();
+        ResponseBody body = response.body();
+        entity.setContent(body.byteStream());
+        entity.setContentLength(body.contentLength());
+        entity.setContentEncoding(response.header("Content-Encoding"));
+        if (body.contentType() != null) {
+            entity.setContentType(body.contentType().toString());
+        }
+        return entity;
+    }
+
+    @SuppressWarnings("deprecation")
+    private static void setMethod(okhttp3.Request.Builder builder, Request<?> request) throws
+            AuthFailureError {
+        switch (request.getMethod()) {
+            case Request.Method.DEPRECATED_GET_OR_POST:
+                byte[] postBody = request.getPostBody();
+                if (postBody != null) {
+                    builder.post(RequestBody.create(MediaType.parse(request
+                            .getPostBodyContentType()), postBody));
+                }
+                break;
+            case Request.Method.GET:
+                builder.get();
+                break;
+            case Request.Method.DELETE:
+                builder.delete();
+                break;
+            case Request.Method.POST:
+                builder.post(createBody(request));
+                break;
+            case Request.Method.PUT:
+                builder.put(createBody(request));
+                break;
+            case Request.Method.HEAD:
+                builder.head();
+                break;
+            case Request.Method.OPTIONS:
+                builder.method("OPTIONS", null);
+                break;
+            case Request.Method.TRACE:
+                builder.method("TRACE", null);
+                break;
+            case Request.Method.PATCH:
+                builder.patch(createBody(request));
+                break;
+            default:
+                throw new IllegalStateException("Unknown method type.");
+        }
+    }
+
+    private static RequestBody createBody(Request<?> request) throws AuthFailureError {
+        byte[] body = request.getBody();
+        //OkHttp needs a body for POST, PUT and PATCH
+        return RequestBody.create(MediaType.parse(request.getBodyContentType()), body != null ?
+                body : new byte[0]);
+    }
+}
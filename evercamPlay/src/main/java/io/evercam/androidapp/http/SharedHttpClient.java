@@ -0,0 +1,70 @@
+package io.evercam.androidapp.http;
+
+import android.content.Context;
+
+import java.io.File;
+import java.util.Arrays;
+import java.util.concurrent.TimeUnit;
+
+import okhttp3.Cache;
+import okhttp3.ConnectionPool;
+import okhttp3.Dispatcher;
+import okhttp3.OkHttpClient;
+import okhttp3.Protocol;
+
+/**
+ * The one OkHttp client of the app. Volley, Picasso, the Phoenix socket and the tasks
+ * calling Evercam or cameras directly all go through it, so they share the connection
+ * pool, dispatcher and HTTP cache, and reuse connections, DNS lookups and TLS sessions to
+ * the same hosts. HTTP/2 is used where the server supports it.
+ *
+ * Clients needing other timeouts derive from it with {@link OkHttpClient#newBuilder()},
+ * which keeps the same pool and dispatcher, and the {@link NetworkMetricsInterceptor}.
+ */
+public class SharedHttpClient {
+    private final static String CACHE_DIRECTORY = "http";
+    private final static long CACHE_SIZE_BYTES = 50 * 1024 * 1024;
+    private final static int MAX_IDLE_CONNECTIONS = 8;
+    private final static long KEEP_ALIVE_MINUTES = 5;
+    private final static int MAX_REQUESTS = 64;
+    private final static int MAX_REQUESTS_PER_HOST = 8;
+
+    private static OkHttpClient client;
+    private static OkHttpClient uncachedClient;
+
+    /**
+     * Add the disk cache, called once when the application starts
+     */
+    public static synchronized void init(Context context) {
+        File directory = new File(context.getApplicationContext().getCacheDir(),
+                CACHE_DIRECTORY);
+        client = get().newBuilder().cache(new Cache(directory, CACHE_SIZE_BYTES)).build();
+        uncachedClient = null;
+    }
+
+    public static synchronized OkHttpClient get() {
+        if (client == null) {
+            Dispatcher dispatcher = new Dispatcher();
+            dispatcher.setMaxRequests(MAX_REQUESTS);
+            dispatcher.setMaxRequestsPerHost(MAX_REQUESTS_PER_HOST);
+            client = NetworkMetricsInterceptor.install(new OkHttpClient.Builder())
+                    .connectionPool(new ConnectionPool(MAX_IDLE_CONNECTIONS, KEEP_ALIVE_MINUTES,
+                            TimeUnit.MINUTES))
+                    .dispatcher(dispatcher)
+                    .protocols(Arrays.asList(Protocol.HTTP_2, Protocol.HTTP_1_1))
+                    .build();
+        }
+        return client;
+    }
+
+    /**
+     * The shared client without the HTTP cache, for callers keeping their own cache and
+     * for live images from cameras, whose cache headers can't be trusted
+     */
+    public static synchronized OkHttpClient getUncached() {
+        if (uncachedClient == null) {
+            uncachedClient = get().newBuilder().cache(null).build();
+        }
+        return uncachedClient;
+    }
+}
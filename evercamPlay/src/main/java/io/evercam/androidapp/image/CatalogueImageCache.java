@@ -0,0 +1,203 @@
+package io.evercam.androidapp.image;
+
+import android.content.Context;
+import android.util.Log;
+import android.widget.ImageView;
+
+import com.squareup.picasso.Picasso;
+
+import java.io.File;
+import java.io.FileOutputStream;
+import java.io.IOException;
+import java.io.InputStream;
+import java.io.OutputStream;
+import java.util.Collection;
+import java.util.HashSet;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+
+import io.evercam.Model;
+import io.evercam.Vendor;
+import io.evercam.androidapp.http.SharedHttpClient;
+import okhttp3.OkHttpClient;
+import okhttp3.Request;
+import okhttp3.Response;
+
+/**
+ * Disk cache of vendor logos and model thumbnails, keyed by vendor and model id.
+ *
+ * These images never change for an id, so once downloaded they are kept without expiry
+ * and loaded from disk by Picasso. Screens that list vendors or models prefetch them in
+ * a batch on a small thread pool, so selecting an item or scrolling a list doesn't wait
+ * for a per-item download.
+ */
+public class CatalogueImageCache {
+    private final static String TAG = "CatalogueImageCache";
+    private final static String CACHE_DIR = "catalogue_images";
+    private final static String TEMP_SUFFIX = ".tmp";
+    private final static int PREFETCH_THREADS = 4;
+
+    private static CatalogueImageCache instance;
+
+    private final File cacheDir;
+    private final OkHttpClient httpClient = SharedHttpClient.getUncached();
+    private final ExecutorService prefetchExecutor = Executors.newFixedThreadPool(PREFETCH_THREADS);
+    /* Keys being downloaded, and keys that failed this session so they aren't retried */
+    private final HashSet<String> pendingKeys = new HashSet<>();
+    private final HashSet<String> failedKeys = new HashSet<>();
+
+    public static synchronized CatalogueImageCache getInstance(Context context) {
+        if (instance == null) {
+            instance = new CatalogueImageCache(new File(context.getApplicationContext()
+                    .getFilesDir(), CACHE_DIR));
+        }
+        return instance;
+    }
+
+    private CatalogueImageCache(File cacheDir) {
+        this.cacheDir = cacheDir;
+        if (!cacheDir.exists() && !cacheDir.mkdirs()) {
+            Log.e(TAG, "Failed to create " + cacheDir.getPath());
+        }
+    }
+
+    /**
+     * @return the cached logo of the vendor, or null if it isn't downloaded yet
+     */
+    public File getCachedLogo(String vendorId) {
+        return getCachedFile(getLogoKey(vendorId));
+    }
+
+    /**
+     * @return the cached thumbnail of the model, or null if it isn't downloaded yet
+     */
+    public File getCachedThumbnail(String vendorId, String modelId) {
+        return getCachedFile(getThumbnailKey(vendorId, modelId));
+    }
+
+    public void prefetchLogos(Collection<String> vendorIds) {
+        for (String vendorId : vendorIds) {
+            prefetch(getLogoKey(vendorId), Vendor.getLogoUrl(vendorId));
+        }
+    }
+
+    public void prefetchThumbnails(String vendorId, Collection<String> modelIds) {
+        for (String modelId : modelIds) {
+            prefetch(getThumbnailKey(vendorId, modelId), Model.getThumbnailUrl(vendorId, modelId));
+        }
+    }
+
+    /**
+     * Return the model thumbnail from disk, downloading it first if necessary.
+     * Blocks, so only call it off the main thread.
+     *
+     * @return the cached thumbnail, or null if it couldn't be downloaded
+     */
+    public File fetchThumbnail(String vendorId, String modelId) {
+        String key = getThumbnailKey(vendorId, modelId);
+        File file = getCachedFile(key);
+        if (file == null) {
+            file = download(key, Model.getThumbnailUrl(vendorId, modelId));
+        }
+        return file;
+    }
+
+    public void loadLogo(Context context, ImageView imageView, String vendorId) {
+        File file = getCachedLogo(vendorId);
+        if (file != null) {
+            Picasso.with(context).load(file).placeholder(android.R.color.transparent)
+                    .into(imageView);
+        } else {
+            Picasso.with(context).load(Vendor.getLogoUrl(vendorId))
+                    .placeholder(android.R.color.transparent).into(imageView);
+            prefetch(getLogoKey(vendorId), Vendor.getLogoUrl(vendorId));
+        }
+    }
+
+    public void loadThumbnail(Context context, ImageView imageView, String vendorId,
+                              String modelId, int placeholderResId) {
+        File file = getCachedThumbnail(vendorId, modelId);
+        if (file != null) {
+            Picasso.with(context).load(file).placeholder(placeholderResId).into(imageView);
+        } else {
+            String url = Model.getThumbnailUrl(vendorId, modelId);
+            Picasso.with(context).load(url).placeholder(placeholderResId).into(imageView);
+            prefetch(getThumbnailKey(vendorId, modelId), url);
+        }
+    }
+
+    private void prefetch(final String key, final String url) {
+        synchronized (this) {
+            if (pendingKeys.contains(key) || failedKeys.contains(key)) return;
+            if (getCachedFile(key) != null) return;
+            pendingKeys.add(key);
+        }
+
+        prefetchExecutor.execute(new Runnable() {
+            @Override
+            public void run() {
+                download(key, url);
+            }
+        });
+    }
+
+    private File download(String key, String url) {
+        File file = new File(cacheDir, key);
+        File tempFile = new File(cacheDir, key + TEMP_SUFFIX + Thread.currentThread().getId());
+        Response response = null;
+        try {
+            response = httpClient.newCall(new Request.Builder().url(url).build()).execute();
+            if (!response.isSuccessful()) {
+                throw new IOException("HTTP " + response.code() + " for " + url);
+            }
+
+            InputStream inputStream = response.body().byteStream();
+            OutputStream outputStream = new FileOutputStream(tempFile);
+            try {
+                byte[] buffer = new byte[8192];
+                int length;
+                while ((length = inputStream.read(buffer)) != -1) {
+                    outputStream.write(buffer, 0, length);
+                }
+            } finally {
+                outputStream.close();
+            }
+
+            if (tempFile.length() == 0 || !tempFile.renameTo(file)) {
+                throw new IOException("Failed to save " + url);
+            }
+            return file;
+        } catch (IOException | IllegalArgumentException e) {
+            Log.e(TAG, e.toString());
+            synchronized (this) {
+                failedKeys.add(key);
+            }
+            tempFile.delete();
+            return null;
+        } finally {
+            if (response != null) {
+                response.close();
+            }
+            synchronized (this) {
+                pendingKeys.remove(key);
+            }
+        }
+    }
+
+    private File getCachedFile(String key) {
+        File file = new File(cacheDir, key);
+        return file.exists() ? file : null;
+    }
+
+    private static String getLogoKey(String vendorId) {
+        return "logo_" + toFileName(vendorId);
+    }
+
+    private static String getThumbnailKey(String vendorId, String modelId) {
+        return "thumbnail_" + toFileName(vendorId) + "_" + toFileName(modelId);
+    }
+
+    private static String toFileName(String id) {
+        return id.replaceAll("[^A-Za-z0-9_-]", "_");
+    }
+}
@@ -2,16 +2,29 @@ package io.evercam.androidapp.image;
 
 import android.content.Context;
 import android.graphics.Bitmap;
+import android.util.LruCache;
 import android.view.View;
 import android.widget.ImageView;
 
+import com.android.volley.AuthFailureError;
 import com.android.volley.Response;
 import com.android.volley.VolleyError;
 import com.android.volley.toolbox.ImageRequest;
 
+import java.util.HashMap;
+import java.util.Map;
+
 import io.evercam.androidapp.utils.Commons;
 
 public class VolleyRequest {
+    /* Decoded images by URL, up to an eighth of the heap */
+    private static final LruCache<String, Bitmap> imageCache = new LruCache<String, Bitmap>(
+            (int) (Runtime.getRuntime().maxMemory() / 1024 / 8)) {
+        @Override
+        protected int sizeOf(String key, Bitmap bitmap) {
+            return bitmap.getByteCount() / 1024;
+        }
+    };
 
     /**
      * Load image using Valley, and handle the image response listener
@@ -20,8 +33,16 @@ public class VolleyRequest {
      * @param imageUrl image URL
      * @param view Any view with equivalent size of the image view for decoding image
      * @param listener Implement {@link ImageResponseListener} to handle callback for valid/error image
+     *
+     * An image loaded before is passed to the listener straight away, and again when the
+     * fresh one arrives.
      */
-    public static void loadImage(Context context, String imageUrl, final View view, final ImageResponseListener listener) {
+    public static void loadImage(Context context, final String imageUrl, final View view, final ImageResponseListener listener) {
+        Bitmap cachedBitmap = imageCache.get(imageUrl);
+        if (cachedBitmap != null) {
+            listener.onValidImage(cachedBitmap);
+        }
+
         /**
          * Volley ImageLoader
          */
@@ -30,6 +51,7 @@ public class VolleyRequest {
                 new Response.Listener<Bitmap>() {
                     @Override
                     public void onResponse(Bitmap bitmap) {
+                        imageCache.put(imageUrl, bitmap);
                         listener.onValidImage(bitmap);
                     }
                 }, view.getWidth(), view.getHeight(), ImageView.ScaleType.CENTER_CROP, Bitmap.Config.RGB_565,
@@ -49,4 +71,65 @@ public class VolleyRequest {
         VolleySingleton.getInstance(context).addToRequestQueue(imageRequest);
     }
 
-}
\ No newline at end of file
+    /**
+     * Load a still image straight from the camera, falling back to the image at
+     * fallbackUrl if the camera doesn't return one. Both are cached under fallbackUrl,
+     * so either is shown straight away next time.
+     *
+     * @param authorization value of the Authorization header for the camera, or null
+     * @param onFailed called when the camera request failed, before the fallback
+     */
+    public static void loadCameraImage(final Context context, String imageUrl,
+                                       final String authorization, final String fallbackUrl,
+                                       final View view, final ImageResponseListener listener,
+                                       final Runnable onFailed) {
+        Bitmap cachedBitmap = imageCache.get(fallbackUrl);
+        if (cachedBitmap != null) {
+            listener.onValidImage(cachedBitmap);
+        }
+
+        ImageRequest imageRequest = new ImageRequest(imageUrl,
+                new Response.Listener<Bitmap>() {
+                    @Override
+                    public void onResponse(Bitmap bitmap) {
+                        imageCache.put(fallbackUrl, bitmap);
+                        listener.onValidImage(bitmap);
+                    }
+                }, view.getWidth(), view.getHeight(), ImageView.ScaleType.CENTER_CROP, Bitmap.Config.RGB_565,
+                new Response.ErrorListener() {
+                    public void onErrorResponse(VolleyError error) {
+                        if (onFailed != null) {
+                            onFailed.run();
+                        }
+                        loadImage(context, fallbackUrl, view, listener);
+                    }
+                }) {
+            @Override
+            public Map<String, String> getHeaders() throws AuthFailureError {
+                if (authorization == null) return super.getHeaders();
+                HashMap<String, String> headers = new HashMap<>(super.getHeaders());
+                headers.put("Authorization", authorization);
+                return headers;
+            }
+        };
+        VolleySingleton.getInstance(context).addToRequestQueue(imageRequest);
+    }
+
+    /**
+     * Load an image into the cache only, so a later {@link #loadImage} shows it at once
+     */
+    public static void prefetchImage(Context context, final String imageUrl, int maxWidth,
+                                     int maxHeight) {
+        if (imageCache.get(imageUrl) != null) return;
+
+        ImageRequest imageRequest = new ImageRequest(imageUrl,
+                new Response.Listener<Bitmap>() {
+                    @Override
+                    public void onResponse(Bitmap bitmap) {
+                        imageCache.put(imageUrl, bitmap);
+                    }
+                }, maxWidth, maxHeight, ImageView.ScaleType.CENTER_CROP, Bitmap.Config.RGB_565,
+                null);
+        VolleySingleton.getInstance(context).addToRequestQueue(imageRequest);
+    }
+}
@@ -6,6 +6,9 @@ import com.android.volley.Request;
 import com.android.volley.RequestQueue;
 import com.android.volley.toolbox.Volley;
 
+import io.evercam.androidapp.http.OkHttp3Stack;
+import io.evercam.androidapp.http.SharedHttpClient;
+
 /**
  * Singleton class that encapsulates RequestQueue
  */
@@ -30,7 +33,10 @@ public class VolleySingleton {
         if (mRequestQueue == null) {
             // getApplicationContext() is key, it keeps you from leaking the
             // Activity or BroadcastReceiver if someone passes one in.
-            mRequestQueue = Volley.newRequestQueue(mContext.getApplicationContext());
+            // Volley keeps its own disk cache, so it shares the connection pool but not the
+            // HTTP cache
+            mRequestQueue = Volley.newRequestQueue(mContext.getApplicationContext(), new
+                    OkHttp3Stack(SharedHttpClient.getUncached()));
         }
         return mRequestQueue;
     }
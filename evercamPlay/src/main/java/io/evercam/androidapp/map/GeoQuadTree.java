@@ -0,0 +1,133 @@
+package io.evercam.androidapp.map;
+
+import java.util.ArrayList;
+import java.util.List;
+
+/**
+ * Point quadtree over latitude/longitude, so the items inside the visible map region
+ * can be found without scanning every item.
+ *
+ * Leaves split into four when they hold more than NODE_CAPACITY items, down to
+ * MAX_DEPTH where items at the same spot are kept together.
+ */
+public class GeoQuadTree<T extends GeoQuadTree.Item> {
+    private final static int NODE_CAPACITY = 16;
+    private final static int MAX_DEPTH = 20;
+
+    public interface Item {
+        double getLatitude();
+
+        double getLongitude();
+    }
+
+    private final Node root = new Node(-90, -180, 90, 180, 0);
+    private int size = 0;
+
+    private class Node {
+        final double south;
+        final double west;
+        final double north;
+        final double east;
+        final int depth;
+        ArrayList<T> items = new ArrayList<>();
+        /* South west, south east, north west, north east, or null for a leaf */
+        ArrayList<Node> children;
+
+        Node(double south, double west, double north, double east, int depth) {
+            this.south = south;
+            this.west = west;
+            this.north = north;
+            this.east = east;
+            this.depth = depth;
+        }
+
+        void insert(T item) {
+            if (children != null) {
+                getChild(item).insert(item);
+                return;
+            }
+
+            items.add(item);
+            if (items.size() > NODE_CAPACITY && depth < MAX_DEPTH) {
+                split();
+            }
+        }
+
+        void split() {
+            double middleLatitude = (south + north) / 2;
+            double middleLongitude = (west + east) / 2;
+            children = new ArrayList<>(4);
+            children.add(new Node(south, west, middleLatitude, middleLongitude, depth + 1));
+            children.add(new Node(south, middleLongitude, middleLatitude, east, depth + 1));
+            children.add(new Node(middleLatitude, west, north, middleLongitude, depth + 1));
+            children.add(new Node(middleLatitude, middleLongitude, north, east, depth + 1));
+
+            ArrayList<T> splitItems = items;
+            items = null;
+            for (T item : splitItems) {
+                getChild(item).insert(item);
+            }
+        }
+
+        Node getChild(T item) {
+            int index = item.getLatitude() >= (south + north) / 2 ? 2 : 0;
+            if (item.getLongitude() >= (west + east) / 2) {
+                index++;
+            }
+            return children.get(index);
+        }
+
+        void query(double querySouth, double queryWest, double queryNorth, double queryEast,
+                   List<T> result) {
+            if (querySouth > north || queryNorth < south || queryWest > east || queryEast < west) {
+                return;
+            }
+
+            if (children != null) {
+                for (Node child : children) {
+                    child.query(querySouth, queryWest, queryNorth, queryEast, result);
+                }
+                return;
+            }
+
+            for (T item : items) {
+                if (item.getLatitude() >= querySouth && item.getLatitude() <= queryNorth
+                        && item.getLongitude() >= queryWest && item.getLongitude() <= queryEast) {
+                    result.add(item);
+                }
+            }
+        }
+    }
+
+    /**
+     * Add an item, ignored if its coordinate is out of range
+     */
+    public void add(T item) {
+        if (!isValid(item.getLatitude(), item.getLongitude())) return;
+
+        root.insert(item);
+        size++;
+    }
+
+    public int size() {
+        return size;
+    }
+
+    /**
+     * @return the items inside the box, which crosses the antimeridian if west > east
+     */
+    public List<T> query(double south, double west, double north, double east) {
+        ArrayList<T> result = new ArrayList<>();
+        if (west <= east) {
+            root.query(south, west, north, east, result);
+        } else {
+            root.query(south, west, north, 180, result);
+            root.query(south, -180, north, east, result);
+        }
+        return result;
+    }
+
+    private static boolean isValid(double latitude, double longitude) {
+        return latitude >= -90 && latitude <= 90 && longitude >= -180 && longitude <= 180;
+    }
+}
@@ -0,0 +1,91 @@
+package io.evercam.androidapp.map;
+
+import java.util.ArrayList;
+import java.util.LinkedHashMap;
+import java.util.List;
+
+/**
+ * Groups map items that would be drawn close together at a zoom level.
+ *
+ * Items are projected to Web Mercator pixels at the zoom level and bucketed into square
+ * cells of cellSizePx, each non-empty cell becoming one cluster. A cell covers the same
+ * area for a whole zoom level, so clusters stay put while panning.
+ */
+public class MarkerClusterer {
+    private final static int TILE_SIZE = 256;
+    /* Mercator is undefined at the poles */
+    private final static double MAX_LATITUDE = 85.05112878;
+
+    public static class Cluster<T extends GeoQuadTree.Item> {
+        private final long cellKey;
+        private final ArrayList<T> items = new ArrayList<>();
+        private double latitudeSum = 0;
+        private double longitudeSum = 0;
+
+        Cluster(long cellKey) {
+            this.cellKey = cellKey;
+        }
+
+        void add(T item) {
+            items.add(item);
+            latitudeSum += item.getLatitude();
+            longitudeSum += item.getLongitude();
+        }
+
+        /**
+         * @return the cell of the cluster, unique within a zoom level
+         */
+        public long getCellKey() {
+            return cellKey;
+        }
+
+        public List<T> getItems() {
+            return items;
+        }
+
+        public int size() {
+            return items.size();
+        }
+
+        public boolean isSingle() {
+            return items.size() == 1;
+        }
+
+        public double getLatitude() {
+            return latitudeSum / items.size();
+        }
+
+        public double getLongitude() {
+            return longitudeSum / items.size();
+        }
+    }
+
+    public static <T extends GeoQuadTree.Item> List<Cluster<T>> cluster(List<T> items, int zoom,
+                                                                       int cellSizePx) {
+        double worldSize = TILE_SIZE * Math.pow(2, zoom);
+        LinkedHashMap<Long, Cluster<T>> clusters = new LinkedHashMap<>();
+        for (T item : items) {
+            long column = (long) Math.floor(getX(item.getLongitude(), worldSize) / cellSizePx);
+            long row = (long) Math.floor(getY(item.getLatitude(), worldSize) / cellSizePx);
+            long cellKey = (row << 32) | (column & 0xFFFFFFFFL);
+
+            Cluster<T> cluster = clusters.get(cellKey);
+            if (cluster == null) {
+                cluster = new Cluster<>(cellKey);
+                clusters.put(cellKey, cluster);
+            }
+            cluster.add(item);
+        }
+        return new ArrayList<>(clusters.values());
+    }
+
+    static double getX(double longitude, double worldSize) {
+        return (longitude + 180) / 360 * worldSize;
+    }
+
+    static double getY(double latitude, double worldSize) {
+        double clamped = Math.max(-MAX_LATITUDE, Math.min(MAX_LATITUDE, latitude));
+        double sin = Math.sin(Math.toRadians(clamped));
+        return (0.5 - Math.log((1 + sin) / (1 - sin)) / (4 * Math.PI)) * worldSize;
+    }
+}
@@ -0,0 +1,187 @@
+package io.evercam.androidapp.photoview;
+
+import android.content.ContentResolver;
+import android.content.Context;
+import android.provider.MediaStore;
+import android.util.Log;
+
+import java.io.File;
+import java.util.ArrayList;
+import java.util.HashMap;
+import java.util.HashSet;
+import java.util.List;
+import java.util.Map;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+
+import io.evercam.androidapp.dal.DbSnapshot;
+import io.evercam.androidapp.dto.SavedSnapshot;
+import io.evercam.androidapp.utils.PrefsManager;
+
+/**
+ * Enforces the snapshot storage quotas from settings, both per camera and in total,
+ * by evicting the oldest or least viewed snapshots.
+ *
+ * Runs on a single background thread so that compactions never overlap. Sizes come
+ * from the snapshot index in {@link DbSnapshot}, so the snapshot folders are only
+ * scanned once to backfill the index for snapshots saved before it existed. The
+ * backfill is tracked in preferences rather than inferred from an empty index, because
+ * the snapshot that triggered the first compaction is already indexed by then.
+ */
+public class SnapshotCompactor implements Runnable {
+    private final static String TAG = "SnapshotCompactor";
+
+    /* SQLite allows at most 999 bound arguments in a single statement */
+    private final static int MEDIA_STORE_DELETE_BATCH_SIZE = 200;
+
+    private final static ExecutorService EXECUTOR = Executors.newSingleThreadExecutor();
+
+    private final Context context;
+
+    public SnapshotCompactor(Context context) {
+        this.context = context.getApplicationContext();
+    }
+
+    public static void launch(Context context) {
+        EXECUTOR.execute(new SnapshotCompactor(context));
+    }
+
+    @Override
+    public void run() {
+        try {
+            DbSnapshot dbSnapshot = new DbSnapshot(context);
+            //Retried on the next compaction if the folders couldn't be read, e.g. before the
+            //storage permission is granted
+            if (!PrefsManager.isSnapshotIndexBackfilled(context) && backfillIndex(dbSnapshot)) {
+                PrefsManager.setSnapshotIndexBackfilled(context);
+            }
+
+            compact(dbSnapshot, PrefsManager.getSnapshotQuotaBytes(context),
+                    PrefsManager.getSnapshotCameraQuotaBytes(context), getEvictionOrder());
+        } catch (Exception e) {
+            Log.e(TAG, "Snapshot compaction failed: " + e.toString());
+        }
+    }
+
+    private DbSnapshot.EvictionOrder getEvictionOrder() {
+        String eviction = PrefsManager.getSnapshotEviction(context);
+        if (eviction.equals(PrefsManager.VALUE_EVICTION_LEAST_VIEWED)) {
+            return DbSnapshot.EvictionOrder.LEAST_VIEWED;
+        }
+        return DbSnapshot.EvictionOrder.OLDEST;
+    }
+
+    private void compact(DbSnapshot dbSnapshot, long quotaBytes, long cameraQuotaBytes,
+                         DbSnapshot.EvictionOrder order) {
+        if (quotaBytes <= 0 && cameraQuotaBytes <= 0) return;
+
+        HashMap<String, Long> sizeByCamera = dbSnapshot.getSizeByCamera();
+        HashSet<String> evictedPaths = new HashSet<>();
+        ArrayList<String> pathsToDelete = new ArrayList<>();
+
+        if (cameraQuotaBytes > 0) {
+            for (Map.Entry<String, Long> entry : sizeByCamera.entrySet()) {
+                long cameraSize = entry.getValue();
+                if (cameraSize <= cameraQuotaBytes) continue;
+
+                for (SavedSnapshot snapshot : dbSnapshot.getEvictionCandidates(entry.getKey(),
+                        order)) {
+                    if (cameraSize <= cameraQuotaBytes) break;
+                    cameraSize -= snapshot.getSize();
+                    evictedPaths.add(snapshot.getPath());
+                    pathsToDelete.add(snapshot.getPath());
+                }
+                entry.setValue(cameraSize);
+            }
+        }
+
+        if (quotaBytes > 0) {
+            long totalSize = 0;
+            for (long cameraSize : sizeByCamera.values()) {
+                totalSize += cameraSize;
+            }
+
+            if (totalSize > quotaBytes) {
+                for (SavedSnapshot snapshot : dbSnapshot.getEvictionCandidates(null, order)) {
+                    if (totalSize <= quotaBytes) break;
+                    if (evictedPaths.contains(snapshot.getPath())) continue;
+                    totalSize -= snapshot.getSize();
+                    pathsToDelete.add(snapshot.getPath());
+                }
+            }
+        }
+
+        if (!pathsToDelete.isEmpty()) {
+            Log.d(TAG, "Evicting " + pathsToDelete.size() + " snapshots");
+            deleteSnapshots(context, pathsToDelete);
+        }
+    }
+
+    /**
+     * Delete snapshot files and remove them from both the snapshot index and
+     * MediaStore using batched statements.
+     */
+    public static void deleteSnapshots(Context context, List<String> paths) {
+        for (String path : paths) {
+            File file = new File(path);
+            if (file.exists() && !file.delete()) {
+                Log.e(TAG, "Failed to delete " + path);
+            }
+        }
+
+        new DbSnapshot(context).deleteSnapshots(paths);
+
+        ContentResolver contentResolver = context.getContentResolver();
+        for (int start = 0; start < paths.size(); start += MEDIA_STORE_DELETE_BATCH_SIZE) {
+            List<String> batch = paths.subList(start, Math.min(paths.size(),
+                    start + MEDIA_STORE_DELETE_BATCH_SIZE));
+
+            StringBuilder selection = new StringBuilder(MediaStore.Images.Media.DATA + " IN (");
+            for (int index = 0; index < batch.size(); index++) {
+                selection.append(index == 0 ? "?" : ",?");
+            }
+            selection.append(")");
+
+            try {
+                contentResolver.delete(MediaStore.Images.Media.EXTERNAL_CONTENT_URI,
+                        selection.toString(), batch.toArray(new String[batch.size()]));
+            } catch (Exception e) {
+                Log.e(TAG, "MediaStore delete failed: " + e.toString());
+            }
+        }
+    }
+
+    /**
+     * Index the snapshots that were saved before the snapshot index existed
+     *
+     * @return false if the snapshot folder couldn't be listed
+     */
+    private boolean backfillIndex(DbSnapshot dbSnapshot) {
+        File playFolder = new File(SnapshotManager.getPlayFolderPath());
+        File[] cameraFolders = playFolder.listFiles();
+        if (cameraFolders == null) {
+            //Missing or unreadable, e.g. without the storage permission
+            Log.e(TAG, "Unable to list " + playFolder.getPath() + ", backfill postponed");
+            return false;
+        }
+
+        ArrayList<SavedSnapshot> snapshots = new ArrayList<>();
+        for (File cameraFolder : cameraFolders) {
+            File[] files = cameraFolder.listFiles();
+            if (!cameraFolder.isDirectory() || files == null) continue;
+
+            for (File file : files) {
+                if (file.isFile()) {
+                    snapshots.add(new SavedSnapshot(file.getPath(), cameraFolder.getName(),
+                            file.length(), file.lastModified()));
+                }
+            }
+        }
+
+        if (!snapshots.isEmpty()) {
+            Log.d(TAG, "Backfilled " + snapshots.size() + " snapshots into index");
+            dbSnapshot.addSnapshots(snapshots);
+        }
+        return true;
+    }
+}
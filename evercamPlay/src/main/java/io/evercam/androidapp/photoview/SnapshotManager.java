@@ -1,6 +1,7 @@
 package io.evercam.androidapp.photoview;
 
 import android.app.Activity;
+import android.content.Context;
 import android.content.Intent;
 import android.media.MediaScannerConnection;
 import android.net.Uri;
@@ -16,6 +17,8 @@ import java.util.Collections;
 import io.evercam.androidapp.R;
 import io.evercam.androidapp.custom.CustomSnackbar;
 import io.evercam.androidapp.custom.CustomToast;
+import io.evercam.androidapp.dal.DbSnapshot;
+import io.evercam.androidapp.dto.SavedSnapshot;
 
 public class SnapshotManager {
     private final static String TAG = "SnapshotManager";
@@ -79,6 +82,43 @@ public class SnapshotManager {
         }
     }
 
+    /**
+     * Record a newly saved snapshot in the snapshot index and enforce the storage quotas.
+     * Should be called from a background thread.
+     */
+    public static void addToIndex(Context context, String path, String cameraId) {
+        File file = new File(path);
+        new DbSnapshot(context).addSnapshot(new SavedSnapshot(path, cameraId, file.length(),
+                System.currentTimeMillis()));
+        SnapshotCompactor.launch(context);
+    }
+
+    /**
+     * Count a view of the snapshot, used by the least viewed eviction policy
+     */
+    public static void markViewed(Context context, final String path) {
+        final Context appContext = context.getApplicationContext();
+        new Thread(new Runnable() {
+            @Override
+            public void run() {
+                new DbSnapshot(appContext).markViewed(path);
+            }
+        }).start();
+    }
+
+    /**
+     * Remove a snapshot deleted by the user from the snapshot index and MediaStore
+     */
+    public static void removeFromIndex(Context context, final String path) {
+        final Context appContext = context.getApplicationContext();
+        new Thread(new Runnable() {
+            @Override
+            public void run() {
+                SnapshotCompactor.deleteSnapshots(appContext, Collections.singletonList(path));
+            }
+        }).start();
+    }
+
     private static String fileType(FileType fileType) {
         if (fileType.equals(FileType.PNG)) {
             return ".png";
@@ -126,6 +166,7 @@ public class SnapshotManager {
             try {
                 connection.scanFile(imagePath, null);
             } catch (java.lang.IllegalStateException e) {
+                Log.e(TAG, e.toString());
             }
         }
 
@@ -51,6 +51,9 @@ public class ViewPagerActivity extends ParentAppCompatActivity {
         mViewPager.setAdapter(mViewPagerAdapter);
 
         updateTitleWithPage(1); //Initial title as 1 of total pages
+        if (!mImagePathList.isEmpty()) {
+            SnapshotManager.markViewed(this, mImagePathList.get(0));
+        }
 
         mViewPager.addOnPageChangeListener(new ViewPager.OnPageChangeListener() {
             @Override
@@ -61,6 +64,7 @@ public class ViewPagerActivity extends ParentAppCompatActivity {
             @Override
             public void onPageSelected(int position) {
                 updateTitleWithPage(position + 1);
+                SnapshotManager.markViewed(ViewPagerActivity.this, mImagePathList.get(position));
             }
 
             @Override
@@ -86,6 +90,7 @@ public class ViewPagerActivity extends ParentAppCompatActivity {
                         File imageFile = new File(currentPath);
                         boolean isDeleted = imageFile.delete();
                         if (isDeleted) {
+                            SnapshotManager.removeFromIndex(ViewPagerActivity.this, currentPath);
                             updateViewAfterDelete(currentPosition);
                             showSnapshotDeletedSnackbar();
                         }
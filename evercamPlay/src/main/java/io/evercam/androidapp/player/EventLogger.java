@@ -58,7 +58,7 @@ import java.util.concurrent.CopyOnWriteArrayList;
 /* package */public final class EventLogger implements ExoPlayer.EventListener,
         AudioRendererEventListener, VideoRendererEventListener, AdaptiveMediaSourceEventListener,
         ExtractorMediaSource.EventListener, DefaultDrmSessionManager.EventListener,
-        MetadataRenderer.Output {
+        MetadataRenderer.Output, LiveEdgeController.SeekListener {
 
   private static final String TAG = "EventLogger";
   private static final int MAX_TIMELINE_ITEM_LINES = 3;
@@ -73,7 +73,10 @@ import java.util.concurrent.CopyOnWriteArrayList;
   private final MappingTrackSelector trackSelector;
   private final Timeline.Window window;
   private final Timeline.Period period;
-  private final long startTimeMs;
+  private long startTimeMs;
+  private long startupTimeMs = C.TIME_UNSET;
+  private long liveEdgeOffsetMs = C.TIME_UNSET;
+  private PlaybackMetrics metrics;
 
   private final CopyOnWriteArrayList<Listener> listeners;
 
@@ -90,6 +93,8 @@ import java.util.concurrent.CopyOnWriteArrayList;
 
     void onVideoSizeChanged(int width, int height, int unappliedRotationDegrees,
                             float pixelWidthHeightRatio);
+
+    void onRenderedFirstFrame();
   }
 
 
@@ -99,6 +104,7 @@ import java.util.concurrent.CopyOnWriteArrayList;
     window = new Timeline.Window();
     period = new Timeline.Period();
     startTimeMs = SystemClock.elapsedRealtime();
+    metrics = new PlaybackMetrics(startTimeMs);
 
     listeners = new CopyOnWriteArrayList<>();
   }
@@ -114,6 +120,7 @@ import java.util.concurrent.CopyOnWriteArrayList;
   public void onPlayerStateChanged(boolean playWhenReady, int state) {
     Log.d(TAG, "state [" + getSessionTimeString() + ", " + playWhenReady + ", "
             + getStateString(state) + "]");
+    metrics.onStateChanged(playWhenReady, state, SystemClock.elapsedRealtime());
   }
 
   @Override
@@ -289,6 +296,7 @@ import java.util.concurrent.CopyOnWriteArrayList;
   @Override
   public void onDroppedFrames(int count, long elapsed) {
     Log.d(TAG, "droppedFrames [" + getSessionTimeString() + ", " + count + "]");
+    metrics.onDroppedFrames(count);
   }
 
   @Override
@@ -302,7 +310,58 @@ import java.util.concurrent.CopyOnWriteArrayList;
 
   @Override
   public void onRenderedFirstFrame(Surface surface) {
-    // Do nothing.
+    metrics.onFirstFrameRendered(SystemClock.elapsedRealtime());
+    if (startupTimeMs == C.TIME_UNSET) {
+      startupTimeMs = SystemClock.elapsedRealtime() - startTimeMs;
+      Log.d(TAG, "startupTime [" + getTimeString(startupTimeMs) + "]");
+    }
+    for (Listener listener : listeners) {
+      listener.onRenderedFirstFrame();
+    }
+  }
+
+  /**
+   * Restart the startup timer when the player is reused for another media source.
+   */
+  public void startSession() {
+    startTimeMs = SystemClock.elapsedRealtime();
+    startupTimeMs = C.TIME_UNSET;
+    liveEdgeOffsetMs = C.TIME_UNSET;
+    metrics = new PlaybackMetrics(startTimeMs);
+  }
+
+  /**
+   * @return QoE metrics of the current session
+   */
+  public PlaybackMetrics getMetrics() {
+    return metrics;
+  }
+
+  // LiveEdgeController
+
+  public void onLiveEdgeOffset(long offsetMs) {
+    liveEdgeOffsetMs = offsetMs;
+    Log.d(TAG, "liveEdgeOffset [" + getSessionTimeString() + ", " + getTimeString(offsetMs) + "]");
+  }
+
+  @Override
+  public void onLiveEdgeSeek() {
+    Log.d(TAG, "liveEdgeSeek [" + getSessionTimeString() + "]");
+    metrics.onSeek();
+  }
+
+  /**
+   * @return time from player creation or the last session start to the first rendered frame, C.TIME_UNSET if not rendered yet
+   */
+  public long getStartupTimeMs() {
+    return startupTimeMs;
+  }
+
+  /**
+   * @return the latest reported live edge offset, C.TIME_UNSET if unknown
+   */
+  public long getLiveEdgeOffsetMs() {
+    return liveEdgeOffsetMs;
   }
 
   // DefaultDrmSessionManager.EventListener
@@ -349,6 +408,7 @@ import java.util.concurrent.CopyOnWriteArrayList;
                           long mediaEndTimeMs, long elapsedRealtimeMs, long loadDurationMs, long bytesLoaded,
                           IOException error, boolean wasCanceled) {
     printInternalError("loadError", error);
+    metrics.onLoadError();
   }
 
   @Override
@@ -362,7 +422,10 @@ import java.util.concurrent.CopyOnWriteArrayList;
   public void onLoadCompleted(DataSpec dataSpec, int dataType, int trackType, Format trackFormat,
                               int trackSelectionReason, Object trackSelectionData, long mediaStartTimeMs,
                               long mediaEndTimeMs, long elapsedRealtimeMs, long loadDurationMs, long bytesLoaded) {
-    // Do nothing.
+    //Preloaded and cached segments say nothing about the network
+    if (dataType == C.DATA_TYPE_MEDIA && !LocalLoads.remove(dataSpec.uri.toString())) {
+      metrics.onLoadCompleted(bytesLoaded, loadDurationMs);
+    }
   }
 
   @Override
@@ -373,7 +436,9 @@ import java.util.concurrent.CopyOnWriteArrayList;
   @Override
   public void onDownstreamFormatChanged(int trackType, Format trackFormat, int trackSelectionReason,
                                         Object trackSelectionData, long mediaTimeMs) {
-    // Do nothing.
+    if (trackType != C.TRACK_TYPE_AUDIO) {
+      metrics.onVideoFormatChanged(trackFormat);
+    }
   }
 
   // Internal methods
@@ -0,0 +1,103 @@
+package io.evercam.androidapp.player;
+
+import android.annotation.TargetApi;
+import android.graphics.Bitmap;
+import android.os.Build;
+import android.os.Handler;
+import android.os.HandlerThread;
+import android.os.Looper;
+import android.util.Log;
+import android.view.PixelCopy;
+import android.view.Surface;
+import android.view.TextureView;
+
+/**
+ * Captures the current video frame without blocking playback.
+ *
+ * On Android 7.0+ the frame is copied from the player's output surface with PixelCopy,
+ * which reads the last rendered frame on the render thread and reports back on a
+ * background thread. Older versions fall back to TextureView.getBitmap at the
+ * requested size, which has to run on the UI thread but is cheap for small sizes.
+ *
+ * The callback is always invoked on the main thread, with null if nothing was captured.
+ */
+public class FrameCapture {
+    private final static String TAG = "FrameCapture";
+
+    private static HandlerThread captureThread;
+    private static final Handler mainHandler = new Handler(Looper.getMainLooper());
+
+    public interface Callback {
+        void onFrameCaptured(Bitmap bitmap);
+    }
+
+    /**
+     * @param textureView the view the player renders to, used for the frame size and fallback
+     * @param surface     the player's output surface
+     * @param maxWidth    the maximum width of the captured frame, 0 for the full view size
+     */
+    public static void capture(final TextureView textureView, Surface surface, int maxWidth,
+                               final Callback callback) {
+        int viewWidth = textureView.getWidth();
+        int viewHeight = textureView.getHeight();
+        if (viewWidth <= 0 || viewHeight <= 0) {
+            callback.onFrameCaptured(null);
+            return;
+        }
+
+        final int width = maxWidth > 0 ? Math.min(maxWidth, viewWidth) : viewWidth;
+        final int height = Math.max(1, viewHeight * width / viewWidth);
+
+        if (Build.VERSION.SDK_INT >= Build.VERSION_CODES.N && surface != null && surface.isValid()) {
+            copySurface(surface, width, height, new Callback() {
+                @Override
+                public void onFrameCaptured(Bitmap bitmap) {
+                    if (bitmap != null) {
+                        callback.onFrameCaptured(bitmap);
+                    } else {
+                        callback.onFrameCaptured(textureView.getBitmap(width, height));
+                    }
+                }
+            });
+        } else {
+            callback.onFrameCaptured(textureView.getBitmap(width, height));
+        }
+    }
+
+    @TargetApi(Build.VERSION_CODES.N)
+    private static void copySurface(Surface surface, int width, int height, final Callback callback) {
+        final Bitmap bitmap = Bitmap.createBitmap(width, height, Bitmap.Config.ARGB_8888);
+        try {
+            PixelCopy.request(surface, bitmap, new PixelCopy.OnPixelCopyFinishedListener() {
+                @Override
+                public void onPixelCopyFinished(final int copyResult) {
+                    mainHandler.post(new Runnable() {
+                        @Override
+                        public void run() {
+                            if (copyResult == PixelCopy.SUCCESS) {
+                                callback.onFrameCaptured(bitmap);
+                            } else {
+                                Log.d(TAG, "PixelCopy failed: " + copyResult);
+                                bitmap.recycle();
+                                callback.onFrameCaptured(null);
+                            }
+                        }
+                    });
+                }
+            }, getCaptureHandler());
+        } catch (IllegalArgumentException e) {
+            //The surface was released in the meantime
+            Log.e(TAG, e.toString());
+            bitmap.recycle();
+            callback.onFrameCaptured(null);
+        }
+    }
+
+    private static synchronized Handler getCaptureHandler() {
+        if (captureThread == null) {
+            captureThread = new HandlerThread(TAG);
+            captureThread.start();
+        }
+        return new Handler(captureThread.getLooper());
+    }
+}
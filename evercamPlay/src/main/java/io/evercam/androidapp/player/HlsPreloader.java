@@ -0,0 +1,255 @@
+package io.evercam.androidapp.player;
+
+import android.net.Uri;
+import android.os.SystemClock;
+import android.util.Log;
+
+import com.google.android.exoplayer2.C;
+import com.google.android.exoplayer2.upstream.DataSource;
+import com.google.android.exoplayer2.upstream.DataSpec;
+import com.google.android.exoplayer2.util.UriUtil;
+
+import java.io.ByteArrayOutputStream;
+import java.io.IOException;
+import java.util.ArrayList;
+import java.util.HashSet;
+import java.util.Iterator;
+import java.util.LinkedHashMap;
+import java.util.Map;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+
+/**
+ * Pre-fetches the HLS playlists and the starting segment of cameras the user is likely
+ * to switch to next, so that switching cameras does not wait for three sequential
+ * network round trips before the first frame.
+ *
+ * Pre-fetched data is handed to the player through {@link #wrap(DataSource.Factory)}.
+ * Each entry is used at most once, and playlists expire quickly since live playlists
+ * change with every new segment, so callers keep calling {@link #preload(String, long)}
+ * every {@link #REFRESH_INTERVAL_MS} for as long as a switch is likely.
+ */
+public class HlsPreloader {
+    private final static String TAG = "HlsPreloader";
+    private final static String TAG_STREAM_INF = "#EXT-X-STREAM-INF";
+    private final static String TAG_MEDIA_DURATION = "#EXTINF:";
+
+    final static long PLAYLIST_MAX_AGE_MS = 4000;
+    private final static long SEGMENT_MAX_AGE_MS = 30000;
+    private final static int MAX_CACHE_BYTES = 8 * 1024 * 1024;
+
+    /**
+     * How often pre-fetched playlists should be refreshed, leaving a second for the
+     * playlist requests so that a fresh copy is always available
+     */
+    public final static long REFRESH_INTERVAL_MS = PLAYLIST_MAX_AGE_MS - 1000;
+
+    interface Clock {
+        long elapsedRealtime();
+    }
+
+    private final static Clock SYSTEM_CLOCK = new Clock() {
+        @Override
+        public long elapsedRealtime() {
+            return SystemClock.elapsedRealtime();
+        }
+    };
+
+    private final DataSource.Factory upstreamFactory;
+    private final Clock clock;
+    private final ExecutorService executor = Executors.newFixedThreadPool(2);
+    private final LinkedHashMap<String, Entry> cache = new LinkedHashMap<>(16, 0.75f, true);
+    private final HashSet<String> pendingUrls = new HashSet<>();
+    private int cacheBytes = 0;
+
+    private static class Entry {
+        final byte[] data;
+        final long loadedAtMs;
+        final long maxAgeMs;
+
+        Entry(byte[] data, long loadedAtMs, long maxAgeMs) {
+            this.data = data;
+            this.loadedAtMs = loadedAtMs;
+            this.maxAgeMs = maxAgeMs;
+        }
+
+        boolean isExpired(long nowMs) {
+            return nowMs - loadedAtMs > maxAgeMs;
+        }
+    }
+
+    /**
+     * @param upstreamFactory factory for the connections used to pre-fetch, which should
+     *                        not report to the player's bandwidth meter
+     */
+    public HlsPreloader(DataSource.Factory upstreamFactory) {
+        this(upstreamFactory, SYSTEM_CLOCK);
+    }
+
+    HlsPreloader(DataSource.Factory upstreamFactory, Clock clock) {
+        this.upstreamFactory = upstreamFactory;
+        this.clock = clock;
+    }
+
+    /**
+     * Fetch the playlists and the segment playback will start from in the background
+     *
+     * @param hlsUrl       the camera's HLS URL
+     * @param liveOffsetMs the offset from the live edge playback starts at, or
+     *                     C.TIME_UNSET for the ExoPlayer default of the third last segment
+     */
+    public void preload(final String hlsUrl, final long liveOffsetMs) {
+        synchronized (this) {
+            if (pendingUrls.contains(hlsUrl)) return;
+            pendingUrls.add(hlsUrl);
+        }
+
+        executor.execute(new Runnable() {
+            @Override
+            public void run() {
+                try {
+                    preloadBlocking(hlsUrl, liveOffsetMs);
+                } catch (IOException e) {
+                    Log.d(TAG, "Preload failed for " + hlsUrl + ": " + e.toString());
+                } finally {
+                    synchronized (HlsPreloader.this) {
+                        pendingUrls.remove(hlsUrl);
+                    }
+                }
+            }
+        });
+    }
+
+    public DataSource.Factory wrap(final DataSource.Factory factory) {
+        return new DataSource.Factory() {
+            @Override
+            public DataSource createDataSource() {
+                return new PreloadingDataSource(HlsPreloader.this, factory.createDataSource());
+            }
+        };
+    }
+
+    public void release() {
+        executor.shutdownNow();
+        synchronized (this) {
+            cache.clear();
+            cacheBytes = 0;
+        }
+    }
+
+    /**
+     * Remove and return the pre-fetched data for the URL, or null if not available
+     */
+    synchronized byte[] take(String url) {
+        Entry entry = cache.remove(url);
+        if (entry == null) return null;
+
+        cacheBytes -= entry.data.length;
+        return entry.isExpired(clock.elapsedRealtime()) ? null : entry.data;
+    }
+
+    void preloadBlocking(String hlsUrl, long liveOffsetMs) throws IOException {
+        String playlistUrl = hlsUrl;
+        String playlist = put(playlistUrl, load(playlistUrl), PLAYLIST_MAX_AGE_MS);
+
+        if (playlist.contains(TAG_STREAM_INF)) {
+            String variantUrl = getFirstVariantUrl(playlistUrl, playlist);
+            if (variantUrl == null) return;
+            playlistUrl = variantUrl;
+            playlist = put(playlistUrl, load(playlistUrl), PLAYLIST_MAX_AGE_MS);
+        }
+
+        String segmentUrl = getStartSegmentUrl(playlistUrl, playlist, liveOffsetMs);
+        if (segmentUrl != null && !containsFresh(segmentUrl)) {
+            put(segmentUrl, load(segmentUrl), SEGMENT_MAX_AGE_MS);
+            Log.d(TAG, "Preloaded " + hlsUrl);
+        }
+    }
+
+    private synchronized boolean containsFresh(String url) {
+        Entry entry = cache.get(url);
+        return entry != null && !entry.isExpired(clock.elapsedRealtime());
+    }
+
+    private synchronized String put(String url, byte[] data, long maxAgeMs) {
+        Entry previous = cache.put(url, new Entry(data, clock.elapsedRealtime(), maxAgeMs));
+        if (previous != null) {
+            cacheBytes -= previous.data.length;
+        }
+        cacheBytes += data.length;
+
+        Iterator<Map.Entry<String, Entry>> iterator = cache.entrySet().iterator();
+        while (cacheBytes > MAX_CACHE_BYTES && iterator.hasNext()) {
+            Map.Entry<String, Entry> eldest = iterator.next();
+            if (eldest.getKey().equals(url)) continue;
+            cacheBytes -= eldest.getValue().data.length;
+            iterator.remove();
+        }
+
+        return new String(data);
+    }
+
+    byte[] load(String url) throws IOException {
+        DataSource dataSource = upstreamFactory.createDataSource();
+        ByteArrayOutputStream outputStream = new ByteArrayOutputStream();
+        try {
+            dataSource.open(new DataSpec(Uri.parse(url)));
+            byte[] buffer = new byte[16 * 1024];
+            int bytesRead;
+            while ((bytesRead = dataSource.read(buffer, 0, buffer.length)) != C.RESULT_END_OF_INPUT) {
+                outputStream.write(buffer, 0, bytesRead);
+            }
+        } finally {
+            dataSource.close();
+        }
+        return outputStream.toByteArray();
+    }
+
+    private static String getFirstVariantUrl(String masterUrl, String masterPlaylist) {
+        boolean nextLineIsVariant = false;
+        for (String line : masterPlaylist.split("\n")) {
+            line = line.trim();
+            if (line.startsWith(TAG_STREAM_INF)) {
+                nextLineIsVariant = true;
+            } else if (nextLineIsVariant && !line.isEmpty() && !line.startsWith("#")) {
+                return UriUtil.resolve(masterUrl, line);
+            }
+        }
+        return null;
+    }
+
+    private static String getStartSegmentUrl(String playlistUrl, String mediaPlaylist,
+                                             long liveOffsetMs) {
+        ArrayList<String> segmentUrls = new ArrayList<>();
+        ArrayList<Long> segmentDurationsMs = new ArrayList<>();
+        long durationMs = 0;
+        for (String line : mediaPlaylist.split("\n")) {
+            line = line.trim();
+            if (line.startsWith(TAG_MEDIA_DURATION)) {
+                String durationString = line.substring(TAG_MEDIA_DURATION.length()).split(",")[0];
+                try {
+                    durationMs = (long) (Double.parseDouble(durationString) * 1000);
+                } catch (NumberFormatException e) {
+                    durationMs = 0;
+                }
+            } else if (!line.isEmpty() && !line.startsWith("#")) {
+                segmentUrls.add(UriUtil.resolve(playlistUrl, line));
+                segmentDurationsMs.add(durationMs);
+            }
+        }
+        if (segmentUrls.isEmpty()) return null;
+
+        if (liveOffsetMs == C.TIME_UNSET) {
+            return segmentUrls.get(Math.max(0, segmentUrls.size() - 3));
+        }
+
+        long offsetFromEndMs = 0;
+        for (int index = segmentUrls.size() - 1; index >= 0; index--) {
+            offsetFromEndMs += segmentDurationsMs.get(index);
+            if (offsetFromEndMs >= liveOffsetMs) {
+                return segmentUrls.get(index);
+            }
+        }
+        return segmentUrls.get(0);
+    }
+}
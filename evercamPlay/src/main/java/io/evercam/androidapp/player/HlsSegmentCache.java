@@ -0,0 +1,417 @@
+package io.evercam.androidapp.player;
+
+import android.content.Context;
+import android.net.Uri;
+import android.util.Log;
+
+import com.google.android.exoplayer2.upstream.DataSource;
+import com.google.android.exoplayer2.util.UriUtil;
+
+import java.io.BufferedReader;
+import java.io.File;
+import java.io.FileReader;
+import java.io.FileWriter;
+import java.io.IOException;
+import java.io.PrintWriter;
+import java.util.ArrayList;
+import java.util.HashMap;
+import java.util.HashSet;
+import java.util.Iterator;
+import java.util.LinkedHashMap;
+import java.util.Locale;
+import java.util.Map;
+
+/**
+ * Disk cache of the live HLS segments played for each camera, kept as a rolling window.
+ *
+ * Segments are cached as they stream through {@link #wrap(DataSource.Factory, String)},
+ * and later requests for the same segment are served from disk, so re-opening a camera
+ * starts from cached segments. {@link #writeReplayPlaylist(String)} turns a camera's
+ * window into a local VOD playlist to rewind the last minutes without any network.
+ *
+ * Segments are evicted when older than the maximum age, then oldest first across all
+ * cameras while the cache is over its size limit.
+ *
+ * The index is read from disk on first use, which is always on a loader or background
+ * thread, so the main thread can get the instance and wrap data sources without I/O.
+ */
+public class HlsSegmentCache {
+    private final static String TAG = "HlsSegmentCache";
+    private final static String CACHE_DIR = "hls";
+    private final static String INDEX_FILE = "index";
+    private final static String REPLAY_PLAYLIST_FILE = "replay.m3u8";
+    private final static String SEGMENT_SUFFIX = ".ts";
+    private final static String TEMP_SUFFIX = ".tmp";
+    private final static String TAG_MEDIA_SEQUENCE = "#EXT-X-MEDIA-SEQUENCE:";
+    private final static String TAG_MEDIA_DURATION = "#EXTINF:";
+
+    public final static long MAX_BYTES = 100 * 1024 * 1024;
+    public final static long MAX_AGE_MS = 10 * 60 * 1000;
+    private final static int MAX_KNOWN_SEGMENTS = 200;
+
+    private static HlsSegmentCache instance;
+
+    private final File cacheDir;
+    private final long maxBytes;
+    private final long maxAgeMs;
+    private long totalBytes = 0;
+    private boolean indexesLoaded = false;
+
+    /* Cached segments of each camera, oldest first */
+    private final HashMap<String, ArrayList<Segment>> segmentsByCamera = new HashMap<>();
+    private final HashMap<String, Segment> segmentsByUrl = new HashMap<>();
+    /* Segments listed in recently loaded media playlists, by URL */
+    private final LinkedHashMap<String, Segment> knownSegments =
+            new LinkedHashMap<String, Segment>(16, 0.75f, true) {
+                @Override
+                protected boolean removeEldestEntry(Map.Entry<String, Segment> eldest) {
+                    return size() > MAX_KNOWN_SEGMENTS;
+                }
+            };
+
+    static class Segment {
+        final String url;
+        final long sequence;
+        final long durationUs;
+        String cameraId;
+        String fileName;
+        long size;
+        long savedAtMs;
+
+        Segment(String url, long sequence, long durationUs) {
+            this.url = url;
+            this.sequence = sequence;
+            this.durationUs = durationUs;
+        }
+    }
+
+    public static synchronized HlsSegmentCache getInstance(Context context) {
+        if (instance == null) {
+            instance = new HlsSegmentCache(new File(context.getCacheDir(), CACHE_DIR),
+                    MAX_BYTES, MAX_AGE_MS);
+        }
+        return instance;
+    }
+
+    HlsSegmentCache(File cacheDir, long maxBytes, long maxAgeMs) {
+        this.cacheDir = cacheDir;
+        this.maxBytes = maxBytes;
+        this.maxAgeMs = maxAgeMs;
+    }
+
+    public DataSource.Factory wrap(final DataSource.Factory upstreamFactory, final String cameraId) {
+        return new DataSource.Factory() {
+            @Override
+            public DataSource createDataSource() {
+                return new SegmentCachingDataSource(HlsSegmentCache.this,
+                        upstreamFactory.createDataSource(), cameraId);
+            }
+        };
+    }
+
+    /**
+     * Write the camera's cached segments as a local VOD playlist
+     *
+     * @return the playlist file, or null if nothing is cached for the camera
+     */
+    public synchronized File writeReplayPlaylist(String cameraId) {
+        ensureIndexesLoaded();
+        evict();
+        ArrayList<Segment> segments = segmentsByCamera.get(cameraId);
+        if (segments == null || segments.isEmpty()) return null;
+
+        long maxDurationUs = 0;
+        for (Segment segment : segments) {
+            maxDurationUs = Math.max(maxDurationUs, segment.durationUs);
+        }
+
+        File cameraDir = getCameraDir(cameraId);
+        File playlistFile = new File(cameraDir, REPLAY_PLAYLIST_FILE);
+        PrintWriter writer = null;
+        try {
+            writer = new PrintWriter(new FileWriter(playlistFile));
+            writer.println("#EXTM3U");
+            writer.println("#EXT-X-VERSION:3");
+            writer.println("#EXT-X-TARGETDURATION:" + (long) Math.ceil(maxDurationUs / 1000000d));
+            writer.println(TAG_MEDIA_SEQUENCE + segments.get(0).sequence);
+            Segment previous = null;
+            for (Segment segment : segments) {
+                if (previous != null && segment.sequence != previous.sequence + 1) {
+                    writer.println("#EXT-X-DISCONTINUITY");
+                }
+                writer.println(String.format(Locale.US, "%s%.3f,", TAG_MEDIA_DURATION,
+                        segment.durationUs / 1000000d));
+                writer.println(Uri.fromFile(new File(cameraDir, segment.fileName)).toString());
+                previous = segment;
+            }
+            writer.println("#EXT-X-ENDLIST");
+        } catch (IOException e) {
+            Log.e(TAG, e.toString());
+            return null;
+        } finally {
+            if (writer != null) {
+                writer.close();
+            }
+        }
+        return playlistFile;
+    }
+
+    /**
+     * Remember the segments listed in a media playlist, only those get cached
+     */
+    synchronized void onPlaylistLoaded(String playlistUrl, String playlist) {
+        ensureIndexesLoaded();
+        long sequence = 0;
+        long durationUs = 0;
+        for (String line : playlist.split("\n")) {
+            line = line.trim();
+            if (line.startsWith(TAG_MEDIA_SEQUENCE)) {
+                try {
+                    sequence = Long.parseLong(line.substring(TAG_MEDIA_SEQUENCE.length()));
+                } catch (NumberFormatException e) {
+                    Log.e(TAG, e.toString());
+                }
+            } else if (line.startsWith(TAG_MEDIA_DURATION)) {
+                String durationString = line.substring(TAG_MEDIA_DURATION.length()).split(",")[0];
+                try {
+                    durationUs = (long) (Double.parseDouble(durationString) * 1000000);
+                } catch (NumberFormatException e) {
+                    durationUs = 0;
+                }
+            } else if (!line.isEmpty() && !line.startsWith("#")) {
+                String segmentUrl = UriUtil.resolve(playlistUrl, line);
+                if (durationUs > 0 && !knownSegments.containsKey(segmentUrl)) {
+                    knownSegments.put(segmentUrl, new Segment(segmentUrl, sequence, durationUs));
+                }
+                sequence++;
+                durationUs = 0;
+            }
+        }
+    }
+
+    synchronized boolean isKnownSegment(String url) {
+        ensureIndexesLoaded();
+        return knownSegments.containsKey(url) && !segmentsByUrl.containsKey(url);
+    }
+
+    /**
+     * @return the cached file of the segment, or null if not cached or expired
+     */
+    synchronized File getCachedFile(String url) {
+        ensureIndexesLoaded();
+        Segment segment = segmentsByUrl.get(url);
+        if (segment == null || isExpired(segment, System.currentTimeMillis())) return null;
+
+        File file = new File(getCameraDir(segment.cameraId), segment.fileName);
+        return file.exists() ? file : null;
+    }
+
+    File createTempFile(String cameraId) throws IOException {
+        File cameraDir = getCameraDir(cameraId);
+        if (!cameraDir.exists() && !cameraDir.mkdirs()) {
+            throw new IOException("Unable to create " + cameraDir.getPath());
+        }
+        return File.createTempFile("segment", TEMP_SUFFIX, cameraDir);
+    }
+
+    /**
+     * Add a fully downloaded segment to the camera's window
+     */
+    synchronized void commit(String cameraId, String url, File tempFile) {
+        ensureIndexesLoaded();
+        Segment known = knownSegments.get(url);
+        if (known == null || segmentsByUrl.containsKey(url)) {
+            tempFile.delete();
+            return;
+        }
+
+        Segment segment = new Segment(url, known.sequence, known.durationUs);
+        segment.cameraId = cameraId;
+        segment.fileName = Integer.toHexString(url.hashCode()) + "_" + segment.sequence + SEGMENT_SUFFIX;
+        segment.size = tempFile.length();
+        segment.savedAtMs = System.currentTimeMillis();
+
+        File segmentFile = new File(getCameraDir(cameraId), segment.fileName);
+        if (!tempFile.renameTo(segmentFile)) {
+            tempFile.delete();
+            return;
+        }
+
+        ArrayList<Segment> segments = segmentsByCamera.get(cameraId);
+        if (segments == null) {
+            segments = new ArrayList<>();
+            segmentsByCamera.put(cameraId, segments);
+        }
+        //A camera stream restarted with a lower sequence starts a new window
+        if (!segments.isEmpty() && segments.get(segments.size() - 1).sequence >= segment.sequence) {
+            removeSegments(segments, segments.size());
+        }
+        segments.add(segment);
+        segmentsByUrl.put(url, segment);
+        totalBytes += segment.size;
+
+        evict();
+        writeIndex(cameraId);
+    }
+
+    private boolean isExpired(Segment segment, long nowMs) {
+        return nowMs - segment.savedAtMs > maxAgeMs;
+    }
+
+    private void evict() {
+        long nowMs = System.currentTimeMillis();
+        HashSet<String> changedCameras = new HashSet<>();
+
+        for (Map.Entry<String, ArrayList<Segment>> entry : segmentsByCamera.entrySet()) {
+            ArrayList<Segment> segments = entry.getValue();
+            int expiredCount = 0;
+            while (expiredCount < segments.size() && isExpired(segments.get(expiredCount), nowMs)) {
+                expiredCount++;
+            }
+            if (expiredCount > 0) {
+                removeSegments(segments, expiredCount);
+                changedCameras.add(entry.getKey());
+            }
+        }
+
+        while (totalBytes > maxBytes) {
+            ArrayList<Segment> oldestSegments = null;
+            String oldestCameraId = null;
+            for (Map.Entry<String, ArrayList<Segment>> entry : segmentsByCamera.entrySet()) {
+                ArrayList<Segment> segments = entry.getValue();
+                if (!segments.isEmpty() && (oldestSegments == null
+                        || segments.get(0).savedAtMs < oldestSegments.get(0).savedAtMs)) {
+                    oldestSegments = segments;
+                    oldestCameraId = entry.getKey();
+                }
+            }
+            if (oldestSegments == null) break;
+
+            removeSegments(oldestSegments, 1);
+            changedCameras.add(oldestCameraId);
+        }
+
+        for (String cameraId : changedCameras) {
+            writeIndex(cameraId);
+        }
+    }
+
+    /**
+     * Delete the first count segments of the list
+     */
+    private void removeSegments(ArrayList<Segment> segments, int count) {
+        Iterator<Segment> iterator = segments.iterator();
+        for (int index = 0; index < count && iterator.hasNext(); index++) {
+            Segment segment = iterator.next();
+            new File(getCameraDir(segment.cameraId), segment.fileName).delete();
+            segmentsByUrl.remove(segment.url);
+            totalBytes -= segment.size;
+            iterator.remove();
+        }
+    }
+
+    private File getCameraDir(String cameraId) {
+        return new File(cacheDir, cameraId);
+    }
+
+    private void writeIndex(String cameraId) {
+        ArrayList<Segment> segments = segmentsByCamera.get(cameraId);
+        File indexFile = new File(getCameraDir(cameraId), INDEX_FILE);
+        if (segments == null || segments.isEmpty()) {
+            indexFile.delete();
+            return;
+        }
+
+        PrintWriter writer = null;
+        try {
+            writer = new PrintWriter(new FileWriter(indexFile));
+            for (Segment segment : segments) {
+                writer.println(segment.sequence + "\t" + segment.durationUs + "\t"
+                        + segment.savedAtMs + "\t" + segment.size + "\t" + segment.fileName
+                        + "\t" + segment.url);
+            }
+        } catch (IOException e) {
+            Log.e(TAG, e.toString());
+        } finally {
+            if (writer != null) {
+                writer.close();
+            }
+        }
+    }
+
+    private void ensureIndexesLoaded() {
+        if (!indexesLoaded) {
+            indexesLoaded = true;
+            loadIndexes();
+        }
+    }
+
+    private void loadIndexes() {
+        File[] cameraDirs = cacheDir.listFiles();
+        if (cameraDirs == null) return;
+
+        for (File cameraDir : cameraDirs) {
+            if (!cameraDir.isDirectory()) continue;
+            String cameraId = cameraDir.getName();
+            ArrayList<Segment> segments = readIndex(cameraId);
+            HashSet<String> fileNames = new HashSet<>();
+            for (Segment segment : segments) {
+                fileNames.add(segment.fileName);
+                segmentsByUrl.put(segment.url, segment);
+                totalBytes += segment.size;
+            }
+            segmentsByCamera.put(cameraId, segments);
+
+            //Remove unfinished downloads and files missing from the index
+            File[] files = cameraDir.listFiles();
+            if (files != null) {
+                for (File file : files) {
+                    String name = file.getName();
+                    if (name.endsWith(TEMP_SUFFIX)
+                            || (name.endsWith(SEGMENT_SUFFIX) && !fileNames.contains(name))) {
+                        file.delete();
+                    }
+                }
+            }
+        }
+        evict();
+    }
+
+    private ArrayList<Segment> readIndex(String cameraId) {
+        ArrayList<Segment> segments = new ArrayList<>();
+        File cameraDir = getCameraDir(cameraId);
+        File indexFile = new File(cameraDir, INDEX_FILE);
+        if (!indexFile.exists()) return segments;
+
+        BufferedReader reader = null;
+        try {
+            reader = new BufferedReader(new FileReader(indexFile));
+            String line;
+            while ((line = reader.readLine()) != null) {
+                String[] fields = line.split("\t", 6);
+                if (fields.length < 6) continue;
+
+                Segment segment = new Segment(fields[5], Long.parseLong(fields[0]),
+                        Long.parseLong(fields[1]));
+                segment.cameraId = cameraId;
+                segment.savedAtMs = Long.parseLong(fields[2]);
+                segment.size = Long.parseLong(fields[3]);
+                segment.fileName = fields[4];
+                if (new File(cameraDir, segment.fileName).exists()) {
+                    segments.add(segment);
+                }
+            }
+        } catch (IOException | NumberFormatException e) {
+            Log.e(TAG, e.toString());
+        } finally {
+            if (reader != null) {
+                try {
+                    reader.close();
+                } catch (IOException e) {
+                    Log.e(TAG, e.toString());
+                }
+            }
+        }
+        return segments;
+    }
+}
@@ -0,0 +1,206 @@
+package io.evercam.androidapp.player;
+
+import android.os.Handler;
+import android.os.SystemClock;
+import android.util.Log;
+
+import com.google.android.exoplayer2.ExoPlaybackException;
+import com.google.android.exoplayer2.ExoPlayer;
+import com.google.android.exoplayer2.Timeline;
+import com.google.android.exoplayer2.source.TrackGroupArray;
+import com.google.android.exoplayer2.trackselection.TrackSelectionArray;
+
+import java.util.ArrayDeque;
+
+/**
+ * Decides whether the live view shows the HLS stream or the JPG channel while both run.
+ *
+ * HLS is shown as soon as its first frame is rendered, being ready doesn't mean
+ * anything has been drawn yet. If it rebuffers for too long, or too often within
+ * a short window, the JPG view is shown instead while HLS keeps loading in the background.
+ * Once HLS has played without rebuffering for a while, the live view switches back to it.
+ *
+ * Player errors are not handled here, VideoActivity releases the player and stays on JPG.
+ * Buffering after a {@link LiveEdgeController} seek doesn't count towards the fallback.
+ */
+public class HybridStreamSwitcher implements ExoPlayer.EventListener,
+        LiveEdgeController.SeekListener, EventLogger.Listener {
+    private final static String TAG = "HybridStreamSwitcher";
+
+    public interface Listener {
+        void onSwitchToHls();
+
+        void onSwitchToJpg();
+    }
+
+    /**
+     * Switching thresholds, the defaults suit the Evercam HLS segment length
+     */
+    public static class Thresholds {
+        /* A single rebuffer longer than this switches to JPG */
+        public long maxRebufferMs = 4000;
+        /* This many rebuffers within rebufferWindowMs switch to JPG */
+        public int maxRebufferCount = 3;
+        public long rebufferWindowMs = 60000;
+        /* After falling back, HLS needs to play this long without rebuffering to be shown again */
+        public long recoveryMs = 10000;
+    }
+
+    private final Listener listener;
+    private final Thresholds thresholds;
+    private final Handler handler = new Handler();
+    private final ArrayDeque<Long> rebufferTimesMs = new ArrayDeque<>();
+
+    private boolean showingHls = false;
+    private boolean hasShownHls = false;
+    private boolean seeking = false;
+
+    private final Runnable fallbackRunnable = new Runnable() {
+        @Override
+        public void run() {
+            Log.d(TAG, "Rebuffer took longer than " + thresholds.maxRebufferMs + "ms");
+            switchToJpg();
+        }
+    };
+
+    private final Runnable recoveryRunnable = new Runnable() {
+        @Override
+        public void run() {
+            Log.d(TAG, "HLS recovered, switching back");
+            switchToHls();
+        }
+    };
+
+    public HybridStreamSwitcher(Listener listener, Thresholds thresholds) {
+        this.listener = listener;
+        this.thresholds = thresholds;
+    }
+
+    public boolean isShowingHls() {
+        return showingHls;
+    }
+
+    /**
+     * Start over for a new media source played by the same player
+     */
+    public void reset() {
+        cancelTimers();
+        rebufferTimesMs.clear();
+        showingHls = false;
+        hasShownHls = false;
+        seeking = false;
+    }
+
+    public void release() {
+        cancelTimers();
+    }
+
+    private void switchToHls() {
+        if (showingHls) return;
+        showingHls = true;
+        hasShownHls = true;
+        listener.onSwitchToHls();
+    }
+
+    private void switchToJpg() {
+        cancelTimers();
+        rebufferTimesMs.clear();
+        if (!showingHls) return;
+        showingHls = false;
+        listener.onSwitchToJpg();
+    }
+
+    private void cancelTimers() {
+        handler.removeCallbacks(fallbackRunnable);
+        handler.removeCallbacks(recoveryRunnable);
+    }
+
+    private boolean isRebufferingTooOften(long nowMs) {
+        rebufferTimesMs.addLast(nowMs);
+        while (!rebufferTimesMs.isEmpty()
+                && nowMs - rebufferTimesMs.peekFirst() > thresholds.rebufferWindowMs) {
+            rebufferTimesMs.pollFirst();
+        }
+        return rebufferTimesMs.size() >= thresholds.maxRebufferCount;
+    }
+
+    // LiveEdgeController.SeekListener
+
+    @Override
+    public void onLiveEdgeSeek() {
+        seeking = true;
+    }
+
+    // EventLogger.Listener
+
+    @Override
+    public void onRenderedFirstFrame() {
+        if (!hasShownHls) {
+            switchToHls();
+        }
+    }
+
+    @Override
+    public void onVideoSizeChanged(int width, int height, int unappliedRotationDegrees,
+                                   float pixelWidthHeightRatio) {
+
+    }
+
+    // ExoPlayer.EventListener
+
+    @Override
+    public void onPlayerStateChanged(boolean playWhenReady, int playbackState) {
+        if (playbackState != ExoPlayer.STATE_BUFFERING) {
+            seeking = false;
+        } else if (seeking) {
+            return;
+        }
+
+        if (playbackState == ExoPlayer.STATE_READY) {
+            handler.removeCallbacks(fallbackRunnable);
+            if (hasShownHls && !showingHls && playWhenReady) {
+                handler.removeCallbacks(recoveryRunnable);
+                handler.postDelayed(recoveryRunnable, thresholds.recoveryMs);
+            }
+        } else if (playbackState == ExoPlayer.STATE_BUFFERING && playWhenReady) {
+            handler.removeCallbacks(recoveryRunnable);
+            if (showingHls) {
+                if (isRebufferingTooOften(SystemClock.elapsedRealtime())) {
+                    Log.d(TAG, "Rebuffered " + thresholds.maxRebufferCount + " times within "
+                            + thresholds.rebufferWindowMs + "ms");
+                    switchToJpg();
+                } else {
+                    handler.removeCallbacks(fallbackRunnable);
+                    handler.postDelayed(fallbackRunnable, thresholds.maxRebufferMs);
+                }
+            }
+        } else {
+            cancelTimers();
+        }
+    }
+
+    @Override
+    public void onPlayerError(ExoPlaybackException error) {
+        cancelTimers();
+    }
+
+    @Override
+    public void onLoadingChanged(boolean isLoading) {
+
+    }
+
+    @Override
+    public void onTimelineChanged(Timeline timeline, Object manifest) {
+
+    }
+
+    @Override
+    public void onTracksChanged(TrackGroupArray trackGroups, TrackSelectionArray trackSelections) {
+
+    }
+
+    @Override
+    public void onPositionDiscontinuity() {
+
+    }
+}
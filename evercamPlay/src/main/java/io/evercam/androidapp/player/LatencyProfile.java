@@ -0,0 +1,56 @@
+package io.evercam.androidapp.player;
+
+import com.google.android.exoplayer2.C;
+import com.google.android.exoplayer2.DefaultLoadControl;
+import com.google.android.exoplayer2.LoadControl;
+import com.google.android.exoplayer2.upstream.DefaultAllocator;
+
+/**
+ * Buffering and live edge settings for HLS live view.
+ *
+ * STANDARD keeps the ExoPlayer defaults, which play smoothly but lag several
+ * segments behind live. LOW_LATENCY buffers much less, starts playback as soon
+ * as a second of video is available and keeps playback close to the live edge.
+ */
+public enum LatencyProfile {
+    STANDARD(DefaultLoadControl.DEFAULT_MIN_BUFFER_MS,
+            DefaultLoadControl.DEFAULT_MAX_BUFFER_MS,
+            DefaultLoadControl.DEFAULT_BUFFER_FOR_PLAYBACK_MS,
+            DefaultLoadControl.DEFAULT_BUFFER_FOR_PLAYBACK_AFTER_REBUFFER_MS,
+            C.TIME_UNSET, C.TIME_UNSET, C.TIME_UNSET),
+
+    LOW_LATENCY(2000, 6000, 1000, 1500, 3000, 8000, 3000);
+
+    public final int minBufferMs;
+    public final int maxBufferMs;
+    public final long bufferForPlaybackMs;
+    public final long bufferForPlaybackAfterRebufferMs;
+
+    /* How far behind the live edge to start playing and to seek to when chasing it */
+    public final long targetLiveOffsetMs;
+    /* Playback further than this behind the live edge jumps back to the target offset */
+    public final long maxLiveOffsetMs;
+    /* A rebuffer longer than this jumps to the live edge instead of waiting */
+    public final long maxRebufferMs;
+
+    LatencyProfile(int minBufferMs, int maxBufferMs, long bufferForPlaybackMs,
+                   long bufferForPlaybackAfterRebufferMs, long targetLiveOffsetMs,
+                   long maxLiveOffsetMs, long maxRebufferMs) {
+        this.minBufferMs = minBufferMs;
+        this.maxBufferMs = maxBufferMs;
+        this.bufferForPlaybackMs = bufferForPlaybackMs;
+        this.bufferForPlaybackAfterRebufferMs = bufferForPlaybackAfterRebufferMs;
+        this.targetLiveOffsetMs = targetLiveOffsetMs;
+        this.maxLiveOffsetMs = maxLiveOffsetMs;
+        this.maxRebufferMs = maxRebufferMs;
+    }
+
+    public boolean chasesLiveEdge() {
+        return targetLiveOffsetMs != C.TIME_UNSET;
+    }
+
+    public LoadControl buildLoadControl() {
+        return new DefaultLoadControl(new DefaultAllocator(true, C.DEFAULT_BUFFER_SEGMENT_SIZE),
+                minBufferMs, maxBufferMs, bufferForPlaybackMs, bufferForPlaybackAfterRebufferMs);
+    }
+}
@@ -0,0 +1,179 @@
+package io.evercam.androidapp.player;
+
+import android.os.Handler;
+import android.util.Log;
+
+import com.google.android.exoplayer2.C;
+import com.google.android.exoplayer2.ExoPlaybackException;
+import com.google.android.exoplayer2.ExoPlayer;
+import com.google.android.exoplayer2.Timeline;
+import com.google.android.exoplayer2.source.TrackGroupArray;
+import com.google.android.exoplayer2.trackselection.TrackSelectionArray;
+
+import java.util.ArrayList;
+
+/**
+ * Keeps a live HLS stream close to the live edge according to a {@link LatencyProfile}:
+ * starts playback at the live edge, jumps forward when playback drifts too far behind,
+ * and skips to the live edge instead of waiting out long rebuffers.
+ *
+ * The live edge offset is reported to the {@link EventLogger} on every check. The seeks
+ * made here are announced to {@link SeekListener}s first, so that the buffering that
+ * follows them is not mistaken for a rebuffer.
+ */
+public class LiveEdgeController implements ExoPlayer.EventListener {
+    private final static String TAG = "LiveEdgeController";
+    private final static long CHECK_INTERVAL_MS = 2000;
+
+    public interface SeekListener {
+        /**
+         * Called right before the controller seeks, the player buffers until it is ready again
+         */
+        void onLiveEdgeSeek();
+    }
+
+    private final ExoPlayer player;
+    private final LatencyProfile profile;
+    private final EventLogger eventLogger;
+    private final Handler handler = new Handler();
+    private final Timeline.Window window = new Timeline.Window();
+    private final ArrayList<SeekListener> seekListeners = new ArrayList<>();
+
+    private boolean startedAtLiveEdge = false;
+    private boolean hasBeenReady = false;
+    private boolean released = false;
+
+    private final Runnable checkRunnable = new Runnable() {
+        @Override
+        public void run() {
+            checkLiveOffset();
+            handler.postDelayed(this, CHECK_INTERVAL_MS);
+        }
+    };
+
+    private final Runnable rebufferTimeoutRunnable = new Runnable() {
+        @Override
+        public void run() {
+            Log.d(TAG, "Rebuffer took longer than " + profile.maxRebufferMs + "ms, " +
+                    "jumping to live edge");
+            seekToLiveEdge();
+        }
+    };
+
+    public LiveEdgeController(ExoPlayer player, LatencyProfile profile, EventLogger eventLogger) {
+        this.player = player;
+        this.profile = profile;
+        this.eventLogger = eventLogger;
+        handler.postDelayed(checkRunnable, CHECK_INTERVAL_MS);
+    }
+
+    public void addSeekListener(SeekListener listener) {
+        seekListeners.add(listener);
+    }
+
+    /**
+     * Start over for a new media source played by the same player
+     */
+    public void reset() {
+        startedAtLiveEdge = false;
+        hasBeenReady = false;
+        handler.removeCallbacks(rebufferTimeoutRunnable);
+    }
+
+    public void release() {
+        released = true;
+        handler.removeCallbacks(checkRunnable);
+        handler.removeCallbacks(rebufferTimeoutRunnable);
+    }
+
+    /**
+     * @return how far playback is behind the live edge in milliseconds, or
+     * C.TIME_UNSET if the current stream is not live
+     */
+    public long getLiveOffsetMs() {
+        Timeline timeline = player.getCurrentTimeline();
+        if (timeline == null || timeline.isEmpty()) return C.TIME_UNSET;
+
+        timeline.getWindow(player.getCurrentWindowIndex(), window);
+        long durationMs = window.getDurationMs();
+        if (!window.isDynamic || durationMs == C.TIME_UNSET) return C.TIME_UNSET;
+
+        return Math.max(0, durationMs - player.getCurrentPosition());
+    }
+
+    private void checkLiveOffset() {
+        long liveOffsetMs = getLiveOffsetMs();
+        if (liveOffsetMs == C.TIME_UNSET) return;
+
+        if (eventLogger != null) {
+            eventLogger.onLiveEdgeOffset(liveOffsetMs);
+        }
+
+        if (profile.chasesLiveEdge() && liveOffsetMs > profile.maxLiveOffsetMs
+                && player.getPlaybackState() == ExoPlayer.STATE_READY) {
+            Log.d(TAG, "Drifted " + liveOffsetMs + "ms behind live edge, catching up");
+            seekToLiveEdge();
+        }
+    }
+
+    private void seekToLiveEdge() {
+        if (released || !profile.chasesLiveEdge()) return;
+
+        Timeline timeline = player.getCurrentTimeline();
+        if (timeline == null || timeline.isEmpty()) return;
+
+        int windowIndex = player.getCurrentWindowIndex();
+        timeline.getWindow(windowIndex, window);
+        long durationMs = window.getDurationMs();
+        if (!window.isDynamic || durationMs == C.TIME_UNSET) return;
+
+        for (SeekListener listener : seekListeners) {
+            listener.onLiveEdgeSeek();
+        }
+        player.seekTo(windowIndex, Math.max(0, durationMs - profile.targetLiveOffsetMs));
+    }
+
+    // ExoPlayer.EventListener
+
+    @Override
+    public void onTimelineChanged(Timeline timeline, Object manifest) {
+        if (!startedAtLiveEdge && timeline != null && !timeline.isEmpty()) {
+            startedAtLiveEdge = true;
+            seekToLiveEdge();
+        }
+    }
+
+    @Override
+    public void onPlayerStateChanged(boolean playWhenReady, int playbackState) {
+        if (playbackState == ExoPlayer.STATE_READY) {
+            hasBeenReady = true;
+            handler.removeCallbacks(rebufferTimeoutRunnable);
+        } else if (playbackState == ExoPlayer.STATE_BUFFERING && hasBeenReady && playWhenReady
+                && profile.chasesLiveEdge()) {
+            handler.removeCallbacks(rebufferTimeoutRunnable);
+            handler.postDelayed(rebufferTimeoutRunnable, profile.maxRebufferMs);
+        } else {
+            handler.removeCallbacks(rebufferTimeoutRunnable);
+        }
+    }
+
+    @Override
+    public void onLoadingChanged(boolean isLoading) {
+
+    }
+
+    @Override
+    public void onTracksChanged(TrackGroupArray trackGroups, TrackSelectionArray trackSelections) {
+
+    }
+
+    @Override
+    public void onPlayerError(ExoPlaybackException error) {
+        handler.removeCallbacks(rebufferTimeoutRunnable);
+    }
+
+    @Override
+    public void onPositionDiscontinuity() {
+
+    }
+}
@@ -0,0 +1,37 @@
+package io.evercam.androidapp.player;
+
+import java.util.Iterator;
+import java.util.LinkedHashSet;
+
+/**
+ * Remembers which URLs were served from the device rather than the network, by
+ * {@link PreloadingDataSource} or {@link SegmentCachingDataSource}, so that
+ * {@link EventLogger} can leave those loads out of the bandwidth estimate.
+ *
+ * Data sources run on loader threads while the logger runs on the main thread.
+ */
+final class LocalLoads {
+    //Loads that fail or are canceled are never consumed, so only the latest are kept
+    private final static int MAX_URLS = 64;
+
+    private static final LinkedHashSet<String> urls = new LinkedHashSet<>();
+
+    private LocalLoads() {
+    }
+
+    static synchronized void add(String url) {
+        urls.add(url);
+        if (urls.size() > MAX_URLS) {
+            Iterator<String> iterator = urls.iterator();
+            iterator.next();
+            iterator.remove();
+        }
+    }
+
+    /**
+     * @return whether the URL was served locally, each load is only reported once
+     */
+    static synchronized boolean remove(String url) {
+        return urls.remove(url);
+    }
+}
@@ -0,0 +1,212 @@
+package io.evercam.androidapp.player;
+
+import java.io.ByteArrayOutputStream;
+import java.io.IOException;
+import java.io.InputStream;
+
+/**
+ * Splits a camera's HTTP response body into JPEG frames.
+ *
+ * A frame starts at the start of image marker (FFD8), so the same reader works for a
+ * multipart/x-mixed-replace MJPEG stream, whatever its boundary and part headers, and
+ * for a plain snapshot response holding a single JPEG. From there the frame is parsed
+ * segment by segment using the segment lengths, so an EXIF thumbnail or any other FFD8
+ * and FFD9 bytes inside APPn data are skipped over, and only after a start of scan is
+ * the entropy coded data searched for the next marker. A malformed frame is dropped and
+ * reading carries on from the next start of image.
+ */
+public class MjpegFrameReader {
+    private final static int BUFFER_SIZE = 16 * 1024;
+    /* A frame larger than this is not a camera image, stop rather than run out of memory */
+    private final static int MAX_FRAME_SIZE = 8 * 1024 * 1024;
+
+    private final static int MARKER_SOI = 0xD8;
+    private final static int MARKER_EOI = 0xD9;
+    private final static int MARKER_SOS = 0xDA;
+    private final static int MARKER_TEM = 0x01;
+    private final static int MARKER_RST0 = 0xD0;
+    private final static int MARKER_RST7 = 0xD7;
+
+    /* Results of the parsing steps, all other results are markers */
+    private final static int END_OF_STREAM = -1;
+    private final static int MALFORMED = -2;
+
+    private final InputStream inputStream;
+    private final byte[] buffer = new byte[BUFFER_SIZE];
+    private int bufferPosition = 0;
+    private int bufferLength = 0;
+    private final ByteArrayOutputStream frame = new ByteArrayOutputStream(BUFFER_SIZE);
+
+    public MjpegFrameReader(InputStream inputStream) {
+        this.inputStream = inputStream;
+    }
+
+    /**
+     * Block until the next complete frame is read
+     *
+     * @return the JPEG bytes of the frame, or null if the stream ended first
+     */
+    public byte[] readFrame() throws IOException {
+        boolean atStartOfImage = false;
+        while (true) {
+            if (!atStartOfImage && !skipToStartOfImage()) return null;
+
+            frame.reset();
+            frame.write(0xFF);
+            frame.write(MARKER_SOI);
+            int result = readSegments();
+            if (result == MARKER_EOI) {
+                return frame.toByteArray();
+            } else if (result == END_OF_STREAM) {
+                return null;
+            }
+            //A new image started before this one ended, the camera dropped the rest
+            atStartOfImage = result == MARKER_SOI;
+        }
+    }
+
+    /**
+     * Skip boundaries and part headers up to the start of the image
+     *
+     * @return false if the stream ended first
+     */
+    private boolean skipToStartOfImage() throws IOException {
+        int previous = -1;
+        int current;
+        while ((current = read()) >= 0) {
+            if (previous == 0xFF && current == MARKER_SOI) return true;
+            previous = current;
+        }
+        return false;
+    }
+
+    /**
+     * Copy the frame's segments after its start of image
+     *
+     * @return MARKER_EOI when the frame is complete, MARKER_SOI if another image started,
+     * MALFORMED or END_OF_STREAM
+     */
+    private int readSegments() throws IOException {
+        int marker = readMarker();
+        while (true) {
+            if (marker < 0 || marker == MARKER_EOI || marker == MARKER_SOI) {
+                return marker;
+            } else if (marker == MARKER_TEM || (marker >= MARKER_RST0 && marker <= MARKER_RST7)) {
+                //Markers without a segment
+                marker = readMarker();
+            } else {
+                int result = copySegment();
+                if (result < 0) return result;
+                //Progressive frames have several scans, each followed by more segments
+                marker = marker == MARKER_SOS ? copyEntropyCodedData() : readMarker();
+            }
+        }
+    }
+
+    /**
+     * @return the next marker, any fill bytes before it are skipped
+     */
+    private int readMarker() throws IOException {
+        int current = copyByte();
+        if (current < 0) return END_OF_STREAM;
+        if (current != 0xFF) return MALFORMED;
+
+        do {
+            current = copyByte();
+        } while (current == 0xFF);
+        if (current < 0) return END_OF_STREAM;
+        return current == 0 ? MALFORMED : current;
+    }
+
+    /**
+     * Copy a segment whose marker has just been read, its length includes the two
+     * length bytes themselves
+     */
+    private int copySegment() throws IOException {
+        int high = copyByte();
+        int low = copyByte();
+        if (low < 0) return END_OF_STREAM;
+
+        int length = (high << 8) | low;
+        if (length < 2) return MALFORMED;
+        return copyBytes(length - 2) ? 0 : END_OF_STREAM;
+    }
+
+    /**
+     * Copy entropy coded data, where FF is followed by a stuffed 00 or a restart marker
+     *
+     * @return the marker that ends the data
+     */
+    private int copyEntropyCodedData() throws IOException {
+        while (true) {
+            if (!fillBuffer()) return END_OF_STREAM;
+
+            //Copy everything up to the next FF at once
+            int start = bufferPosition;
+            while (bufferPosition < bufferLength && buffer[bufferPosition] != (byte) 0xFF) {
+                bufferPosition++;
+            }
+            write(buffer, start, bufferPosition - start);
+            if (bufferPosition == bufferLength) continue;
+
+            bufferPosition++;
+            frame.write(0xFF);
+            int current;
+            do {
+                current = copyByte();
+            } while (current == 0xFF);
+            if (current < 0) return END_OF_STREAM;
+            if (current != 0 && (current < MARKER_RST0 || current > MARKER_RST7)) {
+                return current;
+            }
+        }
+    }
+
+    private boolean copyBytes(int count) throws IOException {
+        while (count > 0) {
+            if (!fillBuffer()) return false;
+            int length = Math.min(count, bufferLength - bufferPosition);
+            write(buffer, bufferPosition, length);
+            bufferPosition += length;
+            count -= length;
+        }
+        return true;
+    }
+
+    private int copyByte() throws IOException {
+        int current = read();
+        if (current >= 0) {
+            frame.write(current);
+            if (frame.size() > MAX_FRAME_SIZE) {
+                throw new IOException("JPEG frame exceeds " + MAX_FRAME_SIZE + " bytes");
+            }
+        }
+        return current;
+    }
+
+    private void write(byte[] bytes, int offset, int length) throws IOException {
+        frame.write(bytes, offset, length);
+        if (frame.size() > MAX_FRAME_SIZE) {
+            throw new IOException("JPEG frame exceeds " + MAX_FRAME_SIZE + " bytes");
+        }
+    }
+
+    private int read() throws IOException {
+        return fillBuffer() ? buffer[bufferPosition++] & 0xFF : -1;
+    }
+
+    /**
+     * @return false if the buffer is empty and the stream has ended
+     */
+    private boolean fillBuffer() throws IOException {
+        if (bufferPosition == bufferLength) {
+            bufferLength = inputStream.read(buffer, 0, buffer.length);
+            bufferPosition = 0;
+            if (bufferLength <= 0) {
+                bufferLength = 0;
+                return false;
+            }
+        }
+        return true;
+    }
+}
@@ -12,6 +12,9 @@ public abstract class OnSwipeTouchListener implements View.OnTouchListener {
     private final String TAG = "OnSwipeTouchListener";
     private float lastX = -1;
     private float lastY = -1;
+    private float downX = -1;
+    private float downY = -1;
+    private boolean multiTouch = false;
     private ScaleListener scaleListener;
     private ScaleGestureDetector gestureDetector;
     private long time = 0;
@@ -34,12 +37,19 @@ public abstract class OnSwipeTouchListener implements View.OnTouchListener {
         if (gestureDetector != null) {
             gestureDetector.onTouchEvent(event);
         }
+        if (event.getPointerCount() > 1) {
+            multiTouch = true;
+        }
 
         switch (event.getAction()) {
             case MotionEvent.ACTION_DOWN:
 
+                onTouchDown();
                 lastX = event.getX();
                 lastY = event.getY();
+                downX = lastX;
+                downY = lastY;
+                multiTouch = false;
                 break;
 
             case MotionEvent.ACTION_UP:
@@ -49,6 +59,12 @@ public abstract class OnSwipeTouchListener implements View.OnTouchListener {
 
                 if (lastX == upX && lastY == upY) {
                     onClick();
+                } else if (isSwipe(upX - downX, upY - downY)) {
+                    if (upX < downX) {
+                        onSwipeLeft();
+                    } else {
+                        onSwipeRight();
+                    }
                 }
 
                 lastX = -1;
@@ -138,6 +154,18 @@ public abstract class OnSwipeTouchListener implements View.OnTouchListener {
         }
     }
 
+    /**
+     * A horizontal fling across a quarter of the screen, only when the view is not zoomed
+     * in, because dragging a zoomed view pans it instead
+     */
+    private boolean isSwipe(float xDiff, float yDiff) {
+        if (multiTouch || downX < 0 || scaleListener == null
+                || scaleListener.scaleFactor > ScaleListener.MIN_ZOOM) {
+            return false;
+        }
+        return Math.abs(xDiff) > getScreenWidth() / 4 && Math.abs(xDiff) > Math.abs(yDiff) * 2;
+    }
+
     public void isLandscape(boolean landscape) {
         this.isLandscape = landscape;
     }
@@ -186,4 +214,20 @@ public abstract class OnSwipeTouchListener implements View.OnTouchListener {
     }
 
     public abstract void onClick();
+
+    /**
+     * Called when a finger touches the view, before it is known whether it is a click,
+     * a swipe or a pinch
+     */
+    public void onTouchDown() {
+
+    }
+
+    public void onSwipeLeft() {
+
+    }
+
+    public void onSwipeRight() {
+
+    }
 }
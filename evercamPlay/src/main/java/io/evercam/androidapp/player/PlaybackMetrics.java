@@ -0,0 +1,174 @@
+package io.evercam.androidapp.player;
+
+import com.google.android.exoplayer2.C;
+import com.google.android.exoplayer2.ExoPlayer;
+import com.google.android.exoplayer2.Format;
+
+/**
+ * Quality of experience metrics aggregated over one playback session: startup time,
+ * rebuffering, dropped frames, bitrate switches and measured throughput.
+ *
+ * All times are passed in by the caller, so the aggregation doesn't depend on a clock.
+ * Buffering after a seek counts as neither rebuffering nor playing.
+ */
+public class PlaybackMetrics {
+    private final long sessionStartMs;
+
+    private long startupTimeMs = C.TIME_UNSET;
+    private int rebufferCount = 0;
+    private long rebufferTimeMs = 0;
+    private long playingTimeMs = 0;
+    private int droppedFrames = 0;
+    private int bitrateSwitches = 0;
+    private int videoBitrate = Format.NO_VALUE;
+    private long bytesLoaded = 0;
+    private long loadDurationMs = 0;
+    private int loadErrors = 0;
+
+    private boolean hasBeenReady = false;
+    private boolean finished = false;
+    private boolean seeking = false;
+    private long playingSinceMs = C.TIME_UNSET;
+    private long rebufferingSinceMs = C.TIME_UNSET;
+
+    public PlaybackMetrics(long sessionStartMs) {
+        this.sessionStartMs = sessionStartMs;
+    }
+
+    public void onStateChanged(boolean playWhenReady, int playbackState, long nowMs) {
+        if (finished) return;
+        closeIntervals(nowMs);
+
+        if (playbackState != ExoPlayer.STATE_BUFFERING) {
+            seeking = false;
+        }
+
+        if (playbackState == ExoPlayer.STATE_READY && playWhenReady) {
+            hasBeenReady = true;
+            playingSinceMs = nowMs;
+        } else if (playbackState == ExoPlayer.STATE_BUFFERING && playWhenReady && hasBeenReady
+                && !seeking) {
+            rebufferCount++;
+            rebufferingSinceMs = nowMs;
+        }
+    }
+
+    /**
+     * Called before a seek, until the player is ready again its buffering is not a rebuffer
+     */
+    public void onSeek() {
+        seeking = true;
+    }
+
+    public void onFirstFrameRendered(long nowMs) {
+        if (startupTimeMs == C.TIME_UNSET) {
+            startupTimeMs = nowMs - sessionStartMs;
+        }
+    }
+
+    public void onDroppedFrames(int count) {
+        droppedFrames += count;
+    }
+
+    public void onVideoFormatChanged(Format format) {
+        if (format == null || format.bitrate == Format.NO_VALUE) return;
+
+        if (videoBitrate != Format.NO_VALUE && videoBitrate != format.bitrate) {
+            bitrateSwitches++;
+        }
+        videoBitrate = format.bitrate;
+    }
+
+    public void onLoadCompleted(long bytes, long durationMs) {
+        bytesLoaded += bytes;
+        loadDurationMs += durationMs;
+    }
+
+    public void onLoadError() {
+        loadErrors++;
+    }
+
+    /**
+     * Close the session, so that a rebuffer or playback still in progress is counted up to now
+     */
+    public void finish(long nowMs) {
+        if (finished) return;
+        closeIntervals(nowMs);
+        finished = true;
+    }
+
+    private void closeIntervals(long nowMs) {
+        if (playingSinceMs != C.TIME_UNSET) {
+            playingTimeMs += nowMs - playingSinceMs;
+            playingSinceMs = C.TIME_UNSET;
+        }
+        if (rebufferingSinceMs != C.TIME_UNSET) {
+            rebufferTimeMs += nowMs - rebufferingSinceMs;
+            rebufferingSinceMs = C.TIME_UNSET;
+        }
+    }
+
+    /**
+     * @return whether anything was played, sessions that never started are not worth reporting
+     */
+    public boolean hasPlayback() {
+        return hasBeenReady;
+    }
+
+    /**
+     * @return time to the first rendered frame, C.TIME_UNSET if never rendered
+     */
+    public long getStartupTimeMs() {
+        return startupTimeMs;
+    }
+
+    public int getRebufferCount() {
+        return rebufferCount;
+    }
+
+    public long getRebufferTimeMs() {
+        return rebufferTimeMs;
+    }
+
+    public long getPlayingTimeMs() {
+        return playingTimeMs;
+    }
+
+    /**
+     * @return share of the watch time spent rebuffering, from 0 to 1
+     */
+    public float getRebufferRatio() {
+        long watchTimeMs = playingTimeMs + rebufferTimeMs;
+        return watchTimeMs > 0 ? (float) rebufferTimeMs / watchTimeMs : 0;
+    }
+
+    public int getDroppedFrames() {
+        return droppedFrames;
+    }
+
+    public float getDroppedFramesPerMinute() {
+        return playingTimeMs > 0 ? droppedFrames * 60000f / playingTimeMs : 0;
+    }
+
+    public int getBitrateSwitches() {
+        return bitrateSwitches;
+    }
+
+    /**
+     * @return the last selected video bitrate in bits per second, Format.NO_VALUE if unknown
+     */
+    public int getVideoBitrate() {
+        return videoBitrate;
+    }
+
+    /**
+     * @return average throughput of completed loads in bits per second, 0 if nothing loaded
+     */
+    public long getBandwidthEstimate() {
+        return loadDurationMs > 0 ? bytesLoaded * 8000 / loadDurationMs : 0;
+    }
+
+    public int getLoadErrors() {
+        return loadErrors;
+    }
+}
@@ -0,0 +1,76 @@
+package io.evercam.androidapp.player;
+
+import android.net.Uri;
+
+import com.google.android.exoplayer2.C;
+import com.google.android.exoplayer2.upstream.DataSource;
+import com.google.android.exoplayer2.upstream.DataSpec;
+
+import java.io.IOException;
+
+/**
+ * Serves whole-resource requests from data pre-fetched by {@link HlsPreloader}, and
+ * everything else from the upstream data source.
+ */
+final class PreloadingDataSource implements DataSource {
+    private final HlsPreloader preloader;
+    private final DataSource upstream;
+
+    private boolean usingUpstream = false;
+    private byte[] data;
+    private int readPosition;
+    private Uri uri;
+
+    PreloadingDataSource(HlsPreloader preloader, DataSource upstream) {
+        this.preloader = preloader;
+        this.upstream = upstream;
+    }
+
+    @Override
+    public long open(DataSpec dataSpec) throws IOException {
+        if (dataSpec.position == 0 && dataSpec.length == C.LENGTH_UNSET) {
+            byte[] preloaded = preloader.take(dataSpec.uri.toString());
+            if (preloaded != null) {
+                data = preloaded;
+                readPosition = 0;
+                uri = dataSpec.uri;
+                LocalLoads.add(uri.toString());
+                return data.length;
+            }
+        }
+
+        usingUpstream = true;
+        return upstream.open(dataSpec);
+    }
+
+    @Override
+    public int read(byte[] buffer, int offset, int readLength) throws IOException {
+        if (usingUpstream) {
+            return upstream.read(buffer, offset, readLength);
+        }
+
+        int remaining = data.length - readPosition;
+        if (remaining == 0) {
+            return C.RESULT_END_OF_INPUT;
+        }
+        int bytesToRead = Math.min(readLength, remaining);
+        System.arraycopy(data, readPosition, buffer, offset, bytesToRead);
+        readPosition += bytesToRead;
+        return bytesToRead;
+    }
+
+    @Override
+    public Uri getUri() {
+        return usingUpstream ? upstream.getUri() : uri;
+    }
+
+    @Override
+    public void close() throws IOException {
+        data = null;
+        uri = null;
+        if (usingUpstream) {
+            usingUpstream = false;
+            upstream.close();
+        }
+    }
+}
@@ -0,0 +1,160 @@
+package io.evercam.androidapp.player;
+
+import android.net.Uri;
+import android.util.Log;
+
+import com.google.android.exoplayer2.C;
+import com.google.android.exoplayer2.upstream.DataSource;
+import com.google.android.exoplayer2.upstream.DataSpec;
+import com.google.android.exoplayer2.upstream.FileDataSource;
+
+import java.io.BufferedOutputStream;
+import java.io.ByteArrayOutputStream;
+import java.io.File;
+import java.io.FileOutputStream;
+import java.io.IOException;
+import java.io.OutputStream;
+
+/**
+ * Serves HLS segments from {@link HlsSegmentCache} when cached, otherwise reads them from
+ * upstream while writing a copy to the cache. Playlists are read from upstream and
+ * passed to the cache so it knows the duration and sequence number of each segment.
+ */
+final class SegmentCachingDataSource implements DataSource {
+    private final static String TAG = "SegmentCachingDataSource";
+
+    private final HlsSegmentCache cache;
+    private final DataSource upstream;
+    private final String cameraId;
+    private final FileDataSource fileDataSource = new FileDataSource();
+
+    private DataSource currentDataSource;
+    private String url;
+    private boolean reachedEnd;
+    private ByteArrayOutputStream playlistBuffer;
+    private File tempFile;
+    private OutputStream segmentOutputStream;
+
+    SegmentCachingDataSource(HlsSegmentCache cache, DataSource upstream, String cameraId) {
+        this.cache = cache;
+        this.upstream = upstream;
+        this.cameraId = cameraId;
+    }
+
+    @Override
+    public long open(DataSpec dataSpec) throws IOException {
+        url = dataSpec.uri.toString();
+        reachedEnd = false;
+        boolean isWholeResource = dataSpec.position == 0 && dataSpec.length == C.LENGTH_UNSET;
+
+        if (isWholeResource) {
+            File cachedFile = cache.getCachedFile(url);
+            if (cachedFile != null) {
+                currentDataSource = fileDataSource;
+                LocalLoads.add(url);
+                return fileDataSource.open(new DataSpec(Uri.fromFile(cachedFile)));
+            }
+        }
+
+        currentDataSource = upstream;
+        long length = upstream.open(dataSpec);
+
+        if (isWholeResource) {
+            if (isPlaylist(dataSpec.uri)) {
+                playlistBuffer = new ByteArrayOutputStream();
+            } else if (cache.isKnownSegment(url)) {
+                try {
+                    tempFile = cache.createTempFile(cameraId);
+                    segmentOutputStream = new BufferedOutputStream(new FileOutputStream(tempFile));
+                } catch (IOException e) {
+                    Log.e(TAG, e.toString());
+                    discardSegment();
+                }
+            }
+        }
+        return length;
+    }
+
+    @Override
+    public int read(byte[] buffer, int offset, int readLength) throws IOException {
+        int bytesRead = currentDataSource.read(buffer, offset, readLength);
+        if (bytesRead == C.RESULT_END_OF_INPUT) {
+            reachedEnd = true;
+            return bytesRead;
+        }
+
+        if (playlistBuffer != null) {
+            playlistBuffer.write(buffer, offset, bytesRead);
+        }
+        if (segmentOutputStream != null) {
+            try {
+                segmentOutputStream.write(buffer, offset, bytesRead);
+            } catch (IOException e) {
+                //Failing to cache must not fail playback
+                Log.e(TAG, e.toString());
+                discardSegment();
+            }
+        }
+        return bytesRead;
+    }
+
+    @Override
+    public Uri getUri() {
+        return currentDataSource == upstream ? upstream.getUri() : Uri.parse(url);
+    }
+
+    @Override
+    public void close() throws IOException {
+        try {
+            if (currentDataSource != null) {
+                currentDataSource.close();
+            }
+        } finally {
+            currentDataSource = null;
+            finishCaching();
+        }
+    }
+
+    private void finishCaching() {
+        if (playlistBuffer != null) {
+            if (reachedEnd) {
+                cache.onPlaylistLoaded(url, new String(playlistBuffer.toByteArray()));
+            }
+            playlistBuffer = null;
+        }
+
+        if (segmentOutputStream != null) {
+            try {
+                segmentOutputStream.close();
+                segmentOutputStream = null;
+                if (reachedEnd) {
+                    cache.commit(cameraId, url, tempFile);
+                    tempFile = null;
+                }
+            } catch (IOException e) {
+                Log.e(TAG, e.toString());
+            }
+            discardSegment();
+        }
+    }
+
+    private void discardSegment() {
+        if (segmentOutputStream != null) {
+            try {
+                segmentOutputStream.close();
+            } catch (IOException e) {
+                Log.e(TAG, e.toString());
+            }
+            segmentOutputStream = null;
+        }
+        if (tempFile != null) {
+            tempFile.delete();
+            tempFile = null;
+        }
+    }
+
+    private static boolean isPlaylist(Uri uri) {
+        String path = uri.getPath();
+        return path != null && (path.endsWith(".m3u8") || path.endsWith(".m3u"));
+    }
+}
@@ -0,0 +1,68 @@
+package io.evercam.androidapp.ptz;
+
+import android.os.Handler;
+import android.view.MotionEvent;
+import android.view.View;
+import android.view.ViewConfiguration;
+
+/**
+ * Keeps moving the camera while a PTZ button is held down.
+ *
+ * A tap is left to the button's click listener. Once the button is held for a long press,
+ * a relative move step is sent every STEP_INTERVAL_MS, skipped while the previous step is
+ * still in flight so slow cameras don't build up a backlog. Releasing the button drops
+ * the steps that haven't been sent, which stops the camera after the current step.
+ */
+public abstract class ContinuousMoveTouchListener implements View.OnTouchListener {
+    private static final long STEP_INTERVAL_MS = 400;
+
+    private final int pan;
+    private final int tilt;
+    private final int zoom;
+    private final Handler handler = new Handler();
+    private boolean isMoving = false;
+
+    public ContinuousMoveTouchListener(int pan, int tilt, int zoom) {
+        this.pan = pan;
+        this.tilt = tilt;
+        this.zoom = zoom;
+    }
+
+    /**
+     * @return the queue of the camera currently shown
+     */
+    protected abstract PTZCommandQueue getQueue();
+
+    private final Runnable stepRunnable = new Runnable() {
+        @Override
+        public void run() {
+            isMoving = true;
+            PTZCommandQueue queue = getQueue();
+            if (queue.isIdle()) {
+                queue.move(pan, tilt, zoom);
+            }
+            handler.postDelayed(this, STEP_INTERVAL_MS);
+        }
+    };
+
+    @Override
+    public boolean onTouch(View view, MotionEvent event) {
+        switch (event.getActionMasked()) {
+            case MotionEvent.ACTION_DOWN:
+                handler.postDelayed(stepRunnable, ViewConfiguration.getLongPressTimeout());
+                break;
+            case MotionEvent.ACTION_UP:
+            case MotionEvent.ACTION_CANCEL:
+                handler.removeCallbacks(stepRunnable);
+                if (isMoving) {
+                    isMoving = false;
+                    getQueue().cancel();
+                    //Consume the release so it doesn't trigger another move by click
+                    view.setPressed(false);
+                    return true;
+                }
+                break;
+        }
+        return false;
+    }
+}
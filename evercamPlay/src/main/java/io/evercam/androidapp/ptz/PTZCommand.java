@@ -0,0 +1,96 @@
+package io.evercam.androidapp.ptz;
+
+import android.os.SystemClock;
+
+import io.evercam.PTZControl;
+import io.evercam.PTZRelativeBuilder;
+
+/**
+ * A PTZ command waiting in {@link PTZCommandQueue}.
+ *
+ * Relative moves keep their net pan, tilt and zoom so consecutive moves can be merged
+ * into one request. Absolute commands (home and preset recall) are sent as they are.
+ */
+public class PTZCommand {
+    private final PTZControl absoluteControl;
+    /* Positive pans right, negative pans left */
+    private int pan;
+    /* Positive tilts up, negative tilts down */
+    private int tilt;
+    private int zoom;
+    /* The time the oldest merged command was queued, for latency measurement */
+    private final long queuedAtMs;
+
+    private PTZCommand(PTZControl absoluteControl, int pan, int tilt, int zoom) {
+        this.absoluteControl = absoluteControl;
+        this.pan = pan;
+        this.tilt = tilt;
+        this.zoom = zoom;
+        this.queuedAtMs = SystemClock.elapsedRealtime();
+    }
+
+    public static PTZCommand relative(int pan, int tilt, int zoom) {
+        return new PTZCommand(null, pan, tilt, zoom);
+    }
+
+    /**
+     * @param control a PTZHome or PTZPresetControl that moves the camera to a fixed position
+     */
+    public static PTZCommand absolute(PTZControl control) {
+        return new PTZCommand(control, 0, 0, 0);
+    }
+
+    public boolean isRelative() {
+        return absoluteControl == null;
+    }
+
+    /**
+     * Whether the command has no effect, e.g. a left move merged with a right move
+     */
+    public boolean isEmpty() {
+        return isRelative() && pan == 0 && tilt == 0 && zoom == 0;
+    }
+
+    public void merge(PTZCommand other) {
+        if (!isRelative() || !other.isRelative()) {
+            throw new IllegalArgumentException("Only relative moves can be merged");
+        }
+        pan += other.pan;
+        tilt += other.tilt;
+        zoom += other.zoom;
+    }
+
+    public int getPan() {
+        return pan;
+    }
+
+    public int getTilt() {
+        return tilt;
+    }
+
+    public int getZoom() {
+        return zoom;
+    }
+
+    public long getQueuedAtMs() {
+        return queuedAtMs;
+    }
+
+    public PTZControl toControl(String cameraId) {
+        if (!isRelative()) return absoluteControl;
+
+        PTZRelativeBuilder builder = new PTZRelativeBuilder(cameraId);
+        if (pan > 0) builder.right(pan);
+        else if (pan < 0) builder.left(-pan);
+        if (tilt > 0) builder.up(tilt);
+        else if (tilt < 0) builder.down(-tilt);
+        if (zoom != 0) builder.zoom(zoom);
+        return builder.build();
+    }
+
+    @Override
+    public String toString() {
+        if (!isRelative()) return absoluteControl.getClass().getSimpleName();
+        return "Relative pan: " + pan + " tilt: " + tilt + " zoom: " + zoom;
+    }
+}
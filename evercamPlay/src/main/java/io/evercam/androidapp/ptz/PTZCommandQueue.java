@@ -0,0 +1,147 @@
+package io.evercam.androidapp.ptz;
+
+import android.os.SystemClock;
+import android.util.Log;
+
+import java.util.HashMap;
+import java.util.LinkedList;
+import java.util.concurrent.Executor;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+
+import io.evercam.PTZControl;
+import io.evercam.PTZException;
+
+/**
+ * Sends PTZ commands to one camera, one at a time and in the order they were queued.
+ *
+ * While a command is in flight, new relative moves are merged into the last queued one,
+ * so a burst of taps results in a single request. Queuing a home or preset recall drops
+ * everything still waiting, because the camera would end up at the preset anyway.
+ */
+public class PTZCommandQueue {
+    private final static String TAG = "PTZCommandQueue";
+
+    private static final HashMap<String, PTZCommandQueue> queues = new HashMap<>();
+    private static final ExecutorService sharedExecutor = Executors.newCachedThreadPool();
+
+    private final String cameraId;
+    private final Executor executor;
+    private final LinkedList<PTZCommand> pendingCommands = new LinkedList<>();
+    private boolean isRunning = false;
+
+    private long lastLatencyMs = 0;
+    private long totalLatencyMs = 0;
+    private int completedCount = 0;
+
+    public static synchronized PTZCommandQueue forCamera(String cameraId) {
+        PTZCommandQueue queue = queues.get(cameraId);
+        if (queue == null) {
+            queue = new PTZCommandQueue(cameraId, sharedExecutor);
+            queues.put(cameraId, queue);
+        }
+        return queue;
+    }
+
+    PTZCommandQueue(String cameraId, Executor executor) {
+        this.cameraId = cameraId;
+        this.executor = executor;
+    }
+
+    public void move(int pan, int tilt, int zoom) {
+        enqueue(PTZCommand.relative(pan, tilt, zoom));
+    }
+
+    public void moveTo(PTZControl control) {
+        enqueue(PTZCommand.absolute(control));
+    }
+
+    public synchronized void enqueue(PTZCommand command) {
+        if (command.isRelative()) {
+            PTZCommand lastCommand = pendingCommands.peekLast();
+            if (lastCommand != null && lastCommand.isRelative()) {
+                lastCommand.merge(command);
+            } else {
+                pendingCommands.addLast(command);
+            }
+        } else {
+            pendingCommands.clear();
+            pendingCommands.addLast(command);
+        }
+
+        if (!isRunning) {
+            isRunning = true;
+            executor.execute(drainRunnable);
+        }
+    }
+
+    /**
+     * Drop all commands that haven't been sent yet. The one in flight can't be recalled.
+     */
+    public synchronized void cancel() {
+        pendingCommands.clear();
+    }
+
+    /**
+     * @return true if no command is waiting or in flight
+     */
+    public synchronized boolean isIdle() {
+        return !isRunning;
+    }
+
+    synchronized int getPendingCount() {
+        return pendingCommands.size();
+    }
+
+    synchronized PTZCommand peekPending() {
+        return pendingCommands.peekFirst();
+    }
+
+    /**
+     * @return the time from queuing to completion of the last command, 0 if none completed
+     */
+    public synchronized long getLastLatencyMs() {
+        return lastLatencyMs;
+    }
+
+    public synchronized long getAverageLatencyMs() {
+        return completedCount == 0 ? 0 : totalLatencyMs / completedCount;
+    }
+
+    private synchronized PTZCommand nextCommand() {
+        PTZCommand command = pendingCommands.pollFirst();
+        if (command == null) {
+            isRunning = false;
+        }
+        return command;
+    }
+
+    private synchronized void recordLatency(long latencyMs) {
+        lastLatencyMs = latencyMs;
+        totalLatencyMs += latencyMs;
+        completedCount++;
+    }
+
+    private final Runnable drainRunnable = new Runnable() {
+        @Override
+        public void run() {
+            PTZCommand command;
+            while ((command = nextCommand()) != null) {
+                if (command.isEmpty()) continue;
+                send(command);
+            }
+        }
+    };
+
+    private void send(PTZCommand command) {
+        try {
+            command.toControl(cameraId).move();
+            long latencyMs = SystemClock.elapsedRealtime() - command.getQueuedAtMs();
+            recordLatency(latencyMs);
+            Log.d(TAG, command + " completed in " + latencyMs + "ms, average: "
+                    + getAverageLatencyMs() + "ms");
+        } catch (PTZException e) {
+            Log.e(TAG, e.getMessage());
+        }
+    }
+}
@@ -0,0 +1,304 @@
+package io.evercam.androidapp.routing;
+
+import android.content.BroadcastReceiver;
+import android.content.Context;
+import android.content.Intent;
+import android.content.IntentFilter;
+import android.net.ConnectivityManager;
+import android.os.SystemClock;
+import android.util.Log;
+
+import java.io.IOException;
+import java.util.ArrayList;
+import java.util.Collections;
+import java.util.HashSet;
+import java.util.LinkedHashMap;
+import java.util.List;
+import java.util.Locale;
+import java.util.Map;
+import java.util.concurrent.Callable;
+import java.util.concurrent.ExecutionException;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.Future;
+import java.util.concurrent.TimeUnit;
+
+import io.evercam.API;
+import io.evercam.androidapp.dto.EvercamCamera;
+import io.evercam.androidapp.http.SharedHttpClient;
+import io.evercam.androidapp.utils.Commons;
+import io.evercam.androidapp.utils.NetInfo;
+import okhttp3.Credentials;
+import okhttp3.HttpUrl;
+import okhttp3.OkHttpClient;
+import okhttp3.Request;
+import okhttp3.Response;
+
+/**
+ * Decides how camera media is fetched on the network the phone is on: straight from the
+ * camera's local address, from its public address, or through Evercam.
+ *
+ * Every route of a camera is probed at once and the fastest working one is kept in a
+ * {@link RouteTable} keyed by the network, so moving between sites or from WiFi to mobile
+ * data picks the right route again without a new probe for networks seen recently.
+ * Cameras used recently are probed again in the background when the connectivity
+ * changes. Callers get a decision straight away, or null while the first probe runs.
+ */
+public class RouteSelector {
+    private final static String TAG = "RouteSelector";
+    private final static long DECISION_TTL_MS = TimeUnit.MINUTES.toMillis(10);
+    private final static int PROBE_TIMEOUT_SECONDS = 4;
+    private final static int MAX_RECENT_CAMERAS = 8;
+    /* Cameras probed at the same time, a camera list can ask for all of them at once */
+    private final static int MAX_PARALLEL_PROBES = 3;
+
+    private final static RouteTable routeTable = new RouteTable(DECISION_TTL_MS);
+    private final static ExecutorService probeExecutor = Executors.newFixedThreadPool
+            (MAX_PARALLEL_PROBES);
+    private final static ExecutorService requestExecutor = Executors.newCachedThreadPool();
+    private final static OkHttpClient client = SharedHttpClient.getUncached().newBuilder()
+            .connectTimeout(PROBE_TIMEOUT_SECONDS, TimeUnit.SECONDS)
+            .readTimeout(PROBE_TIMEOUT_SECONDS, TimeUnit.SECONDS)
+            .build();
+
+    /* Network and camera pairs being probed */
+    private final static HashSet<String> probing = new HashSet<>();
+    private final static LinkedHashMap<String, EvercamCamera> recentCameras =
+            new LinkedHashMap<String, EvercamCamera>(MAX_RECENT_CAMERAS, 0.75f, true) {
+                @Override
+                protected boolean removeEldestEntry(Map.Entry<String, EvercamCamera> eldest) {
+                    return size() > MAX_RECENT_CAMERAS;
+                }
+            };
+    private static Context appContext;
+    private static String currentNetworkKey;
+
+    /**
+     * Start watching connectivity changes, called once when the app starts
+     */
+    public static synchronized void init(Context context) {
+        if (appContext != null) return;
+        appContext = context.getApplicationContext();
+        currentNetworkKey = new NetInfo(appContext).getNetworkKey();
+        appContext.registerReceiver(new BroadcastReceiver() {
+            @Override
+            public void onReceive(Context context, Intent intent) {
+                onConnectivityChanged();
+            }
+        }, new IntentFilter(ConnectivityManager.CONNECTIVITY_ACTION));
+    }
+
+    /**
+     * @return the route decided for the camera on the current network, or null if it is
+     * not known yet, in which case a probe is started
+     */
+    public static RouteTable.Decision getDecision(Context context, EvercamCamera camera) {
+        String networkKey = new NetInfo(context.getApplicationContext()).getNetworkKey();
+        synchronized (RouteSelector.class) {
+            recentCameras.put(camera.getCameraId(), camera);
+        }
+
+        RouteTable.Decision decision = routeTable.get(networkKey, camera.getCameraId(),
+                SystemClock.elapsedRealtime());
+        if (decision == null) {
+            probeAsync(networkKey, camera);
+        }
+        return decision;
+    }
+
+    /**
+     * @return the decided route, or the given one if it is not known yet
+     */
+    public static RouteTable.Route getRoute(Context context, EvercamCamera camera,
+                                            RouteTable.Route fallback) {
+        RouteTable.Decision decision = getDecision(context, camera);
+        return decision != null ? decision.getRoute() : fallback;
+    }
+
+    /**
+     * A route that was chosen failed while in use, forget it and probe again
+     */
+    public static void reportFailure(Context context, EvercamCamera camera,
+                                     RouteTable.Route route) {
+        String networkKey = new NetInfo(context.getApplicationContext()).getNetworkKey();
+        routeTable.invalidate(networkKey, camera.getCameraId(), route);
+        probeAsync(networkKey, camera);
+    }
+
+    public static synchronized void clear() {
+        routeTable.clear();
+        recentCameras.clear();
+    }
+
+    /**
+     * The URL to fetch a still image of the camera over the route, the cloud route uses
+     * the Evercam live snapshot so that probing it measures a real round trip to the camera
+     *
+     * @return the URL, or null if the camera has none for the route
+     */
+    public static String getSnapshotUrl(EvercamCamera camera, RouteTable.Route route) {
+        String url;
+        switch (route) {
+            case INTERNAL:
+                url = camera.getInternalSnapshotUrl();
+                break;
+            case EXTERNAL:
+                url = camera.getExternalSnapshotUrl();
+                break;
+            default:
+                url = getLiveSnapshotUrl(camera);
+        }
+        return url == null || url.isEmpty() ? null : url;
+    }
+
+    /**
+     * @return the basic authorization header value for the camera's own addresses, or null.
+     * Credentials only go to the local address or over HTTPS, never in clear text across
+     * the internet.
+     */
+    public static String getAuthorization(EvercamCamera camera, RouteTable.Route route) {
+        if (!camera.hasCredentials() || !isSecureForCredentials(camera, route)) return null;
+        return Credentials.basic(camera.getUsername(), camera.getPassword());
+    }
+
+    private static boolean isSecureForCredentials(EvercamCamera camera, RouteTable.Route route) {
+        switch (route) {
+            case INTERNAL:
+                return true;
+            case EXTERNAL:
+                String url = camera.getExternalSnapshotUrl();
+                return url != null && url.toLowerCase(Locale.ENGLISH).startsWith("https://");
+            default:
+                return false;
+        }
+    }
+
+    private static String getLiveSnapshotUrl(EvercamCamera camera) {
+        if (!API.hasUserKeyPair()) return null;
+        HttpUrl url = HttpUrl.parse(API.URL + "cameras/" + camera.getCameraId()
+                + "/live/snapshot.jpg");
+        if (url == null) return null;
+        return url.newBuilder().addQueryParameter("api_key", API.getUserKeyPair()[0])
+                .addQueryParameter("api_id", API.getUserKeyPair()[1]).build().toString();
+    }
+
+    private static void onConnectivityChanged() {
+        final String networkKey = new NetInfo(appContext).getNetworkKey();
+        ArrayList<EvercamCamera> cameras;
+        synchronized (RouteSelector.class) {
+            if (networkKey.equals(currentNetworkKey)) return;
+            currentNetworkKey = networkKey;
+            cameras = new ArrayList<>(recentCameras.values());
+        }
+        Log.d(TAG, "Network changed to " + networkKey + ", probing " + cameras.size()
+                + " cameras");
+
+        routeTable.trim(SystemClock.elapsedRealtime());
+        for (EvercamCamera camera : cameras) {
+            if (routeTable.get(networkKey, camera.getCameraId(), SystemClock.elapsedRealtime())
+                    == null) {
+                probeAsync(networkKey, camera);
+            }
+        }
+    }
+
+    private static void probeAsync(final String networkKey, final EvercamCamera camera) {
+        final String probeKey = networkKey + "/" + camera.getCameraId();
+        synchronized (RouteSelector.class) {
+            if (!probing.add(probeKey)) return;
+        }
+
+        probeExecutor.execute(new Runnable() {
+            @Override
+            public void run() {
+                try {
+                    RouteTable.Decision decision = routeTable.put(networkKey, camera
+                            .getCameraId(), probe(camera), SystemClock.elapsedRealtime());
+                    Log.d(TAG, camera.getCameraId() + " on " + networkKey + ": " + decision);
+                } finally {
+                    synchronized (RouteSelector.class) {
+                        probing.remove(probeKey);
+                    }
+                }
+            }
+        });
+    }
+
+    /**
+     * Probe every route of the camera at the same time, blocking
+     */
+    static List<RouteTable.Probe> probe(final EvercamCamera camera) {
+        ArrayList<Future<RouteTable.Probe>> futures = new ArrayList<>();
+        for (final RouteTable.Route route : RouteTable.Route.values()) {
+            if (route == RouteTable.Route.INTERNAL && !isOnCameraNetwork(camera)) continue;
+            //Without a secure way to send the credentials, Evercam fetches from the public address
+            if (route == RouteTable.Route.EXTERNAL && camera.hasCredentials()
+                    && !isSecureForCredentials(camera, route)) continue;
+
+            futures.add(requestExecutor.submit(new Callable<RouteTable.Probe>() {
+                @Override
+                public RouteTable.Probe call() {
+                    return probeRoute(camera, route);
+                }
+            }));
+        }
+
+        ArrayList<RouteTable.Probe> probes = new ArrayList<>();
+        for (Future<RouteTable.Probe> future : futures) {
+            try {
+                probes.add(future.get());
+            } catch (InterruptedException e) {
+                Thread.currentThread().interrupt();
+                return Collections.emptyList();
+            } catch (ExecutionException e) {
+                Log.e(TAG, e.toString());
+            }
+        }
+        return probes;
+    }
+
+    private static RouteTable.Probe probeRoute(EvercamCamera camera, RouteTable.Route route) {
+        String url = getSnapshotUrl(camera, route);
+        if (url == null) return new RouteTable.Probe(route, false, 0);
+
+        Request.Builder builder;
+        try {
+            builder = new Request.Builder().url(url);
+        } catch (IllegalArgumentException e) {
+            Log.e(TAG, e.toString());
+            return new RouteTable.Probe(route, false, 0);
+        }
+        String authorization = getAuthorization(camera, route);
+        if (authorization != null) {
+            builder.header("Authorization", authorization);
+        }
+
+        long startTime = SystemClock.elapsedRealtime();
+        Response response = null;
+        try {
+            response = client.newCall(builder.build()).execute();
+            //A route only works if it returns an image
+            boolean isSuccessful = response.isSuccessful() && isJpeg(response.body().bytes());
+            return new RouteTable.Probe(route, isSuccessful, SystemClock.elapsedRealtime()
+                    - startTime);
+        } catch (IOException e) {
+            Log.e(TAG, route + " " + e.toString());
+            return new RouteTable.Probe(route, false, 0);
+        } finally {
+            if (response != null) {
+                response.close();
+            }
+        }
+    }
+
+    private static boolean isOnCameraNetwork(EvercamCamera camera) {
+        String internalHost = camera.getInternalHost();
+        return appContext != null && Commons.isLocalIp(internalHost)
+                && new NetInfo(appContext).isInSubnet(internalHost);
+    }
+
+    private static boolean isJpeg(byte[] data) {
+        return data != null && data.length > 2 && (data[0] & 0xFF) == 0xFF
+                && (data[1] & 0xFF) == 0xD8;
+    }
+}
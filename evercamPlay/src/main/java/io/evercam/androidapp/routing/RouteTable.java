@@ -0,0 +1,172 @@
+package io.evercam.androidapp.routing;
+
+import java.util.HashMap;
+import java.util.Iterator;
+import java.util.List;
+import java.util.Map;
+
+/**
+ * The route chosen for each camera on each network the phone has been on.
+ *
+ * A decision is made from one probe of every route: the working route with the lowest
+ * round trip wins, with the cloud as the answer when nothing worked. Decisions expire
+ * after a while, so a camera that moved or a network that changed is probed again.
+ */
+public class RouteTable {
+
+    public enum Route {
+        /* Straight to the camera's local address */
+        INTERNAL,
+        /* Straight to the camera's public address */
+        EXTERNAL,
+        /* Through the Evercam media servers */
+        CLOUD
+    }
+
+    public static class Probe {
+        private final Route route;
+        private final boolean isSuccessful;
+        private final long rttMs;
+
+        public Probe(Route route, boolean isSuccessful, long rttMs) {
+            this.route = route;
+            this.isSuccessful = isSuccessful;
+            this.rttMs = rttMs;
+        }
+
+        public Route getRoute() {
+            return route;
+        }
+
+        public boolean isSuccessful() {
+            return isSuccessful;
+        }
+
+        public long getRttMs() {
+            return rttMs;
+        }
+
+        @Override
+        public String toString() {
+            return route + (isSuccessful ? " " + rttMs + "ms" : " failed");
+        }
+    }
+
+    public static class Decision {
+        private final Route route;
+        private final long rttMs;
+        private final boolean isVerified;
+        private final long decidedTime;
+
+        Decision(Route route, long rttMs, boolean isVerified, long decidedTime) {
+            this.route = route;
+            this.rttMs = rttMs;
+            this.isVerified = isVerified;
+            this.decidedTime = decidedTime;
+        }
+
+        public Route getRoute() {
+            return route;
+        }
+
+        public long getRttMs() {
+            return rttMs;
+        }
+
+        /**
+         * @return false if no route worked and the cloud is only the fallback
+         */
+        public boolean isVerified() {
+            return isVerified;
+        }
+
+        public long getDecidedTime() {
+            return decidedTime;
+        }
+
+        @Override
+        public String toString() {
+            return route + (isVerified ? " " + rttMs + "ms" : " unverified");
+        }
+    }
+
+    private final long ttlMs;
+    private final HashMap<String, Decision> decisions = new HashMap<>();
+
+    public RouteTable(long ttlMs) {
+        this.ttlMs = ttlMs;
+    }
+
+    /**
+     * @return the working route with the lowest round trip. On a tie the more direct
+     * route wins, when nothing worked it is an unverified cloud route.
+     */
+    public static Decision choose(List<Probe> probes, long now) {
+        Probe best = null;
+        for (Probe probe : probes) {
+            if (!probe.isSuccessful()) continue;
+            if (best == null || probe.getRttMs() < best.getRttMs() || (probe.getRttMs() == best
+                    .getRttMs() && probe.getRoute().ordinal() < best.getRoute().ordinal())) {
+                best = probe;
+            }
+        }
+        if (best == null) {
+            return new Decision(Route.CLOUD, 0, false, now);
+        }
+        return new Decision(best.getRoute(), best.getRttMs(), true, now);
+    }
+
+    /**
+     * @return the decision for the camera on the network, or null if there is none or it
+     * has expired
+     */
+    public synchronized Decision get(String networkKey, String cameraId, long now) {
+        Decision decision = decisions.get(getKey(networkKey, cameraId));
+        if (decision == null || now - decision.getDecidedTime() > ttlMs) {
+            return null;
+        }
+        return decision;
+    }
+
+    public synchronized Decision put(String networkKey, String cameraId, List<Probe> probes,
+                                     long now) {
+        Decision decision = choose(probes, now);
+        decisions.put(getKey(networkKey, cameraId), decision);
+        return decision;
+    }
+
+    /**
+     * Forget the decision if it is for this route, so the camera is probed again
+     */
+    public synchronized void invalidate(String networkKey, String cameraId, Route route) {
+        String key = getKey(networkKey, cameraId);
+        Decision decision = decisions.get(key);
+        if (decision != null && decision.getRoute() == route) {
+            decisions.remove(key);
+        }
+    }
+
+    /**
+     * Drop expired decisions of every network
+     */
+    public synchronized void trim(long now) {
+        Iterator<Map.Entry<String, Decision>> iterator = decisions.entrySet().iterator();
+        while (iterator.hasNext()) {
+            if (now - iterator.next().getValue().getDecidedTime() > ttlMs) {
+                iterator.remove();
+            }
+        }
+    }
+
+    public synchronized void clear() {
+        decisions.clear();
+    }
+
+    public synchronized int size() {
+        return decisions.size();
+    }
+
+    private static String getKey(String networkKey, String cameraId) {
+        return networkKey + "/" + cameraId;
+    }
+}
@@ -0,0 +1,216 @@
+package io.evercam.androidapp.rtsp;
+
+import java.io.ByteArrayOutputStream;
+
+/**
+ * Rebuilds H.264 access units from RTP payloads (RFC 6184).
+ *
+ * Single NAL unit packets, STAP-A aggregates and FU-A fragments are supported, which
+ * covers packetization modes 0 and 1 used by IP cameras. Each access unit is written in
+ * Annex B format, NAL units prefixed by start codes, ready to queue to a decoder. An
+ * access unit ends at the RTP marker bit, or when the timestamp changes if the marker
+ * was lost. After a lost packet frames are dropped until the next key frame, so the
+ * decoder never gets a frame referencing a broken one.
+ *
+ * Not thread safe, packets are pushed in order from the receiving thread.
+ */
+public class H264Depacketizer {
+    public final static int NAL_TYPE_IDR = 5;
+    public final static int NAL_TYPE_SPS = 7;
+    public final static int NAL_TYPE_PPS = 8;
+    private final static int NAL_TYPE_STAP_A = 24;
+    private final static int NAL_TYPE_FU_A = 28;
+    private final static byte[] START_CODE = {0, 0, 0, 1};
+
+    public static class AccessUnit {
+        private final byte[] data;
+        private final long timestamp;
+        private final long arrivalTimeMs;
+        private final boolean isKeyFrame;
+
+        AccessUnit(byte[] data, long timestamp, long arrivalTimeMs, boolean isKeyFrame) {
+            this.data = data;
+            this.timestamp = timestamp;
+            this.arrivalTimeMs = arrivalTimeMs;
+            this.isKeyFrame = isKeyFrame;
+        }
+
+        /**
+         * @return the NAL units of the access unit, each prefixed by a start code
+         */
+        public byte[] getData() {
+            return data;
+        }
+
+        /**
+         * @return the RTP timestamp of the access unit
+         */
+        public long getTimestamp() {
+            return timestamp;
+        }
+
+        /**
+         * @return when the first packet of the access unit arrived
+         */
+        public long getArrivalTimeMs() {
+            return arrivalTimeMs;
+        }
+
+        public boolean isKeyFrame() {
+            return isKeyFrame;
+        }
+    }
+
+    public interface Listener {
+        void onAccessUnit(AccessUnit accessUnit);
+
+        /**
+         * Called with each SPS or PPS seen in the stream, without start code
+         */
+        void onParameterSet(int nalType, byte[] nalUnit);
+    }
+
+    private final Listener listener;
+    private final RtspMetrics metrics;
+    private final ByteArrayOutputStream accessUnit = new ByteArrayOutputStream(64 * 1024);
+    private long timestamp = -1;
+    private long arrivalTimeMs;
+    private boolean isKeyFrame = false;
+    private boolean hasParameterSet = false;
+    private boolean isCorrupted = false;
+    private boolean isFragmenting = false;
+    private boolean isWaitingForKeyFrame = true;
+    private int lastSequenceNumber = -1;
+
+    public H264Depacketizer(Listener listener, RtspMetrics metrics) {
+        this.listener = listener;
+        this.metrics = metrics;
+    }
+
+    public void push(RtpPacket packet) {
+        //A lost packet may belong to the unfinished access unit or to this one
+        boolean isGap = lastSequenceNumber >= 0 && packet.getSequenceNumber()
+                != ((lastSequenceNumber + 1) & 0xFFFF);
+        lastSequenceNumber = packet.getSequenceNumber();
+
+        if (packet.getTimestamp() != timestamp) {
+            if (isGap && accessUnit.size() > 0) {
+                isCorrupted = true;
+            }
+            finishAccessUnit();
+            timestamp = packet.getTimestamp();
+            arrivalTimeMs = packet.getArrivalTimeMs();
+        }
+        if (isGap) {
+            isCorrupted = true;
+            isFragmenting = false;
+        }
+
+        byte[] data = packet.getData();
+        int offset = packet.getPayloadOffset();
+        int length = packet.getPayloadLength();
+        if (length > 0) {
+            int nalType = data[offset] & 0x1F;
+            if (nalType >= 1 && nalType <= 23) {
+                writeNalUnit(data, offset, length);
+            } else if (nalType == NAL_TYPE_STAP_A) {
+                readAggregate(data, offset + 1, length - 1);
+            } else if (nalType == NAL_TYPE_FU_A) {
+                readFragment(data, offset, length);
+            }
+        }
+
+        if (packet.isMarker()) {
+            finishAccessUnit();
+        }
+    }
+
+    private void readAggregate(byte[] data, int offset, int length) {
+        int end = offset + length;
+        while (offset + 2 <= end) {
+            int size = RtpPacket.readUnsigned16(data, offset);
+            offset += 2;
+            if (size == 0 || offset + size > end) {
+                isCorrupted = true;
+                return;
+            }
+            writeNalUnit(data, offset, size);
+            offset += size;
+        }
+    }
+
+    private void readFragment(byte[] data, int offset, int length) {
+        if (length < 2) return;
+        int indicator = data[offset] & 0xFF;
+        int header = data[offset + 1] & 0xFF;
+        boolean isStart = (header & 0x80) != 0;
+        boolean isEnd = (header & 0x40) != 0;
+        int nalType = header & 0x1F;
+
+        if (isStart) {
+            accessUnit.write(START_CODE, 0, START_CODE.length);
+            accessUnit.write((indicator & 0xE0) | nalType);
+            if (nalType == NAL_TYPE_IDR) {
+                isKeyFrame = true;
+            }
+            isFragmenting = true;
+        } else if (!isFragmenting) {
+            //The start of this NAL unit was lost
+            isCorrupted = true;
+            return;
+        }
+        accessUnit.write(data, offset + 2, length - 2);
+        if (isEnd) {
+            isFragmenting = false;
+        }
+    }
+
+    private void writeNalUnit(byte[] data, int offset, int length) {
+        int nalType = data[offset] & 0x1F;
+        if (nalType == NAL_TYPE_IDR) {
+            isKeyFrame = true;
+        } else if (nalType == NAL_TYPE_SPS || nalType == NAL_TYPE_PPS) {
+            byte[] nalUnit = new byte[length];
+            System.arraycopy(data, offset, nalUnit, 0, length);
+            listener.onParameterSet(nalType, nalUnit);
+            hasParameterSet = true;
+        }
+        accessUnit.write(START_CODE, 0, START_CODE.length);
+        accessUnit.write(data, offset, length);
+    }
+
+    private void finishAccessUnit() {
+        if (accessUnit.size() == 0) {
+            //Every NAL unit of the frame was lost
+            if (isCorrupted) {
+                isWaitingForKeyFrame = true;
+                metrics.onFrameDropped();
+            }
+            isCorrupted = false;
+            return;
+        }
+
+        if (isFragmenting) {
+            //The end of the last NAL unit was lost
+            isCorrupted = true;
+        }
+        //Parameter sets sent on their own are kept, the key frame after needs them
+        if (isCorrupted || (isWaitingForKeyFrame && !isKeyFrame && !hasParameterSet)) {
+            isWaitingForKeyFrame = true;
+            metrics.onFrameDropped();
+        } else {
+            if (isKeyFrame) {
+                isWaitingForKeyFrame = false;
+            }
+            metrics.onFrameAssembled();
+            listener.onAccessUnit(new AccessUnit(accessUnit.toByteArray(), timestamp,
+                    arrivalTimeMs, isKeyFrame));
+        }
+
+        accessUnit.reset();
+        isKeyFrame = false;
+        hasParameterSet = false;
+        isCorrupted = false;
+        isFragmenting = false;
+    }
+}
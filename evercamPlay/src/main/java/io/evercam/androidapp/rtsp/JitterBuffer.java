@@ -0,0 +1,123 @@
+package io.evercam.androidapp.rtsp;
+
+import java.util.Map;
+import java.util.TreeMap;
+
+/**
+ * Puts RTP packets back in sequence order.
+ *
+ * A packet is released as soon as every packet before it has been released, or once it
+ * has waited delayMs for the missing ones, which are then counted as lost. Packets
+ * arriving after their turn are dropped as late. Sequence numbers are extended past
+ * 16 bits so the order holds across wrap around.
+ *
+ * Not thread safe, packets are pushed and polled from the receiving thread.
+ */
+public class JitterBuffer {
+    private final static int SEQUENCE_MODULO = 1 << 16;
+    private final static int DEFAULT_CAPACITY = 512;
+
+    private final RtspMetrics metrics;
+    private final int clockRate;
+    private final long delayMs;
+    private final int capacity;
+    private final TreeMap<Long, RtpPacket> packets = new TreeMap<>();
+
+    private long highestSequence = -1;
+    private long nextSequence = -1;
+    /* Interarrival jitter in timestamp units, RFC 3550 A.8 */
+    private double jitter = 0;
+    private long lastTransit = Long.MIN_VALUE;
+
+    public JitterBuffer(RtspMetrics metrics, int clockRate, long delayMs) {
+        this(metrics, clockRate, delayMs, DEFAULT_CAPACITY);
+    }
+
+    public JitterBuffer(RtspMetrics metrics, int clockRate, long delayMs, int capacity) {
+        this.metrics = metrics;
+        this.clockRate = clockRate;
+        this.delayMs = delayMs;
+        this.capacity = capacity;
+    }
+
+    /**
+     * @param packet a packet with its arrival time set
+     */
+    public void push(RtpPacket packet) {
+        metrics.onPacketReceived();
+        updateJitter(packet);
+
+        long sequence = extend(packet.getSequenceNumber());
+        if (nextSequence >= 0 && sequence < nextSequence) {
+            metrics.onPacketLate();
+            return;
+        }
+        if (packets.containsKey(sequence)) {
+            metrics.onPacketDuplicate();
+            return;
+        }
+        packets.put(sequence, packet);
+        highestSequence = Math.max(highestSequence, sequence);
+    }
+
+    /**
+     * @return the next packet in order, or null if it should be waited for
+     */
+    public RtpPacket poll(long nowMs) {
+        Map.Entry<Long, RtpPacket> first = packets.firstEntry();
+        if (first == null) return null;
+
+        long sequence = first.getKey();
+        RtpPacket packet = first.getValue();
+        boolean isNext = nextSequence < 0 || sequence == nextSequence;
+        boolean hasWaited = nowMs - packet.getArrivalTimeMs() >= delayMs;
+        if (!isNext && !hasWaited && packets.size() < capacity) return null;
+
+        if (!isNext) {
+            metrics.onPacketsLost(sequence - nextSequence);
+        }
+        packets.remove(sequence);
+        nextSequence = sequence + 1;
+        metrics.onBufferDelay(Math.max(0, nowMs - packet.getArrivalTimeMs()));
+        return packet;
+    }
+
+    public int size() {
+        return packets.size();
+    }
+
+    public double getJitterMs() {
+        return jitter * 1000 / clockRate;
+    }
+
+    /**
+     * The sequence number extended by the wrap arounds seen, picking the cycle closest
+     * to the highest sequence so far
+     */
+    long extend(int sequenceNumber) {
+        if (highestSequence < 0) return sequenceNumber + SEQUENCE_MODULO;
+
+        long cycle = highestSequence & ~(long) (SEQUENCE_MODULO - 1);
+        long sequence = cycle | sequenceNumber;
+        if (sequence - highestSequence > SEQUENCE_MODULO / 2) {
+            sequence -= SEQUENCE_MODULO;
+        } else if (highestSequence - sequence > SEQUENCE_MODULO / 2) {
+            sequence += SEQUENCE_MODULO;
+        }
+        return sequence;
+    }
+
+    private void updateJitter(RtpPacket packet) {
+        long arrival = packet.getArrivalTimeMs() * clockRate / 1000;
+        long transit = arrival - packet.getTimestamp();
+        if (lastTransit != Long.MIN_VALUE) {
+            long difference = transit - lastTransit;
+            //Timestamps wrap around at 32 bits
+            if (difference > Integer.MAX_VALUE) difference -= 1L << 32;
+            if (difference < Integer.MIN_VALUE) difference += 1L << 32;
+            jitter += (Math.abs(difference) - jitter) / 16;
+            metrics.setJitterMs(getJitterMs());
+        }
+        lastTransit = transit;
+    }
+}
@@ -0,0 +1,45 @@
+package io.evercam.androidapp.rtsp;
+
+/**
+ * Turns RTP timestamps into presentation times counted from the first timestamp.
+ *
+ * RTP timestamps wrap around at 32 bits, so each one is extended to the cycle closest
+ * to the highest timestamp so far and presentation times keep increasing across the
+ * wrap. Not thread safe, used from the receiving thread.
+ */
+public class PresentationClock {
+    private final static long TIMESTAMP_MODULO = 1L << 32;
+
+    private final int clockRate;
+    private boolean hasTimestamp = false;
+    private long firstTimestamp;
+    private long highestTimestamp;
+
+    public PresentationClock(int clockRate) {
+        this.clockRate = clockRate;
+    }
+
+    public long toPresentationTimeUs(long timestamp) {
+        long extendedTimestamp = extend(timestamp);
+        if (!hasTimestamp) {
+            hasTimestamp = true;
+            firstTimestamp = extendedTimestamp;
+            highestTimestamp = extendedTimestamp;
+        } else if (extendedTimestamp > highestTimestamp) {
+            highestTimestamp = extendedTimestamp;
+        }
+        return (extendedTimestamp - firstTimestamp) * 1000000L / clockRate;
+    }
+
+    private long extend(long timestamp) {
+        if (!hasTimestamp) return timestamp;
+
+        long extendedTimestamp = (highestTimestamp & ~(TIMESTAMP_MODULO - 1)) | timestamp;
+        if (extendedTimestamp - highestTimestamp > TIMESTAMP_MODULO / 2) {
+            extendedTimestamp -= TIMESTAMP_MODULO;
+        } else if (highestTimestamp - extendedTimestamp > TIMESTAMP_MODULO / 2) {
+            extendedTimestamp += TIMESTAMP_MODULO;
+        }
+        return extendedTimestamp;
+    }
+}
@@ -0,0 +1,129 @@
+package io.evercam.androidapp.rtsp;
+
+/**
+ * One RTP packet (RFC 3550), with the payload located past the CSRC list, header
+ * extension and padding.
+ */
+public class RtpPacket {
+    public final static int HEADER_SIZE = 12;
+    private final static int VERSION = 2;
+
+    private final byte[] data;
+    private final int payloadOffset;
+    private final int payloadLength;
+    private final int payloadType;
+    private final boolean marker;
+    private final int sequenceNumber;
+    private final long timestamp;
+    private final long ssrc;
+    private long arrivalTimeMs;
+
+    private RtpPacket(byte[] data, int payloadOffset, int payloadLength, int payloadType,
+                      boolean marker, int sequenceNumber, long timestamp, long ssrc) {
+        this.data = data;
+        this.payloadOffset = payloadOffset;
+        this.payloadLength = payloadLength;
+        this.payloadType = payloadType;
+        this.marker = marker;
+        this.sequenceNumber = sequenceNumber;
+        this.timestamp = timestamp;
+        this.ssrc = ssrc;
+    }
+
+    /**
+     * Parse a packet, the bytes are copied so the buffer can be reused
+     *
+     * @return the packet, or null if the bytes are not a valid RTP packet
+     */
+    public static RtpPacket parse(byte[] buffer, int offset, int length) {
+        if (length < HEADER_SIZE) return null;
+
+        byte[] data = new byte[length];
+        System.arraycopy(buffer, offset, data, 0, length);
+
+        int first = data[0] & 0xFF;
+        if (first >> 6 != VERSION) return null;
+        boolean hasPadding = (first & 0x20) != 0;
+        boolean hasExtension = (first & 0x10) != 0;
+        int csrcCount = first & 0x0F;
+
+        int second = data[1] & 0xFF;
+        boolean marker = (second & 0x80) != 0;
+        int payloadType = second & 0x7F;
+        int sequenceNumber = readUnsigned16(data, 2);
+        long timestamp = readUnsigned32(data, 4);
+        long ssrc = readUnsigned32(data, 8);
+
+        int payloadOffset = HEADER_SIZE + csrcCount * 4;
+        if (hasExtension) {
+            if (payloadOffset + 4 > length) return null;
+            payloadOffset += 4 + readUnsigned16(data, payloadOffset + 2) * 4;
+        }
+        int end = length;
+        if (hasPadding) {
+            end -= data[length - 1] & 0xFF;
+        }
+        if (payloadOffset > end) return null;
+
+        return new RtpPacket(data, payloadOffset, end - payloadOffset, payloadType, marker,
+                sequenceNumber, timestamp, ssrc);
+    }
+
+    public byte[] getData() {
+        return data;
+    }
+
+    public int getPayloadOffset() {
+        return payloadOffset;
+    }
+
+    public int getPayloadLength() {
+        return payloadLength;
+    }
+
+    public int getPayloadType() {
+        return payloadType;
+    }
+
+    /**
+     * For H.264, set on the last packet of an access unit
+     */
+    public boolean isMarker() {
+        return marker;
+    }
+
+    public int getSequenceNumber() {
+        return sequenceNumber;
+    }
+
+    public long getTimestamp() {
+        return timestamp;
+    }
+
+    public long getSsrc() {
+        return ssrc;
+    }
+
+    public long getArrivalTimeMs() {
+        return arrivalTimeMs;
+    }
+
+    public RtpPacket setArrivalTimeMs(long arrivalTimeMs) {
+        this.arrivalTimeMs = arrivalTimeMs;
+        return this;
+    }
+
+    static int readUnsigned16(byte[] data, int offset) {
+        return ((data[offset] & 0xFF) << 8) | (data[offset + 1] & 0xFF);
+    }
+
+    static long readUnsigned32(byte[] data, int offset) {
+        return ((long) readUnsigned16(data, offset) << 16) | readUnsigned16(data, offset + 2);
+    }
+
+    @Override
+    public String toString() {
+        return "RTP pt=" + payloadType + " seq=" + sequenceNumber + " ts=" + timestamp
+                + (marker ? " M" : "") + " " + payloadLength + "B";
+    }
+}
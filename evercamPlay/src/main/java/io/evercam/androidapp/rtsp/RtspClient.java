@@ -0,0 +1,415 @@
+package io.evercam.androidapp.rtsp;
+
+import java.io.BufferedInputStream;
+import java.io.ByteArrayOutputStream;
+import java.io.Closeable;
+import java.io.DataInputStream;
+import java.io.IOException;
+import java.io.InputStream;
+import java.io.OutputStream;
+import java.net.InetSocketAddress;
+import java.net.Socket;
+import java.net.URI;
+import java.net.URISyntaxException;
+import java.net.URLDecoder;
+import java.util.Locale;
+import java.util.Map;
+import java.util.TreeMap;
+import java.util.regex.Matcher;
+import java.util.regex.Pattern;
+
+import okio.ByteString;
+
+/**
+ * A minimal RTSP client (RFC 2326) that receives one H.264 track interleaved on the RTSP
+ * connection.
+ *
+ * RTP over the RTSP TCP connection needs no extra ports, so it works through the same
+ * address and port as the RTSP URL. Basic and digest authentication are supported, with
+ * credentials given or taken from the URL. The session is kept alive from the receive loop.
+ *
+ * All calls block, so the client runs on its own thread; {@link #close()} may be called
+ * from any thread to stop it.
+ */
+public class RtspClient implements Closeable {
+    private final static String USER_AGENT = "Evercam Play";
+    private final static int DEFAULT_PORT = 554;
+    private final static int DEFAULT_SESSION_TIMEOUT_SECONDS = 60;
+    private final static int RTP_CHANNEL = 0;
+    private final static int MAX_HEADER_LINE = 8192;
+    private final static Pattern AUTH_PARAMETER = Pattern.compile("(\\w+)=(\"([^\"]*)\"|[^,\\s]*)");
+
+    public static class Response {
+        private final int statusCode;
+        private final String statusLine;
+        private final TreeMap<String, String> headers = new TreeMap<>(String.CASE_INSENSITIVE_ORDER);
+        private String body = "";
+
+        Response(String statusLine) throws IOException {
+            this.statusLine = statusLine;
+            String[] fields = statusLine.split(" ", 3);
+            if (fields.length < 2 || !fields[0].startsWith("RTSP/")) {
+                throw new IOException("Invalid RTSP status line: " + statusLine);
+            }
+            try {
+                statusCode = Integer.parseInt(fields[1]);
+            } catch (NumberFormatException e) {
+                throw new IOException("Invalid RTSP status line: " + statusLine);
+            }
+        }
+
+        public int getStatusCode() {
+            return statusCode;
+        }
+
+        public String getHeader(String name) {
+            return headers.get(name);
+        }
+
+        public String getBody() {
+            return body;
+        }
+
+        public boolean isSuccessful() {
+            return statusCode >= 200 && statusCode < 300;
+        }
+
+        @Override
+        public String toString() {
+            return statusLine;
+        }
+    }
+
+    public interface PacketListener {
+        void onRtpPacket(RtpPacket packet);
+    }
+
+    private final String url;
+    private final String host;
+    private final int port;
+    private final String username;
+    private final String password;
+
+    private Socket socket;
+    private DataInputStream inputStream;
+    private OutputStream outputStream;
+    private int cSeq = 0;
+    private String session;
+    private int sessionTimeoutSeconds = DEFAULT_SESSION_TIMEOUT_SECONDS;
+    private String contentBase;
+    private Map<String, String> challenge;
+    private boolean isDigest = false;
+    private volatile boolean isClosed = false;
+
+    /**
+     * @param username null to use the credentials in the URL, if any
+     */
+    public RtspClient(String url, String username, String password) throws IOException {
+        URI uri;
+        try {
+            uri = new URI(url);
+        } catch (URISyntaxException e) {
+            throw new IOException("Invalid RTSP URL: " + url);
+        }
+        if (!"rtsp".equalsIgnoreCase(uri.getScheme()) || uri.getHost() == null) {
+            throw new IOException("Invalid RTSP URL: " + url);
+        }
+        host = uri.getHost();
+        port = uri.getPort() > 0 ? uri.getPort() : DEFAULT_PORT;
+
+        String userInfo = uri.getRawUserInfo();
+        if (username == null && userInfo != null) {
+            String[] credentials = userInfo.split(":", 2);
+            username = URLDecoder.decode(credentials[0], "UTF-8");
+            password = credentials.length > 1 ? URLDecoder.decode(credentials[1], "UTF-8") : "";
+        }
+        this.username = username;
+        this.password = password;
+
+        //Credentials are sent in headers, not in the request URL
+        this.url = withoutUserInfo(uri);
+    }
+
+    /**
+     * @return the RTSP URL without the credentials in it, safe to log or report, or null
+     * if it is not a valid RTSP URL
+     */
+    public static String stripCredentials(String url) {
+        try {
+            URI uri = new URI(url);
+            if (!"rtsp".equalsIgnoreCase(uri.getScheme()) || uri.getHost() == null) return null;
+            return withoutUserInfo(uri);
+        } catch (URISyntaxException e) {
+            return null;
+        }
+    }
+
+    private static String withoutUserInfo(URI uri) {
+        return "rtsp://" + uri.getHost() + (uri.getPort() > 0 ? ":" + uri.getPort() : "")
+                + (uri.getRawPath() != null ? uri.getRawPath() : "")
+                + (uri.getRawQuery() != null ? "?" + uri.getRawQuery() : "");
+    }
+
+    public String getUrl() {
+        return url;
+    }
+
+    public void connect(int timeoutMs) throws IOException {
+        socket = new Socket();
+        socket.setTcpNoDelay(true);
+        socket.connect(new InetSocketAddress(host, port), timeoutMs);
+        socket.setSoTimeout(timeoutMs);
+        inputStream = new DataInputStream(new BufferedInputStream(socket.getInputStream()));
+        outputStream = socket.getOutputStream();
+    }
+
+    public Response options() throws IOException {
+        return send("OPTIONS", url, null);
+    }
+
+    public SessionDescription describe() throws IOException {
+        Response response = send("DESCRIBE", url, "Accept: application/sdp\r\n");
+        String base = response.getHeader("Content-Base");
+        if (base == null) base = response.getHeader("Content-Location");
+        contentBase = base != null ? base : url;
+        return SessionDescription.parse(response.getBody());
+    }
+
+    /**
+     * Set up the track with RTP interleaved on channel 0 and RTCP on channel 1
+     */
+    public void setup(SessionDescription description) throws IOException {
+        Response response = send("SETUP", description.getVideoControlUrl(contentBase),
+                "Transport: RTP/AVP/TCP;unicast;interleaved=" + RTP_CHANNEL + "-"
+                        + (RTP_CHANNEL + 1) + "\r\n");
+        String sessionHeader = response.getHeader("Session");
+        if (sessionHeader == null) {
+            throw new IOException("No session in SETUP response");
+        }
+        String[] fields = sessionHeader.split(";");
+        session = fields[0].trim();
+        for (int index = 1; index < fields.length; index++) {
+            String[] pair = fields[index].trim().split("=", 2);
+            if (pair.length == 2 && pair[0].equalsIgnoreCase("timeout")) {
+                try {
+                    sessionTimeoutSeconds = Integer.parseInt(pair[1].trim());
+                } catch (NumberFormatException e) {
+                    //Keep the default
+                }
+            }
+        }
+    }
+
+    public void play() throws IOException {
+        send("PLAY", contentBase, "Range: npt=0.000-\r\n");
+    }
+
+    /**
+     * Receive RTP packets until the connection is closed. Responses to the keep alive
+     * requests sent meanwhile are read and skipped.
+     */
+    public void receive(PacketListener listener) throws IOException {
+        long keepAliveIntervalMs = sessionTimeoutSeconds * 1000L / 2;
+        long lastKeepAliveTime = System.currentTimeMillis();
+        byte[] buffer = new byte[65536];
+
+        while (!isClosed) {
+            int first = inputStream.read();
+            if (first < 0) throw new IOException("RTSP connection closed");
+
+            if (first == '$') {
+                int channel = inputStream.readUnsignedByte();
+                int length = inputStream.readUnsignedShort();
+                inputStream.readFully(buffer, 0, length);
+                if (channel == RTP_CHANNEL) {
+                    RtpPacket packet = RtpPacket.parse(buffer, 0, length);
+                    if (packet != null) {
+                        listener.onRtpPacket(packet.setArrivalTimeMs(System.currentTimeMillis()));
+                    }
+                }
+            } else if (first != '\r' && first != '\n') {
+                //A response to a keep alive, or a request from the server
+                readLine();
+                skipHeadersAndBody();
+            }
+
+            //OPTIONS is the keep alive every camera supports
+            if (System.currentTimeMillis() - lastKeepAliveTime > keepAliveIntervalMs) {
+                lastKeepAliveTime = System.currentTimeMillis();
+                write("OPTIONS", url, null);
+            }
+        }
+    }
+
+    public void teardown() {
+        if (session == null || socket == null || socket.isClosed()) return;
+        try {
+            write("TEARDOWN", contentBase, null);
+        } catch (IOException e) {
+            //Closing anyway
+        }
+    }
+
+    @Override
+    public void close() {
+        isClosed = true;
+        if (socket != null) {
+            try {
+                socket.close();
+            } catch (IOException e) {
+                //Already closed
+            }
+        }
+    }
+
+    /**
+     * Send a request and read its response, answering an authentication challenge once
+     */
+    Response send(String method, String requestUrl, String extraHeaders) throws IOException {
+        write(method, requestUrl, extraHeaders);
+        Response response = readResponseSkippingData();
+        if (response.getStatusCode() == 401 && username != null && challenge == null) {
+            String authenticate = response.getHeader("WWW-Authenticate");
+            if (authenticate != null) {
+                isDigest = authenticate.trim().toLowerCase(Locale.ENGLISH).startsWith("digest");
+                challenge = parseAuthParameters(authenticate);
+                write(method, requestUrl, extraHeaders);
+                response = readResponseSkippingData();
+            }
+        }
+        if (!response.isSuccessful()) {
+            throw new IOException(method + " failed: " + response);
+        }
+        return response;
+    }
+
+    private void write(String method, String requestUrl, String extraHeaders) throws
+            IOException {
+        StringBuilder request = new StringBuilder();
+        request.append(method).append(' ').append(requestUrl).append(" RTSP/1.0\r\n");
+        request.append("CSeq: ").append(++cSeq).append("\r\n");
+        request.append("User-Agent: ").append(USER_AGENT).append("\r\n");
+        if (session != null) {
+            request.append("Session: ").append(session).append("\r\n");
+        }
+        String authorization = getAuthorization(method, requestUrl);
+        if (authorization != null) {
+            request.append("Authorization: ").append(authorization).append("\r\n");
+        }
+        if (extraHeaders != null) {
+            request.append(extraHeaders);
+        }
+        request.append("\r\n");
+        outputStream.write(request.toString().getBytes("UTF-8"));
+        outputStream.flush();
+    }
+
+    private String getAuthorization(String method, String requestUrl) {
+        if (username == null || challenge == null) return null;
+        if (!isDigest) {
+            return "Basic " + ByteString.encodeUtf8(username + ":" + password).base64();
+        }
+        String realm = challenge.get("realm");
+        String nonce = challenge.get("nonce");
+        return "Digest username=\"" + username + "\", realm=\"" + realm + "\", nonce=\""
+                + nonce + "\", uri=\"" + requestUrl + "\", response=\"" + digestResponse
+                (username, password, realm, nonce, method, requestUrl) + "\"";
+    }
+
+    /**
+     * The digest response without qop, as RTSP cameras expect it
+     */
+    static String digestResponse(String username, String password, String realm,
+                                 String nonce, String method, String uri) {
+        String ha1 = md5Hex(username + ":" + realm + ":" + password);
+        String ha2 = md5Hex(method + ":" + uri);
+        return md5Hex(ha1 + ":" + nonce + ":" + ha2);
+    }
+
+    static Map<String, String> parseAuthParameters(String header) {
+        TreeMap<String, String> parameters = new TreeMap<>(String.CASE_INSENSITIVE_ORDER);
+        Matcher matcher = AUTH_PARAMETER.matcher(header);
+        while (matcher.find()) {
+            parameters.put(matcher.group(1), matcher.group(3) != null ? matcher.group(3)
+                    : matcher.group(2));
+        }
+        return parameters;
+    }
+
+    private static String md5Hex(String value) {
+        return ByteString.encodeUtf8(value).md5().hex();
+    }
+
+    /**
+     * Read the next response, skipping RTP data the server may already be sending
+     */
+    private Response readResponseSkippingData() throws IOException {
+        while (true) {
+            int first = inputStream.read();
+            if (first < 0) throw new IOException("RTSP connection closed");
+            if (first == '$') {
+                inputStream.readUnsignedByte();
+                int length = inputStream.readUnsignedShort();
+                inputStream.skipBytes(length);
+                continue;
+            }
+            if (first == '\r' || first == '\n') continue;
+
+            Response response = new Response(((char) first + readLine()).trim());
+            response.headers.putAll(readHeaders());
+            response.body = new String(readBody(response.headers), "UTF-8");
+            return response;
+        }
+    }
+
+    private void skipHeadersAndBody() throws IOException {
+        readBody(readHeaders());
+    }
+
+    private Map<String, String> readHeaders() throws IOException {
+        TreeMap<String, String> headers = new TreeMap<>(String.CASE_INSENSITIVE_ORDER);
+        String line;
+        while (!(line = readLine()).isEmpty()) {
+            int colon = line.indexOf(':');
+            if (colon > 0) {
+                headers.put(line.substring(0, colon).trim(), line.substring(colon + 1).trim());
+            }
+        }
+        return headers;
+    }
+
+    private byte[] readBody(Map<String, String> headers) throws IOException {
+        String contentLength = headers.get("Content-Length");
+        if (contentLength == null) return new byte[0];
+        int length;
+        try {
+            length = Integer.parseInt(contentLength.trim());
+        } catch (NumberFormatException e) {
+            throw new IOException("Invalid Content-Length: " + contentLength);
+        }
+        byte[] body = new byte[length];
+        inputStream.readFully(body);
+        return body;
+    }
+
+    private String readLine() throws IOException {
+        return readLine(inputStream);
+    }
+
+    static String readLine(InputStream inputStream) throws IOException {
+        ByteArrayOutputStream line = new ByteArrayOutputStream();
+        int current;
+        while ((current = inputStream.read()) >= 0 && current != '\n') {
+            if (current != '\r') {
+                line.write(current);
+            }
+            if (line.size() > MAX_HEADER_LINE) {
+                throw new IOException("RTSP header line too long");
+            }
+        }
+        if (current < 0 && line.size() == 0) {
+            throw new IOException("RTSP connection closed");
+        }
+        return line.toString("UTF-8");
+    }
+}
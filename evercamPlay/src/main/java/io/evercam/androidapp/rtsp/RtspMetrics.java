@@ -0,0 +1,128 @@
+package io.evercam.androidapp.rtsp;
+
+import java.util.Locale;
+
+/**
+ * Counters of one RTSP session, updated from the receiving thread and read from any.
+ *
+ * Jitter is the RFC 3550 interarrival jitter. Buffer delay is the time a packet waited in
+ * the {@link JitterBuffer}, frame latency the time from the first packet of a frame
+ * arriving to the frame being rendered.
+ */
+public class RtspMetrics {
+    private long packetsReceived = 0;
+    private long packetsLost = 0;
+    private long packetsLate = 0;
+    private long packetsDuplicate = 0;
+    private double jitterMs = 0;
+    private long bufferDelaySumMs = 0;
+    private long bufferDelayCount = 0;
+    private long maxBufferDelayMs = 0;
+    private long framesAssembled = 0;
+    private long framesDropped = 0;
+    private long framesRendered = 0;
+    private long frameLatencySumMs = 0;
+    private long maxFrameLatencyMs = 0;
+
+    synchronized void onPacketReceived() {
+        packetsReceived++;
+    }
+
+    synchronized void onPacketsLost(long count) {
+        packetsLost += count;
+    }
+
+    synchronized void onPacketLate() {
+        packetsLate++;
+    }
+
+    synchronized void onPacketDuplicate() {
+        packetsDuplicate++;
+    }
+
+    synchronized void setJitterMs(double jitterMs) {
+        this.jitterMs = jitterMs;
+    }
+
+    synchronized void onBufferDelay(long delayMs) {
+        bufferDelaySumMs += delayMs;
+        bufferDelayCount++;
+        maxBufferDelayMs = Math.max(maxBufferDelayMs, delayMs);
+    }
+
+    synchronized void onFrameAssembled() {
+        framesAssembled++;
+    }
+
+    synchronized void onFrameDropped() {
+        framesDropped++;
+    }
+
+    public synchronized void onFrameRendered(long latencyMs) {
+        framesRendered++;
+        frameLatencySumMs += latencyMs;
+        maxFrameLatencyMs = Math.max(maxFrameLatencyMs, latencyMs);
+    }
+
+    public synchronized long getPacketsReceived() {
+        return packetsReceived;
+    }
+
+    public synchronized long getPacketsLost() {
+        return packetsLost;
+    }
+
+    public synchronized long getPacketsLate() {
+        return packetsLate;
+    }
+
+    public synchronized long getPacketsDuplicate() {
+        return packetsDuplicate;
+    }
+
+    public synchronized float getLossRatio() {
+        long expected = packetsReceived + packetsLost;
+        return expected == 0 ? 0 : (float) packetsLost / expected;
+    }
+
+    public synchronized double getJitterMs() {
+        return jitterMs;
+    }
+
+    public synchronized long getAverageBufferDelayMs() {
+        return bufferDelayCount == 0 ? 0 : bufferDelaySumMs / bufferDelayCount;
+    }
+
+    public synchronized long getMaxBufferDelayMs() {
+        return maxBufferDelayMs;
+    }
+
+    public synchronized long getFramesAssembled() {
+        return framesAssembled;
+    }
+
+    public synchronized long getFramesDropped() {
+        return framesDropped;
+    }
+
+    public synchronized long getFramesRendered() {
+        return framesRendered;
+    }
+
+    public synchronized long getAverageFrameLatencyMs() {
+        return framesRendered == 0 ? 0 : frameLatencySumMs / framesRendered;
+    }
+
+    public synchronized long getMaxFrameLatencyMs() {
+        return maxFrameLatencyMs;
+    }
+
+    @Override
+    public synchronized String toString() {
+        return "packets " + packetsReceived + " lost " + packetsLost + " late " + packetsLate
+                + ", jitter " + String.format(Locale.ENGLISH, "%.1f", jitterMs) + "ms, buffer "
+                + getAverageBufferDelayMs() + "/" + maxBufferDelayMs + "ms, frames "
+                + framesRendered + "/" + framesAssembled + " dropped " + framesDropped
+                + ", latency " + getAverageFrameLatencyMs() + "/" + maxFrameLatencyMs + "ms";
+    }
+}
@@ -0,0 +1,344 @@
+package io.evercam.androidapp.rtsp;
+
+import android.media.MediaCodec;
+import android.media.MediaFormat;
+import android.os.Handler;
+import android.os.Looper;
+import android.os.SystemClock;
+import android.util.Log;
+import android.view.Surface;
+
+import java.io.IOException;
+import java.nio.ByteBuffer;
+import java.util.HashMap;
+import java.util.List;
+
+/**
+ * Plays the H.264 track of an RTSP stream to a surface with as little delay as possible.
+ *
+ * Packets from the {@link RtspClient} go through a short {@link JitterBuffer} and the
+ * {@link H264Depacketizer}, and each access unit is queued to a MediaCodec decoder as
+ * soon as it is complete. Decoded frames are rendered at once instead of being scheduled
+ * by timestamp, which is what keeps the latency low on a local network.
+ *
+ * Listener methods are called on the main thread. The decoder keeps the surface until the
+ * worker thread has finished, so errors are only reported, and release callbacks only
+ * run, once the surface is free for another player.
+ */
+public class RtspPlayer {
+    private final static String TAG = "RtspPlayer";
+    private final static String MIME_TYPE = "video/avc";
+    private final static int CONNECT_TIMEOUT_MS = 5000;
+    private final static long JITTER_BUFFER_DELAY_MS = 60;
+    private final static long INPUT_TIMEOUT_US = 10000;
+    private final static int MAX_INPUT_ATTEMPTS = 20;
+    private final static long METRICS_LOG_INTERVAL_MS = 10000;
+    private final static int MAX_FRAMES_IN_DECODER = 64;
+    /* Decoders read the real size from the SPS, this is only the buffer hint */
+    private final static int DEFAULT_WIDTH = 1920;
+    private final static int DEFAULT_HEIGHT = 1080;
+
+    public interface Listener {
+        void onFirstFrameRendered();
+
+        void onVideoSizeChanged(int width, int height);
+
+        void onError(Exception e);
+    }
+
+    private final String url;
+    private final String username;
+    private final String password;
+    private final Surface surface;
+    private final Listener listener;
+    private final Handler mainHandler = new Handler(Looper.getMainLooper());
+    private final RtspMetrics metrics = new RtspMetrics();
+
+    private volatile boolean isReleased = false;
+    private final Object finishLock = new Object();
+    private boolean isFinished = false;
+    private Runnable onReleased;
+    private boolean isStarted = false;
+    private volatile RtspClient client;
+    private MediaCodec codec;
+    private byte[] sps;
+    private byte[] pps;
+    private boolean isFirstFrameRendered = false;
+    private long lastMetricsLogTime;
+    private PresentationClock presentationClock;
+    /* Arrival time of the access units being decoded, by presentation time */
+    private final HashMap<Long, Long> arrivalTimes = new HashMap<>();
+
+    /**
+     * @param username null to use the credentials in the URL, if any
+     */
+    public RtspPlayer(String url, String username, String password, Surface surface,
+                      Listener listener) {
+        this.url = url;
+        this.username = username;
+        this.password = password;
+        this.surface = surface;
+        this.listener = listener;
+    }
+
+    public RtspMetrics getMetrics() {
+        return metrics;
+    }
+
+    public void start() {
+        synchronized (finishLock) {
+            isStarted = true;
+        }
+        new Thread(new Runnable() {
+            @Override
+            public void run() {
+                Exception error = null;
+                try {
+                    play();
+                } catch (Exception e) {
+                    if (!isReleased) {
+                        Log.e(TAG, e.toString());
+                        error = e;
+                    }
+                } finally {
+                    releaseResources();
+                    onFinished(error);
+                }
+            }
+        }, TAG).start();
+    }
+
+    /**
+     * Stop playing, can be called from any thread
+     *
+     * @param onReleased run on the main thread once the decoder has let go of the surface,
+     *                   may be null
+     */
+    public void release(Runnable onReleased) {
+        isReleased = true;
+        RtspClient rtspClient = client;
+        if (rtspClient != null) {
+            rtspClient.close();
+        }
+        Log.d(TAG, "Released: " + metrics);
+
+        if (onReleased == null) return;
+        synchronized (finishLock) {
+            if (isStarted && !isFinished) {
+                this.onReleased = onReleased;
+                return;
+            }
+        }
+        mainHandler.post(onReleased);
+    }
+
+    private void onFinished(final Exception error) {
+        final Runnable releasedRunnable;
+        synchronized (finishLock) {
+            isFinished = true;
+            releasedRunnable = onReleased;
+        }
+        mainHandler.post(new Runnable() {
+            @Override
+            public void run() {
+                if (error != null && !isReleased) {
+                    listener.onError(error);
+                }
+                if (releasedRunnable != null) {
+                    releasedRunnable.run();
+                }
+            }
+        });
+    }
+
+    private void play() throws IOException {
+        client = new RtspClient(url, username, password);
+        if (isReleased) return;
+        client.connect(CONNECT_TIMEOUT_MS);
+        client.options();
+        SessionDescription description = client.describe();
+        if (!description.hasH264Video()) {
+            throw new IOException("No H.264 video track at " + client.getUrl());
+        }
+        int clockRate = description.getClockRate();
+        presentationClock = new PresentationClock(clockRate);
+        sps = description.getSps();
+        pps = description.getPps();
+        client.setup(description);
+        client.play();
+
+        final JitterBuffer jitterBuffer = new JitterBuffer(metrics, clockRate,
+                JITTER_BUFFER_DELAY_MS);
+        final H264Depacketizer depacketizer = new H264Depacketizer(new H264Depacketizer
+                .Listener() {
+            @Override
+            public void onAccessUnit(H264Depacketizer.AccessUnit accessUnit) {
+                decode(accessUnit);
+            }
+
+            @Override
+            public void onParameterSet(int nalType, byte[] nalUnit) {
+                if (nalType == H264Depacketizer.NAL_TYPE_SPS) {
+                    sps = nalUnit;
+                } else {
+                    pps = nalUnit;
+                }
+            }
+        }, metrics);
+        final int payloadType = description.getPayloadType();
+
+        lastMetricsLogTime = SystemClock.elapsedRealtime();
+        client.receive(new RtspClient.PacketListener() {
+            @Override
+            public void onRtpPacket(RtpPacket packet) {
+                if (packet.getPayloadType() != payloadType) return;
+                jitterBuffer.push(packet);
+                RtpPacket orderedPacket;
+                while ((orderedPacket = jitterBuffer.poll(System.currentTimeMillis())) != null) {
+                    depacketizer.push(orderedPacket);
+                }
+                drainOutput();
+                logMetrics();
+            }
+        });
+    }
+
+    private void decode(H264Depacketizer.AccessUnit accessUnit) {
+        if (codec == null && !configureCodec()) {
+            //Wait for the parameter sets
+            return;
+        }
+
+        //Free input buffers by rendering what is decoded, skipping a frame would break
+        //the frames referencing it
+        int index = -1;
+        for (int attempt = 0; attempt < MAX_INPUT_ATTEMPTS && index < 0; attempt++) {
+            index = codec.dequeueInputBuffer(INPUT_TIMEOUT_US);
+            if (index < 0) {
+                drainOutput();
+            }
+        }
+        if (index < 0) {
+            metrics.onFrameDropped();
+            return;
+        }
+        ByteBuffer buffer = getInputBuffer(index);
+        byte[] data = accessUnit.getData();
+        if (buffer == null || buffer.capacity() < data.length) {
+            codec.queueInputBuffer(index, 0, 0, 0, 0);
+            metrics.onFrameDropped();
+            return;
+        }
+        buffer.clear();
+        buffer.put(data);
+
+        long presentationTimeUs = presentationClock.toPresentationTimeUs(accessUnit.getTimestamp());
+        if (arrivalTimes.size() > MAX_FRAMES_IN_DECODER) {
+            //Frames the decoder dropped never come out
+            arrivalTimes.clear();
+        }
+        arrivalTimes.put(presentationTimeUs, accessUnit.getArrivalTimeMs());
+        codec.queueInputBuffer(index, 0, data.length, presentationTimeUs,
+                accessUnit.isKeyFrame() ? MediaCodec.BUFFER_FLAG_KEY_FRAME : 0);
+    }
+
+    private boolean configureCodec() {
+        if (sps == null || pps == null) return false;
+        try {
+            MediaFormat format = MediaFormat.createVideoFormat(MIME_TYPE, DEFAULT_WIDTH,
+                    DEFAULT_HEIGHT);
+            List<byte[]> csd = SessionDescription.toCodecSpecificData(sps, pps);
+            format.setByteBuffer("csd-0", ByteBuffer.wrap(csd.get(0)));
+            format.setByteBuffer("csd-1", ByteBuffer.wrap(csd.get(1)));
+            codec = MediaCodec.createDecoderByType(MIME_TYPE);
+            codec.configure(format, surface, null, 0);
+            codec.start();
+            return true;
+        } catch (IOException | IllegalStateException | IllegalArgumentException e) {
+            throw new IllegalStateException("H.264 decoder failed: " + e.toString());
+        }
+    }
+
+    private void drainOutput() {
+        if (codec == null) return;
+        MediaCodec.BufferInfo info = new MediaCodec.BufferInfo();
+        while (true) {
+            int index = codec.dequeueOutputBuffer(info, 0);
+            if (index == MediaCodec.INFO_OUTPUT_FORMAT_CHANGED) {
+                onOutputFormatChanged(codec.getOutputFormat());
+            } else if (index >= 0) {
+                codec.releaseOutputBuffer(index, true);
+                Long arrivalTime = arrivalTimes.remove(info.presentationTimeUs);
+                if (arrivalTime != null) {
+                    metrics.onFrameRendered(System.currentTimeMillis() - arrivalTime);
+                }
+                if (!isFirstFrameRendered) {
+                    isFirstFrameRendered = true;
+                    mainHandler.post(new Runnable() {
+                        @Override
+                        public void run() {
+                            if (!isReleased) {
+                                listener.onFirstFrameRendered();
+                            }
+                        }
+                    });
+                }
+            } else if (index != MediaCodec.INFO_OUTPUT_BUFFERS_CHANGED) {
+                return;
+            }
+        }
+    }
+
+    private void onOutputFormatChanged(MediaFormat format) {
+        int width = format.getInteger(MediaFormat.KEY_WIDTH);
+        int height = format.getInteger(MediaFormat.KEY_HEIGHT);
+        if (format.containsKey("crop-left") && format.containsKey("crop-right")) {
+            width = format.getInteger("crop-right") + 1 - format.getInteger("crop-left");
+        }
+        if (format.containsKey("crop-top") && format.containsKey("crop-bottom")) {
+            height = format.getInteger("crop-bottom") + 1 - format.getInteger("crop-top");
+        }
+        final int videoWidth = width;
+        final int videoHeight = height;
+        mainHandler.post(new Runnable() {
+            @Override
+            public void run() {
+                if (!isReleased) {
+                    listener.onVideoSizeChanged(videoWidth, videoHeight);
+                }
+            }
+        });
+    }
+
+    @SuppressWarnings("deprecation")
+    private ByteBuffer getInputBuffer(int index) {
+        if (android.os.Build.VERSION.SDK_INT >= 21) {
+            return codec.getInputBuffer(index);
+        }
+        return codec.getInputBuffers()[index];
+    }
+
+    private void logMetrics() {
+        long now = SystemClock.elapsedRealtime();
+        if (now - lastMetricsLogTime > METRICS_LOG_INTERVAL_MS) {
+            lastMetricsLogTime = now;
+            Log.d(TAG, metrics.toString());
+        }
+    }
+
+    private void releaseResources() {
+        if (client != null) {
+            client.teardown();
+            client.close();
+        }
+        if (codec != null) {
+            try {
+                codec.stop();
+            } catch (IllegalStateException e) {
+                Log.e(TAG, e.toString());
+            }
+            codec.release();
+            codec = null;
+        }
+    }
+}
@@ -0,0 +1,164 @@
+package io.evercam.androidapp.rtsp;
+
+import java.util.ArrayList;
+import java.util.List;
+import java.util.Locale;
+
+import okio.ByteString;
+
+/**
+ * The H.264 video track of an SDP session description (RFC 4566) returned by DESCRIBE.
+ */
+public class SessionDescription {
+    private final static String ENCODING_H264 = "H264";
+
+    private String sessionControl = "";
+    private boolean hasVideo = false;
+    private int payloadType = -1;
+    private String encoding = "";
+    private int clockRate = 90000;
+    private String control = "";
+    private byte[] sps;
+    private byte[] pps;
+
+    /**
+     * @return the description of the first video track, which has no video if the
+     * session has none
+     */
+    public static SessionDescription parse(String sdp) {
+        SessionDescription description = new SessionDescription();
+        boolean isInVideo = false;
+        boolean isInMedia = false;
+        for (String rawLine : sdp.split("\r?\n")) {
+            String line = rawLine.trim();
+            if (line.length() < 2 || line.charAt(1) != '=') continue;
+            char type = line.charAt(0);
+            String value = line.substring(2);
+
+            if (type == 'm') {
+                isInMedia = true;
+                //Only the first video track is played
+                isInVideo = !description.hasVideo && value.startsWith("video ");
+                if (isInVideo) {
+                    description.hasVideo = true;
+                    String[] fields = value.split(" ");
+                    if (fields.length >= 4) {
+                        description.payloadType = parseInt(fields[3], -1);
+                    }
+                }
+            } else if (type == 'a') {
+                if (!isInMedia) {
+                    if (value.startsWith("control:")) {
+                        description.sessionControl = value.substring("control:".length());
+                    }
+                } else if (isInVideo) {
+                    description.parseVideoAttribute(value);
+                }
+            }
+        }
+        return description;
+    }
+
+    private void parseVideoAttribute(String value) {
+        if (value.startsWith("control:")) {
+            control = value.substring("control:".length());
+        } else if (value.startsWith("rtpmap:")) {
+            //rtpmap:96 H264/90000
+            String[] fields = value.substring("rtpmap:".length()).split(" ", 2);
+            if (fields.length == 2 && parseInt(fields[0], -2) == payloadType) {
+                String[] encodingFields = fields[1].split("/");
+                encoding = encodingFields[0].toUpperCase(Locale.ENGLISH);
+                if (encodingFields.length > 1) {
+                    clockRate = parseInt(encodingFields[1], clockRate);
+                }
+            }
+        } else if (value.startsWith("fmtp:")) {
+            //fmtp:96 packetization-mode=1;sprop-parameter-sets=Z0IAH5Y1QKALdNwEBAQI,aM4xsg==
+            String[] fields = value.substring("fmtp:".length()).split(" ", 2);
+            if (fields.length < 2 || parseInt(fields[0], -2) != payloadType) return;
+            for (String parameter : fields[1].split(";")) {
+                String[] pair = parameter.trim().split("=", 2);
+                if (pair.length == 2 && pair[0].equalsIgnoreCase("sprop-parameter-sets")) {
+                    parseParameterSets(pair[1]);
+                }
+            }
+        }
+    }
+
+    private void parseParameterSets(String value) {
+        for (String encoded : value.split(",")) {
+            ByteString decoded = ByteString.decodeBase64(encoded.trim());
+            if (decoded == null || decoded.size() == 0) continue;
+            byte[] nalUnit = decoded.toByteArray();
+            int nalType = nalUnit[0] & 0x1F;
+            if (nalType == H264Depacketizer.NAL_TYPE_SPS) {
+                sps = nalUnit;
+            } else if (nalType == H264Depacketizer.NAL_TYPE_PPS) {
+                pps = nalUnit;
+            }
+        }
+    }
+
+    public boolean hasH264Video() {
+        return hasVideo && ENCODING_H264.equals(encoding);
+    }
+
+    public int getPayloadType() {
+        return payloadType;
+    }
+
+    public int getClockRate() {
+        return clockRate;
+    }
+
+    /**
+     * @return the SPS from the description without start code, or null
+     */
+    public byte[] getSps() {
+        return sps;
+    }
+
+    /**
+     * @return the PPS from the description without start code, or null
+     */
+    public byte[] getPps() {
+        return pps;
+    }
+
+    /**
+     * The URL to SETUP the video track with, relative controls are resolved against the
+     * content base of the DESCRIBE response
+     */
+    public String getVideoControlUrl(String baseUrl) {
+        return resolve(resolve(baseUrl, sessionControl), control);
+    }
+
+    static String resolve(String baseUrl, String control) {
+        if (control == null || control.isEmpty() || control.equals("*")) return baseUrl;
+        if (control.toLowerCase(Locale.ENGLISH).startsWith("rtsp://")) return control;
+        return baseUrl.endsWith("/") ? baseUrl + control : baseUrl + "/" + control;
+    }
+
+    private static int parseInt(String value, int defaultValue) {
+        try {
+            return Integer.parseInt(value.trim());
+        } catch (NumberFormatException e) {
+            return defaultValue;
+        }
+    }
+
+    /**
+     * @return the parameter sets prefixed by start codes, as codec specific data
+     */
+    public static List<byte[]> toCodecSpecificData(byte[]... nalUnits) {
+        ArrayList<byte[]> csd = new ArrayList<>();
+        for (byte[] nalUnit : nalUnits) {
+            if (nalUnit == null) continue;
+            byte[] data = new byte[nalUnit.length + 4];
+            data[3] = 1;
+            System.arraycopy(nalUnit, 0, data, 4, nalUnit.length);
+            csd.add(data);
+        }
+        return csd;
+    }
+}
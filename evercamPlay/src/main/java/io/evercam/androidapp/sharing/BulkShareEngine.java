@@ -0,0 +1,247 @@
+package io.evercam.androidapp.sharing;
+
+import com.mashape.unirest.http.exceptions.UnirestException;
+
+import java.io.IOException;
+import java.util.ArrayList;
+import java.util.Collections;
+import java.util.LinkedHashSet;
+import java.util.List;
+import java.util.Locale;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.TimeUnit;
+import java.util.concurrent.atomic.AtomicInteger;
+
+import io.evercam.CameraShareInterface;
+
+/**
+ * Runs one share operation for every camera and email pair.
+ *
+ * Items are pulled from a shared queue by a fixed number of workers, so a bulk share
+ * of many cameras only has a few requests in flight. Transient failures (network errors,
+ * server errors, rate limiting) are retried with exponential backoff, every other failure
+ * is final for that item and the rest carry on. Each finished item is reported to the
+ * listener from a worker thread.
+ */
+public class BulkShareEngine {
+    private final static String TAG = "BulkShareEngine";
+    private final static int DEFAULT_CONCURRENCY = 4;
+    private final static int DEFAULT_MAX_ATTEMPTS = 3;
+    private final static long DEFAULT_BACKOFF_MS = 500;
+
+    public enum Status {
+        PENDING, SUCCEEDED, FAILED, CANCELLED
+    }
+
+    public static class Item {
+        private final String cameraId;
+        private final String email;
+        private volatile Status status = Status.PENDING;
+        private volatile int attempts = 0;
+        private volatile String errorMessage;
+        private volatile CameraShareInterface share;
+
+        Item(String cameraId, String email) {
+            this.cameraId = cameraId;
+            this.email = email;
+        }
+
+        public String getCameraId() {
+            return cameraId;
+        }
+
+        public String getEmail() {
+            return email;
+        }
+
+        public Status getStatus() {
+            return status;
+        }
+
+        public boolean isSucceeded() {
+            return status == Status.SUCCEEDED;
+        }
+
+        public int getAttempts() {
+            return attempts;
+        }
+
+        public String getErrorMessage() {
+            return errorMessage;
+        }
+
+        /**
+         * @return the share or share request returned by the server, null for removals
+         */
+        public CameraShareInterface getShare() {
+            return share;
+        }
+
+        @Override
+        public String toString() {
+            return cameraId + " " + email + " " + status + (errorMessage != null ? " "
+                    + errorMessage : "");
+        }
+    }
+
+    public interface Operation {
+        /**
+         * Run the request for one item, blocking
+         */
+        CameraShareInterface run(Item item) throws Exception;
+    }
+
+    public interface Listener {
+        void onItemFinished(Item item, int finishedCount, int totalCount);
+    }
+
+    private final ArrayList<Item> items = new ArrayList<>();
+    private int concurrency = DEFAULT_CONCURRENCY;
+    private int maxAttempts = DEFAULT_MAX_ATTEMPTS;
+    private long backoffMs = DEFAULT_BACKOFF_MS;
+    private Listener listener;
+    private volatile boolean isCancelled = false;
+
+    /**
+     * One item for each camera and email, duplicates and blank entries are dropped
+     */
+    public BulkShareEngine(List<String> cameraIds, List<String> emails) {
+        LinkedHashSet<String> uniqueCameraIds = new LinkedHashSet<>();
+        for (String cameraId : cameraIds) {
+            if (cameraId != null && !cameraId.trim().isEmpty()) {
+                uniqueCameraIds.add(cameraId.trim());
+            }
+        }
+        LinkedHashSet<String> uniqueEmails = new LinkedHashSet<>();
+        for (String email : emails) {
+            if (email != null && !email.trim().isEmpty()) {
+                uniqueEmails.add(email.trim().toLowerCase(Locale.ENGLISH));
+            }
+        }
+
+        for (String cameraId : uniqueCameraIds) {
+            for (String email : uniqueEmails) {
+                items.add(new Item(cameraId, email));
+            }
+        }
+    }
+
+    public BulkShareEngine setConcurrency(int concurrency) {
+        this.concurrency = Math.max(1, concurrency);
+        return this;
+    }
+
+    public BulkShareEngine setMaxAttempts(int maxAttempts) {
+        this.maxAttempts = Math.max(1, maxAttempts);
+        return this;
+    }
+
+    public BulkShareEngine setBackoffMs(long backoffMs) {
+        this.backoffMs = backoffMs;
+        return this;
+    }
+
+    public BulkShareEngine setListener(Listener listener) {
+        this.listener = listener;
+        return this;
+    }
+
+    public List<Item> getItems() {
+        return Collections.unmodifiableList(items);
+    }
+
+    /**
+     * Items not started yet are marked cancelled, requests in flight finish
+     */
+    public void cancel() {
+        isCancelled = true;
+    }
+
+    /**
+     * Run all items and block until they are finished or cancelled
+     */
+    public List<Item> run(final Operation operation) {
+        final AtomicInteger nextIndex = new AtomicInteger(0);
+        final AtomicInteger finishedCount = new AtomicInteger(0);
+        int workerCount = Math.min(concurrency, items.size());
+        if (workerCount == 0) return getItems();
+
+        ExecutorService executor = Executors.newFixedThreadPool(workerCount);
+        for (int worker = 0; worker < workerCount; worker++) {
+            executor.execute(new Runnable() {
+                @Override
+                public void run() {
+                    int index;
+                    while ((index = nextIndex.getAndIncrement()) < items.size()) {
+                        Item item = items.get(index);
+                        runItem(item, operation);
+                        if (listener != null) {
+                            listener.onItemFinished(item, finishedCount.incrementAndGet(),
+                                    items.size());
+                        }
+                    }
+                }
+            });
+        }
+        executor.shutdown();
+        try {
+            while (!executor.awaitTermination(1, TimeUnit.SECONDS)) {
+                //Wait for the remaining items
+            }
+        } catch (InterruptedException e) {
+            isCancelled = true;
+            executor.shutdownNow();
+            Thread.currentThread().interrupt();
+        }
+        return getItems();
+    }
+
+    private void runItem(Item item, Operation operation) {
+        while (true) {
+            if (isCancelled) {
+                item.status = Status.CANCELLED;
+                return;
+            }
+
+            item.attempts++;
+            try {
+                item.share = operation.run(item);
+                item.errorMessage = null;
+                item.status = Status.SUCCEEDED;
+                return;
+            } catch (Exception e) {
+                item.errorMessage = e.getMessage() != null ? e.getMessage() : e.toString();
+                if (item.attempts >= maxAttempts || !isRetryable(e)) {
+                    item.status = Status.FAILED;
+                    return;
+                }
+            }
+
+            try {
+                Thread.sleep(backoffMs << (item.attempts - 1));
+            } catch (InterruptedException e) {
+                item.status = Status.CANCELLED;
+                Thread.currentThread().interrupt();
+                return;
+            }
+        }
+    }
+
+    /**
+     * Whether repeating the request may succeed: a network error, or the server
+     * failing or asking to slow down. Validation errors like an unknown user are final.
+     */
+    public static boolean isRetryable(Exception e) {
+        Throwable cause = e.getCause() != null ? e.getCause() : e;
+        if (cause instanceof IOException || cause instanceof UnirestException) {
+            return true;
+        }
+
+        String message = e.getMessage();
+        if (message == null) return false;
+        message = message.toLowerCase(Locale.ENGLISH);
+        return message.contains("server error") || message.contains("timed out")
+                || message.contains("too many requests");
+    }
+}
@@ -1,20 +1,33 @@
 package io.evercam.androidapp.sharing;
 
+import android.app.AlertDialog;
+import android.content.DialogInterface;
 import android.os.Bundle;
 import android.view.Menu;
 import android.view.MenuInflater;
 import android.view.MenuItem;
+import android.view.View;
 import android.widget.ArrayAdapter;
 import android.widget.EditText;
 import android.widget.Spinner;
+import android.widget.TextView;
+
+import java.util.ArrayList;
+import java.util.Arrays;
 
 import io.evercam.androidapp.ParentAppCompatActivity;
 import io.evercam.androidapp.R;
-import io.evercam.androidapp.tasks.CreateShareTask;
+import io.evercam.androidapp.dto.AppData;
+import io.evercam.androidapp.dto.EvercamCamera;
+import io.evercam.androidapp.tasks.BulkShareTask;
 
 public class CreateShareActivity extends ParentAppCompatActivity {
     private static final String TAG = "CreateShareActivity";
     private Spinner mSpinner;
+    private TextView mCamerasTextView;
+    /* Cameras the user can share, and which of them are selected */
+    private ArrayList<EvercamCamera> mShareableCameras = new ArrayList<>();
+    private boolean[] mSelectedCameras;
 
     @Override
     protected void onCreate(Bundle savedInstanceState) {
@@ -25,6 +38,7 @@ public class CreateShareActivity extends ParentAppCompatActivity {
         setHomeIconAsCancel();
 
         setUpRightsSpinner();
+        setUpCameraSelector();
     }
 
     @Override
@@ -53,22 +67,115 @@ public class CreateShareActivity extends ParentAppCompatActivity {
 
     private void setUpRightsSpinner() {
         mSpinner = (Spinner) findViewById(R.id.access_permission_spinner);
-        ArrayAdapter<String> spinnerArrayAdapter = new ArrayAdapter<>(this,
-                android.R.layout.simple_spinner_item, RightsStatus.getDefaultItems(this));
+        ArrayAdapter<CharSequence> spinnerArrayAdapter = new ArrayAdapter<>(this,
+                android.R.layout.simple_spinner_item, RightsStatus.getFullItems(this));
         spinnerArrayAdapter.setDropDownViewResource(R.layout.spinner);
         mSpinner.setAdapter(spinnerArrayAdapter);
     }
 
+    /**
+     * Cameras with full rights can be shared together with the current one
+     */
+    private void setUpCameraSelector() {
+        mCamerasTextView = (TextView) findViewById(R.id.create_share_cameras_text_view);
+
+        String currentCameraId = SharingActivity.evercamCamera != null ?
+                SharingActivity.evercamCamera.getCameraId() : "";
+        for (EvercamCamera camera : AppData.evercamCameraList) {
+            if (camera.canEdit() || camera.getCameraId().equals(currentCameraId)) {
+                mShareableCameras.add(camera);
+            }
+        }
+        mSelectedCameras = new boolean[mShareableCameras.size()];
+        for (int index = 0; index < mShareableCameras.size(); index++) {
+            mSelectedCameras[index] = mShareableCameras.get(index).getCameraId()
+                    .equals(currentCameraId);
+        }
+
+        mCamerasTextView.setOnClickListener(new View.OnClickListener() {
+            @Override
+            public void onClick(View v) {
+                showCameraSelectorDialog();
+            }
+        });
+        mCamerasTextView.setVisibility(mShareableCameras.size() > 1 ? View.VISIBLE : View.GONE);
+        updateCamerasText();
+    }
+
+    private void showCameraSelectorDialog() {
+        String[] cameraNames = new String[mShareableCameras.size()];
+        for (int index = 0; index < mShareableCameras.size(); index++) {
+            cameraNames[index] = mShareableCameras.get(index).getName();
+        }
+        final boolean[] checkedItems = Arrays.copyOf(mSelectedCameras, mSelectedCameras.length);
+
+        new AlertDialog.Builder(this).setTitle(R.string.create_sharing_select_cameras)
+                .setMultiChoiceItems(cameraNames, checkedItems,
+                        new DialogInterface.OnMultiChoiceClickListener() {
+                    @Override
+                    public void onClick(DialogInterface dialog, int which, boolean isChecked) {
+                        checkedItems[which] = isChecked;
+                    }
+                })
+                .setPositiveButton(R.string.ok, new DialogInterface.OnClickListener() {
+                    @Override
+                    public void onClick(DialogInterface dialog, int which) {
+                        mSelectedCameras = checkedItems;
+                        updateCamerasText();
+                    }
+                })
+                .setNegativeButton(R.string.cancel, null).show();
+    }
+
+    private void updateCamerasText() {
+        ArrayList<EvercamCamera> selectedCameras = getSelectedCameras();
+        String camerasText = "";
+        if (selectedCameras.size() == 1) {
+            camerasText = selectedCameras.get(0).getName();
+        } else if (selectedCameras.size() > 1) {
+            camerasText = getString(R.string.create_sharing_cameras_more,
+                    selectedCameras.get(0).getName(), selectedCameras.size() - 1);
+        }
+        mCamerasTextView.setText(getString(R.string.create_sharing_cameras, camerasText));
+    }
+
+    private ArrayList<EvercamCamera> getSelectedCameras() {
+        ArrayList<EvercamCamera> selectedCameras = new ArrayList<>();
+        for (int index = 0; index < mShareableCameras.size(); index++) {
+            if (mSelectedCameras[index]) {
+                selectedCameras.add(mShareableCameras.get(index));
+            }
+        }
+        return selectedCameras;
+    }
+
     private void onShareMenuClicked() {
         EditText usernameEditText = (EditText) findViewById(R.id.create_share_user_edit_text);
         EditText messageEditText = (EditText) findViewById(R.id.create_share_message_edit_text);
         String usernameText = usernameEditText.getText().toString();
         String messageText = messageEditText.getText().toString();
-        if (!usernameText.isEmpty()) {
+
+        //Several users can be entered, separated by commas or spaces
+        ArrayList<String> usernames = new ArrayList<>();
+        for (String username : usernameText.split("[,;\\s]+")) {
+            if (!username.isEmpty()) {
+                usernames.add(username);
+            }
+        }
+
+        ArrayList<String> cameraIds = new ArrayList<>();
+        for (EvercamCamera camera : getSelectedCameras()) {
+            cameraIds.add(camera.getCameraId());
+        }
+        if (cameraIds.isEmpty() && SharingActivity.evercamCamera != null) {
+            cameraIds.add(SharingActivity.evercamCamera.getCameraId());
+        }
+
+        if (!usernames.isEmpty() && !cameraIds.isEmpty()) {
             String selectedRights = mSpinner.getSelectedItem().toString();
             RightsStatus rightsStatus = new RightsStatus(this, selectedRights);
-            CreateShareTask.launch(this, usernameText, SharingActivity.evercamCamera.getCameraId(),
-                    rightsStatus.getRightString(), messageText);
+            BulkShareTask.launch(this, cameraIds, usernames, rightsStatus.getRightString(),
+                    messageText);
         }
     }
 }
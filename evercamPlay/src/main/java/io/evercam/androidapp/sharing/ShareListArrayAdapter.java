@@ -21,6 +21,34 @@ import io.evercam.androidapp.dto.AppData;
 public class ShareListArrayAdapter extends ArrayAdapter<CameraShareInterface> {
     private List<CameraShareInterface> mCameraShareList;
 
+    private static final ShareListDiff.Keys<CameraShareInterface> SHARE_KEYS =
+            new ShareListDiff.Keys<CameraShareInterface>() {
+        @Override
+        public String getKey(CameraShareInterface shareInterface) {
+            if (shareInterface instanceof CameraShare) {
+                return "share:" + ((CameraShare) shareInterface).getUserId();
+            } else if (shareInterface instanceof CameraShareRequest) {
+                return "request:" + ((CameraShareRequest) shareInterface).getEmail();
+            } else if (shareInterface instanceof CameraShareOwner) {
+                return "owner:" + ((CameraShareOwner) shareInterface).getUsername();
+            }
+            return String.valueOf(shareInterface);
+        }
+
+        @Override
+        public String getContent(CameraShareInterface shareInterface) {
+            String fullName = "";
+            if (shareInterface instanceof CameraShare) {
+                fullName = ((CameraShare) shareInterface).getFullName() + " "
+                        + ((CameraShare) shareInterface).getUserEmail();
+            } else if (shareInterface instanceof CameraShareOwner) {
+                fullName = ((CameraShareOwner) shareInterface).getFullName() + " "
+                        + ((CameraShareOwner) shareInterface).getEmail();
+            }
+            return fullName + " " + EvercamObject.getRightsFrom(shareInterface);
+        }
+    };
+
     public ShareListArrayAdapter(Context context, int resource, List<CameraShareInterface>
             objects) {
         super(context, resource, objects);
@@ -80,6 +108,19 @@ public class ShareListArrayAdapter extends ArrayAdapter<CameraShareInterface> {
         return view;
     }
 
+    /**
+     * Update the list to the fetched one, redrawing only if something changed
+     *
+     * @return true if the list changed
+     */
+    public boolean applyShareList(List<CameraShareInterface> shareList) {
+        int editCount = ShareListDiff.apply(mCameraShareList, shareList, SHARE_KEYS);
+        if (editCount > 0) {
+            notifyDataSetChanged();
+        }
+        return editCount > 0;
+    }
+
     public List<CameraShareInterface> getShareList() {
         return mCameraShareList;
     }
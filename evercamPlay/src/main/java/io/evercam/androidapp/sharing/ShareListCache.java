@@ -0,0 +1,79 @@
+package io.evercam.androidapp.sharing;
+
+import java.util.ArrayList;
+import java.util.HashMap;
+import java.util.List;
+
+import io.evercam.CameraShareInterface;
+import io.evercam.androidapp.dto.AppData;
+
+/**
+ * Share lists and sharing status of the cameras opened in this session, so the sharing
+ * screen shows them straight away while a fresh list is fetched. Entries are kept per
+ * user, as the list depends on who is looking at it.
+ */
+public class ShareListCache {
+    /* Don't fetch again when the cached list is this recent */
+    private final static long FRESH_MS = 30 * 1000;
+
+    private static final HashMap<String, Entry> entries = new HashMap<>();
+
+    private static class Entry {
+        ArrayList<CameraShareInterface> shareList;
+        long updatedTime;
+        SharingStatus sharingStatus;
+    }
+
+    /**
+     * @return a copy of the cached share list, null if not cached
+     */
+    public static synchronized ArrayList<CameraShareInterface> getShareList(String cameraId) {
+        Entry entry = entries.get(getKey(cameraId));
+        if (entry == null || entry.shareList == null) return null;
+        return new ArrayList<>(entry.shareList);
+    }
+
+    public static synchronized void putShareList(String cameraId,
+                                                 List<CameraShareInterface> shareList) {
+        Entry entry = getOrCreateEntry(cameraId);
+        entry.shareList = new ArrayList<>(shareList);
+        entry.updatedTime = System.currentTimeMillis();
+    }
+
+    public static synchronized boolean isFresh(String cameraId) {
+        Entry entry = entries.get(getKey(cameraId));
+        return entry != null && entry.shareList != null
+                && System.currentTimeMillis() - entry.updatedTime < FRESH_MS;
+    }
+
+    public static synchronized SharingStatus getSharingStatus(String cameraId) {
+        Entry entry = entries.get(getKey(cameraId));
+        return entry != null ? entry.sharingStatus : null;
+    }
+
+    public static synchronized void putSharingStatus(String cameraId, SharingStatus status) {
+        getOrCreateEntry(cameraId).sharingStatus = status;
+    }
+
+    /**
+     * Forget everything, e.g. when logging out
+     */
+    public static synchronized void clear() {
+        entries.clear();
+    }
+
+    private static Entry getOrCreateEntry(String cameraId) {
+        String key = getKey(cameraId);
+        Entry entry = entries.get(key);
+        if (entry == null) {
+            entry = new Entry();
+            entries.put(key, entry);
+        }
+        return entry;
+    }
+
+    private static String getKey(String cameraId) {
+        String username = AppData.defaultUser != null ? AppData.defaultUser.getUsername() : "";
+        return username + "/" + cameraId;
+    }
+}
@@ -0,0 +1,65 @@
+package io.evercam.androidapp.sharing;
+
+import java.util.List;
+
+/**
+ * Brings a list shown by an adapter up to date with a freshly fetched one in place.
+ *
+ * Entries are matched by key. Unchanged entries are left alone, so the adapter only
+ * needs notifying when something was actually added, removed, moved or changed.
+ */
+public class ShareListDiff {
+
+    public interface Keys<T> {
+        /**
+         * @return what identifies the entry, e.g. the user of a share
+         */
+        String getKey(T item);
+
+        /**
+         * @return everything shown for the entry, compared to find changed entries
+         */
+        String getContent(T item);
+    }
+
+    /**
+     * Edit current so it equals updated
+     *
+     * @return the number of edits, 0 if current was already up to date
+     */
+    public static <T> int apply(List<T> current, List<T> updated, Keys<T> keys) {
+        int editCount = 0;
+        for (int index = 0; index < updated.size(); index++) {
+            T updatedItem = updated.get(index);
+            String key = keys.getKey(updatedItem);
+
+            if (index < current.size() && key.equals(keys.getKey(current.get(index)))) {
+                if (!keys.getContent(current.get(index)).equals(keys.getContent(updatedItem))) {
+                    current.set(index, updatedItem);
+                    editCount++;
+                }
+                continue;
+            }
+
+            int oldIndex = indexOfKey(current, key, index + 1, keys);
+            if (oldIndex >= 0) {
+                current.remove(oldIndex);
+            }
+            current.add(index, updatedItem);
+            editCount++;
+        }
+
+        while (current.size() > updated.size()) {
+            current.remove(current.size() - 1);
+            editCount++;
+        }
+        return editCount;
+    }
+
+    private static <T> int indexOfKey(List<T> list, String key, int fromIndex, Keys<T> keys) {
+        for (int index = fromIndex; index < list.size(); index++) {
+            if (key.equals(keys.getKey(list.get(index)))) return index;
+        }
+        return -1;
+    }
+}
@@ -9,10 +9,13 @@ import android.view.MenuItem;
 
 import com.badoo.mobile.util.WeakHandler;
 
+import java.util.List;
+
 import io.evercam.androidapp.ParentAppCompatActivity;
 import io.evercam.androidapp.R;
 import io.evercam.androidapp.custom.CustomSnackbar;
 import io.evercam.androidapp.dto.EvercamCamera;
+import io.evercam.androidapp.tasks.BulkShareTask;
 import io.evercam.androidapp.tasks.FetchShareListTask;
 import io.evercam.androidapp.tasks.ValidateRightsRunnable;
 import io.evercam.androidapp.utils.Constants;
@@ -86,7 +89,12 @@ public class SharingActivity extends ParentAppCompatActivity {
     @Override
     protected void onActivityResult(int requestCode, int resultCode, Intent data) {
         if (requestCode == Constants.REQUEST_CODE_CREATE_SHARE) {
-            FetchShareListTask.launch(SharingActivity.evercamCamera.getCameraId(), this);
+            List<BulkShareEngine.Item> bulkShareItems = BulkShareTask.takeFinishedItems();
+            if (bulkShareItems.isEmpty()) {
+                FetchShareListTask.launch(SharingActivity.evercamCamera.getCameraId(), this);
+            } else {
+                sharingListFragment.applyBulkShareItems(bulkShareItems);
+            }
 
             if (resultCode == Constants.RESULT_SHARE_CREATED) {
                 mWeakHandler.postDelayed(new Runnable() {
@@ -16,6 +16,7 @@ import java.util.List;
 import io.evercam.CameraShare;
 import io.evercam.CameraShareInterface;
 import io.evercam.CameraShareOwner;
+import io.evercam.CameraShareRequest;
 import io.evercam.PatchCameraBuilder;
 import io.evercam.androidapp.R;
 import io.evercam.androidapp.custom.CustomedDialog;
@@ -81,27 +82,88 @@ public class SharingListFragment extends ListFragment {
         retrieveSharingStatusFromCamera();
 
         if (SharingActivity.evercamCamera != null) {
-            FetchShareListTask.launch(SharingActivity.evercamCamera.getCameraId(), getActivity());
+            String cameraId = SharingActivity.evercamCamera.getCameraId();
+
+            //Show the list from the last visit straight away, and refresh it unless it's recent
+            ArrayList<CameraShareInterface> cachedShareList = ShareListCache.getShareList(cameraId);
+            if (cachedShareList != null) {
+                updateShareListOnUi(cachedShareList);
+            }
+            if (!ShareListCache.isFresh(cameraId)) {
+                FetchShareListTask.launch(cameraId, getActivity());
+            }
         }
     }
 
     public void updateShareListOnUi(ArrayList<CameraShareInterface> shareList) {
-        mShareList.clear();
-        mShareList.addAll(shareList);
+        mShareAdapter.applyShareList(shareList);
+
+        updateMenuInSharingActivity();
+    }
+
+    /**
+     * Apply the finished items of a bulk share to the list instead of fetching it again
+     */
+    public void applyBulkShareItems(List<BulkShareEngine.Item> items) {
+        if (SharingActivity.evercamCamera == null) return;
+        String cameraId = SharingActivity.evercamCamera.getCameraId();
+
+        for (BulkShareEngine.Item item : items) {
+            if (!item.isSucceeded() || !item.getCameraId().equals(cameraId)) continue;
+
+            int index = indexOfUser(item.getEmail());
+            if (item.getShare() == null) {
+                if (index >= 0) mShareList.remove(index);
+            } else if (index >= 0) {
+                mShareList.set(index, item.getShare());
+            } else {
+                mShareList.add(item.getShare());
+            }
+        }
         mShareAdapter.notifyDataSetChanged();
+        ShareListCache.putShareList(cameraId, mShareList);
 
         updateMenuInSharingActivity();
     }
 
+    /**
+     * @return the position of the share or share request for this email or username, or -1
+     */
+    private int indexOfUser(String user) {
+        for (int index = 0; index < mShareList.size(); index++) {
+            CameraShareInterface shareInterface = mShareList.get(index);
+            if (shareInterface instanceof CameraShare) {
+                CameraShare share = (CameraShare) shareInterface;
+                if (user.equalsIgnoreCase(share.getUserEmail())
+                        || user.equalsIgnoreCase(share.getUserId())) {
+                    return index;
+                }
+            } else if (shareInterface instanceof CameraShareRequest) {
+                if (user.equalsIgnoreCase(((CameraShareRequest) shareInterface).getEmail())) {
+                    return index;
+                }
+            }
+        }
+        return -1;
+    }
+
     public void retrieveSharingStatusFromCamera() {
         if (SharingActivity.evercamCamera != null) {
-            SharingStatus status = new SharingStatus(SharingActivity.evercamCamera.isDiscoverable(),
-                    SharingActivity.evercamCamera.isPublic());
+            SharingStatus status = ShareListCache.getSharingStatus(SharingActivity.evercamCamera
+                    .getCameraId());
+            if (status == null) {
+                status = new SharingStatus(SharingActivity.evercamCamera.isDiscoverable(),
+                        SharingActivity.evercamCamera.isPublic());
+            }
             updateSharingStatusUi(status);
         }
     }
 
     public void updateSharingStatusUi(SharingStatus status) {
+        if (SharingActivity.evercamCamera != null) {
+            ShareListCache.putSharingStatus(SharingActivity.evercamCamera.getCameraId(), status);
+        }
+
         mSharingStatusImageView.setImageResource(status.getImageResourceId());
         mSharingStatusTextView.setText(status.getStatusStringId());
         mSharingStatusDetailTextView.setText(status.getStatusDetailStringId());
@@ -1,10 +1,9 @@
 package io.evercam.androidapp.tasks;
 
 import android.app.Activity;
+import android.app.AlertDialog;
 import android.content.DialogInterface;
 import android.content.Intent;
-import android.graphics.Bitmap;
-import android.graphics.BitmapFactory;
 import android.os.AsyncTask;
 import android.os.Bundle;
 import android.util.Log;
@@ -13,10 +12,11 @@ import android.widget.Button;
 import org.json.JSONException;
 import org.json.JSONObject;
 
+import java.util.concurrent.CountDownLatch;
+
 import io.evercam.Camera;
 import io.evercam.CameraDetail;
 import io.evercam.EvercamException;
-import io.evercam.Snapshot;
 import io.evercam.androidapp.EditCameraActivity;
 import io.evercam.androidapp.EvercamPlayApplication;
 import io.evercam.androidapp.ParentAppCompatActivity;
@@ -40,7 +40,9 @@ public class AddCameraTask extends AsyncTask<Void, Boolean, EvercamCamera> {
     private CustomProgressDialog customProgressDialog;
     private String errorMessage = null;
     private boolean isReachableExternally = false;
-    private Boolean readyToCreateCamera = null;
+    private volatile boolean readyToCreateCamera = false;
+    /* Released when the user answers the confirm dialog shown if no snapshot was found */
+    private final CountDownLatch confirmLatch = new CountDownLatch(1);
     private boolean isFromScan;
     private Button createCamButton;
     private FirebaseAnalytics mFirebaseAnalytics;
@@ -126,27 +128,25 @@ public class AddCameraTask extends AsyncTask<Void, Boolean, EvercamCamera> {
     protected EvercamCamera doInBackground(Void... params) {
         // Check camera is reachable or not by request for snapshot
         // If either internal or external url return a snapshot, create the
-        // camera
+        // camera straight away
         // If neither of the urls return a snapshot, warn the user.
-        isReachableExternally = isSnapshotReachableExternally();
+        SnapshotProber.Result result = probeSnapshot();
 
-        if (isReachableExternally) {
+        if (result != null) {
             publishProgress(true);
-        } else {
-            publishProgress(false);
+            return createCamera(cameraDetail);
         }
 
-        while (readyToCreateCamera == null) {
-            try {
-                Thread.sleep(500);
-            } catch (InterruptedException e) {
-                Log.e(TAG, e.toString());
-            }
+        publishProgress(false);
+        try {
+            confirmLatch.await();
+        } catch (InterruptedException e) {
+            Log.e(TAG, e.toString());
         }
 
         if (readyToCreateCamera) {
             return createCamera(cameraDetail);
-        } else if (!readyToCreateCamera) {
+        } else {
             Log.d(TAG, "Not ready to create camera");
         }
         return null;
@@ -158,58 +158,72 @@ public class AddCameraTask extends AsyncTask<Void, Boolean, EvercamCamera> {
 
         if (isSnapshotReceived) {
             customProgressDialog.setMessage(activity.getString(R.string.creating_camera));
-            readyToCreateCamera = true;
         } else {
             if (!activity.isFinishing()) {
-                CustomedDialog.getConfirmCreateDialog(activity,
+                AlertDialog confirmDialog = CustomedDialog.getConfirmCreateDialog(activity,
                         new DialogInterface.OnClickListener() {
                             @Override
                             public void onClick(DialogInterface dialog, int which) {
                                 customProgressDialog.setMessage(activity.getString(R.string.creating_camera));
-                                readyToCreateCamera = true;
-                                return;
+                                onCreateConfirmed(true);
                             }
                         }, new DialogInterface.OnClickListener() {
                             @Override
                             public void onClick(DialogInterface dialog, int which) {
-                                readyToCreateCamera = false;
                                 customProgressDialog.dismiss();
-                                return;
+                                onCreateConfirmed(false);
                             }
-                        }).show();
+                        });
+                confirmDialog.setOnCancelListener(new DialogInterface.OnCancelListener() {
+                    @Override
+                    public void onCancel(DialogInterface dialog) {
+                        customProgressDialog.dismiss();
+                        onCreateConfirmed(false);
+                    }
+                });
+                confirmDialog.show();
+            } else {
+                onCreateConfirmed(false);
             }
         }
     }
 
-    private boolean isSnapshotReachableExternally() {
-        String externalHost = cameraDetail.getExternalHost();
-        final String username = cameraDetail.getCameraUsername();
-        final String password = cameraDetail.getCameraPassword();
-        String jpgUrlString = cameraDetail.getJpgUrl();
-        final  String vendor_id = cameraDetail.getVendor();
+    private void onCreateConfirmed(boolean isConfirmed) {
+        readyToCreateCamera = isConfirmed;
+        confirmLatch.countDown();
+    }
 
-        final String jpgUrl = EditCameraActivity.buildUrlEndingWithSlash(jpgUrlString);
+    /**
+     * Test the external snapshot through Evercam and the internal one directly, in parallel.
+     * Also records whether the external address answered, which the winning route
+     * alone doesn't tell when the internal one is faster.
+     *
+     * @return the first snapshot found, or null if neither address returned one
+     */
+    private SnapshotProber.Result probeSnapshot() {
+        String externalHost = cameraDetail.getExternalHost();
+        String jpgUrl = EditCameraActivity.buildUrlEndingWithSlash(cameraDetail.getJpgUrl());
 
+        SnapshotProber prober = new SnapshotProber(cameraDetail.getCameraUsername(),
+                cameraDetail.getCameraPassword(), cameraDetail.getVendor(), "");
+        boolean hasAddress = false;
         if (externalHost != null && !externalHost.isEmpty()) {
             String portString = String.valueOf(cameraDetail.getExternalHttpPort());
-            String externalUrl = buildHttpUrl(externalHost, portString);
-
-            try {
-                Snapshot snapshot = Camera.testSnapshot(externalUrl, jpgUrl, username, password,vendor_id,"");
-
-                if (snapshot != null) {
-                    byte[] snapshotData = snapshot.getData();
-                    Bitmap bitmap = BitmapFactory.decodeByteArray(snapshotData, 0, snapshotData.length);
-
-                    if (bitmap != null) {
-                        return true;
-                    }
-                }
-            } catch (Exception e) {
-                Log.e(TAG, "test snapshot: " + e.toString());
+            prober.addExternal(buildHttpUrl(externalHost, portString), jpgUrl);
+            hasAddress = true;
+        }
+        if (activity instanceof AddCameraActivity) {
+            String internalUrl = ((AddCameraActivity) activity).getDiscoveredInternalUrl();
+            if (internalUrl != null) {
+                prober.addInternal(internalUrl, jpgUrl);
+                hasAddress = true;
             }
         }
-        return false;
+        if (!hasAddress) return null;
+
+        SnapshotProber.Result result = prober.probe(SnapshotProber.DEFAULT_TIMEOUT_MS);
+        isReachableExternally = prober.isReachableExternally();
+        return result;
     }
 
     private String buildHttpUrl(String host, String portString) {
@@ -0,0 +1,172 @@
+package io.evercam.androidapp.tasks;
+
+import android.app.Activity;
+import android.app.AlertDialog;
+import android.os.AsyncTask;
+import android.util.Log;
+
+import java.util.ArrayList;
+import java.util.List;
+
+import io.evercam.CameraShare;
+import io.evercam.CameraShareInterface;
+import io.evercam.CameraShareRequest;
+import io.evercam.EvercamException;
+import io.evercam.androidapp.R;
+import io.evercam.androidapp.custom.CustomProgressDialog;
+import io.evercam.androidapp.sharing.BulkShareEngine;
+import io.evercam.androidapp.sharing.CreateShareActivity;
+import io.evercam.androidapp.utils.Constants;
+
+/**
+ * Shares many cameras with many users, or removes their access, in one go.
+ *
+ * Progress is shown as a count, and failed items are listed when done. The
+ * finished items are kept for {@link io.evercam.androidapp.sharing.SharingActivity} to
+ * update its share list without fetching it again.
+ */
+public class BulkShareTask extends AsyncTask<Void, Integer, List<BulkShareEngine.Item>> {
+    private final static String TAG = "BulkShareTask";
+
+    private static ArrayList<BulkShareEngine.Item> finishedItems = new ArrayList<>();
+
+    private Activity activity;
+    private CustomProgressDialog customProgressDialog;
+    private final BulkShareEngine engine;
+    /* Rights to give, null to remove access */
+    private final String rights;
+    private final String message;
+
+    public BulkShareTask(Activity activity, List<String> cameraIds, List<String> emails,
+                         String rights, String message) {
+        this.activity = activity;
+        this.rights = rights;
+        this.message = message;
+        engine = new BulkShareEngine(cameraIds, emails);
+    }
+
+    @Override
+    protected void onPreExecute() {
+        customProgressDialog = new CustomProgressDialog(activity);
+        customProgressDialog.show(activity.getString(R.string.msg_sharing));
+    }
+
+    @Override
+    protected List<BulkShareEngine.Item> doInBackground(Void... params) {
+        engine.setListener(new BulkShareEngine.Listener() {
+            @Override
+            public void onItemFinished(BulkShareEngine.Item item, int finishedCount,
+                                       int totalCount) {
+                if (!item.isSucceeded()) {
+                    Log.e(TAG, item.toString());
+                }
+                publishProgress(finishedCount, totalCount);
+            }
+        });
+
+        return engine.run(new BulkShareEngine.Operation() {
+            @Override
+            public CameraShareInterface run(BulkShareEngine.Item item) throws Exception {
+                return rights != null ? share(item) : removeShare(item);
+            }
+        });
+    }
+
+    @Override
+    protected void onProgressUpdate(Integer... values) {
+        customProgressDialog.setMessage(activity.getString(R.string.msg_bulk_sharing_progress,
+                values[0], values[1]));
+    }
+
+    @Override
+    protected void onPostExecute(List<BulkShareEngine.Item> items) {
+        customProgressDialog.dismiss();
+        finishedItems.addAll(items);
+
+        ArrayList<String> failedLines = new ArrayList<>();
+        boolean hasShare = false;
+        boolean hasShareRequest = false;
+        for (BulkShareEngine.Item item : items) {
+            if (item.isSucceeded()) {
+                if (item.getShare() instanceof CameraShareRequest) {
+                    hasShareRequest = true;
+                } else {
+                    hasShare = true;
+                }
+            } else {
+                failedLines.add(item.getEmail() + " - " + item.getCameraId() + ": "
+                        + item.getErrorMessage());
+            }
+        }
+
+        if (hasShareRequest) {
+            activity.setResult(Constants.RESULT_SHARE_REQUEST_CREATED);
+        } else if (hasShare) {
+            activity.setResult(Constants.RESULT_SHARE_CREATED);
+        }
+
+        if (failedLines.isEmpty()) {
+            if (activity instanceof CreateShareActivity) {
+                activity.finish();
+            }
+        } else {
+            new AlertDialog.Builder(activity)
+                    .setTitle(activity.getString(R.string.msg_bulk_sharing_failed,
+                            failedLines.size(), items.size()))
+                    .setItems(failedLines.toArray(new String[failedLines.size()]), null)
+                    .setPositiveButton(R.string.ok, null).show();
+        }
+    }
+
+    /**
+     * Share the camera, or update the rights if it is already shared with the user
+     */
+    private CameraShareInterface share(BulkShareEngine.Item item) throws EvercamException {
+        try {
+            return CameraShare.create(item.getCameraId(), item.getEmail(), rights, message);
+        } catch (EvercamException e) {
+            if (BulkShareEngine.isRetryable(e)) throw e;
+
+            try {
+                CameraShare patchedShare = CameraShare.patch(item.getCameraId(),
+                        item.getEmail(), rights);
+                if (patchedShare != null) return patchedShare;
+            } catch (EvercamException patchException) {
+                //Not shared yet, report the original error
+            }
+            throw e;
+        }
+    }
+
+    /**
+     * Remove the share, or revoke the share request if the user has not accepted it yet
+     */
+    private CameraShareInterface removeShare(BulkShareEngine.Item item) throws
+            EvercamException {
+        try {
+            if (CameraShare.delete(item.getCameraId(), item.getEmail())) return null;
+        } catch (EvercamException e) {
+            if (BulkShareEngine.isRetryable(e)) throw e;
+        }
+
+        if (!CameraShareRequest.delete(item.getCameraId(), item.getEmail())) {
+            throw new EvercamException(activity.getString(R.string.unknown_error));
+        }
+        return null;
+    }
+
+    /**
+     * @return the items of the bulk operations finished since the last call
+     */
+    public static List<BulkShareEngine.Item> takeFinishedItems() {
+        ArrayList<BulkShareEngine.Item> items = finishedItems;
+        finishedItems = new ArrayList<>();
+        return items;
+    }
+
+    public static void launch(Activity activity, List<String> cameraIds, List<String> emails,
+                              String rights, String message) {
+        new BulkShareTask(activity, cameraIds, emails, rights, message)
+                .executeOnExecutor(AsyncTask.THREAD_POOL_EXECUTOR);
+    }
+}
@@ -71,6 +71,7 @@ public class CaptureSnapshotRunnable implements Runnable {
 
                 SnapshotManager.updateGallery(savedPath, cameraId, activity);
 
+                SnapshotManager.addToIndex(activity, savedPath, cameraId);
             }
         }
     }
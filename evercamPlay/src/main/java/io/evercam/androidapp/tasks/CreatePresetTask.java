@@ -9,6 +9,8 @@ import io.evercam.PTZPreset;
 import io.evercam.androidapp.R;
 import io.evercam.androidapp.custom.CustomProgressDialog;
 import io.evercam.androidapp.custom.CustomToast;
+import io.evercam.androidapp.dal.DbCapability;
+import io.evercam.androidapp.dto.CameraCapability;
 import io.evercam.androidapp.video.VideoActivity;
 
 public class CreatePresetTask extends AsyncTask<Void, Void, Boolean> {
@@ -36,11 +38,12 @@ public class CreatePresetTask extends AsyncTask<Void, Void, Boolean> {
             PTZPreset.create(cameraId, presetName);
 
             ArrayList<PTZPreset> allPresets = PTZPreset.getAllPresets(cameraId);
-            ArrayList<PTZPreset> customPresets = removeSystemPresetsFrom(allPresets);
+            ArrayList<PTZPreset> customPresets = CameraCapability.getCustomPresets(allPresets);
 
             if (customPresets.size() > 0) {
                 activity.presetList = customPresets;
             }
+            new DbCapability(activity).updatePresets(cameraId, customPresets);
 
             return true;
         } catch (PTZException e) {
@@ -55,18 +58,4 @@ public class CreatePresetTask extends AsyncTask<Void, Void, Boolean> {
         CustomToast.showInCenter(activity, success ? activity.getString(R.string
                 .msg_preset_created) : errorMessage);
     }
-
-    private ArrayList<PTZPreset> removeSystemPresetsFrom(ArrayList<PTZPreset> allPresets) {
-        ArrayList<PTZPreset> customPresets = new ArrayList<>();
-        if (allPresets.size() > 0) {
-            //Exclude presets with token >= 33 and only keep those user defined presets
-            for (PTZPreset preset : allPresets) {
-                int tokenInt = Integer.valueOf(preset.getToken());
-                if (tokenInt < 33) {
-                    customPresets.add(preset);
-                }
-            }
-        }
-        return customPresets;
-    }
 }
@@ -0,0 +1,107 @@
+package io.evercam.androidapp.tasks;
+
+import android.app.Activity;
+import android.content.Intent;
+import android.media.MediaScannerConnection;
+import android.net.Uri;
+import android.os.AsyncTask;
+import android.support.design.widget.Snackbar;
+import android.util.Log;
+import android.view.View;
+
+import java.io.File;
+import java.io.IOException;
+
+import io.evercam.androidapp.R;
+import io.evercam.androidapp.custom.CustomProgressDialog;
+import io.evercam.androidapp.custom.CustomToast;
+import io.evercam.androidapp.timelapse.TimelapseBuilder;
+
+public class CreateTimelapseTask extends AsyncTask<Void, Integer, File> {
+    private final String TAG = "CreateTimelapseTask";
+    private Activity activity;
+    private CustomProgressDialog customProgressDialog;
+    private TimelapseBuilder timelapseBuilder;
+    private volatile Uri mediaUri = null;
+
+    public CreateTimelapseTask(Activity activity, String cameraId) {
+        this.activity = activity;
+        this.timelapseBuilder = new TimelapseBuilder(cameraId);
+    }
+
+    @Override
+    protected void onPreExecute() {
+        customProgressDialog = new CustomProgressDialog(activity);
+        customProgressDialog.show(activity.getString(R.string.msg_creating_timelapse));
+    }
+
+    @Override
+    protected File doInBackground(Void... params) {
+        try {
+            return timelapseBuilder.build(new TimelapseBuilder.ProgressListener() {
+                @Override
+                public void onProgress(int framesWritten, int totalFrames) {
+                    publishProgress(framesWritten, totalFrames);
+                }
+            });
+        } catch (IOException e) {
+            Log.e(TAG, e.toString());
+        }
+        return null;
+    }
+
+    @Override
+    protected void onProgressUpdate(Integer... values) {
+        customProgressDialog.setMessage(activity.getString(R.string.msg_creating_timelapse)
+                + " " + values[0] + "/" + values[1]);
+    }
+
+    @Override
+    protected void onCancelled(File file) {
+        customProgressDialog.dismiss();
+    }
+
+    @Override
+    protected void onPostExecute(final File timelapseFile) {
+        customProgressDialog.dismiss();
+
+        if (timelapseFile == null) {
+            CustomToast.showInCenter(activity, R.string.msg_timelapse_failed);
+            return;
+        }
+
+        //The content URI from MediaStore can be shared with other apps, unlike the file URI
+        MediaScannerConnection.scanFile(activity.getApplicationContext(),
+                new String[]{timelapseFile.getPath()}, null,
+                new MediaScannerConnection.OnScanCompletedListener() {
+                    @Override
+                    public void onScanCompleted(String path, Uri uri) {
+                        mediaUri = uri;
+                    }
+                });
+
+        Snackbar.make(activity.findViewById(android.R.id.content), R.string.msg_timelapse_saved,
+                Snackbar.LENGTH_LONG)
+                .setAction(R.string.view_capital, new View.OnClickListener() {
+                    @Override
+                    public void onClick(View v) {
+                        Intent viewIntent = new Intent(Intent.ACTION_VIEW);
+                        Uri uri = mediaUri != null ? mediaUri : Uri.fromFile(timelapseFile);
+                        viewIntent.setDataAndType(uri, "video/avi");
+                        viewIntent.addFlags(Intent.FLAG_GRANT_READ_URI_PERMISSION);
+                        activity.startActivity(Intent.createChooser(viewIntent, null));
+                    }
+                }).show();
+    }
+
+    public void cancelBuild() {
+        timelapseBuilder.cancel();
+        cancel(false);
+    }
+
+    public static CreateTimelapseTask launch(Activity activity, String cameraId) {
+        CreateTimelapseTask task = new CreateTimelapseTask(activity, cameraId);
+        task.executeOnExecutor(AsyncTask.THREAD_POOL_EXECUTOR);
+        return task;
+    }
+}
@@ -5,16 +5,21 @@ import android.os.AsyncTask;
 import android.util.Log;
 
 import java.util.ArrayList;
+import java.util.concurrent.Callable;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.Future;
 
 import io.evercam.CameraShare;
 import io.evercam.CameraShareInterface;
 import io.evercam.CameraShareOwner;
 import io.evercam.CameraShareRequest;
-import io.evercam.EvercamException;
+import io.evercam.androidapp.sharing.ShareListCache;
 import io.evercam.androidapp.sharing.SharingActivity;
 
 public class FetchShareListTask extends AsyncTask<Void, Void, ArrayList<CameraShareInterface>> {
     private final String TAG = "FetchShareListTask";
+    private static final ExecutorService requestExecutor = Executors.newCachedThreadPool();
     private final String cameraId;
     private Activity activity;
 
@@ -32,12 +37,23 @@ public class FetchShareListTask extends AsyncTask<Void, Void, ArrayList<CameraSh
     protected ArrayList<CameraShareInterface> doInBackground(Void... params) {
         ArrayList<CameraShareInterface> shareList = new ArrayList<>();
 
+        //Fetch pending share requests while fetching the shares
+        Future<ArrayList<? extends CameraShareInterface>> requestFuture = requestExecutor.submit
+                (new Callable<ArrayList<? extends CameraShareInterface>>() {
+            @Override
+            public ArrayList<? extends CameraShareInterface> call() throws Exception {
+                return CameraShareRequest.get(cameraId, CameraShareRequest.STATUS_PENDING);
+            }
+        });
+
         try {
             shareList.addAll(CameraShare.getByCamera(cameraId));
-            shareList.addAll(CameraShareRequest.get(cameraId, CameraShareRequest.STATUS_PENDING));
-
-        } catch (EvercamException e) {
-            Log.e(TAG, e.getMessage());
+            shareList.addAll(requestFuture.get());
+        } catch (Exception e) {
+            //Keep showing the cached list rather than a partial one
+            requestFuture.cancel(true);
+            Log.e(TAG, e.toString());
+            return null;
         }
 
         /**
@@ -50,18 +66,20 @@ public class FetchShareListTask extends AsyncTask<Void, Void, ArrayList<CameraSh
                     shareList.add(0, owner);
                 }
             }
-            CameraShare cameraShare =  ((CameraShare) shareList.get(1));
 
-            if (cameraShare.toString().equals("{}")) {
+            if (shareList.size() > 1 && shareList.get(1) instanceof CameraShare
+                    && shareList.get(1).toString().equals("{}")) {
                 shareList.remove(1);
             }
         }
+
+        ShareListCache.putShareList(cameraId, shareList);
         return shareList;
     }
 
     @Override
     protected void onPostExecute(ArrayList<CameraShareInterface> cameraShareList) {
-        if (activity instanceof SharingActivity) {
+        if (cameraShareList != null && activity instanceof SharingActivity) {
             ((SharingActivity) activity).sharingListFragment
                     .updateShareListOnUi(cameraShareList);
         }
@@ -0,0 +1,260 @@
+package io.evercam.androidapp.tasks;
+
+import android.graphics.Bitmap;
+import android.os.Handler;
+import android.os.Looper;
+import android.os.SystemClock;
+import android.util.Log;
+
+import java.io.IOException;
+import java.lang.ref.WeakReference;
+import java.util.HashMap;
+import java.util.Locale;
+import java.util.Map;
+import java.util.concurrent.TimeUnit;
+
+import io.evercam.androidapp.dto.EvercamCamera;
+import io.evercam.androidapp.http.SharedHttpClient;
+import io.evercam.androidapp.player.MjpegFrameReader;
+import io.evercam.androidapp.utils.Commons;
+import io.evercam.androidapp.utils.NetInfo;
+import io.evercam.androidapp.video.VideoActivity;
+import okhttp3.Call;
+import okhttp3.Credentials;
+import okhttp3.OkHttpClient;
+import okhttp3.Request;
+import okhttp3.Response;
+import okhttp3.ResponseBody;
+
+/**
+ * Live view straight from the camera when the phone is on the camera's local network.
+ *
+ * The camera's MJPEG endpoint is used when its vendor has a known one, otherwise the
+ * internal snapshot URL is polled over a kept alive connection. Frames go through the
+ * same decoding and {@link VideoActivity#updateImage(Bitmap, String)} as the cloud live
+ * view in {@link LiveViewRunnable}. If no frame arrives in time, or requests keep
+ * failing, {@link VideoActivity#onLanLiveViewFailed(String)} is called so the cloud
+ * route can take over.
+ */
+public class LanLiveViewRunnable implements Runnable {
+    private final static String TAG = "LanLiveViewRunnable";
+    private final static int CONNECT_TIMEOUT_SECONDS = 2;
+    private final static int READ_TIMEOUT_SECONDS = 5;
+    private final static long FIRST_FRAME_TIMEOUT_MS = 4000;
+    private final static int MAX_CONSECUTIVE_FAILURES = 3;
+    /* Shortest time between two snapshot requests when polling */
+    private final static long MIN_POLL_INTERVAL_MS = 200;
+
+    /* MJPEG paths for vendors whose snapshot URL only returns single images */
+    private final static HashMap<String, String> VENDOR_MJPEG_PATHS = new HashMap<>();
+
+    static {
+        VENDOR_MJPEG_PATHS.put("axis", "/axis-cgi/mjpg/video.cgi");
+        VENDOR_MJPEG_PATHS.put("hikvision", "/Streaming/channels/102/httppreview");
+        VENDOR_MJPEG_PATHS.put("dahua", "/cgi-bin/mjpg/video.cgi?channel=1&subtype=1");
+    }
+
+    /* One client for all LAN views, so connections to a camera are reused */
+    private final static OkHttpClient CLIENT = SharedHttpClient.getUncached().newBuilder()
+            .connectTimeout(CONNECT_TIMEOUT_SECONDS, TimeUnit.SECONDS)
+            .readTimeout(READ_TIMEOUT_SECONDS, TimeUnit.SECONDS)
+            .build();
+
+    private final String mCameraId;
+    private final String mSnapshotUrl;
+    private final String mMjpegUrl;
+    private final String mCredentials;
+    private final int mScreenWidth;
+
+    private volatile boolean isRunning = true;
+    private volatile Call mCall;
+    private boolean isFirstImage = true;
+    private int consecutiveFailures = 0;
+
+    private final Handler mHandler;
+    private WeakReference<VideoActivity> mVideoActivityReference;
+
+    public LanLiveViewRunnable(VideoActivity videoActivity, EvercamCamera camera) {
+        mCameraId = camera.getCameraId();
+        mSnapshotUrl = camera.getInternalSnapshotUrl();
+        mMjpegUrl = getMjpegUrl(camera);
+        mCredentials = camera.hasCredentials() ? Credentials.basic(camera.getUsername(),
+                camera.getPassword()) : null;
+        mScreenWidth = videoActivity.getResources().getDisplayMetrics().widthPixels;
+        mHandler = new Handler(Looper.getMainLooper());
+        mVideoActivityReference = new WeakReference<>(videoActivity);
+    }
+
+    /**
+     * Whether the camera's internal host is on the same subnet as the phone's WiFi
+     */
+    public static boolean isAvailable(NetInfo netInfo, EvercamCamera camera) {
+        String internalHost = camera.getInternalHost();
+        return !camera.getInternalSnapshotUrl().isEmpty() && Commons.isLocalIp(internalHost)
+                && netInfo.isInSubnet(internalHost);
+    }
+
+    @Override
+    public void run() {
+        long startTime = SystemClock.elapsedRealtime();
+        boolean useMjpeg = mMjpegUrl != null;
+
+        while (isRunning) {
+            long requestTime = SystemClock.elapsedRealtime();
+            try {
+                if (useMjpeg) {
+                    if (!readStream(mMjpegUrl)) {
+                        //Not an MJPEG endpoint after all, poll snapshots instead
+                        useMjpeg = false;
+                    }
+                } else {
+                    readSnapshot();
+                    long elapsed = SystemClock.elapsedRealtime() - requestTime;
+                    if (elapsed < MIN_POLL_INTERVAL_MS) {
+                        Thread.sleep(MIN_POLL_INTERVAL_MS - elapsed);
+                    }
+                }
+            } catch (InterruptedException e) {
+                return;
+            } catch (IOException e) {
+                if (!isRunning) return;
+                Log.e(TAG, e.toString());
+                consecutiveFailures++;
+                //The MJPEG path may not exist on this model
+                if (useMjpeg && isFirstImage) {
+                    useMjpeg = false;
+                }
+            }
+
+            if (isRunning && (consecutiveFailures >= MAX_CONSECUTIVE_FAILURES || (isFirstImage
+                    && SystemClock.elapsedRealtime() - startTime > FIRST_FRAME_TIMEOUT_MS))) {
+                isRunning = false;
+                onFailed();
+            }
+        }
+    }
+
+    /**
+     * Show every frame of the stream until it ends
+     *
+     * @return false if the response is not a multipart stream
+     */
+    private boolean readStream(String url) throws IOException {
+        Response response = execute(url);
+        try {
+            String contentType = response.header("Content-Type", "");
+            if (!contentType.toLowerCase(Locale.ENGLISH).startsWith("multipart")) {
+                return false;
+            }
+            MjpegFrameReader reader = new MjpegFrameReader(response.body().byteStream());
+            byte[] frame;
+            while (isRunning && (frame = reader.readFrame()) != null) {
+                showFrame(frame);
+            }
+            return true;
+        } finally {
+            response.close();
+        }
+    }
+
+    private void readSnapshot() throws IOException {
+        Response response = execute(mSnapshotUrl);
+        try {
+            //Read the whole body so the connection goes back to the pool
+            showFrame(response.body().bytes());
+        } finally {
+            response.close();
+        }
+    }
+
+    private Response execute(String url) throws IOException {
+        Request.Builder builder = new Request.Builder().url(url);
+        if (mCredentials != null) {
+            builder.header("Authorization", mCredentials);
+        }
+        mCall = CLIENT.newCall(builder.build());
+        Response response = mCall.execute();
+        ResponseBody body = response.body();
+        if (!response.isSuccessful() || body == null) {
+            response.close();
+            throw new IOException("HTTP " + response.code() + " from " + url);
+        }
+        return response;
+    }
+
+    private void showFrame(byte[] jpeg) throws IOException {
+        final Bitmap bitmap = Commons.decodeBitmapFromResource(jpeg, mScreenWidth);
+        if (bitmap == null) {
+            throw new IOException("Invalid JPEG from " + mCameraId);
+        }
+        consecutiveFailures = 0;
+
+        if (isFirstImage) {
+            isFirstImage = false;
+            Log.d(TAG, "Playing " + mCameraId + " from the local network");
+            runOnUiThread(new Runnable() {
+                @Override
+                public void run() {
+                    if (getActivity() != null) {
+                        getActivity().onFirstJpgLoaded();
+                    }
+                }
+            });
+        }
+        runOnUiThread(new Runnable() {
+            @Override
+            public void run() {
+                if (getActivity() != null && isRunning) {
+                    getActivity().updateImage(bitmap, mCameraId);
+                }
+            }
+        });
+    }
+
+    private void onFailed() {
+        runOnUiThread(new Runnable() {
+            @Override
+            public void run() {
+                if (getActivity() != null) {
+                    getActivity().onLanLiveViewFailed(mCameraId);
+                }
+            }
+        });
+    }
+
+    public void disconnect() {
+        isRunning = false;
+        Call call = mCall;
+        if (call != null) {
+            call.cancel();
+        }
+    }
+
+    public boolean isStopped() {
+        return !isRunning;
+    }
+
+    private VideoActivity getActivity() {
+        return mVideoActivityReference.get();
+    }
+
+    private void runOnUiThread(Runnable runnable) {
+        mHandler.post(runnable);
+    }
+
+    private static String getMjpegUrl(EvercamCamera camera) {
+        //The vendor is the vendor name, e.g. 'Hikvision Digital Technology', not its id
+        String vendor = camera.getVendor().toLowerCase(Locale.ENGLISH);
+        String path = null;
+        for (Map.Entry<String, String> entry : VENDOR_MJPEG_PATHS.entrySet()) {
+            if (vendor.contains(entry.getKey())) {
+                path = entry.getValue();
+                break;
+            }
+        }
+        if (path == null) return null;
+        int port = camera.getInternalHttp();
+        return "http://" + camera.getInternalHost() + (port > 0 && port != 80 ? ":" + port :
+                "") + path;
+    }
+}
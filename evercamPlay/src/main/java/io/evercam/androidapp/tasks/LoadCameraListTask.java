@@ -11,6 +11,7 @@ import io.evercam.EvercamException;
 import io.evercam.androidapp.CamerasActivity;
 import io.evercam.androidapp.EvercamPlayApplication;
 import io.evercam.androidapp.R;
+import io.evercam.androidapp.authentication.AccountStateCache;
 import io.evercam.androidapp.custom.CustomedDialog;
 import io.evercam.androidapp.dal.DbCamera;
 import io.evercam.androidapp.dto.AppData;
@@ -61,6 +62,7 @@ public class LoadCameraListTask extends AsyncTask<Void, Boolean, Boolean> {
 
             //Publish camera list to UI before deciding to update database or not
             AppData.evercamCameraList = evercamCameras;
+            AccountStateCache.putCameraList(user.getUsername(), evercamCameras);
             reload = true;
             this.publishProgress(true);
 
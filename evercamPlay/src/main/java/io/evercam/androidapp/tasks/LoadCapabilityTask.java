@@ -0,0 +1,94 @@
+package io.evercam.androidapp.tasks;
+
+import android.content.Context;
+import android.os.AsyncTask;
+import android.util.Log;
+
+import java.lang.ref.WeakReference;
+
+import io.evercam.Camera;
+import io.evercam.EvercamException;
+import io.evercam.Model;
+import io.evercam.PTZException;
+import io.evercam.PTZPreset;
+import io.evercam.androidapp.dal.DbCapability;
+import io.evercam.androidapp.dto.CameraCapability;
+import io.evercam.androidapp.dto.EvercamCamera;
+import io.evercam.androidapp.video.VideoActivity;
+
+/**
+ * Shows the PTZ controls from the cached capability straight away, then revalidates
+ * whatever has expired with the Evercam API and updates the controls if it changed.
+ */
+public class LoadCapabilityTask extends AsyncTask<Void, CameraCapability, CameraCapability> {
+    private final String TAG = "LoadCapabilityTask";
+    private WeakReference<VideoActivity> videoActivityWeakReference;
+    private Context context;
+    private String modelId;
+    private String cameraId;
+
+    public LoadCapabilityTask(VideoActivity videoActivity, EvercamCamera camera) {
+        videoActivityWeakReference = new WeakReference<>(videoActivity);
+        this.context = videoActivity.getApplicationContext();
+        this.modelId = camera.getModelId();
+        this.cameraId = camera.getCameraId();
+    }
+
+    @Override
+    protected CameraCapability doInBackground(Void... params) {
+        DbCapability dbCapability = new DbCapability(context);
+        CameraCapability capability = dbCapability.getCapability(cameraId, modelId);
+        if (capability.isKnown()) {
+            publishProgress(capability);
+        }
+
+        long now = System.currentTimeMillis();
+        if (!capability.isStale(now)) {
+            return null;
+        }
+
+        boolean isRevalidated = false;
+        try {
+            if (capability.isModelStale(now)) {
+                Model model = Model.getById(modelId);
+                capability.setModelCapability(model.isOnvif(), model.isPTZ(), now);
+                isRevalidated = true;
+            }
+            if (capability.isOnvif() && capability.isPtz() && capability.isCameraStale(now)) {
+                Camera camera = Camera.getById(cameraId, false);
+                boolean hasFullRights = camera.getRights().isFullRight();
+                capability.setCameraCapability(hasFullRights, CameraCapability.getCustomPresets
+                        (PTZPreset.getAllPresets(cameraId)), now);
+            }
+        } catch (EvercamException e) {
+            //Keep showing the cached capability, it will be revalidated next time
+            Log.e(TAG, e.toString());
+        } catch (PTZException e) {
+            Log.e(TAG, e.toString());
+        }
+
+        if (isRevalidated || capability.getCameraCheckedAt() == now) {
+            dbCapability.saveCapability(capability);
+            return capability;
+        }
+        return null;
+    }
+
+    @Override
+    protected void onProgressUpdate(CameraCapability... capabilities) {
+        if (getVideoActivity() != null) {
+            getVideoActivity().applyCapability(capabilities[0]);
+        }
+    }
+
+    @Override
+    protected void onPostExecute(CameraCapability capability) {
+        if (capability != null && getVideoActivity() != null) {
+            getVideoActivity().applyCapability(capability);
+        }
+    }
+
+    private VideoActivity getVideoActivity() {
+        return videoActivityWeakReference.get();
+    }
+}
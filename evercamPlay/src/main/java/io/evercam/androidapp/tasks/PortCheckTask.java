@@ -7,10 +7,6 @@ import android.view.View;
 import android.widget.ProgressBar;
 import android.widget.TextView;
 
-import com.squareup.okhttp.OkHttpClient;
-import com.squareup.okhttp.Request;
-import com.squareup.okhttp.Response;
-
 import org.json.JSONException;
 import org.json.JSONObject;
 
@@ -19,6 +15,9 @@ import java.lang.ref.WeakReference;
 
 import io.evercam.API;
 import io.evercam.androidapp.R;
+import io.evercam.androidapp.http.SharedHttpClient;
+import okhttp3.Request;
+import okhttp3.Response;
 
 public class PortCheckTask extends AsyncTask<Void, Void, Boolean> {
     public enum PortType {HTTP, RTSP}
@@ -101,15 +100,18 @@ public class PortCheckTask extends AsyncTask<Void, Void, Boolean> {
     }
 
     public static boolean isPortOpen(String ip, String port) {
-        OkHttpClient client = new OkHttpClient();
         Request request = new Request.Builder()
                 .url(getUrl(ip, port)).build();
 
         try {
-            Response response = client.newCall(request).execute();
-            if(response.isSuccessful()) {
-                String responseString = response.body().string();
-                return isResponseIndicatePortOpen(responseString);
+            Response response = SharedHttpClient.get().newCall(request).execute();
+            try {
+                if(response.isSuccessful()) {
+                    String responseString = response.body().string();
+                    return isResponseIndicatePortOpen(responseString);
+                }
+            } finally {
+                response.close();
             }
         } catch (IOException e) {
             e.printStackTrace();
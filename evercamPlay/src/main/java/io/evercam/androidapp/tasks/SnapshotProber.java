@@ -0,0 +1,334 @@
+package io.evercam.androidapp.tasks;
+
+import android.graphics.Bitmap;
+import android.graphics.BitmapFactory;
+import android.util.Log;
+
+import java.io.IOException;
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.Collections;
+import java.util.HashMap;
+import java.util.List;
+import java.util.Locale;
+import java.util.concurrent.Callable;
+import java.util.concurrent.ExecutionException;
+import java.util.concurrent.ExecutorCompletionService;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.Future;
+import java.util.concurrent.TimeUnit;
+import java.util.concurrent.TimeoutException;
+
+import io.evercam.Camera;
+import io.evercam.Snapshot;
+import io.evercam.androidapp.http.SharedHttpClient;
+import okhttp3.Call;
+import okhttp3.Credentials;
+import okhttp3.OkHttpClient;
+import okhttp3.Request;
+import okhttp3.Response;
+
+/**
+ * Tests every way a camera's snapshot could be reached at the same time and returns the
+ * first one that gives a valid JPEG.
+ *
+ * The external URL is tested through Evercam, the internal URL is requested directly
+ * over the local network, and the external port check runs alongside so a closed port
+ * can be reported if nothing succeeds. As soon as one snapshot decodes, the remaining
+ * direct requests are cancelled. Tests through Evercam can't be interrupted, so they are
+ * abandoned instead: they finish in the background and their results are ignored.
+ *
+ * probe() blocks, so it must be called off the main thread.
+ */
+public class SnapshotProber {
+    private final static String TAG = "SnapshotProber";
+    public final static long DEFAULT_TIMEOUT_MS = 20000;
+    private final static int DIRECT_TIMEOUT_SECONDS = 5;
+
+    /* Snapshot endings to try when the model, and so the ending, is unknown */
+    private final static List<String> GENERIC_ENDINGS = Arrays.asList("/snapshot.jpg",
+            "/image.jpg", "/cgi-bin/snapshot.cgi");
+    private final static HashMap<String, List<String>> VENDOR_ENDINGS = new HashMap<>();
+
+    static {
+        VENDOR_ENDINGS.put("hikvision", Arrays.asList("/Streaming/channels/1/picture",
+                "/ISAPI/Streaming/channels/101/picture"));
+        //Dahua uses /cgi-bin/snapshot.cgi, which is already one of the generic endings
+        VENDOR_ENDINGS.put("axis", Collections.singletonList("/axis-cgi/jpg/image.cgi"));
+        VENDOR_ENDINGS.put("ubiquiti", Collections.singletonList("/snap.jpeg"));
+        VENDOR_ENDINGS.put("foscam", Collections.singletonList(
+                "/cgi-bin/CGIProxy.fcgi?cmd=snapPicture2"));
+    }
+
+    private final static ExecutorService EXECUTOR = Executors.newCachedThreadPool();
+    private final static OkHttpClient DIRECT_CLIENT = SharedHttpClient.getUncached().newBuilder()
+            .connectTimeout(DIRECT_TIMEOUT_SECONDS, TimeUnit.SECONDS)
+            .readTimeout(DIRECT_TIMEOUT_SECONDS, TimeUnit.SECONDS)
+            .build();
+
+    public enum Route {EXTERNAL, INTERNAL}
+
+    private final String username;
+    private final String password;
+    private final String vendorId;
+    private final String cameraExid;
+    private final ArrayList<Candidate> candidates = new ArrayList<>();
+    private final List<Call> directCalls = Collections.synchronizedList(new ArrayList<Call>());
+    private String portCheckHost;
+    private String portCheckPort;
+    private boolean isPortClosed = false;
+    private volatile boolean isReachableExternally = false;
+    private volatile String errorMessage;
+
+    public static class Result {
+        private final Route route;
+        private final String url;
+        private final String ending;
+        private final Bitmap bitmap;
+
+        Result(Route route, String url, String ending, Bitmap bitmap) {
+            this.route = route;
+            this.url = url;
+            this.ending = ending;
+            this.bitmap = bitmap;
+        }
+
+        public Route getRoute() {
+            return route;
+        }
+
+        public String getUrl() {
+            return url;
+        }
+
+        public String getEnding() {
+            return ending;
+        }
+
+        public Bitmap getBitmap() {
+            return bitmap;
+        }
+    }
+
+    private static class Candidate {
+        final Route route;
+        final String url;
+        final String ending;
+
+        Candidate(Route route, String url, String ending) {
+            this.route = route;
+            this.url = url;
+            this.ending = ending;
+        }
+    }
+
+    public SnapshotProber(String username, String password, String vendorId, String cameraExid) {
+        this.username = username;
+        this.password = password;
+        this.vendorId = vendorId;
+        this.cameraExid = cameraExid;
+    }
+
+    /**
+     * Test the snapshot at the camera's public address through Evercam
+     */
+    public SnapshotProber addExternal(String url, String ending) {
+        candidates.add(new Candidate(Route.EXTERNAL, url, ending));
+        return this;
+    }
+
+    /**
+     * Request the snapshot directly from the camera's local address
+     */
+    public SnapshotProber addInternal(String url, String ending) {
+        candidates.add(new Candidate(Route.INTERNAL, url, ending));
+        return this;
+    }
+
+    /**
+     * Also try the common snapshot endings of the vendor on every address added so far.
+     * Only useful when the ending is unknown, the winning ending is in the result.
+     */
+    public SnapshotProber addCommonEndings() {
+        ArrayList<String> endings = new ArrayList<>();
+        if (vendorId != null && VENDOR_ENDINGS.containsKey(vendorId.toLowerCase(Locale.UK))) {
+            endings.addAll(VENDOR_ENDINGS.get(vendorId.toLowerCase(Locale.UK)));
+        }
+        endings.addAll(GENERIC_ENDINGS);
+
+        for (Candidate candidate : new ArrayList<>(candidates)) {
+            for (String ending : endings) {
+                if (!ending.equals(candidate.ending)) {
+                    candidates.add(new Candidate(candidate.route, candidate.url, ending));
+                }
+            }
+        }
+        return this;
+    }
+
+    /**
+     * Run the Evercam port check for the public address in parallel
+     */
+    public SnapshotProber addPortCheck(String host, String port) {
+        portCheckHost = host;
+        portCheckPort = port;
+        return this;
+    }
+
+    /**
+     * @return true if nothing succeeded and the port check reported the port closed
+     */
+    public boolean isPortClosed() {
+        return isPortClosed;
+    }
+
+    /**
+     * @return true if a snapshot was returned through Evercam, whichever route won.
+     * An external test still running when another route won counts as not reachable.
+     */
+    public boolean isReachableExternally() {
+        return isReachableExternally;
+    }
+
+    /**
+     * @return the error message from Evercam for the first external address, if any
+     */
+    public String getErrorMessage() {
+        return errorMessage;
+    }
+
+    /**
+     * @return the first snapshot that decoded, or null if none did within the timeout
+     */
+    public Result probe(long timeoutMs) {
+        long deadline = System.currentTimeMillis() + timeoutMs;
+        ExecutorCompletionService<Result> completionService = new ExecutorCompletionService<>(EXECUTOR);
+        ArrayList<Future<Result>> futures = new ArrayList<>();
+        for (int index = 0; index < candidates.size(); index++) {
+            final Candidate candidate = candidates.get(index);
+            final boolean isPrimary = index == 0;
+            futures.add(completionService.submit(new Callable<Result>() {
+                @Override
+                public Result call() {
+                    return candidate.route == Route.EXTERNAL ? testExternal(candidate, isPrimary)
+                            : testInternal(candidate);
+                }
+            }));
+        }
+
+        Future<Boolean> portCheckFuture = null;
+        if (portCheckHost != null) {
+            portCheckFuture = EXECUTOR.submit(new Callable<Boolean>() {
+                @Override
+                public Boolean call() {
+                    return PortCheckTask.isPortOpen(portCheckHost, portCheckPort);
+                }
+            });
+        }
+
+        Result result = null;
+        try {
+            for (int count = 0; count < futures.size() && result == null; count++) {
+                long remainingMs = deadline - System.currentTimeMillis();
+                Future<Result> future = completionService.poll(remainingMs, TimeUnit.MILLISECONDS);
+                if (future == null) break;
+                try {
+                    result = future.get();
+                } catch (ExecutionException e) {
+                    Log.e(TAG, e.toString());
+                }
+            }
+
+            if (result == null && portCheckFuture != null) {
+                long remainingMs = Math.max(0, deadline - System.currentTimeMillis());
+                isPortClosed = !portCheckFuture.get(remainingMs, TimeUnit.MILLISECONDS);
+            }
+        } catch (InterruptedException | ExecutionException | TimeoutException e) {
+            Log.e(TAG, e.toString());
+        } finally {
+            //Only stops tests that haven't started, Evercam tests ignore interrupts
+            for (Future<Result> future : futures) {
+                future.cancel(true);
+            }
+            if (portCheckFuture != null) {
+                portCheckFuture.cancel(true);
+            }
+            synchronized (directCalls) {
+                for (Call call : directCalls) {
+                    call.cancel();
+                }
+            }
+        }
+
+        if (result != null) {
+            Log.d(TAG, "Snapshot found via " + result.getRoute() + " " + result.getUrl()
+                    + result.getEnding());
+        }
+        return result;
+    }
+
+    private Result testExternal(Candidate candidate, boolean isPrimary) {
+        try {
+            Snapshot snapshot = Camera.testSnapshot(candidate.url, candidate.ending, username,
+                    password, vendorId, cameraExid);
+            if (snapshot != null) {
+                Result result = toResult(candidate, snapshot.getData());
+                if (result != null) {
+                    isReachableExternally = true;
+                }
+                return result;
+            }
+        } catch (Exception e) {
+            if (isPrimary) {
+                errorMessage = e.getMessage();
+            }
+            Log.e(TAG, "test snapshot: " + e.toString());
+        }
+        return null;
+    }
+
+    private Result testInternal(Candidate candidate) {
+        Request.Builder requestBuilder = new Request.Builder().url(candidate.url + candidate.ending);
+        if (username != null && !username.isEmpty()) {
+            requestBuilder.header("Authorization", Credentials.basic(username, password));
+        }
+
+        Call call;
+        try {
+            call = DIRECT_CLIENT.newCall(requestBuilder.build());
+        } catch (IllegalArgumentException e) {
+            Log.e(TAG, e.toString());
+            return null;
+        }
+        directCalls.add(call);
+
+        Response response = null;
+        try {
+            response = call.execute();
+            if (response.isSuccessful()) {
+                return toResult(candidate, response.body().bytes());
+            }
+        } catch (IOException e) {
+            Log.e(TAG, "direct snapshot: " + e.toString());
+        } finally {
+            if (response != null) {
+                response.close();
+            }
+        }
+        return null;
+    }
+
+    private static Result toResult(Candidate candidate, byte[] data) {
+        if (!isJpeg(data)) return null;
+
+        Bitmap bitmap = BitmapFactory.decodeByteArray(data, 0, data.length);
+        return bitmap != null ? new Result(candidate.route, candidate.url, candidate.ending,
+                bitmap) : null;
+    }
+
+    static boolean isJpeg(byte[] data) {
+        return data != null && data.length > 2 && (data[0] & 0xFF) == 0xFF
+                && (data[1] & 0xFF) == 0xD8;
+    }
+}
@@ -2,14 +2,11 @@ package io.evercam.androidapp.tasks;
 
 import android.app.Activity;
 import android.graphics.Bitmap;
-import android.graphics.BitmapFactory;
 import android.os.AsyncTask;
 import android.util.Log;
 
 import java.net.URL;
 
-import io.evercam.Camera;
-import io.evercam.Snapshot;
 import io.evercam.androidapp.EditCameraActivity;
 import io.evercam.androidapp.R;
 import io.evercam.androidapp.addeditcamera.AddCameraActivity;
@@ -29,7 +26,8 @@ public class TestSnapshotTask extends AsyncTask<Void, Void, Bitmap> {
     private String errorMessage = null;
     private String vendor_id;
     private String camera_exId;
-    
+    private String internalUrl;
+    private String foundEnding;
 
     public TestSnapshotTask(String url, String ending, String username, String password, Activity activity, String vendor_id, String camera_exId) {
         this.url = url;
@@ -41,6 +39,14 @@ public class TestSnapshotTask extends AsyncTask<Void, Void, Bitmap> {
         this.camera_exId    = camera_exId;
     }
 
+    /**
+     * Also request the snapshot directly from the camera's local address
+     */
+    public TestSnapshotTask setInternalUrl(String internalUrl) {
+        this.internalUrl = internalUrl;
+        return this;
+    }
+
     @Override
     protected void onPreExecute() {
         if (activity instanceof EditCameraActivity) {
@@ -53,29 +59,34 @@ public class TestSnapshotTask extends AsyncTask<Void, Void, Bitmap> {
 
     @Override
     protected Bitmap doInBackground(Void... params) {
+        SnapshotProber prober = new SnapshotProber(username, password, vendor_id, camera_exId)
+                .addExternal(url, ending);
+        if (internalUrl != null && !internalUrl.isEmpty()) {
+            prober.addInternal(internalUrl, ending);
+        }
+        if (ending.isEmpty()) {
+            prober.addCommonEndings();
+        }
         try {
             URL urlObject = new URL(url);
-            boolean isReachable = PortCheckTask.isPortOpen(urlObject.getHost(),
-                    String.valueOf(urlObject.getPort()));
-            if (!isReachable) {
-                errorMessage = activity.getString(R.string.snapshot_test_port_closed);
-                return null;
-            }
+            prober.addPortCheck(urlObject.getHost(), String.valueOf(urlObject.getPort()));
         } catch (Exception e) {
             Log.e(TAG, e.toString());
             return null;
         }
 
-        try {
-            Snapshot snapshot = Camera.testSnapshot(url, ending, username, password,vendor_id,camera_exId);
-            if (snapshot != null) {
-                byte[] snapshotData = snapshot.getData();
-                return BitmapFactory.decodeByteArray(snapshotData, 0, snapshotData.length);
+        SnapshotProber.Result result = prober.probe(SnapshotProber.DEFAULT_TIMEOUT_MS);
+        if (result != null) {
+            if (!result.getEnding().equals(ending)) {
+                foundEnding = result.getEnding();
             }
-        } catch (Exception e) {
-            errorMessage = e.getMessage();
-            Log.e(TAG, e.getMessage());
-            Log.e(TAG, e.toString());
+            return result.getBitmap();
+        }
+
+        if (prober.isPortClosed()) {
+            errorMessage = activity.getString(R.string.snapshot_test_port_closed);
+        } else {
+            errorMessage = prober.getErrorMessage();
         }
         return null;
     }
@@ -90,6 +101,13 @@ public class TestSnapshotTask extends AsyncTask<Void, Void, Bitmap> {
 
 
         if (bitmap != null) {
+            if (foundEnding != null) {
+                if (activity instanceof EditCameraActivity) {
+                    ((EditCameraActivity) activity).onSnapshotEndingFound(foundEnding);
+                } else if (activity instanceof AddCameraActivity) {
+                    ((AddCameraActivity) activity).onSnapshotEndingFound(foundEnding);
+                }
+            }
             CustomedDialog.getSnapshotDialog(activity, bitmap).show();
 
         } else {
@@ -0,0 +1,249 @@
+package io.evercam.androidapp.timelapse;
+
+import java.io.BufferedOutputStream;
+import java.io.Closeable;
+import java.io.File;
+import java.io.FileOutputStream;
+import java.io.IOException;
+import java.io.OutputStream;
+import java.io.RandomAccessFile;
+import java.util.Arrays;
+
+/**
+ * Writes JPEG frames into a Motion JPEG AVI file.
+ *
+ * Frames are appended to the file as soon as they are added, so only the frame index
+ * (8 bytes per frame) is kept in memory. The header fields that depend on the frame
+ * count are patched in place when the writer is closed.
+ *
+ * This class has no Android dependencies so it can be unit tested on the JVM.
+ */
+public class AviMjpegWriter implements Closeable {
+    private final static int AVIF_HASINDEX = 0x10;
+    private final static int AVIIF_KEYFRAME = 0x10;
+
+    /* Fixed header layout, see writeHeaders() */
+    private final static int OFFSET_RIFF_SIZE = 4;
+    private final static int OFFSET_AVIH_MAX_BYTES_PER_SEC = 36;
+    private final static int OFFSET_AVIH_TOTAL_FRAMES = 48;
+    private final static int OFFSET_AVIH_SUGGESTED_BUFFER = 60;
+    private final static int OFFSET_STRH_LENGTH = 140;
+    private final static int OFFSET_STRH_SUGGESTED_BUFFER = 144;
+    private final static int OFFSET_MOVI_SIZE = 216;
+    private final static int OFFSET_MOVI_FOURCC = 220;
+    private final static int HEADER_LENGTH = 224;
+
+    private final File file;
+    private final int width;
+    private final int height;
+    private final int framesPerSecond;
+
+    private OutputStream outputStream;
+    private long position = 0;
+    private int frameCount = 0;
+    private int maxFrameSize = 0;
+    private long totalFrameBytes = 0;
+
+    /* Offset relative to the 'movi' fourcc and size of every frame chunk */
+    private int[] frameOffsets = new int[64];
+    private int[] frameSizes = new int[64];
+
+    public AviMjpegWriter(File file, int width, int height, int framesPerSecond) throws
+            IOException {
+        if (width <= 0 || height <= 0 || framesPerSecond <= 0) {
+            throw new IllegalArgumentException("Invalid video size or frame rate");
+        }
+        this.file = file;
+        this.width = width;
+        this.height = height;
+        this.framesPerSecond = framesPerSecond;
+
+        outputStream = new BufferedOutputStream(new FileOutputStream(file), 64 * 1024);
+        writeHeaders();
+    }
+
+    public int getFrameCount() {
+        return frameCount;
+    }
+
+    /**
+     * Append one JPEG encoded frame, which should have the size given to the constructor
+     */
+    public void addFrame(byte[] jpegData) throws IOException {
+        addFrame(jpegData, 0, jpegData.length);
+    }
+
+    public void addFrame(byte[] jpegData, int offset, int length) throws IOException {
+        if (outputStream == null) {
+            throw new IOException("Writer is closed");
+        }
+
+        if (frameCount == frameOffsets.length) {
+            frameOffsets = Arrays.copyOf(frameOffsets, frameCount * 2);
+            frameSizes = Arrays.copyOf(frameSizes, frameCount * 2);
+        }
+        frameOffsets[frameCount] = (int) (position - OFFSET_MOVI_FOURCC);
+        frameSizes[frameCount] = length;
+        frameCount++;
+
+        maxFrameSize = Math.max(maxFrameSize, length);
+        totalFrameBytes += length;
+
+        writeFourCC("00dc");
+        writeInt(length);
+        write(jpegData, offset, length);
+        if (length % 2 != 0) {
+            outputStream.write(0);
+            position++;
+        }
+    }
+
+    /**
+     * Write the frame index and patch the header fields. The file is complete once
+     * this returns.
+     */
+    @Override
+    public void close() throws IOException {
+        if (outputStream == null) return;
+
+        long moviEnd = position;
+
+        writeFourCC("idx1");
+        writeInt(frameCount * 16);
+        for (int index = 0; index < frameCount; index++) {
+            writeFourCC("00dc");
+            writeInt(AVIIF_KEYFRAME);
+            writeInt(frameOffsets[index]);
+            writeInt(frameSizes[index]);
+        }
+
+        outputStream.close();
+        outputStream = null;
+
+        int maxBytesPerSec = frameCount == 0 ? 0 :
+                (int) Math.min(Integer.MAX_VALUE, totalFrameBytes * framesPerSecond / frameCount);
+        int suggestedBufferSize = maxFrameSize + 8;
+
+        RandomAccessFile randomAccessFile = new RandomAccessFile(file, "rw");
+        try {
+            patchInt(randomAccessFile, OFFSET_RIFF_SIZE, (int) (position - 8));
+            patchInt(randomAccessFile, OFFSET_AVIH_MAX_BYTES_PER_SEC, maxBytesPerSec);
+            patchInt(randomAccessFile, OFFSET_AVIH_TOTAL_FRAMES, frameCount);
+            patchInt(randomAccessFile, OFFSET_AVIH_SUGGESTED_BUFFER, suggestedBufferSize);
+            patchInt(randomAccessFile, OFFSET_STRH_LENGTH, frameCount);
+            patchInt(randomAccessFile, OFFSET_STRH_SUGGESTED_BUFFER, suggestedBufferSize);
+            patchInt(randomAccessFile, OFFSET_MOVI_SIZE, (int) (moviEnd - OFFSET_MOVI_FOURCC));
+        } finally {
+            randomAccessFile.close();
+        }
+    }
+
+    private void writeHeaders() throws IOException {
+        writeFourCC("RIFF");
+        writeInt(0); // Patched on close
+        writeFourCC("AVI ");
+
+        writeFourCC("LIST");
+        writeInt(192);
+        writeFourCC("hdrl");
+
+        // MainAVIHeader
+        writeFourCC("avih");
+        writeInt(56);
+        writeInt(1000000 / framesPerSecond);
+        writeInt(0); // Max bytes per second, patched on close
+        writeInt(0);
+        writeInt(AVIF_HASINDEX);
+        writeInt(0); // Total frames, patched on close
+        writeInt(0);
+        writeInt(1); // Stream count
+        writeInt(0); // Suggested buffer size, patched on close
+        writeInt(width);
+        writeInt(height);
+        writeInt(0);
+        writeInt(0);
+        writeInt(0);
+        writeInt(0);
+
+        writeFourCC("LIST");
+        writeInt(116);
+        writeFourCC("strl");
+
+        // AVIStreamHeader
+        writeFourCC("strh");
+        writeInt(56);
+        writeFourCC("vids");
+        writeFourCC("MJPG");
+        writeInt(0);
+        writeShort(0); // Priority
+        writeShort(0); // Language
+        writeInt(0);
+        writeInt(1); // Scale
+        writeInt(framesPerSecond); // Rate
+        writeInt(0);
+        writeInt(0); // Length in frames, patched on close
+        writeInt(0); // Suggested buffer size, patched on close
+        writeInt(-1); // Default quality
+        writeInt(0);
+        writeShort(0);
+        writeShort(0);
+        writeShort(width);
+        writeShort(height);
+
+        // BITMAPINFOHEADER
+        writeFourCC("strf");
+        writeInt(40);
+        writeInt(40);
+        writeInt(width);
+        writeInt(height);
+        writeShort(1);
+        writeShort(24);
+        writeFourCC("MJPG");
+        writeInt(width * height * 3);
+        writeInt(0);
+        writeInt(0);
+        writeInt(0);
+        writeInt(0);
+
+        writeFourCC("LIST");
+        writeInt(0); // Patched on close
+        writeFourCC("movi");
+
+        if (position != HEADER_LENGTH) {
+            throw new IllegalStateException("Unexpected AVI header length " + position);
+        }
+    }
+
+    private void write(byte[] data, int offset, int length) throws IOException {
+        outputStream.write(data, offset, length);
+        position += length;
+    }
+
+    private void writeFourCC(String fourCC) throws IOException {
+        for (int index = 0; index < 4; index++) {
+            outputStream.write(fourCC.charAt(index));
+        }
+        position += 4;
+    }
+
+    private void writeInt(int value) throws IOException {
+        outputStream.write(value & 0xff);
+        outputStream.write((value >> 8) & 0xff);
+        outputStream.write((value >> 16) & 0xff);
+        outputStream.write((value >> 24) & 0xff);
+        position += 4;
+    }
+
+    private void writeShort(int value) throws IOException {
+        outputStream.write(value & 0xff);
+        outputStream.write((value >> 8) & 0xff);
+        position += 2;
+    }
+
+    private static void patchInt(RandomAccessFile file, long offset, int value) throws
+            IOException {
+        file.seek(offset);
+        file.write(new byte[]{(byte) value, (byte) (value >> 8), (byte) (value >> 16),
+                (byte) (value >> 24)});
+    }
+}
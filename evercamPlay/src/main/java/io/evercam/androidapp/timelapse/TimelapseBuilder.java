@@ -0,0 +1,213 @@
+package io.evercam.androidapp.timelapse;
+
+import android.graphics.Bitmap;
+import android.graphics.BitmapFactory;
+import android.os.Environment;
+import android.util.Log;
+
+import java.io.ByteArrayOutputStream;
+import java.io.File;
+import java.io.IOException;
+import java.text.SimpleDateFormat;
+import java.util.ArrayDeque;
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.Calendar;
+import java.util.concurrent.Callable;
+import java.util.concurrent.ExecutionException;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.Future;
+
+import io.evercam.androidapp.photoview.SnapshotManager;
+import io.evercam.androidapp.utils.Commons;
+
+/**
+ * Builds a Motion JPEG AVI time-lapse from the snapshots saved for a camera.
+ *
+ * Snapshots are decoded and scaled by a small worker pool, but at most
+ * {@link #MAX_FRAMES_IN_FLIGHT} frames are in memory at any time and frames are
+ * written to the file in order as soon as they are ready.
+ */
+public class TimelapseBuilder {
+    private final static String TAG = "TimelapseBuilder";
+    public static final String TIMELAPSE_FOLDER_NAME = "Evercam";
+
+    private final static int DECODE_THREADS = 2;
+    private final static int MAX_FRAMES_IN_FLIGHT = DECODE_THREADS * 2;
+    private final static int JPEG_QUALITY = 80;
+
+    public interface ProgressListener {
+        void onProgress(int framesWritten, int totalFrames);
+    }
+
+    private final String cameraId;
+    private int width = 1280;
+    private int framesPerSecond = 10;
+    private volatile boolean cancelled = false;
+
+    public TimelapseBuilder(String cameraId) {
+        this.cameraId = cameraId;
+    }
+
+    public TimelapseBuilder setWidth(int width) {
+        this.width = width;
+        return this;
+    }
+
+    public TimelapseBuilder setFramesPerSecond(int framesPerSecond) {
+        this.framesPerSecond = framesPerSecond;
+        return this;
+    }
+
+    public void cancel() {
+        cancelled = true;
+    }
+
+    /**
+     * @return saved snapshot files for the camera, oldest first
+     */
+    public File[] getSnapshotFiles() {
+        File[] files = new File(SnapshotManager.getPlayFolderPathForCamera(cameraId)).listFiles();
+        if (files == null) {
+            return new File[0];
+        }
+
+        ArrayList<File> imageFiles = new ArrayList<>();
+        for (File file : files) {
+            String name = file.getName().toLowerCase();
+            if (file.isFile() && (name.endsWith(".jpg") || name.endsWith(".png"))) {
+                imageFiles.add(file);
+            }
+        }
+
+        //Snapshot file names contain the capture time, so sorting by name is chronological
+        File[] sortedFiles = imageFiles.toArray(new File[imageFiles.size()]);
+        Arrays.sort(sortedFiles);
+        return sortedFiles;
+    }
+
+    /**
+     * Build the time-lapse. Should be called from a background thread.
+     *
+     * @return the time-lapse file, or null if there are no usable snapshots or
+     * the build has been cancelled
+     */
+    public File build(ProgressListener listener) throws IOException {
+        File[] snapshotFiles = getSnapshotFiles();
+        if (snapshotFiles.length == 0) return null;
+
+        int[] size = getOutputSize(snapshotFiles[snapshotFiles.length - 1]);
+        if (size == null) return null;
+        final int outputWidth = size[0];
+        final int outputHeight = size[1];
+
+        File outputFile = createOutputFile();
+        AviMjpegWriter writer = new AviMjpegWriter(outputFile, outputWidth, outputHeight,
+                framesPerSecond);
+        ExecutorService executor = Executors.newFixedThreadPool(DECODE_THREADS);
+        ArrayDeque<Future<byte[]>> pendingFrames = new ArrayDeque<>();
+        int nextFileIndex = 0;
+        int framesDone = 0;
+
+        try {
+            while (framesDone < snapshotFiles.length && !cancelled) {
+                while (nextFileIndex < snapshotFiles.length
+                        && pendingFrames.size() < MAX_FRAMES_IN_FLIGHT) {
+                    final File snapshotFile = snapshotFiles[nextFileIndex++];
+                    pendingFrames.add(executor.submit(new Callable<byte[]>() {
+                        @Override
+                        public byte[] call() throws Exception {
+                            return encodeFrame(snapshotFile, outputWidth, outputHeight);
+                        }
+                    }));
+                }
+
+                byte[] frame = waitForFrame(pendingFrames.poll());
+                if (frame != null) {
+                    writer.addFrame(frame);
+                }
+                framesDone++;
+
+                if (listener != null) {
+                    listener.onProgress(framesDone, snapshotFiles.length);
+                }
+            }
+        } finally {
+            executor.shutdownNow();
+            writer.close();
+        }
+
+        if (cancelled || writer.getFrameCount() == 0) {
+            outputFile.delete();
+            return null;
+        }
+        return outputFile;
+    }
+
+    private byte[] waitForFrame(Future<byte[]> future) throws IOException {
+        try {
+            return future.get();
+        } catch (InterruptedException e) {
+            Thread.currentThread().interrupt();
+            throw new IOException("Time-lapse build interrupted");
+        } catch (ExecutionException e) {
+            //Skip unreadable snapshots rather than failing the whole time-lapse
+            Log.e(TAG, "Failed to encode frame: " + e.getCause());
+            return null;
+        }
+    }
+
+    /**
+     * Use the aspect ratio of the latest snapshot, scaled to the requested width
+     * and rounded to even dimensions as most players expect.
+     */
+    private int[] getOutputSize(File referenceFile) {
+        BitmapFactory.Options options = new BitmapFactory.Options();
+        options.inJustDecodeBounds = true;
+        BitmapFactory.decodeFile(referenceFile.getPath(), options);
+        if (options.outWidth <= 0 || options.outHeight <= 0) return null;
+
+        int outputWidth = Math.min(width, options.outWidth) & ~1;
+        int outputHeight = Math.round((float) options.outHeight * outputWidth /
+                options.outWidth) & ~1;
+        return new int[]{outputWidth, Math.max(outputHeight, 2)};
+    }
+
+    private static byte[] encodeFrame(File snapshotFile, int outputWidth, int outputHeight) throws
+            IOException {
+        BitmapFactory.Options options = new BitmapFactory.Options();
+        options.inJustDecodeBounds = true;
+        BitmapFactory.decodeFile(snapshotFile.getPath(), options);
+        options.inSampleSize = Commons.calculateInSampleSize(options, outputWidth);
+        options.inJustDecodeBounds = false;
+
+        Bitmap decoded = BitmapFactory.decodeFile(snapshotFile.getPath(), options);
+        if (decoded == null) {
+            throw new IOException("Can not decode " + snapshotFile.getPath());
+        }
+
+        Bitmap scaled = decoded;
+        if (decoded.getWidth() != outputWidth || decoded.getHeight() != outputHeight) {
+            scaled = Bitmap.createScaledBitmap(decoded, outputWidth, outputHeight, true);
+            decoded.recycle();
+        }
+
+        ByteArrayOutputStream bytes = new ByteArrayOutputStream();
+        scaled.compress(Bitmap.CompressFormat.JPEG, JPEG_QUALITY, bytes);
+        scaled.recycle();
+        return bytes.toByteArray();
+    }
+
+    private File createOutputFile() throws IOException {
+        File folder = new File(Environment.getExternalStoragePublicDirectory(Environment
+                .DIRECTORY_MOVIES), TIMELAPSE_FOLDER_NAME);
+        if (!folder.exists() && !folder.mkdirs()) {
+            throw new IOException("Can not create " + folder.getPath());
+        }
+
+        SimpleDateFormat dateFormat = new SimpleDateFormat("yyyyMMdd_HHmmss");
+        String timeString = dateFormat.format(Calendar.getInstance().getTime());
+        return new File(folder, cameraId + "_timelapse_" + timeString + ".avi");
+    }
+}
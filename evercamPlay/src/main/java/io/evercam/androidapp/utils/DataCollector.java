@@ -104,6 +104,26 @@ public class DataCollector {
         }
     }
 
+    /**
+     * Return the network string followed by the {@link NetInfo#getNetworkKey()} of the WiFi
+     * network or the mobile carrier name, to tell apart networks of the same type
+     */
+    public String getNetworkIdentifier() {
+        String networkString = getNetworkString();
+        if (mContext == null) return networkString;
+
+        String name = "";
+        if (isConnectedWifi()) {
+            //The same SSID is used at many sites
+            name = new NetInfo(mContext.getApplicationContext()).getNetworkKey();
+        } else if (isConnectedMobile()) {
+            TelephonyManager telephonyManager = (TelephonyManager) mContext
+                    .getSystemService(Context.TELEPHONY_SERVICE);
+            name = telephonyManager.getNetworkOperatorName();
+        }
+        return name == null || name.isEmpty() ? networkString : networkString + " " + name;
+    }
+
     /**
      * Get the network info
      */
@@ -12,7 +12,9 @@ public class NetInfo {
     private String localIp = EMPTY_IP;
     private String netmaskIp = EMPTY_IP;
     private String gatewayIp = EMPTY_IP;
+    private String bssid = "";
     public static final String EMPTY_IP = "0.0.0.0";
+    public static final String NETWORK_KEY_NOT_WIFI = "not-wifi";
 
     public NetInfo(Context context) {
         WifiManager wifi = (WifiManager) context.getSystemService(Context.WIFI_SERVICE);
@@ -21,6 +23,9 @@ public class NetInfo {
             localIp = IpTranslator.getIpFromIntSigned(wifiInfo.getIpAddress());
             netmaskIp = IpTranslator.getIpFromIntSigned(wifi.getDhcpInfo().netmask);
             gatewayIp = IpTranslator.getIpFromIntSigned(wifi.getDhcpInfo().gateway);
+            if (wifiInfo.getBSSID() != null) {
+                bssid = wifiInfo.getBSSID();
+            }
         }
     }
 
@@ -48,4 +53,47 @@ public class NetInfo {
     public String getGatewayIp() {
         return gatewayIp;
     }
+
+    public String getBssid() {
+        return bssid;
+    }
+
+    /**
+     * Identify the network the phone is on by its gateway and access point, the same
+     * WiFi name can be used at several sites
+     */
+    public String getNetworkKey() {
+        if (localIp.equals(EMPTY_IP)) return NETWORK_KEY_NOT_WIFI;
+        return gatewayIp + "@" + bssid;
+    }
+
+    /**
+     * Whether the IP address is on the same subnet as the phone's WiFi address
+     */
+    public boolean isInSubnet(String ip) {
+        long address = toLong(ip);
+        long local = toLong(localIp);
+        long netmask = toLong(netmaskIp);
+        if (address < 0 || local <= 0 || netmask < 0) return false;
+        //Some devices report no netmask over DHCP, assume a home network
+        if (netmask == 0) netmask = 0xFFFFFF00L;
+        return (address & netmask) == (local & netmask);
+    }
+
+    private static long toLong(String ip) {
+        if (ip == null) return -1;
+        String[] parts = ip.trim().split("\\.");
+        if (parts.length != 4) return -1;
+        long value = 0;
+        try {
+            for (String part : parts) {
+                int octet = Integer.parseInt(part);
+                if (octet < 0 || octet > 255) return -1;
+                value = (value << 8) | octet;
+            }
+        } catch (NumberFormatException e) {
+            return -1;
+        }
+        return value;
+    }
 }
@@ -10,15 +10,31 @@ public class PrefsManager {
     public final static String KEY_RELEASE_NOTES_SHOWN = "isReleaseNotesShown";
     public static final String KEY_AWAKE_TIME = "prefsAwakeTime";
     public static final String KEY_FORCE_LANDSCAPE = "prefsForceLandscape";
+    public static final String KEY_LOW_LATENCY = "prefsLowLatency";
     public static final String KEY_SHOW_OFFLINE_CAMERA = "prefsShowOfflineCameras";
     public final static String KEY_VERSION = "prefsVersion";
     public final static String KEY_SHOWCASE_SHOWN = "isShowcaseShown";
     public final static String KEY_GUIDE = "prefsGuide";
+    public final static String KEY_ABOUT = "prefsAbout";
+    public final static String KEY_NETWORK_METRICS = "prefsNetworkMetrics";
+    public final static String KEY_SNAPSHOT_QUOTA = "prefsSnapshotQuota";
+    public final static String KEY_SNAPSHOT_CAMERA_QUOTA = "prefsSnapshotCameraQuota";
+    public final static String KEY_SNAPSHOT_EVICTION = "prefsSnapshotEviction";
+    public final static String KEY_SNAPSHOT_INDEX_BACKFILLED = "isSnapshotIndexBackfilled";
+
+    public final static String VALUE_EVICTION_OLDEST = "oldest";
+    public final static String VALUE_EVICTION_LEAST_VIEWED = "leastViewed";
 
     public final static String KEY_GCM_PREFS_ID = "gcmDetails";
     public final static String KEY_GCM_REGISTRATION_ID = "registrationId";
     public final static String KEY_GCM_APP_VERSION = "gcmAppVersion";
 
+    public final static String KEY_BANDWIDTH_PREFS_ID = "bandwidthEstimates";
+
+    public final static String KEY_CATALOGUE_PREFS_ID = "catalogue";
+    public final static String KEY_CATALOGUE_REFRESHED_AT = "vendorsRefreshedAt";
+    public final static String KEY_CATALOGUE_VERSION = "version";
+
     public static int getCameraPerRow(Context context, int oldNumber) {
         SharedPreferences sharedPrefs = PreferenceManager.getDefaultSharedPreferences(context);
         return Integer.parseInt(sharedPrefs.getString(KEY_CAMERA_PER_ROW, "" + oldNumber));
@@ -41,6 +57,11 @@ public class PrefsManager {
         return sharedPrefs.getBoolean(KEY_FORCE_LANDSCAPE, false);
     }
 
+    public static boolean isLowLatencyEnabled(Context context) {
+        SharedPreferences sharedPrefs = PreferenceManager.getDefaultSharedPreferences(context);
+        return sharedPrefs.getBoolean(KEY_LOW_LATENCY, false);
+    }
+
     public static boolean showOfflineCameras(Context context) {
         SharedPreferences sharedPrefs = PreferenceManager.getDefaultSharedPreferences(context);
         return sharedPrefs.getBoolean(KEY_SHOW_OFFLINE_CAMERA, true);
@@ -53,6 +74,47 @@ public class PrefsManager {
         editor.apply();
     }
 
+    /**
+     * @return the total snapshot storage quota in bytes, 0 if unlimited
+     */
+    public static long getSnapshotQuotaBytes(Context context) {
+        SharedPreferences sharedPrefs = PreferenceManager.getDefaultSharedPreferences(context);
+        return megabytesToBytes(sharedPrefs.getString(KEY_SNAPSHOT_QUOTA, "" + 0));
+    }
+
+    /**
+     * @return the snapshot storage quota for each camera in bytes, 0 if unlimited
+     */
+    public static long getSnapshotCameraQuotaBytes(Context context) {
+        SharedPreferences sharedPrefs = PreferenceManager.getDefaultSharedPreferences(context);
+        return megabytesToBytes(sharedPrefs.getString(KEY_SNAPSHOT_CAMERA_QUOTA, "" + 0));
+    }
+
+    public static String getSnapshotEviction(Context context) {
+        SharedPreferences sharedPrefs = PreferenceManager.getDefaultSharedPreferences(context);
+        return sharedPrefs.getString(KEY_SNAPSHOT_EVICTION, VALUE_EVICTION_OLDEST);
+    }
+
+    public static boolean isSnapshotIndexBackfilled(Context context) {
+        SharedPreferences sharedPrefs = PreferenceManager.getDefaultSharedPreferences(context);
+        return sharedPrefs.getBoolean(KEY_SNAPSHOT_INDEX_BACKFILLED, false);
+    }
+
+    public static void setSnapshotIndexBackfilled(Context context) {
+        SharedPreferences sharedPrefs = PreferenceManager.getDefaultSharedPreferences(context);
+        SharedPreferences.Editor editor = sharedPrefs.edit();
+        editor.putBoolean(KEY_SNAPSHOT_INDEX_BACKFILLED, true);
+        editor.apply();
+    }
+
+    private static long megabytesToBytes(String megabytesString) {
+        try {
+            return Long.parseLong(megabytesString) * 1024 * 1024;
+        } catch (NumberFormatException e) {
+            return 0;
+        }
+    }
+
     public static boolean isReleaseNotesShown(Context context, int versionCode) {
         SharedPreferences sharedPrefs = PreferenceManager.getDefaultSharedPreferences(context);
 
@@ -102,4 +164,69 @@ public class PrefsManager {
 
         return registrationId;
     }
+
+    /**
+     * @return the stored bandwidth estimate in bits per second for the network, 0 if unknown
+     */
+    public static long getBandwidthEstimate(Context context, String networkIdentifier) {
+        SharedPreferences prefs = context.getSharedPreferences(KEY_BANDWIDTH_PREFS_ID, Activity.MODE_PRIVATE);
+        return prefs.getLong(networkIdentifier, 0);
+    }
+
+    /**
+     * Blend a new bandwidth sample into the stored estimate for the network, so one
+     * unusually fast or slow session doesn't replace the history
+     */
+    public static void updateBandwidthEstimate(Context context, String networkIdentifier, long bitrate) {
+        if (bitrate <= 0) return;
+
+        SharedPreferences prefs = context.getSharedPreferences(KEY_BANDWIDTH_PREFS_ID, Activity.MODE_PRIVATE);
+        long storedBitrate = prefs.getLong(networkIdentifier, 0);
+        long newBitrate = storedBitrate == 0 ? bitrate : (storedBitrate + bitrate) / 2;
+
+        SharedPreferences.Editor editor = prefs.edit();
+        editor.putLong(networkIdentifier, newBitrate);
+        editor.apply();
+    }
+
+    /**
+     * @return when the vendor list was last fetched, 0 if never
+     */
+    public static long getCatalogueRefreshedAt(Context context) {
+        SharedPreferences prefs = context.getSharedPreferences(KEY_CATALOGUE_PREFS_ID, Activity.MODE_PRIVATE);
+        return prefs.getLong(KEY_CATALOGUE_REFRESHED_AT, 0);
+    }
+
+    public static void setCatalogueRefreshedAt(Context context, long refreshedAt) {
+        SharedPreferences prefs = context.getSharedPreferences(KEY_CATALOGUE_PREFS_ID, Activity.MODE_PRIVATE);
+        SharedPreferences.Editor editor = prefs.edit();
+        editor.putLong(KEY_CATALOGUE_REFRESHED_AT, refreshedAt);
+        editor.apply();
+    }
+
+    /**
+     * @return a number that increases every time the local catalogue changes
+     */
+    public static int getCatalogueVersion(Context context) {
+        SharedPreferences prefs = context.getSharedPreferences(KEY_CATALOGUE_PREFS_ID, Activity.MODE_PRIVATE);
+        return prefs.getInt(KEY_CATALOGUE_VERSION, 0);
+    }
+
+    /**
+     * Forget when the catalogue was last refreshed, after its tables were emptied
+     */
+    public static void resetCatalogue(Context context) {
+        SharedPreferences prefs = context.getSharedPreferences(KEY_CATALOGUE_PREFS_ID, Activity.MODE_PRIVATE);
+        SharedPreferences.Editor editor = prefs.edit();
+        editor.remove(KEY_CATALOGUE_REFRESHED_AT);
+        editor.putInt(KEY_CATALOGUE_VERSION, prefs.getInt(KEY_CATALOGUE_VERSION, 0) + 1);
+        editor.apply();
+    }
+
+    public static void increaseCatalogueVersion(Context context) {
+        SharedPreferences prefs = context.getSharedPreferences(KEY_CATALOGUE_PREFS_ID, Activity.MODE_PRIVATE);
+        SharedPreferences.Editor editor = prefs.edit();
+        editor.putInt(KEY_CATALOGUE_VERSION, prefs.getInt(KEY_CATALOGUE_VERSION, 0) + 1);
+        editor.apply();
+    }
 }
@@ -0,0 +1,116 @@
+package io.evercam.androidapp.utils;
+
+import java.io.DataInputStream;
+import java.io.IOException;
+import java.io.InputStream;
+
+/**
+ * Compact raster of time zone boundaries, resolving a coordinate to a tz id with two
+ * array lookups and a binary search.
+ *
+ * The world is split into cells of 1 / cellsPerDegree degrees. Each row of cells, from
+ * latitude 90 down to -90, is run length encoded since neighbouring cells mostly share
+ * a zone, which keeps a quarter degree grid at a few hundred kilobytes. Each cell holds
+ * the zone covering most of it, so results can be off within one cell of a border.
+ *
+ * File format, big endian:
+ * <pre>
+ * int    magic "TZG1"
+ * int    cellsPerDegree
+ * int    zoneCount, followed by zoneCount tz ids written with writeUTF
+ * rows   for each of 180 * cellsPerDegree rows:
+ *        unsigned short runCount, followed by runCount pairs of
+ *        short zoneIndex (-1 for sea), unsigned short cellCount
+ * </pre>
+ */
+public class TimezoneGrid {
+    public final static int MAGIC = 0x545A4731;
+
+    private final int cellsPerDegree;
+    private final int columnCount;
+    private final String[] zones;
+    /* Per row, the exclusive end column of each run and the zone index of that run */
+    private final int[][] runEnds;
+    private final short[][] runZones;
+
+    public TimezoneGrid(InputStream inputStream) throws IOException {
+        DataInputStream dataInputStream = new DataInputStream(inputStream);
+        if (dataInputStream.readInt() != MAGIC) {
+            throw new IOException("Not a timezone grid");
+        }
+
+        cellsPerDegree = dataInputStream.readInt();
+        if (cellsPerDegree <= 0 || cellsPerDegree > 100) {
+            throw new IOException("Invalid cells per degree: " + cellsPerDegree);
+        }
+        columnCount = 360 * cellsPerDegree;
+        int rowCount = 180 * cellsPerDegree;
+
+        zones = new String[dataInputStream.readInt()];
+        for (int index = 0; index < zones.length; index++) {
+            zones[index] = dataInputStream.readUTF();
+        }
+
+        runEnds = new int[rowCount][];
+        runZones = new short[rowCount][];
+        for (int row = 0; row < rowCount; row++) {
+            int runCount = dataInputStream.readUnsignedShort();
+            int[] ends = new int[runCount];
+            short[] rowZones = new short[runCount];
+            int column = 0;
+            for (int run = 0; run < runCount; run++) {
+                rowZones[run] = dataInputStream.readShort();
+                column += dataInputStream.readUnsignedShort();
+                ends[run] = column;
+                if (rowZones[run] >= zones.length) {
+                    throw new IOException("Invalid zone index in row " + row);
+                }
+            }
+            if (column != columnCount) {
+                throw new IOException("Row " + row + " covers " + column + " of "
+                        + columnCount + " cells");
+            }
+            runEnds[row] = ends;
+            runZones[row] = rowZones;
+        }
+    }
+
+    /**
+     * @return the tz id at the coordinate, or null if it's at sea
+     */
+    public String lookup(double latitude, double longitude) {
+        int row = clamp((int) Math.floor((90 - latitude) * cellsPerDegree), runEnds.length);
+        int column = clamp((int) Math.floor((normalizeLongitude(longitude) + 180)
+                * cellsPerDegree), columnCount);
+
+        int[] ends = runEnds[row];
+        int low = 0;
+        int high = ends.length - 1;
+        while (low < high) {
+            int middle = (low + high) >>> 1;
+            if (ends[middle] <= column) {
+                low = middle + 1;
+            } else {
+                high = middle;
+            }
+        }
+        short zoneIndex = runZones[row][low];
+        return zoneIndex < 0 ? null : zones[zoneIndex];
+    }
+
+    public int getZoneCount() {
+        return zones.length;
+    }
+
+    private static double normalizeLongitude(double longitude) {
+        double normalized = (longitude + 180) % 360;
+        if (normalized < 0) {
+            normalized += 360;
+        }
+        return normalized - 180;
+    }
+
+    private static int clamp(int index, int count) {
+        return Math.max(0, Math.min(count - 1, index));
+    }
+}
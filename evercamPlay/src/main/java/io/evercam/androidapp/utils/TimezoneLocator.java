@@ -0,0 +1,63 @@
+package io.evercam.androidapp.utils;
+
+import android.content.Context;
+import android.util.Log;
+
+import java.io.FileNotFoundException;
+import java.io.IOException;
+import java.io.InputStream;
+
+/**
+ * Resolves a coordinate to a tz id from a {@link TimezoneGrid} asset, for builds that
+ * add one. The grid is not generated by this project, so without the asset there is no
+ * local result and the timezone comes from the Google Time Zone API only.
+ */
+public class TimezoneLocator {
+    private final static String TAG = "TimezoneLocator";
+    private final static String GRID_ASSET = "timezone_grid.bin";
+
+    private static TimezoneGrid grid;
+    private static boolean isGridLoaded = false;
+
+    /**
+     * Load the grid asset if not loaded yet. Reads an asset, so call it off the main
+     * thread.
+     */
+    public static synchronized void loadGrid(Context context) {
+        if (isGridLoaded) return;
+        isGridLoaded = true;
+
+        InputStream inputStream = null;
+        try {
+            long startTime = System.currentTimeMillis();
+            inputStream = context.getAssets().open(GRID_ASSET);
+            grid = new TimezoneGrid(inputStream);
+            Log.d(TAG, "Loaded " + grid.getZoneCount() + " zones in "
+                    + (System.currentTimeMillis() - startTime) + "ms");
+        } catch (FileNotFoundException e) {
+            Log.d(TAG, "No timezone grid in this build");
+        } catch (IOException e) {
+            Log.e(TAG, "Failed to load timezone grid: " + e.toString());
+        } finally {
+            if (inputStream != null) {
+                try {
+                    inputStream.close();
+                } catch (IOException e) {
+                    Log.e(TAG, e.toString());
+                }
+            }
+        }
+    }
+
+    /**
+     * @return the zone from the grid, or null if the build has no grid or the
+     * coordinate is outside every zone in it
+     */
+    public static String locateInGrid(double latitude, double longitude) {
+        TimezoneGrid loadedGrid;
+        synchronized (TimezoneLocator.class) {
+            loadedGrid = grid;
+        }
+        return loadedGrid != null ? loadedGrid.lookup(latitude, longitude) : null;
+    }
+}
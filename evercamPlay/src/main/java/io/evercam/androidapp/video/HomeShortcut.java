@@ -18,6 +18,7 @@ import io.evercam.androidapp.dto.EvercamCamera;
 
 public class HomeShortcut {
     public static final String KEY_CAMERA_ID = "cameraId";
+    public static final int ICON_SIZE = 192;
 
     private static final String TAG = "HomeShortcut";
 
@@ -44,6 +45,19 @@ public class HomeShortcut {
         context.sendBroadcast(addIntent);
     }
 
+    /**
+     * Build the icon and create the shortcut on a background thread
+     */
+    public static void createInBackground(final Context context, final EvercamCamera evercamCamera,
+                                          final Bitmap snapshotBitmap) {
+        new Thread(new Runnable() {
+            @Override
+            public void run() {
+                create(context, evercamCamera, snapshotBitmap);
+            }
+        }).start();
+    }
+
     private static String getLiveViewUri(Context context) {
         return context.getString(R.string.data_scheme) + "://" + context.getString(R.string
                 .data_host) + context.getString(R.string.data_path);
@@ -55,11 +69,11 @@ public class HomeShortcut {
         if (bitmap == null) {
             bitmap = BitmapFactory.decodeResource(context.getResources(),
                     R.drawable.icon_evercam);
-            return Bitmap.createScaledBitmap(bitmap, 192, 192, false);
+            return Bitmap.createScaledBitmap(bitmap, ICON_SIZE, ICON_SIZE, false);
         }
 
         //Resize the thumbnail for desktop icon size
-        bitmap = Bitmap.createScaledBitmap(bitmap, 192, 192, false);
+        bitmap = Bitmap.createScaledBitmap(bitmap, ICON_SIZE, ICON_SIZE, false);
 
         //Rounded image corner
         bitmap = getRoundedCornerBitmap(bitmap);
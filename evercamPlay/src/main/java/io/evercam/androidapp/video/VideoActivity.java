@@ -3,6 +3,7 @@ package io.evercam.androidapp.video;
 import android.app.Activity;
 import android.app.AlertDialog;
 import android.app.TaskStackBuilder;
+import android.content.Context;
 import android.content.DialogInterface;
 import android.content.Intent;
 import android.content.pm.ActivityInfo;
@@ -19,6 +20,7 @@ import android.net.Uri;
 import android.os.AsyncTask;
 import android.os.Bundle;
 import android.os.Handler;
+import android.os.SystemClock;
 import android.support.v4.app.NavUtils;
 import android.support.v7.widget.Toolbar;
 import android.util.Log;
@@ -43,7 +45,6 @@ import android.widget.TextView;
 import android.widget.Toast;
 
 import com.google.android.exoplayer2.C;
-import com.google.android.exoplayer2.DefaultLoadControl;
 import com.google.android.exoplayer2.ExoPlaybackException;
 import com.google.android.exoplayer2.ExoPlayer;
 import com.google.android.exoplayer2.ExoPlayerFactory;
@@ -71,6 +72,7 @@ import com.squareup.picasso.Picasso;
 import org.json.JSONException;
 import org.json.JSONObject;
 
+import java.io.File;
 import java.util.ArrayList;
 import java.util.Date;
 
@@ -78,7 +80,6 @@ import io.evercam.EvercamException;
 import io.evercam.PTZHome;
 import io.evercam.PTZPreset;
 import io.evercam.PTZPresetControl;
-import io.evercam.PTZRelativeBuilder;
 import io.evercam.Right;
 import io.evercam.Snapshot;
 import io.evercam.androidapp.CamerasActivity;
@@ -97,22 +98,40 @@ import io.evercam.androidapp.custom.ProgressView;
 import io.evercam.androidapp.dal.DbCamera;
 import io.evercam.androidapp.dto.AppData;
 import io.evercam.androidapp.dto.AppUser;
+import io.evercam.androidapp.dto.CameraCapability;
 import io.evercam.androidapp.dto.EvercamCamera;
 import io.evercam.androidapp.feedback.StreamFeedbackItem;
+import io.evercam.androidapp.feedback.StreamQoeReporter;
 import io.evercam.androidapp.permission.Permission;
 import io.evercam.androidapp.photoview.SnapshotManager;
 import io.evercam.androidapp.photoview.SnapshotManager.FileType;
 import io.evercam.androidapp.player.EventLogger;
+import io.evercam.androidapp.player.FrameCapture;
+import io.evercam.androidapp.player.HlsPreloader;
+import io.evercam.androidapp.player.HlsSegmentCache;
+import io.evercam.androidapp.player.HybridStreamSwitcher;
+import io.evercam.androidapp.player.LatencyProfile;
+import io.evercam.androidapp.player.LiveEdgeController;
 import io.evercam.androidapp.player.OnSwipeTouchListener;
+import io.evercam.androidapp.player.PlaybackMetrics;
+import io.evercam.androidapp.ptz.ContinuousMoveTouchListener;
+import io.evercam.androidapp.ptz.PTZCommandQueue;
 import io.evercam.androidapp.ptz.PresetsListAdapter;
 import io.evercam.androidapp.recordings.RecordingWebActivity;
+import io.evercam.androidapp.routing.RouteSelector;
+import io.evercam.androidapp.routing.RouteTable;
+import io.evercam.androidapp.rtsp.RtspClient;
+import io.evercam.androidapp.rtsp.RtspPlayer;
 import io.evercam.androidapp.sharing.SharingActivity;
 import io.evercam.androidapp.tasks.CaptureSnapshotRunnable;
-import io.evercam.androidapp.tasks.CheckOnvifTask;
+import io.evercam.androidapp.tasks.CreateTimelapseTask;
+import io.evercam.androidapp.tasks.LanLiveViewRunnable;
 import io.evercam.androidapp.tasks.LiveViewRunnable;
-import io.evercam.androidapp.tasks.PTZMoveTask;
+import io.evercam.androidapp.tasks.LoadCapabilityTask;
 import io.evercam.androidapp.utils.Commons;
 import io.evercam.androidapp.utils.Constants;
+import io.evercam.androidapp.utils.DataCollector;
+import io.evercam.androidapp.utils.NetInfo;
 import io.evercam.androidapp.utils.PrefsManager;
 import io.evercam.androidapp.utils.RxUtils;
 import rx.Observable;
@@ -128,6 +147,7 @@ public class VideoActivity extends ParentAppCompatActivity
     public static EvercamCamera evercamCamera;
 
     private final static String TAG = "VideoActivity";
+    private final static long CROSS_FADE_MS = 300;
     private String liveViewCameraId = "";
     public ArrayList<PTZPreset> presetList = new ArrayList<>();
 
@@ -137,6 +157,16 @@ public class VideoActivity extends ParentAppCompatActivity
      * JPG live view using WebSocket
      */
     private LiveViewRunnable mLiveViewRunnable;
+    private LanLiveViewRunnable mLanLiveViewRunnable;
+    private RtspPlayer rtspPlayer;
+    /* Released RTSP players whose decoder still holds the surface */
+    private int releasingRtspPlayers = 0;
+    /* Waits for those decoders to let go of the surface, only the latest is kept */
+    private Runnable surfaceFreeRunnable;
+    /* Camera whose RTSP stream failed, it stays on HLS or JPG */
+    private String rtspFailedCameraId;
+    /* Camera whose local network route failed, it stays on the cloud route */
+    private String lanFailedCameraId;
     private boolean showJpgView = false;
 
     /**
@@ -152,6 +182,16 @@ public class VideoActivity extends ParentAppCompatActivity
 
     private DefaultTrackSelector trackSelector;
     private EventLogger eventLogger;
+    private LiveEdgeController liveEdgeController;
+    private HybridStreamSwitcher hybridStreamSwitcher;
+    private LatencyProfile latencyProfile;
+    private HlsPreloader hlsPreloader;
+    private ArrayList<EvercamCamera> spinnerCameraList;
+    private Runnable preloadRefreshRunnable;
+    private File replayPlaylist;
+    private String sessionCameraId;
+    private String sessionHlsUrl;
+    private String sessionNetworkId;
     private SimpleExoPlayer player;
     private DataSource.Factory mediaDataSourceFactory;
     private Handler mainHandler;
@@ -203,6 +243,7 @@ public class VideoActivity extends ParentAppCompatActivity
     private OnSwipeTouchListener swipeTouchListener;
 
     private Subscription mSubscription;
+    private CreateTimelapseTask timelapseTask;
     private FirebaseAnalytics mFirebaseAnalytics;
 
     @Override
@@ -235,7 +276,9 @@ public class VideoActivity extends ParentAppCompatActivity
             getSupportActionBar().setDisplayHomeAsUpEnabled(true);
             mCameraListSpinner = (Spinner) findViewById(R.id.spinner_camera_list);
 
-            mediaDataSourceFactory = buildDataSourceFactory(true);
+            hlsPreloader = new HlsPreloader(((EvercamPlayApplication) getApplication())
+                    .buildHttpDataSourceFactory(null));
+            mediaDataSourceFactory = hlsPreloader.wrap(buildDataSourceFactory(true));
             mainHandler = new Handler();
 
             initialPageElements();
@@ -395,8 +438,18 @@ public class VideoActivity extends ParentAppCompatActivity
     @Override
     protected void onDestroy() {
         releasePlayer();
+        if (hlsPreloader != null) {
+            hlsPreloader.release();
+        }
+        StreamQoeReporter.flush(getMixpanel(), true);
+        if (evercamCamera != null) {
+            getPtzQueue().cancel();
+        }
         super.onDestroy();
         RxUtils.unsubscribeIfNotNull(mSubscription);
+        if (timelapseTask != null) {
+            timelapseTask.cancelBuild();
+        }
     }
 
     @Override
@@ -516,6 +569,7 @@ public class VideoActivity extends ParentAppCompatActivity
     public boolean onPrepareOptionsMenu(Menu menu) {
         MenuItem shortcutItem = menu.findItem(R.id.video_menu_create_shortcut);
         MenuItem sharingItem = menu.findItem(R.id.video_menu_share);
+        MenuItem replayItem = menu.findItem(R.id.video_menu_replay);
 //        MenuItem removeItem = menu.findItem(R.id.video_menu_remove_camera);
 
         if (evercamCamera != null) {
@@ -526,6 +580,10 @@ public class VideoActivity extends ParentAppCompatActivity
             Right right = new Right(evercamCamera.getRights());
             sharingItem.setVisible(right.isFullRight());
 
+            replayItem.setVisible(evercamCamera.hasHlsUrl());
+            replayItem.setTitle(replayPlaylist != null ? R.string.menu_back_to_live
+                    : R.string.menu_replay);
+
             //Only show item 'Remove Camera' when it's a shared camera
 //            removeItem.setVisible(!evercamCamera.isOwned());
         } else {
@@ -551,6 +609,23 @@ public class VideoActivity extends ParentAppCompatActivity
                 startActivityForResult(shareIntent, Constants.REQUEST_CODE_SHARE);
             } else if (itemId == R.id.video_menu_view_snapshots) {
                 SnapshotManager.showSnapshotsForCamera(this, evercamCamera.getCameraId());
+            } else if (itemId == R.id.video_menu_replay) {
+                if (evercamCamera != null) {
+                    if (replayPlaylist != null) {
+                        stopReplay();
+                    } else {
+                        startReplay();
+                    }
+                }
+            } else if (itemId == R.id.video_menu_create_timelapse) {
+                if (evercamCamera != null) {
+                    if (Permission.isGranted(this, Permission.STORAGE)) {
+                        timelapseTask = CreateTimelapseTask.launch(this, evercamCamera.getCameraId());
+                    } else {
+                        Permission.request(this, new String[]{Permission.STORAGE},
+                                Permission.REQUEST_CODE_STORAGE);
+                    }
+                }
             } else if (itemId == R.id.video_menu_create_shortcut) {
                 if (evercamCamera != null) {
 
@@ -560,8 +635,7 @@ public class VideoActivity extends ParentAppCompatActivity
                     bundle.putString("Evercam_ShortcutCreation", "Home shortcut created successfully");
                     mFirebaseAnalytics.logEvent("Home_Shortcut", bundle);
 
-                    Bitmap bitmap = getBitmapFromImageView(imageView);
-                    HomeShortcut.create(getApplicationContext(), evercamCamera, bitmap);
+                    createHomeShortcut(evercamCamera);
                     CustomSnackbar.showShort(this, R.string.msg_shortcut_created);
                     /*
                     EvercamPlayApplication.sendEventAnalytics(this, R.string.category_shortcut, R.string.action_shortcut_create, R.string.label_shortcut_create);
@@ -613,13 +687,23 @@ public class VideoActivity extends ParentAppCompatActivity
                 text += "buffering";
                 break;
             case ExoPlayer.STATE_ENDED:
+                //Replay reached the end of the cached window, carry on with live
+                if (replayPlaylist != null) {
+                    mainHandler.post(new Runnable() {
+                        @Override
+                        public void run() {
+                            if (replayPlaylist != null) {
+                                stopReplay();
+                            }
+                        }
+                    });
+                }
                 text += "ended";
                 break;
             case ExoPlayer.STATE_IDLE:
                 text += "idle";
                 break;
             case ExoPlayer.STATE_READY:
-                onVideoLoaded();
                 text += "ready";
                 break;
             default:
@@ -636,6 +720,11 @@ public class VideoActivity extends ParentAppCompatActivity
                 height == 0 ? 1 : (width * pixelWidthAspectRatio) / height);
     }
 
+    @Override
+    public void onRenderedFirstFrame() {
+        //First frame handling is done by HybridStreamSwitcher
+    }
+
     /*************************************
      * TextureView.SurfaceTextureListener
      ************************************/
@@ -731,6 +820,8 @@ public class VideoActivity extends ParentAppCompatActivity
         VideoActivity.evercamCamera = evercamCamera;
 
         showJpgView = false;
+        stopPreloadingAdjacentCameras();
+        replayPlaylist = null;
 
         optionsActivityStarted = false;
 
@@ -813,8 +904,20 @@ public class VideoActivity extends ParentAppCompatActivity
     private void createPlayer(EvercamCamera camera) {
         startTime = new Date();
 
-        if (camera.hasHlsUrl()) {
+        if (canPlayRtsp(camera)) {
+            //Paint JPG frames straight away, the RTSP video fades in over them
+            if (!showJpgView) {
+                showJpgView = true;
+                launchJpgRunnable();
+            }
+            startRtspPlayer(camera);
+        } else if (camera.hasHlsUrl()) {
             Log.d(TAG, "HLS url: " + camera.getHlsUrl());
+            //Paint JPG frames straight away, HybridStreamSwitcher switches to HLS once it plays
+            if (!showJpgView) {
+                showJpgView = true;
+                launchJpgRunnable();
+            }
             preparePlayer();
         } else {
             //If no HLS URL exists, start JPG view straight away
@@ -825,6 +928,12 @@ public class VideoActivity extends ParentAppCompatActivity
     }
 
     private void preparePlayer() {
+        if (waitForSurface(new Runnable() {
+            @Override
+            public void run() {
+                preparePlayer();
+            }
+        })) return;
 
         if (player == null){
 
@@ -837,12 +946,20 @@ public class VideoActivity extends ParentAppCompatActivity
                             : SimpleExoPlayer.EXTENSION_RENDERER_MODE_OFF;
 
             TrackSelection.Factory videoTrackSelectionFactory =
-                    new AdaptiveVideoTrackSelection.Factory(BANDWIDTH_METER);
+                    new AdaptiveVideoTrackSelection.Factory(BANDWIDTH_METER,
+                            getInitialBitrateEstimate(),
+                            AdaptiveVideoTrackSelection.DEFAULT_MIN_DURATION_FOR_QUALITY_INCREASE_MS,
+                            AdaptiveVideoTrackSelection.DEFAULT_MAX_DURATION_FOR_QUALITY_DECREASE_MS,
+                            AdaptiveVideoTrackSelection.DEFAULT_MIN_DURATION_TO_RETAIN_AFTER_DISCARD_MS,
+                            AdaptiveVideoTrackSelection.DEFAULT_BANDWIDTH_FRACTION);
 
             trackSelector = new DefaultTrackSelector(videoTrackSelectionFactory);
 
-            player = ExoPlayerFactory.newSimpleInstance(this, trackSelector, new DefaultLoadControl(),
-                    drmSessionManager, extensionRendererMode);
+            latencyProfile = PrefsManager.isLowLatencyEnabled(this)
+                    ? LatencyProfile.LOW_LATENCY : LatencyProfile.STANDARD;
+
+            player = ExoPlayerFactory.newSimpleInstance(this, trackSelector,
+                    latencyProfile.buildLoadControl(), drmSessionManager, extensionRendererMode);
             player.addListener(this);
 
             eventLogger = new EventLogger(trackSelector);
@@ -852,24 +969,51 @@ public class VideoActivity extends ParentAppCompatActivity
             player.setVideoDebugListener(eventLogger);
             player.setMetadataOutput(eventLogger);
 
-            Uri hlsUrl = Uri.parse(evercamCamera.getHlsUrl());
-
-            MediaSource mediaSource = new HlsMediaSource(hlsUrl, mediaDataSourceFactory, mainHandler, eventLogger);
+            liveEdgeController = new LiveEdgeController(player, latencyProfile, eventLogger);
+            player.addListener(liveEdgeController);
 
+            hybridStreamSwitcher = new HybridStreamSwitcher(hybridStreamListener,
+                    new HybridStreamSwitcher.Thresholds());
+            player.addListener(hybridStreamSwitcher);
+            eventLogger.addListener(hybridStreamSwitcher);
 
-            boolean haveResumePosition = resumeWindow != C.INDEX_UNSET;
-            if (haveResumePosition) {
-                player.seekTo(resumeWindow, resumePosition);
-            }
-            player.prepare(mediaSource, !haveResumePosition, false);
+            liveEdgeController.addSeekListener(eventLogger);
+            liveEdgeController.addSeekListener(hybridStreamSwitcher);
 
-            player.setPlayWhenReady(true);
             player.setVideoSurface(surface);
+        } else {
+            //Keep the player, its renderers and decoders alive and only swap the media source
+            reportPlaybackSession();
+            eventLogger.startSession();
+            liveEdgeController.reset();
+            hybridStreamSwitcher.reset();
+        }
 
-        }else{
-            releasePlayer();
-            preparePlayer();
+        MediaSource mediaSource;
+        if (replayPlaylist != null) {
+            mediaSource = new HlsMediaSource(Uri.fromFile(replayPlaylist),
+                    buildDataSourceFactory(false), mainHandler, eventLogger);
+        } else {
+            Uri hlsUrl = Uri.parse(evercamCamera.getHlsUrl());
+            DataSource.Factory cachingDataSourceFactory = HlsSegmentCache.getInstance(this)
+                    .wrap(mediaDataSourceFactory, evercamCamera.getCameraId());
+            mediaSource = new HlsMediaSource(hlsUrl, cachingDataSourceFactory, mainHandler, eventLogger);
+        }
+
+        //Low latency playback always starts from the live edge instead
+        boolean haveResumePosition = resumeWindow != C.INDEX_UNSET
+                && !latencyProfile.chasesLiveEdge();
+        if (haveResumePosition) {
+            player.seekTo(resumeWindow, resumePosition);
         }
+        player.prepare(mediaSource, !haveResumePosition, true);
+
+        player.setPlayWhenReady(true);
+
+        //Only live sessions are reported
+        sessionCameraId = replayPlaylist == null ? evercamCamera.getCameraId() : null;
+        sessionHlsUrl = evercamCamera.getHlsUrl();
+        sessionNetworkId = new DataCollector(this).getNetworkIdentifier();
 
 
         /*DrmSessionManager<FrameworkMediaCrypto> drmSessionManager = null;
@@ -902,10 +1046,110 @@ public class VideoActivity extends ParentAppCompatActivity
         player.setVideoSurface(surface);*/
     }
 
+    /**
+     * Play the camera's RTSP stream directly when the phone is on its local network,
+     * HLS through Evercam adds seconds of latency
+     */
+    private boolean canPlayRtsp(EvercamCamera camera) {
+        if (replayPlaylist != null || surface == null || camera.getInternalRtspUrl().isEmpty()
+                || camera.getCameraId().equals(rtspFailedCameraId)) {
+            return false;
+        }
+        return RouteSelector.getRoute(this, camera, LanLiveViewRunnable.isAvailable(new NetInfo
+                (this), camera) ? RouteTable.Route.INTERNAL : RouteTable.Route.CLOUD)
+                == RouteTable.Route.INTERNAL;
+    }
+
+    private void startRtspPlayer(final EvercamCamera camera) {
+        releasePlayer();
+        if (waitForSurface(new Runnable() {
+            @Override
+            public void run() {
+                if (camera == evercamCamera) {
+                    startRtspPlayer(camera);
+                }
+            }
+        })) return;
+
+        rtspPlayer = new RtspPlayer(camera.getInternalRtspUrl(), camera.hasCredentials() ?
+                camera.getUsername() : null, camera.getPassword(), surface,
+                new RtspPlayer.Listener() {
+                    @Override
+                    public void onFirstFrameRendered() {
+                        if (showJpgView) {
+                            disconnectJpgView();
+                            showJpgView = false;
+                        }
+                        onVideoLoaded();
+                    }
+
+                    @Override
+                    public void onVideoSizeChanged(int width, int height) {
+                        videoFrame.setAspectRatio(height == 0 ? 1 : (float) width / height);
+                    }
+
+                    @Override
+                    public void onError(Exception e) {
+                        Log.e(TAG, "RTSP failed, falling back: " + e.toString());
+                        rtspFailedCameraId = camera.getCameraId();
+                        releaseRtspPlayer();
+                        if (camera == evercamCamera && !paused && !end) {
+                            createPlayer(camera);
+                        }
+                    }
+                });
+        rtspPlayer.start();
+    }
+
+    private void releaseRtspPlayer() {
+        surfaceFreeRunnable = null;
+        if (rtspPlayer != null) {
+            releasingRtspPlayers++;
+            rtspPlayer.release(new Runnable() {
+                @Override
+                public void run() {
+                    releasingRtspPlayers--;
+                    if (releasingRtspPlayers == 0 && surfaceFreeRunnable != null) {
+                        Runnable runnable = surfaceFreeRunnable;
+                        surfaceFreeRunnable = null;
+                        if (!isFinishing()) {
+                            runnable.run();
+                        }
+                    }
+                }
+            });
+            rtspPlayer = null;
+        }
+    }
+
+    /**
+     * RTSP decoders are released on their worker thread, and a new decoder or ExoPlayer
+     * can't use the surface while one is still attached to it
+     *
+     * @return true if the runnable was deferred until the surface is free, false if the
+     * caller can go ahead now
+     */
+    private boolean waitForSurface(Runnable runnable) {
+        if (releasingRtspPlayers == 0) return false;
+        surfaceFreeRunnable = runnable;
+        return true;
+    }
+
     private void releasePlayer() {
+        stopPreloadingAdjacentCameras();
+        releaseRtspPlayer();
         if (player != null) {
             Log.e("EXOPlayer","EXO_PLAYER_RELEASED");
             updateResumePosition();
+            reportPlaybackSession();
+            if (liveEdgeController != null) {
+                liveEdgeController.release();
+                liveEdgeController = null;
+            }
+            if (hybridStreamSwitcher != null) {
+                hybridStreamSwitcher.release();
+                hybridStreamSwitcher = null;
+            }
             player.release();
             player = null;
             trackSelector = null;
@@ -914,6 +1158,79 @@ public class VideoActivity extends ParentAppCompatActivity
     }
 
 
+    /**
+     * Close the QoE metrics of the current HLS session and queue them to be sent
+     */
+    private void reportPlaybackSession() {
+        if (eventLogger == null || sessionCameraId == null) return;
+
+        PlaybackMetrics metrics = eventLogger.getMetrics();
+        metrics.finish(SystemClock.elapsedRealtime());
+        PrefsManager.updateBandwidthEstimate(this, sessionNetworkId, metrics.getBandwidthEstimate());
+        if (metrics.hasPlayback() && AppData.defaultUser != null) {
+            StreamFeedbackItem sessionItem = new StreamFeedbackItem(this,
+                    AppData.defaultUser.getUsername(), true);
+            sessionItem.setCameraId(sessionCameraId);
+            sessionItem.setUrl(sessionHlsUrl);
+            sessionItem.setType(StreamFeedbackItem.TYPE_HLS);
+            sessionItem.setPlaybackMetrics(metrics);
+            StreamQoeReporter.record(getMixpanel(), sessionItem);
+        }
+        sessionCameraId = null;
+    }
+
+    /**
+     * The bitrate adaptive track selection assumes until the bandwidth meter has its own
+     * estimate: the estimate stored for the current network, or the ExoPlayer default
+     */
+    private int getInitialBitrateEstimate() {
+        String networkId = new DataCollector(this).getNetworkIdentifier();
+        long storedBitrate = PrefsManager.getBandwidthEstimate(this, networkId);
+        if (storedBitrate <= 0) {
+            return AdaptiveVideoTrackSelection.DEFAULT_MAX_INITIAL_BITRATE;
+        }
+        Log.d(TAG, "Initial bitrate estimate for " + networkId + ": " + storedBitrate);
+        return (int) Math.min(Integer.MAX_VALUE,
+                storedBitrate * AdaptiveVideoTrackSelection.DEFAULT_BANDWIDTH_FRACTION);
+    }
+
+    /**
+     * Play the camera's cached live segments from the start of the cached window
+     */
+    private void startReplay() {
+        final EvercamCamera camera = evercamCamera;
+        final HlsSegmentCache segmentCache = HlsSegmentCache.getInstance(this);
+        new AsyncTask<Void, Void, File>() {
+            @Override
+            protected File doInBackground(Void... params) {
+                return segmentCache.writeReplayPlaylist(camera.getCameraId());
+            }
+
+            @Override
+            protected void onPostExecute(File playlist) {
+                //The user may have switched camera or left while the playlist was written
+                if (isFinishing() || camera != evercamCamera) return;
+
+                if (playlist == null) {
+                    CustomToast.showInCenter(VideoActivity.this, R.string.msg_replay_unavailable);
+                    return;
+                }
+
+                replayPlaylist = playlist;
+                clearResumePosition();
+                preparePlayer();
+                supportInvalidateOptionsMenu();
+            }
+        }.executeOnExecutor(AsyncTask.THREAD_POOL_EXECUTOR);
+    }
+
+    private void stopReplay() {
+        replayPlaylist = null;
+        clearResumePosition();
+        preparePlayer();
+        supportInvalidateOptionsMenu();
+    }
+
     private void updateResumePosition() {
         resumeWindow = player.getCurrentWindowIndex();
         resumePosition = player.isCurrentWindowSeekable() ? Math.max(0, player.getCurrentPosition())
@@ -926,6 +1243,8 @@ public class VideoActivity extends ParentAppCompatActivity
     }
 
     private void pausePlayer() {
+        //A live RTSP stream can't be paused, it is started again on resume
+        releaseRtspPlayer();
         if (player != null) {
             player.setPlayWhenReady(false);
         }
@@ -1049,52 +1368,16 @@ public class VideoActivity extends ParentAppCompatActivity
         });
 
         /** The click listeners for PTZ control - move, zoom and preset */
-        ptzLeftImageView.setOnClickListener(new OnClickListener() {
-            @Override
-            public void onClick(View v) {
-                PTZMoveTask.launch(new PTZRelativeBuilder(evercamCamera.getCameraId()).left(4)
-                        .build());
-            }
-        });
-        ptzRightImageView.setOnClickListener(new OnClickListener() {
-            @Override
-            public void onClick(View v) {
-                PTZMoveTask.launch(new PTZRelativeBuilder(evercamCamera.getCameraId()).right(4)
-                        .build());
-            }
-        });
-        ptzUpImageView.setOnClickListener(new OnClickListener() {
-            @Override
-            public void onClick(View v) {
-                PTZMoveTask.launch(new PTZRelativeBuilder(evercamCamera.getCameraId()).up(3)
-                        .build());
-            }
-        });
-        ptzDownImageView.setOnClickListener(new OnClickListener() {
-            @Override
-            public void onClick(View v) {
-                PTZMoveTask.launch(new PTZRelativeBuilder(evercamCamera.getCameraId()).down(3)
-                        .build());
-            }
-        });
+        setPtzMoveListeners(ptzLeftImageView, -4, 0, 0);
+        setPtzMoveListeners(ptzRightImageView, 4, 0, 0);
+        setPtzMoveListeners(ptzUpImageView, 0, 3, 0);
+        setPtzMoveListeners(ptzDownImageView, 0, -3, 0);
+        setPtzMoveListeners(ptzZoomInImageView, 0, 0, 1);
+        setPtzMoveListeners(ptzZoomOutImageView, 0, 0, -1);
         ptzHomeImageView.setOnClickListener(new OnClickListener() {
             @Override
             public void onClick(View v) {
-                PTZMoveTask.launch(new PTZHome(evercamCamera.getCameraId()));
-            }
-        });
-        ptzZoomInImageView.setOnClickListener(new OnClickListener() {
-            @Override
-            public void onClick(View v) {
-                PTZMoveTask.launch(new PTZRelativeBuilder(evercamCamera.getCameraId()).zoom(1)
-                        .build());
-            }
-        });
-        ptzZoomOutImageView.setOnClickListener(new OnClickListener() {
-            @Override
-            public void onClick(View v) {
-                PTZMoveTask.launch(new PTZRelativeBuilder(evercamCamera.getCameraId()).zoom(-1)
-                        .build());
+                getPtzQueue().moveTo(new PTZHome(evercamCamera.getCameraId()));
             }
         });
         presetsImageView.setOnClickListener(new OnClickListener() {
@@ -1120,8 +1403,8 @@ public class VideoActivity extends ParentAppCompatActivity
                                     evercamCamera.getCameraId()).show();
                         } else {
                             PTZPreset preset = presetList.get(position - 1);
-                            PTZMoveTask.launch(new PTZPresetControl(evercamCamera.getCameraId(),
-                                    preset.getToken()));
+                            getPtzQueue().moveTo(new PTZPresetControl(evercamCamera
+                                    .getCameraId(), preset.getToken()));
                         }
 
                         listDialog.cancel();
@@ -1155,8 +1438,10 @@ public class VideoActivity extends ParentAppCompatActivity
 
                     startMediaPlayerAnimation();
 
-                    //If playing url is not null, resume HLS stream
-                    if (evercamCamera != null && evercamCamera.hasHlsUrl()) {
+                    //Resume the RTSP stream on the local network, or the HLS stream
+                    if (evercamCamera != null && canPlayRtsp(evercamCamera)) {
+                        startRtspPlayer(evercamCamera);
+                    } else if (evercamCamera != null && evercamCamera.hasHlsUrl()) {
                         resumePlayer();
                     }
                     //Otherwise restart jpg view
@@ -1226,6 +1511,24 @@ public class VideoActivity extends ParentAppCompatActivity
                     }
                 }
             }
+
+            @Override
+            public void onTouchDown() {
+                //Could be the start of a swipe, make sure the neighbours are fresh
+                if (preloadRefreshRunnable != null) {
+                    refreshAdjacentCameras();
+                }
+            }
+
+            @Override
+            public void onSwipeLeft() {
+                switchToAdjacentCamera(1);
+            }
+
+            @Override
+            public void onSwipeRight() {
+                switchToAdjacentCamera(-1);
+            }
         };
         videoFrame.setOnTouchListener(swipeTouchListener);
         imageView.setOnTouchListener(swipeTouchListener);
@@ -1245,8 +1548,14 @@ public class VideoActivity extends ParentAppCompatActivity
 
                     processSnapshot(bitmap, FileType.JPG);
                 } else if (textureView.getVisibility() == View.VISIBLE) {
-                    Bitmap bitmap = textureView.getBitmap();
-                    processSnapshot(bitmap, FileType.JPG);
+                    FrameCapture.capture(textureView, surface, 0, new FrameCapture.Callback() {
+                        @Override
+                        public void onFrameCaptured(Bitmap bitmap) {
+                            if (!isFinishing()) {
+                                processSnapshot(bitmap, FileType.JPG);
+                            }
+                        }
+                    });
                 }
             }
         });
@@ -1315,6 +1624,24 @@ public class VideoActivity extends ParentAppCompatActivity
         this.mBitmap = bitmap;
     }
 
+    /**
+     * Create the home shortcut with the frame on screen as icon, the HLS frame is captured
+     * and the icon is built without blocking the UI thread
+     */
+    private void createHomeShortcut(final EvercamCamera camera) {
+        final Context appContext = getApplicationContext();
+        if (videoFrame.getVisibility() == View.VISIBLE && imageView.getVisibility() != View.VISIBLE) {
+            FrameCapture.capture(textureView, surface, HomeShortcut.ICON_SIZE, new FrameCapture.Callback() {
+                @Override
+                public void onFrameCaptured(Bitmap bitmap) {
+                    HomeShortcut.createInBackground(appContext, camera, bitmap);
+                }
+            });
+        } else {
+            HomeShortcut.createInBackground(appContext, camera, getBitmapFromImageView(imageView));
+        }
+    }
+
     private Bitmap getBitmapFromImageView(ImageView imageView) {
         Bitmap bitmap = null;
         if (imageView.getDrawable() instanceof BitmapDrawable) {
@@ -1342,22 +1669,61 @@ public class VideoActivity extends ParentAppCompatActivity
 
     private void launchJpgRunnable() {
         Log.d("CameraId",evercamCamera.getCameraId());
-        mLiveViewRunnable = new LiveViewRunnable(this, evercamCamera.getCameraId());
+        //Pull frames straight from the camera when the phone is on its network, until
+        //the route selector has measured whether that is the faster route
+        RouteTable.Route route = RouteSelector.getRoute(this, evercamCamera,
+                LanLiveViewRunnable.isAvailable(new NetInfo(this), evercamCamera)
+                        ? RouteTable.Route.INTERNAL : RouteTable.Route.CLOUD);
+        if (route == RouteTable.Route.INTERNAL
+                && !evercamCamera.getCameraId().equals(lanFailedCameraId)) {
+            mLiveViewRunnable = null;
+            mLanLiveViewRunnable = new LanLiveViewRunnable(this, evercamCamera);
+        } else {
+            mLanLiveViewRunnable = null;
+            mLiveViewRunnable = new LiveViewRunnable(this, evercamCamera.getCameraId());
+        }
         loadJpgView();
     }
 
     private void loadJpgView() {
-        if (mLiveViewRunnable != null) {
+        if (mLanLiveViewRunnable != null) {
+            //A disconnected runnable can't be restarted
+            if (mLanLiveViewRunnable.isStopped()) {
+                mLanLiveViewRunnable = new LanLiveViewRunnable(this, evercamCamera);
+            }
+            new Thread(mLanLiveViewRunnable).start();
+        } else if (mLiveViewRunnable != null) {
             new Thread(mLiveViewRunnable).start();
         }
     }
 
     private void disconnectJpgView() {
+        if (mLanLiveViewRunnable != null) {
+            mLanLiveViewRunnable.disconnect();
+        }
         if (mLiveViewRunnable != null) {
             mLiveViewRunnable.disconnect();
         }
     }
 
+    /**
+     * The camera could not be reached over the local network, switch to the cloud route
+     */
+    public void onLanLiveViewFailed(String cameraId) {
+        if (evercamCamera == null || !cameraId.equals(evercamCamera.getCameraId())) return;
+
+        Log.d(TAG, "Local network live view failed, switching to cloud: " + cameraId);
+        lanFailedCameraId = cameraId;
+        RouteSelector.reportFailure(this, evercamCamera, RouteTable.Route.INTERNAL);
+        if (mLanLiveViewRunnable == null) return;
+
+        mLanLiveViewRunnable = null;
+        mLiveViewRunnable = new LiveViewRunnable(this, cameraId);
+        if (showJpgView && !paused && !end) {
+            loadJpgView();
+        }
+    }
+
     private void startTimeCounter() {
         if (timeCounter == null) {
             String timezone = "Etc/UTC";
@@ -1394,9 +1760,9 @@ public class VideoActivity extends ParentAppCompatActivity
             public void run() {
                 //View gets played, show time count, and start buffering
                 showProgressView(false);
-                showVideoView(true);
-                showImageView(false);
+                crossFadeToVideo();
                 startTimeCounter();
+                preloadAdjacentCameras();
 
                 //Calling firebase analytics
                 mFirebaseAnalytics = FirebaseAnalytics.getInstance(VideoActivity.this);
@@ -1415,8 +1781,15 @@ public class VideoActivity extends ParentAppCompatActivity
                 StreamFeedbackItem successItem = new StreamFeedbackItem(VideoActivity
                         .this, AppData.defaultUser.getUsername(), true);
                 successItem.setCameraId(evercamCamera.getCameraId());
-                successItem.setUrl(evercamCamera.getHlsUrl());
-                successItem.setType(StreamFeedbackItem.TYPE_HLS);
+                if (rtspPlayer != null) {
+                    //The internal RTSP URL carries the camera credentials
+                    successItem.setUrl(RtspClient.stripCredentials(evercamCamera
+                            .getInternalRtspUrl()));
+                    successItem.setType(StreamFeedbackItem.TYPE_RTSP);
+                } else {
+                    successItem.setUrl(evercamCamera.getHlsUrl());
+                    successItem.setType(StreamFeedbackItem.TYPE_HLS);
+                }
                 if (startTime != null) {
                     float timeDifferenceFloat = Commons.calculateTimeDifferenceFrom
                             (startTime);
@@ -1451,17 +1824,82 @@ public class VideoActivity extends ParentAppCompatActivity
                 failedItem.setCameraId(evercamCamera.getCameraId());
                 failedItem.setUrl(evercamCamera.getHlsUrl());
                 failedItem.setType(StreamFeedbackItem.TYPE_HLS);
+                if (eventLogger != null) {
+                    PlaybackMetrics metrics = eventLogger.getMetrics();
+                    metrics.finish(SystemClock.elapsedRealtime());
+                    failedItem.setPlaybackMetrics(metrics);
+                }
+                StreamQoeReporter.record(getMixpanel(), failedItem);
+                sessionCameraId = null;
 
                 CustomSnackbar.showShort(VideoActivity.this, R.string.msg_switch_to_jpg);
                 releasePlayer();
                 showVideoView(false);
                 showImageView(true);
-                showJpgView = true;
-                launchJpgRunnable();
+                //The JPG view may be running already in hybrid mode
+                if (!showJpgView) {
+                    showJpgView = true;
+                    launchJpgRunnable();
+                }
             }
         });
     }
 
+    /**
+     * Switch to the previous or next camera in the camera list when swiping the live view
+     */
+    private void switchToAdjacentCamera(int step) {
+        int position = mCameraListSpinner.getSelectedItemPosition() + step;
+        if (position >= 0 && position < mCameraListSpinner.getCount()) {
+            mCameraListSpinner.setSelection(position);
+        }
+    }
+
+    /**
+     * Once the current stream plays, fetch the start of the previous and next cameras'
+     * streams so that swiping to them can show the first frame without waiting for the
+     * playlist and first segment requests. Live playlists go stale within seconds, so
+     * they are refreshed until the player is released or another camera is selected.
+     */
+    private void preloadAdjacentCameras() {
+        if (preloadRefreshRunnable != null || hlsPreloader == null
+                || spinnerCameraList == null) return;
+
+        preloadRefreshRunnable = new Runnable() {
+            @Override
+            public void run() {
+                if (!paused) {
+                    refreshAdjacentCameras();
+                }
+                mainHandler.postDelayed(this, HlsPreloader.REFRESH_INTERVAL_MS);
+            }
+        };
+        preloadRefreshRunnable.run();
+    }
+
+    private void stopPreloadingAdjacentCameras() {
+        if (preloadRefreshRunnable != null) {
+            mainHandler.removeCallbacks(preloadRefreshRunnable);
+            preloadRefreshRunnable = null;
+        }
+    }
+
+    private void refreshAdjacentCameras() {
+        if (hlsPreloader == null || spinnerCameraList == null) return;
+
+        long liveOffsetMs = latencyProfile != null && latencyProfile.chasesLiveEdge()
+                ? latencyProfile.targetLiveOffsetMs : C.TIME_UNSET;
+        int position = mCameraListSpinner.getSelectedItemPosition();
+        for (int index : new int[]{position - 1, position + 1}) {
+            if (index < 0 || index >= spinnerCameraList.size()) continue;
+
+            EvercamCamera camera = spinnerCameraList.get(index);
+            if (camera.isOnline() && camera.hasHlsUrl()) {
+                hlsPreloader.preload(camera.getHlsUrl(), liveOffsetMs);
+            }
+        }
+    }
+
     private String[] getCameraNameArray(ArrayList<EvercamCamera> cameraList) {
         ArrayList<String> cameraNames = new ArrayList<>();
 
@@ -1518,6 +1956,7 @@ public class VideoActivity extends ParentAppCompatActivity
         CameraListAdapter adapter = new CameraListAdapter(VideoActivity.this,
                 R.layout.item_spinner_live_view, R.id.spinner_camera_name_text, cameraNames, cameraList);
         mCameraListSpinner.setAdapter(adapter);
+        spinnerCameraList = cameraList;
         mCameraListSpinner.setOnItemSelectedListener(new AdapterView.OnItemSelectedListener() {
             @Override
             public void onItemSelected(AdapterView<?> parent, View view, int position, long id) {
@@ -1538,6 +1977,8 @@ public class VideoActivity extends ParentAppCompatActivity
                 startingCameraID = evercamCamera.getCameraId();
 
                 //Hide the PTZ control panel when switch to another camera
+                isPtz = false;
+                presetList = new ArrayList<>();
                 showPtzControl(false);
 
                 if (!evercamCamera.isOnline()) {
@@ -1553,10 +1994,12 @@ public class VideoActivity extends ParentAppCompatActivity
                     offlineTextLayout.hide();
 
                     setCameraForPlaying(cameraList.get(position));
+                    //The player is reused across cameras, the last camera's position doesn't apply
+                    clearResumePosition();
                     createPlayer(evercamCamera);
 
                     if (evercamCamera.hasModel()) {
-                        new CheckOnvifTask(VideoActivity.this, evercamCamera)
+                        new LoadCapabilityTask(VideoActivity.this, evercamCamera)
                                 .executeOnExecutor(AsyncTask.THREAD_POOL_EXECUTOR);
                     }
                 }
@@ -1576,9 +2019,70 @@ public class VideoActivity extends ParentAppCompatActivity
     }
 
     private void showVideoView(boolean show) {
+        if (!show) {
+            videoFrame.animate().cancel();
+            videoFrame.setAlpha(1f);
+        }
         videoFrame.setVisibility(show ? View.VISIBLE : View.GONE);
     }
 
+    /**
+     * Fade the video view in over the JPG image or thumbnail, then hide the image
+     */
+    private void crossFadeToVideo() {
+        videoFrame.animate().cancel();
+        if (imageView.getVisibility() != View.VISIBLE) {
+            videoFrame.setAlpha(1f);
+            showVideoView(true);
+            return;
+        }
+
+        if (videoFrame.getVisibility() != View.VISIBLE) {
+            videoFrame.setAlpha(0f);
+            showVideoView(true);
+        }
+        videoFrame.animate().alpha(1f).setDuration(CROSS_FADE_MS).withEndAction(new Runnable() {
+            @Override
+            public void run() {
+                if (!showJpgView) {
+                    showImageView(false);
+                }
+            }
+        });
+    }
+
+    private final HybridStreamSwitcher.Listener hybridStreamListener = new HybridStreamSwitcher.Listener() {
+        @Override
+        public void onSwitchToHls() {
+            if (showJpgView) {
+                disconnectJpgView();
+                showJpgView = false;
+            }
+            onVideoLoaded();
+        }
+
+        @Override
+        public void onSwitchToJpg() {
+            showJpgView = true;
+            launchJpgRunnable();
+
+            //Keep the last video frame on screen until the first JPG arrives
+            FrameCapture.capture(textureView, surface, imageView.getWidth(), new FrameCapture.Callback() {
+                @Override
+                public void onFrameCaptured(Bitmap lastFrame) {
+                    if (!showJpgView) return;
+
+                    if (lastFrame != null) {
+                        imageView.setImageBitmap(lastFrame);
+                    }
+                    showImageView(true);
+                    videoFrame.animate().cancel();
+                    videoFrame.animate().alpha(0f).setDuration(CROSS_FADE_MS);
+                }
+            });
+        }
+    };
+
     public void showAllControlMenus(boolean show) {
         playPauseImageView.setVisibility(show ? View.VISIBLE : View.GONE);
         snapshotMenuView.setVisibility(show ? View.VISIBLE : View.GONE);
@@ -1594,6 +2098,41 @@ public class VideoActivity extends ParentAppCompatActivity
         ptzZoomLayout.setVisibility(show ? View.VISIBLE : View.GONE);
     }
 
+    /**
+     * Render the PTZ controls for a cached or revalidated capability of the current camera
+     */
+    public void applyCapability(CameraCapability capability) {
+        if (evercamCamera == null || !capability.getCameraId().equals(evercamCamera
+                .getCameraId())) {
+            return;
+        }
+        isPtz = capability.hasPtzControl();
+        presetList = capability.getPresetList();
+        showPtzControl(isPtz);
+    }
+
+    private PTZCommandQueue getPtzQueue() {
+        return PTZCommandQueue.forCamera(evercamCamera.getCameraId());
+    }
+
+    /**
+     * A tap moves the camera by one step, holding the button keeps moving until released
+     */
+    private void setPtzMoveListeners(View button, final int pan, final int tilt, final int zoom) {
+        button.setOnClickListener(new OnClickListener() {
+            @Override
+            public void onClick(View v) {
+                getPtzQueue().move(pan, tilt, zoom);
+            }
+        });
+        button.setOnTouchListener(new ContinuousMoveTouchListener(pan, tilt, zoom) {
+            @Override
+            protected PTZCommandQueue getQueue() {
+                return getPtzQueue();
+            }
+        });
+    }
+
     public void updateImage(Bitmap bitmap, String cameraId) {
         if (cameraId.equals(evercamCamera.getCameraId())) {
             if (!paused && !end && showJpgView) {
@@ -0,0 +1,77 @@
+package io.evercam.androidapp.addeditcamera;
+
+import org.json.JSONException;
+import org.junit.Test;
+
+import java.io.File;
+import java.io.IOException;
+import java.nio.charset.Charset;
+import java.nio.file.Files;
+import java.util.ArrayList;
+import java.util.HashSet;
+import java.util.Locale;
+
+import io.evercam.androidapp.dto.CatalogueModel;
+import io.evercam.androidapp.dto.CatalogueVendor;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertFalse;
+import static org.junit.Assert.assertTrue;
+import static org.junit.Assume.assumeTrue;
+
+public class CatalogueBaselineTest {
+    //Unit tests run from the module directory
+    private final static File BASELINE_ASSET = new File("src/main/assets/"
+            + CatalogueBaseline.ASSET_NAME);
+
+    @Test
+    public void testParsesShippedBaseline() throws IOException, JSONException {
+        //Written by the exportCatalogueBaseline task, which release builds run
+        assumeTrue(BASELINE_ASSET.exists());
+
+        CatalogueBaseline baseline = CatalogueBaseline.parse(new String(
+                Files.readAllBytes(BASELINE_ASSET.toPath()), Charset.forName("UTF-8")));
+        assertTrue(baseline.getGeneratedAt() > 0);
+        assertFalse(baseline.getVendorList().isEmpty());
+        assertTrue(baseline.getModelCount() > 0);
+
+        HashSet<String> vendorIds = new HashSet<>();
+        for (CatalogueVendor vendor : baseline.getVendorList()) {
+            assertEquals(vendor.getId().toLowerCase(Locale.UK), vendor.getId());
+            assertTrue("Duplicate vendor " + vendor.getId(), vendorIds.add(vendor.getId()));
+        }
+        for (String vendorId : baseline.getModelsByVendor().keySet()) {
+            assertTrue("Models of unknown vendor " + vendorId, vendorIds.contains(vendorId));
+        }
+    }
+
+    @Test
+    public void testParsesExportFormat() throws JSONException {
+        String json = "{\"generated_at\":1500000000000," +
+                "\"models\":[" +
+                "{\"h264_url\":\"/Streaming/Channels/1\",\"id\":\"hikvision_default\"," +
+                "\"jpg_url\":\"/Streaming/channels/1/picture\",\"name\":\"Default\"," +
+                "\"onvif\":true,\"password\":\"12345\",\"ptz\":false," +
+                "\"username\":\"admin\",\"vendor_id\":\"hikvision\"}," +
+                "{\"h264_url\":\"\",\"id\":\"hikvision_ds_2df7286\",\"jpg_url\":\"\"," +
+                "\"name\":\"DS-2DF7286\",\"onvif\":true,\"password\":\"\",\"ptz\":true," +
+                "\"username\":\"\",\"vendor_id\":\"hikvision\"}]," +
+                "\"vendors\":[{\"id\":\"hikvision\",\"name\":\"Hikvision\"}]}";
+
+        CatalogueBaseline baseline = CatalogueBaseline.parse(json);
+        assertEquals(1500000000000L, baseline.getGeneratedAt());
+        assertEquals(1, baseline.getVendorList().size());
+        assertEquals("Hikvision", baseline.getVendorList().get(0).getName());
+        assertEquals(2, baseline.getModelCount());
+
+        ArrayList<CatalogueModel> models = baseline.getModelsByVendor().get("hikvision");
+        assertEquals(2, models.size());
+        CatalogueModel defaultModel = models.get(0);
+        assertTrue(defaultModel.isDefaultModel());
+        assertEquals("/Streaming/channels/1/picture", defaultModel.getJpgUrl());
+        assertEquals("admin", defaultModel.getUsername());
+        assertTrue(defaultModel.isOnvif());
+        assertFalse(defaultModel.isPtz());
+        assertTrue(models.get(1).isPtz());
+    }
+}
@@ -0,0 +1,84 @@
+package io.evercam.androidapp.addeditcamera;
+
+import org.junit.Before;
+import org.junit.Test;
+
+import java.util.ArrayList;
+import java.util.List;
+
+import io.evercam.androidapp.dto.CatalogueModel;
+import io.evercam.androidapp.dto.CatalogueVendor;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertNull;
+import static org.junit.Assert.assertTrue;
+
+public class CatalogueSearchIndexTest {
+    private CatalogueSearchIndex index;
+
+    @Before
+    public void setUp() {
+        ArrayList<CatalogueVendor> vendorList = new ArrayList<>();
+        vendorList.add(new CatalogueVendor("hikvision", "Hikvision"));
+        vendorList.add(new CatalogueVendor("axis", "Axis"));
+        vendorList.add(new CatalogueVendor("dahua", "Dahua"));
+
+        ArrayList<CatalogueModel> modelList = new ArrayList<>();
+        modelList.add(new CatalogueModel("hikvision_ds_2cd2032_i", "hikvision", "DS-2CD2032-I"));
+        modelList.add(new CatalogueModel("hikvision_ds_2cd2142fwd_i", "hikvision",
+                "DS-2CD2142FWD-I"));
+        modelList.add(new CatalogueModel("axis_m1034_w", "axis", "M1034-W"));
+        modelList.add(new CatalogueModel("axis_p1435_le", "axis", "P1435-LE"));
+        index = new CatalogueSearchIndex(vendorList, modelList);
+    }
+
+    @Test
+    public void testVendorPrefixFindsVendorFirst() {
+        List<CatalogueSearchIndex.Result> results = index.search("hik", 10);
+
+        assertEquals(3, results.size());
+        assertTrue(results.get(0).isVendor());
+        assertEquals("hikvision", results.get(0).getVendorId());
+    }
+
+    @Test
+    public void testAllTokensMustMatch() {
+        List<CatalogueSearchIndex.Result> results = index.search("axis p14", 10);
+
+        assertEquals("axis_p1435_le", results.get(0).getModel().getId());
+        for (CatalogueSearchIndex.Result result : results) {
+            assertEquals("axis", result.getVendorId());
+        }
+    }
+
+    @Test
+    public void testSeparatorsAreOptional() {
+        List<CatalogueSearchIndex.Result> results = index.search("ds2cd2032", 10);
+
+        assertEquals("hikvision_ds_2cd2032_i", results.get(0).getModel().getId());
+    }
+
+    @Test
+    public void testTypoFallsBackToTrigrams() {
+        List<CatalogueSearchIndex.Result> results = index.search("hikvison", 10);
+
+        assertTrue(results.size() > 0);
+        assertEquals("hikvision", results.get(0).getVendorId());
+    }
+
+    @Test
+    public void testLimit() {
+        assertEquals(1, index.search("hikvision", 1).size());
+        assertEquals(0, index.search("  ", 10).size());
+    }
+
+    @Test
+    public void testMatchDiscoveredModel() {
+        assertEquals("hikvision_ds_2cd2032_i", index.matchModelId("hikvision", "DS-2CD2032-I"));
+        assertEquals("hikvision_ds_2cd2142fwd_i", index.matchModelId("hikvision",
+                "DS-2CD2142FWD-IS"));
+        assertEquals("axis_m1034_w", index.matchModelId("axis", "m1034w"));
+        assertNull(index.matchModelId("axis", "DS-2CD2032-I"));
+        assertNull(index.matchModelId("hikvision", "XYZ"));
+    }
+}
@@ -0,0 +1,48 @@
+package io.evercam.androidapp.dto;
+
+import org.junit.Test;
+
+import java.util.ArrayList;
+
+import io.evercam.PTZPreset;
+
+import static org.junit.Assert.assertFalse;
+import static org.junit.Assert.assertTrue;
+
+public class CameraCapabilityTest {
+    private static final long NOW = 1000000000000L;
+
+    @Test
+    public void testUnknownCapabilityIsStale() {
+        CameraCapability capability = new CameraCapability("camera", "model");
+
+        assertFalse(capability.isKnown());
+        assertTrue(capability.isStale(NOW));
+        assertFalse(capability.hasPtzControl());
+    }
+
+    @Test
+    public void testCameraTtlOnlyAppliesToPtzModels() {
+        CameraCapability capability = new CameraCapability("camera", "model");
+        capability.setModelCapability(false, false, NOW);
+
+        assertTrue(capability.isKnown());
+        assertFalse(capability.isStale(NOW + CameraCapability.CAMERA_TTL_MS + 1));
+        assertTrue(capability.isStale(NOW + CameraCapability.MODEL_TTL_MS + 1));
+    }
+
+    @Test
+    public void testPtzControlNeedsFullRights() {
+        CameraCapability capability = new CameraCapability("camera", "model");
+        capability.setModelCapability(true, true, NOW);
+        assertTrue(capability.isStale(NOW));
+
+        capability.setCameraCapability(false, new ArrayList<PTZPreset>(), NOW);
+        assertFalse(capability.isStale(NOW));
+        assertFalse(capability.hasPtzControl());
+
+        capability.setCameraCapability(true, new ArrayList<PTZPreset>(), NOW);
+        assertTrue(capability.hasPtzControl());
+        assertTrue(capability.isStale(NOW + CameraCapability.CAMERA_TTL_MS + 1));
+    }
+}
@@ -0,0 +1,72 @@
+package io.evercam.androidapp.http;
+
+import org.junit.Test;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertTrue;
+
+public class LatencyHistogramTest {
+    @Test
+    public void testBucketsCoverEveryValue() {
+        for (long value = 0; value < 100000; value++) {
+            int index = LatencyHistogram.indexOf(value);
+            assertTrue(value + " below its bucket", LatencyHistogram.lowestValueAt(index) <= value);
+            assertTrue(value + " above its bucket", LatencyHistogram.highestValueAt(index) >=
+                    value);
+        }
+        assertEquals(LatencyHistogram.BUCKET_COUNT - 1, LatencyHistogram.indexOf
+                (LatencyHistogram.MAX_VALUE));
+    }
+
+    @Test
+    public void testPercentilesWithinBucketPrecision() {
+        LatencyHistogram histogram = new LatencyHistogram();
+        for (long value = 1; value <= 1000; value++) {
+            histogram.record(value * 1000);
+        }
+        LatencyHistogram.Snapshot snapshot = histogram.snapshot();
+        assertEquals(1000, snapshot.getCount());
+        assertEquals(500500, snapshot.getMeanUs());
+        assertEquals(1000000, snapshot.getMaxUs());
+        assertEquals(500000, snapshot.getPercentileUs(50), 500000 * 0.07);
+        assertEquals(990000, snapshot.getPercentileUs(99), 990000 * 0.07);
+        assertEquals(1000000, snapshot.getPercentileUs(100));
+    }
+
+    @Test
+    public void testClampsOutOfRangeValues() {
+        LatencyHistogram histogram = new LatencyHistogram();
+        histogram.record(-5);
+        histogram.record(Long.MAX_VALUE);
+        LatencyHistogram.Snapshot snapshot = histogram.snapshot();
+        assertEquals(2, snapshot.getCount());
+        assertEquals(0, snapshot.getPercentileUs(50));
+        assertEquals(LatencyHistogram.MAX_VALUE, snapshot.getMaxUs());
+    }
+
+    @Test
+    public void testDrainStartsOver() throws InterruptedException {
+        final LatencyHistogram histogram = new LatencyHistogram();
+        Thread[] threads = new Thread[4];
+        for (int index = 0; index < threads.length; index++) {
+            threads[index] = new Thread(new Runnable() {
+                @Override
+                public void run() {
+                    for (int count = 0; count < 10000; count++) {
+                        histogram.record(count);
+                    }
+                }
+            });
+            threads[index].start();
+        }
+        for (Thread thread : threads) {
+            thread.join();
+        }
+
+        assertEquals(40000, histogram.drain().getCount());
+        LatencyHistogram.Snapshot empty = histogram.snapshot();
+        assertEquals(0, empty.getCount());
+        assertEquals(0, empty.getMaxUs());
+        assertEquals(0, empty.getPercentileUs(99));
+    }
+}
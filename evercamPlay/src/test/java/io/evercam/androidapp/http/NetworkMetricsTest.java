@@ -0,0 +1,94 @@
+package io.evercam.androidapp.http;
+
+import org.junit.Test;
+
+import java.io.BufferedReader;
+import java.io.InputStreamReader;
+import java.io.OutputStream;
+import java.net.InetAddress;
+import java.net.ServerSocket;
+import java.net.Socket;
+
+import okhttp3.HttpUrl;
+import okhttp3.OkHttpClient;
+import okhttp3.Request;
+import okhttp3.Response;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertTrue;
+
+public class NetworkMetricsTest {
+    private static String normalize(String url) {
+        return NetworkMetrics.normalize(HttpUrl.parse(url));
+    }
+
+    @Test
+    public void testNormalizesEndpoints() {
+        assertEquals("/cameras", normalize("https://api.evercam.io/v1/cameras?include_shared=true"
+                + "&api_key=key"));
+        assertEquals("/cameras/{id}/thumbnail", normalize("https://media.evercam.io/v1/cameras/"
+                + "gpocam/thumbnail?api_id=id"));
+        assertEquals("/cameras/{id}/recordings/snapshots/{id}", normalize("https://media"
+                + ".evercam.io/v1/cameras/gpocam/recordings/snapshots/1500000000"));
+        assertEquals("/cameras/port-check", normalize("https://media.evercam.io/v1/cameras/"
+                + "port-check?address=1.2.3.4&port=80"));
+        assertEquals("/cameras/{id}/ptz/relative", normalize("https://media.evercam.io/v1/"
+                + "cameras/Gpo-Cam/ptz/relative?left=4"));
+        assertEquals("camera", normalize("http://192.168.1.64:8080/Streaming/channels/1/picture"));
+        assertEquals("camera", normalize("http://mycamera.dyndns.org/snapshot.jpg"));
+        assertEquals("gravatar", normalize("https://www.gravatar.com/avatar/abc"));
+    }
+
+    @Test
+    public void testRecordsCallTimingsAndBytes() throws Exception {
+        final ServerSocket serverSocket = new ServerSocket(0, 1, InetAddress.getByName
+                ("127.0.0.1"));
+        Thread server = new Thread(new Runnable() {
+            @Override
+            public void run() {
+                try {
+                    Socket socket = serverSocket.accept();
+                    BufferedReader reader = new BufferedReader(new InputStreamReader(socket
+                            .getInputStream(), "ISO-8859-1"));
+                    String line;
+                    while ((line = reader.readLine()) != null && !line.isEmpty()) {
+                        //Skip the request headers
+                    }
+                    OutputStream output = socket.getOutputStream();
+                    output.write(("HTTP/1.1 200 OK\r\nContent-Type: image/jpeg\r\n"
+                            + "Content-Length: 5\r\nConnection: close\r\n\r\nhello").getBytes
+                            ("ISO-8859-1"));
+                    output.flush();
+                    socket.close();
+                } catch (Exception e) {
+                    //The call fails and the test with it
+                }
+            }
+        });
+        server.start();
+
+        NetworkMetrics.clear();
+        OkHttpClient client = NetworkMetricsInterceptor.install(new OkHttpClient.Builder())
+                .build();
+        Response response = client.newCall(new Request.Builder().url("http://127.0.0.1:" +
+                serverSocket.getLocalPort() + "/snapshot.jpg").build()).execute();
+        assertEquals("hello", response.body().string());
+        server.join(2000);
+        serverSocket.close();
+
+        EndpointMetrics.Snapshot snapshot = null;
+        for (EndpointMetrics.Snapshot endpoint : NetworkMetrics.snapshot(false)) {
+            if (endpoint.getEndpoint().equals(NetworkMetrics.ENDPOINT_CAMERA)) {
+                snapshot = endpoint;
+            }
+        }
+        assertEquals(1, snapshot.getRequests());
+        assertEquals(0, snapshot.getFailures());
+        assertEquals(5, snapshot.getBytesReceived());
+        assertEquals(1, snapshot.getConnect().getCount());
+        assertEquals(0, snapshot.getTls().getCount());
+        assertEquals(1, snapshot.getTtfb().getCount());
+        assertEquals(1, snapshot.getTotal().getCount());
+        assertTrue(snapshot.getTotal().getMaxUs() >= snapshot.getTtfb().getMaxUs());
+    }
+}
@@ -0,0 +1,96 @@
+package io.evercam.androidapp.map;
+
+import org.junit.Test;
+
+import java.util.ArrayList;
+import java.util.List;
+import java.util.Random;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertTrue;
+
+public class GeoQuadTreeTest {
+
+    private static class Point implements GeoQuadTree.Item {
+        final double latitude;
+        final double longitude;
+
+        Point(double latitude, double longitude) {
+            this.latitude = latitude;
+            this.longitude = longitude;
+        }
+
+        @Override
+        public double getLatitude() {
+            return latitude;
+        }
+
+        @Override
+        public double getLongitude() {
+            return longitude;
+        }
+    }
+
+    @Test
+    public void testQueryMatchesLinearScan() {
+        GeoQuadTree<Point> tree = new GeoQuadTree<>();
+        ArrayList<Point> points = new ArrayList<>();
+        Random random = new Random(42);
+        for (int index = 0; index < 2000; index++) {
+            Point point = new Point(random.nextDouble() * 180 - 90, random.nextDouble() * 360 - 180);
+            points.add(point);
+            tree.add(point);
+        }
+        //Many cameras at one spot must not split forever
+        for (int index = 0; index < 100; index++) {
+            tree.add(new Point(53.35, -6.26));
+        }
+        assertEquals(2100, tree.size());
+
+        assertEquals(countIn(points, 10, -20, 40, 60), tree.query(10, -20, 40, 60).size());
+        assertEquals(countIn(points, 53, -7, 54, -6) + 100, tree.query(53, -7, 54, -6).size());
+    }
+
+    @Test
+    public void testAntimeridianAndInvalidItems() {
+        GeoQuadTree<Point> tree = new GeoQuadTree<>();
+        tree.add(new Point(-36.85, 174.76));
+        tree.add(new Point(21.31, -157.86));
+        tree.add(new Point(51.51, -0.13));
+        tree.add(new Point(100, 0));
+        tree.add(new Point(0, 200));
+
+        assertEquals(3, tree.size());
+        assertEquals(2, tree.query(-60, 170, 60, -150).size());
+        assertEquals(1, tree.query(-60, -150, 60, 170).size());
+    }
+
+    @Test
+    public void testClustering() {
+        List<Point> points = new ArrayList<>();
+        points.add(new Point(53.3498, -6.2603));
+        points.add(new Point(53.3440, -6.2672));
+        points.add(new Point(51.5074, -0.1278));
+
+        List<MarkerClusterer.Cluster<Point>> clusters = MarkerClusterer.cluster(points, 4, 64);
+        assertEquals(2, clusters.size());
+        assertEquals(2, clusters.get(0).size());
+        assertTrue(clusters.get(1).isSingle());
+        assertEquals(53.3469, clusters.get(0).getLatitude(), 0.0001);
+
+        //Street level keeps them apart
+        assertEquals(3, MarkerClusterer.cluster(points, 16, 64).size());
+    }
+
+    private static int countIn(List<Point> points, double south, double west, double north,
+                               double east) {
+        int count = 0;
+        for (Point point : points) {
+            if (point.latitude >= south && point.latitude <= north && point.longitude >= west
+                    && point.longitude <= east) {
+                count++;
+            }
+        }
+        return count;
+    }
+}
@@ -0,0 +1,125 @@
+package io.evercam.androidapp.player;
+
+import com.google.android.exoplayer2.C;
+
+import org.junit.After;
+import org.junit.Before;
+import org.junit.Test;
+
+import java.io.IOException;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertNotNull;
+import static org.junit.Assert.assertNull;
+
+public class HlsPreloaderTest {
+    private final static String MASTER_URL = "http://example.com/live/index.m3u8";
+    private final static String MEDIA_URL = "http://example.com/live/stream.m3u8";
+    private final static String MASTER_PLAYLIST = "#EXTM3U\n" +
+            "#EXT-X-STREAM-INF:BANDWIDTH=500000\n" +
+            "stream.m3u8\n";
+    //Round trip of each simulated request
+    private final static long LOAD_TIME_MS = 300;
+    private final static long SEGMENT_DURATION_MS = 2000;
+
+    private long nowMs;
+    private int loadCount;
+    private int servedSequence;
+    private HlsPreloader preloader;
+
+    @Before
+    public void setUp() {
+        nowMs = 0;
+        loadCount = 0;
+        preloader = new HlsPreloader(null, new HlsPreloader.Clock() {
+            @Override
+            public long elapsedRealtime() {
+                return nowMs;
+            }
+        }) {
+            @Override
+            byte[] load(String url) throws IOException {
+                nowMs += LOAD_TIME_MS;
+                loadCount++;
+                if (url.equals(MASTER_URL)) return MASTER_PLAYLIST.getBytes();
+                if (url.equals(MEDIA_URL)) {
+                    servedSequence = getMediaSequence(nowMs);
+                    return getMediaPlaylist().getBytes();
+                }
+                return new byte[1024];
+            }
+        };
+    }
+
+    @After
+    public void tearDown() {
+        preloader.release();
+    }
+
+    @Test
+    public void testSinglePreloadGoesStale() throws IOException {
+        preloader.preloadBlocking(MASTER_URL, C.TIME_UNSET);
+        nowMs += 7500;
+
+        assertNull(preloader.take(MASTER_URL));
+        assertNull(preloader.take(MEDIA_URL));
+    }
+
+    @Test
+    public void testRefreshedPreloadHitsAfterDelays() throws IOException {
+        //Time spent watching the current camera before swiping
+        long[] swipeDelaysMs = {800, 7500, 16300, 45000, 120000};
+        for (long swipeDelayMs : swipeDelaysMs) {
+            setUp();
+            long swipeAtMs = nowMs + swipeDelayMs;
+            long nextRefreshMs = nowMs;
+            while (nextRefreshMs <= swipeAtMs) {
+                nowMs = nextRefreshMs;
+                preloader.preloadBlocking(MASTER_URL, C.TIME_UNSET);
+                nextRefreshMs += HlsPreloader.REFRESH_INTERVAL_MS;
+            }
+            nowMs = swipeAtMs;
+
+            assertNotNull("Playlist stale after " + swipeDelayMs + "ms",
+                    preloader.take(MASTER_URL));
+            assertNotNull("Playlist stale after " + swipeDelayMs + "ms",
+                    preloader.take(MEDIA_URL));
+            //The player starts from the third last segment of the playlist it was given
+            assertNotNull("Segment missing after " + swipeDelayMs + "ms",
+                    preloader.take(getSegmentUrl(servedSequence - 2)));
+            preloader.release();
+        }
+    }
+
+    @Test
+    public void testRefreshKeepsFreshSegment() throws IOException {
+        preloader.preloadBlocking(MASTER_URL, C.TIME_UNSET);
+        assertEquals(3, loadCount);
+
+        //Same live window, only the playlists need fetching again
+        nowMs = 1000;
+        preloader.preloadBlocking(MASTER_URL, C.TIME_UNSET);
+        assertEquals(5, loadCount);
+    }
+
+    /**
+     * A live window of five segments, moving forward one segment every SEGMENT_DURATION_MS
+     */
+    private String getMediaPlaylist() {
+        int sequence = getMediaSequence(nowMs);
+        StringBuilder playlist = new StringBuilder("#EXTM3U\n#EXT-X-TARGETDURATION:2\n");
+        playlist.append("#EXT-X-MEDIA-SEQUENCE:").append(sequence - 4).append("\n");
+        for (int index = sequence - 4; index <= sequence; index++) {
+            playlist.append("#EXTINF:2.0,\n").append("segment").append(index).append(".ts\n");
+        }
+        return playlist.toString();
+    }
+
+    private static int getMediaSequence(long timeMs) {
+        return 10 + (int) (timeMs / SEGMENT_DURATION_MS);
+    }
+
+    private static String getSegmentUrl(int sequence) {
+        return "http://example.com/live/segment" + sequence + ".ts";
+    }
+}
@@ -0,0 +1,130 @@
+package io.evercam.androidapp.player;
+
+import org.junit.Test;
+
+import java.io.ByteArrayInputStream;
+import java.io.ByteArrayOutputStream;
+import java.io.IOException;
+
+import static org.junit.Assert.assertArrayEquals;
+import static org.junit.Assert.assertNull;
+
+public class MjpegFrameReaderTest {
+
+    private static byte[] bytes(int... values) {
+        byte[] bytes = new byte[values.length];
+        for (int i = 0; i < values.length; i++) {
+            bytes[i] = (byte) values[i];
+        }
+        return bytes;
+    }
+
+    /**
+     * A marker segment, the length covers the two length bytes and the data
+     */
+    private static byte[] segment(int marker, int... data) {
+        int length = data.length + 2;
+        ByteArrayOutputStream segment = new ByteArrayOutputStream();
+        segment.write(0xFF);
+        segment.write(marker);
+        segment.write(length >> 8);
+        segment.write(length & 0xFF);
+        for (int value : data) {
+            segment.write(value);
+        }
+        return segment.toByteArray();
+    }
+
+    /**
+     * A frame with the given segments followed by a single scan of entropy coded data
+     */
+    private static byte[] jpeg(byte[][] segments, int... scan) throws IOException {
+        ByteArrayOutputStream frame = new ByteArrayOutputStream();
+        frame.write(bytes(0xFF, 0xD8));
+        for (byte[] segment : segments) {
+            frame.write(segment);
+        }
+        frame.write(segment(0xDA, 0x01, 0x01, 0x00, 0x00, 0x3F, 0x00));
+        frame.write(bytes(scan));
+        frame.write(bytes(0xFF, 0xD9));
+        return frame.toByteArray();
+    }
+
+    private static byte[] jpeg(int... scan) throws IOException {
+        return jpeg(new byte[0][], scan);
+    }
+
+    @Test
+    public void testReadsMultipartFrames() throws IOException {
+        byte[] first = jpeg(0x01, 0xFF, 0x00, 0x02);
+        byte[] second = jpeg(0x03, 0x04);
+        ByteArrayOutputStream stream = new ByteArrayOutputStream();
+        stream.write("--myboundary\r\nContent-Type: image/jpeg\r\nContent-Length: 16\r\n\r\n"
+                .getBytes("US-ASCII"));
+        stream.write(first);
+        stream.write("\r\n--myboundary\r\nContent-Type: image/jpeg\r\n\r\n".getBytes("US-ASCII"));
+        stream.write(second);
+        stream.write("\r\n--myboundary--\r\n".getBytes("US-ASCII"));
+
+        MjpegFrameReader reader = new MjpegFrameReader(new ByteArrayInputStream(stream
+                .toByteArray()));
+        assertArrayEquals(first, reader.readFrame());
+        assertArrayEquals(second, reader.readFrame());
+        assertNull(reader.readFrame());
+    }
+
+    @Test
+    public void testSkipsMarkersInsideSegments() throws IOException {
+        //An EXIF thumbnail has its own start and end markers, and APPn data can hold
+        //a start marker with no end marker at all
+        byte[] frame = jpeg(new byte[][]{
+                segment(0xE1, 0xFF, 0xD8, 0x05, 0xFF, 0xD9, 0x06),
+                segment(0xE2, 0x07, 0xFF, 0xD8, 0x08)}, 0x09);
+        MjpegFrameReader reader = new MjpegFrameReader(new ByteArrayInputStream(frame));
+        assertArrayEquals(frame, reader.readFrame());
+        assertNull(reader.readFrame());
+    }
+
+    @Test
+    public void testReadsRestartMarkersAndProgressiveScans() throws IOException {
+        //Restart markers inside the scan, then a second table and scan before the end
+        ByteArrayOutputStream stream = new ByteArrayOutputStream();
+        stream.write(bytes(0xFF, 0xD8));
+        stream.write(segment(0xDA, 0x01));
+        stream.write(bytes(0x01, 0xFF, 0xD0, 0x02, 0xFF, 0xFF, 0xD1, 0x03));
+        stream.write(segment(0xC4, 0xFF, 0xD9));
+        stream.write(segment(0xDA, 0x01));
+        stream.write(bytes(0x04, 0xFF, 0xD9));
+        byte[] frame = stream.toByteArray();
+
+        MjpegFrameReader reader = new MjpegFrameReader(new ByteArrayInputStream(frame));
+        assertArrayEquals(frame, reader.readFrame());
+        assertNull(reader.readFrame());
+    }
+
+    @Test
+    public void testDropsMalformedFrame() throws IOException {
+        byte[] frame = jpeg(0x01, 0x02);
+        ByteArrayOutputStream stream = new ByteArrayOutputStream();
+        //Not a marker where a segment should start
+        stream.write(bytes(0xFF, 0xD8, 0x12, 0x34));
+        //Cut off by the next frame
+        stream.write(bytes(0xFF, 0xD8));
+        stream.write(segment(0xDA, 0x01));
+        stream.write(bytes(0x05, 0x06));
+        stream.write(frame);
+
+        MjpegFrameReader reader = new MjpegFrameReader(new ByteArrayInputStream(stream
+                .toByteArray()));
+        assertArrayEquals(frame, reader.readFrame());
+        assertNull(reader.readFrame());
+    }
+
+    @Test
+    public void testIgnoresTruncatedFrame() throws IOException {
+        byte[] frame = jpeg(0x01, 0x02);
+        byte[] truncated = new byte[frame.length - 1];
+        System.arraycopy(frame, 0, truncated, 0, truncated.length);
+        assertNull(new MjpegFrameReader(new ByteArrayInputStream(truncated)).readFrame());
+    }
+}
@@ -0,0 +1,76 @@
+package io.evercam.androidapp.player;
+
+import com.google.android.exoplayer2.C;
+import com.google.android.exoplayer2.ExoPlayer;
+import com.google.android.exoplayer2.Format;
+
+import org.junit.Test;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertFalse;
+import static org.junit.Assert.assertTrue;
+
+public class PlaybackMetricsTest {
+
+    @Test
+    public void testAggregatesSession() {
+        PlaybackMetrics metrics = new PlaybackMetrics(1000);
+        assertFalse(metrics.hasPlayback());
+        assertEquals(C.TIME_UNSET, metrics.getStartupTimeMs());
+
+        metrics.onStateChanged(true, ExoPlayer.STATE_BUFFERING, 1000);
+        metrics.onFirstFrameRendered(1800);
+        metrics.onStateChanged(true, ExoPlayer.STATE_READY, 1800);
+        metrics.onVideoFormatChanged(videoFormat(500000));
+        metrics.onDroppedFrames(3);
+        metrics.onStateChanged(true, ExoPlayer.STATE_BUFFERING, 31800);
+        metrics.onStateChanged(true, ExoPlayer.STATE_READY, 41800);
+        metrics.onVideoFormatChanged(videoFormat(250000));
+        metrics.onVideoFormatChanged(videoFormat(250000));
+        metrics.onLoadCompleted(250000, 1000);
+        metrics.onLoadCompleted(250000, 1000);
+        metrics.finish(71800);
+
+        assertTrue(metrics.hasPlayback());
+        assertEquals(800, metrics.getStartupTimeMs());
+        assertEquals(1, metrics.getRebufferCount());
+        assertEquals(10000, metrics.getRebufferTimeMs());
+        assertEquals(60000, metrics.getPlayingTimeMs());
+        assertEquals(1f / 7, metrics.getRebufferRatio(), 0.0001);
+        assertEquals(3f, metrics.getDroppedFramesPerMinute(), 0.0001);
+        assertEquals(1, metrics.getBitrateSwitches());
+        assertEquals(2000000, metrics.getBandwidthEstimate());
+    }
+
+    @Test
+    public void testInitialBufferingIsNotRebuffering() {
+        PlaybackMetrics metrics = new PlaybackMetrics(0);
+        metrics.onStateChanged(true, ExoPlayer.STATE_BUFFERING, 0);
+        metrics.finish(5000);
+
+        assertFalse(metrics.hasPlayback());
+        assertEquals(0, metrics.getRebufferCount());
+        assertEquals(0, metrics.getRebufferRatio(), 0);
+    }
+
+    @Test
+    public void testSeekBufferingIsNotRebuffering() {
+        PlaybackMetrics metrics = new PlaybackMetrics(0);
+        metrics.onStateChanged(true, ExoPlayer.STATE_BUFFERING, 0);
+        metrics.onStateChanged(true, ExoPlayer.STATE_READY, 1000);
+        metrics.onSeek();
+        metrics.onStateChanged(true, ExoPlayer.STATE_BUFFERING, 5000);
+        metrics.onStateChanged(true, ExoPlayer.STATE_READY, 6000);
+        metrics.onStateChanged(true, ExoPlayer.STATE_BUFFERING, 8000);
+        metrics.finish(9000);
+
+        assertEquals(1, metrics.getRebufferCount());
+        assertEquals(1000, metrics.getRebufferTimeMs());
+        assertEquals(6000, metrics.getPlayingTimeMs());
+    }
+
+    private static Format videoFormat(int bitrate) {
+        return Format.createVideoSampleFormat(null, "video/avc", null, bitrate, Format.NO_VALUE,
+                640, 480, Format.NO_VALUE, null, null);
+    }
+}
@@ -0,0 +1,76 @@
+package io.evercam.androidapp.ptz;
+
+import org.junit.Before;
+import org.junit.Test;
+
+import java.util.ArrayList;
+import java.util.concurrent.Executor;
+
+import io.evercam.PTZHome;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertFalse;
+import static org.junit.Assert.assertTrue;
+
+public class PTZCommandQueueTest {
+    private ArrayList<Runnable> scheduled;
+    private PTZCommandQueue queue;
+
+    @Before
+    public void setUp() {
+        scheduled = new ArrayList<>();
+        //Hold the drain runnable back so commands stay pending
+        queue = new PTZCommandQueue("camera", new Executor() {
+            @Override
+            public void execute(Runnable command) {
+                scheduled.add(command);
+            }
+        });
+    }
+
+    @Test
+    public void testMergesConsecutiveRelativeMoves() {
+        queue.move(-4, 0, 0);
+        queue.move(-4, 0, 0);
+        queue.move(0, 3, 0);
+        queue.move(0, 0, 1);
+
+        assertEquals(1, scheduled.size());
+        assertEquals(1, queue.getPendingCount());
+        PTZCommand command = queue.peekPending();
+        assertEquals(-8, command.getPan());
+        assertEquals(3, command.getTilt());
+        assertEquals(1, command.getZoom());
+        assertFalse(queue.isIdle());
+    }
+
+    @Test
+    public void testOppositeMovesCancelOut() {
+        queue.move(4, 0, 0);
+        queue.move(-4, 0, 0);
+
+        assertTrue(queue.peekPending().isEmpty());
+    }
+
+    @Test
+    public void testPresetDropsPendingMoves() {
+        queue.move(4, 0, 0);
+        queue.moveTo(new PTZHome("camera"));
+
+        assertEquals(1, queue.getPendingCount());
+        assertFalse(queue.peekPending().isRelative());
+
+        //Moves after a preset recall are kept and sent after it
+        queue.move(0, -3, 0);
+        queue.move(0, -3, 0);
+        assertEquals(2, queue.getPendingCount());
+    }
+
+    @Test
+    public void testCancel() {
+        queue.move(4, 0, 0);
+        queue.cancel();
+
+        assertEquals(0, queue.getPendingCount());
+    }
+}
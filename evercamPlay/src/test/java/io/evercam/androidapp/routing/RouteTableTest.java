@@ -0,0 +1,68 @@
+package io.evercam.androidapp.routing;
+
+import org.junit.Test;
+
+import java.util.Arrays;
+import java.util.Collections;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertFalse;
+import static org.junit.Assert.assertNotNull;
+import static org.junit.Assert.assertNull;
+import static org.junit.Assert.assertTrue;
+
+public class RouteTableTest {
+
+    @Test
+    public void testChoosesFastestWorkingRoute() {
+        RouteTable.Decision decision = RouteTable.choose(Arrays.asList(
+                new RouteTable.Probe(RouteTable.Route.INTERNAL, false, 0),
+                new RouteTable.Probe(RouteTable.Route.EXTERNAL, true, 180),
+                new RouteTable.Probe(RouteTable.Route.CLOUD, true, 320)), 0);
+        assertEquals(RouteTable.Route.EXTERNAL, decision.getRoute());
+        assertEquals(180, decision.getRttMs());
+        assertTrue(decision.isVerified());
+    }
+
+    @Test
+    public void testPrefersDirectRouteOnTie() {
+        RouteTable.Decision decision = RouteTable.choose(Arrays.asList(
+                new RouteTable.Probe(RouteTable.Route.CLOUD, true, 50),
+                new RouteTable.Probe(RouteTable.Route.INTERNAL, true, 50)), 0);
+        assertEquals(RouteTable.Route.INTERNAL, decision.getRoute());
+    }
+
+    @Test
+    public void testFallsBackToCloud() {
+        RouteTable.Decision decision = RouteTable.choose(Collections.singletonList(
+                new RouteTable.Probe(RouteTable.Route.EXTERNAL, false, 0)), 0);
+        assertEquals(RouteTable.Route.CLOUD, decision.getRoute());
+        assertFalse(decision.isVerified());
+    }
+
+    @Test
+    public void testDecisionsArePerNetworkAndExpire() {
+        RouteTable table = new RouteTable(1000);
+        table.put("192.168.1.1@aa", "camera", Collections.singletonList(
+                new RouteTable.Probe(RouteTable.Route.INTERNAL, true, 10)), 0);
+
+        assertNotNull(table.get("192.168.1.1@aa", "camera", 1000));
+        assertNull(table.get("10.0.0.1@bb", "camera", 1000));
+        assertNull(table.get("192.168.1.1@aa", "camera", 1001));
+
+        table.trim(1001);
+        assertEquals(0, table.size());
+    }
+
+    @Test
+    public void testInvalidatesOnlyTheFailedRoute() {
+        RouteTable table = new RouteTable(1000);
+        table.put("network", "camera", Collections.singletonList(
+                new RouteTable.Probe(RouteTable.Route.INTERNAL, true, 10)), 0);
+
+        table.invalidate("network", "camera", RouteTable.Route.CLOUD);
+        assertNotNull(table.get("network", "camera", 0));
+        table.invalidate("network", "camera", RouteTable.Route.INTERNAL);
+        assertNull(table.get("network", "camera", 0));
+    }
+}
@@ -0,0 +1,159 @@
+package io.evercam.androidapp.rtsp;
+
+import org.junit.Before;
+import org.junit.Test;
+
+import java.util.ArrayList;
+import java.util.List;
+
+import static org.junit.Assert.assertArrayEquals;
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertFalse;
+import static org.junit.Assert.assertNull;
+import static org.junit.Assert.assertTrue;
+
+public class H264DepacketizerTest {
+    private final List<H264Depacketizer.AccessUnit> accessUnits = new ArrayList<>();
+    private final List<byte[]> parameterSets = new ArrayList<>();
+    private RtspMetrics metrics;
+    private H264Depacketizer depacketizer;
+
+    @Before
+    public void setUp() {
+        metrics = new RtspMetrics();
+        depacketizer = new H264Depacketizer(new H264Depacketizer.Listener() {
+            @Override
+            public void onAccessUnit(H264Depacketizer.AccessUnit accessUnit) {
+                accessUnits.add(accessUnit);
+            }
+
+            @Override
+            public void onParameterSet(int nalType, byte[] nalUnit) {
+                parameterSets.add(nalUnit);
+            }
+        }, metrics);
+    }
+
+    /**
+     * Raw bytes of an RTP packet as captured, payload type 96
+     */
+    static byte[] rtp(int sequenceNumber, long timestamp, boolean marker, int... payload) {
+        byte[] packet = new byte[RtpPacket.HEADER_SIZE + payload.length];
+        packet[0] = (byte) 0x80;
+        packet[1] = (byte) ((marker ? 0x80 : 0) | 96);
+        packet[2] = (byte) (sequenceNumber >> 8);
+        packet[3] = (byte) sequenceNumber;
+        packet[4] = (byte) (timestamp >> 24);
+        packet[5] = (byte) (timestamp >> 16);
+        packet[6] = (byte) (timestamp >> 8);
+        packet[7] = (byte) timestamp;
+        packet[8] = 0x12;
+        packet[9] = 0x34;
+        packet[10] = 0x56;
+        packet[11] = 0x78;
+        for (int index = 0; index < payload.length; index++) {
+            packet[RtpPacket.HEADER_SIZE + index] = (byte) payload[index];
+        }
+        return packet;
+    }
+
+    private void push(byte[] packet) {
+        depacketizer.push(RtpPacket.parse(packet, 0, packet.length));
+    }
+
+    private static byte[] bytes(int... values) {
+        byte[] bytes = new byte[values.length];
+        for (int index = 0; index < values.length; index++) {
+            bytes[index] = (byte) values[index];
+        }
+        return bytes;
+    }
+
+    @Test
+    public void testParsesRtpHeader() {
+        byte[] data = rtp(65535, 0xFFFFFFF0L, true, 0x41, 0x9A);
+        RtpPacket packet = RtpPacket.parse(data, 0, data.length);
+        assertEquals(96, packet.getPayloadType());
+        assertEquals(65535, packet.getSequenceNumber());
+        assertEquals(0xFFFFFFF0L, packet.getTimestamp());
+        assertEquals(0x12345678L, packet.getSsrc());
+        assertTrue(packet.isMarker());
+        assertEquals(2, packet.getPayloadLength());
+
+        //Padding and a header extension are skipped
+        byte[] padded = rtp(1, 0, false, 0xBE, 0xDE, 0x00, 0x01, 1, 2, 3, 4, 0x41, 0x9A, 0, 2);
+        padded[0] = (byte) 0xB0;
+        RtpPacket paddedPacket = RtpPacket.parse(padded, 0, padded.length);
+        assertEquals(RtpPacket.HEADER_SIZE + 8, paddedPacket.getPayloadOffset());
+        assertEquals(2, paddedPacket.getPayloadLength());
+
+        assertNull(RtpPacket.parse(new byte[]{0x40, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}, 0, 12));
+    }
+
+    @Test
+    public void testAssemblesAggregatesAndFragments() {
+        //SPS and PPS in a STAP-A, then an IDR slice in three FU-A fragments
+        push(rtp(1, 3000, false, 0x18, 0x00, 0x04, 0x67, 0x42, 0x00, 0x1F, 0x00, 0x02, 0x68,
+                0xCE));
+        push(rtp(2, 3000, false, 0x7C, 0x85, 0xAA, 0xBB));
+        push(rtp(3, 3000, false, 0x7C, 0x05, 0xCC));
+        push(rtp(4, 3000, true, 0x7C, 0x45, 0xDD));
+        //A P slice in a single NAL unit packet
+        push(rtp(5, 6000, true, 0x41, 0x9A, 0x01));
+
+        assertEquals(2, accessUnits.size());
+        H264Depacketizer.AccessUnit keyFrame = accessUnits.get(0);
+        assertTrue(keyFrame.isKeyFrame());
+        assertEquals(3000, keyFrame.getTimestamp());
+        assertArrayEquals(bytes(0, 0, 0, 1, 0x67, 0x42, 0x00, 0x1F, 0, 0, 0, 1, 0x68, 0xCE,
+                0, 0, 0, 1, 0x65, 0xAA, 0xBB, 0xCC, 0xDD), keyFrame.getData());
+
+        H264Depacketizer.AccessUnit frame = accessUnits.get(1);
+        assertFalse(frame.isKeyFrame());
+        assertArrayEquals(bytes(0, 0, 0, 1, 0x41, 0x9A, 0x01), frame.getData());
+
+        assertEquals(2, parameterSets.size());
+        assertArrayEquals(bytes(0x67, 0x42, 0x00, 0x1F), parameterSets.get(0));
+        assertEquals(2, metrics.getFramesAssembled());
+    }
+
+    @Test
+    public void testEndsAccessUnitOnTimestampWithoutMarker() {
+        push(rtp(1, 3000, false, 0x65, 0x88));
+        assertEquals(0, accessUnits.size());
+        push(rtp(2, 6000, true, 0x41, 0x9A));
+        assertEquals(2, accessUnits.size());
+        assertTrue(accessUnits.get(0).isKeyFrame());
+    }
+
+    @Test
+    public void testDropsFramesAfterLossUntilKeyFrame() {
+        //A P frame before any key frame can't be decoded
+        push(rtp(1, 1000, true, 0x41, 0x01));
+        push(rtp(2, 3000, true, 0x65, 0x88));
+        push(rtp(3, 6000, true, 0x41, 0x02));
+        //Sequence 4 is lost
+        push(rtp(5, 9000, true, 0x41, 0x03));
+        push(rtp(6, 12000, true, 0x41, 0x04));
+        push(rtp(7, 15000, true, 0x65, 0x89));
+        push(rtp(8, 18000, true, 0x41, 0x05));
+
+        assertEquals(4, accessUnits.size());
+        assertEquals(3000, accessUnits.get(0).getTimestamp());
+        assertEquals(6000, accessUnits.get(1).getTimestamp());
+        assertEquals(15000, accessUnits.get(2).getTimestamp());
+        assertEquals(18000, accessUnits.get(3).getTimestamp());
+        assertEquals(3, metrics.getFramesDropped());
+    }
+
+    @Test
+    public void testDropsFrameWithLostFragment() {
+        push(rtp(1, 3000, true, 0x65, 0x88));
+        push(rtp(2, 6000, false, 0x7C, 0x81, 0xAA));
+        //The middle fragment, sequence 3, is lost
+        push(rtp(4, 6000, true, 0x7C, 0x41, 0xCC));
+
+        assertEquals(1, accessUnits.size());
+        assertEquals(1, metrics.getFramesDropped());
+    }
+}
@@ -0,0 +1,95 @@
+package io.evercam.androidapp.rtsp;
+
+import org.junit.Before;
+import org.junit.Test;
+
+import static io.evercam.androidapp.rtsp.H264DepacketizerTest.rtp;
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertNull;
+
+public class JitterBufferTest {
+    private final static int CLOCK_RATE = 90000;
+    private final static long DELAY_MS = 50;
+
+    private RtspMetrics metrics;
+    private JitterBuffer jitterBuffer;
+
+    @Before
+    public void setUp() {
+        metrics = new RtspMetrics();
+        jitterBuffer = new JitterBuffer(metrics, CLOCK_RATE, DELAY_MS);
+    }
+
+    private void push(int sequenceNumber, long timestamp, long arrivalTimeMs) {
+        byte[] data = rtp(sequenceNumber, timestamp, false, 0x41);
+        jitterBuffer.push(RtpPacket.parse(data, 0, data.length).setArrivalTimeMs(arrivalTimeMs));
+    }
+
+    @Test
+    public void testReordersPackets() {
+        push(10, 0, 0);
+        push(12, 0, 0);
+        push(11, 0, 5);
+
+        assertEquals(10, jitterBuffer.poll(5).getSequenceNumber());
+        assertEquals(11, jitterBuffer.poll(5).getSequenceNumber());
+        assertEquals(12, jitterBuffer.poll(5).getSequenceNumber());
+        assertNull(jitterBuffer.poll(5));
+        assertEquals(0, metrics.getPacketsLost());
+    }
+
+    @Test
+    public void testWaitsForMissingPacketThenCountsItLost() {
+        push(20, 0, 0);
+        push(22, 0, 0);
+
+        assertEquals(20, jitterBuffer.poll(0).getSequenceNumber());
+        assertNull(jitterBuffer.poll(DELAY_MS - 1));
+        assertEquals(22, jitterBuffer.poll(DELAY_MS).getSequenceNumber());
+        assertEquals(1, metrics.getPacketsLost());
+
+        //The missing packet turning up after its turn is late
+        push(21, 0, DELAY_MS + 10);
+        assertNull(jitterBuffer.poll(DELAY_MS + 10));
+        assertEquals(1, metrics.getPacketsLate());
+
+        push(23, 0, DELAY_MS + 20);
+        push(23, 0, DELAY_MS + 20);
+        assertEquals(1, metrics.getPacketsDuplicate());
+    }
+
+    @Test
+    public void testKeepsOrderAcrossWrapAround() {
+        push(65534, 0, 0);
+        push(0, 0, 0);
+        push(65535, 0, 0);
+        push(1, 0, 0);
+
+        assertEquals(65534, jitterBuffer.poll(0).getSequenceNumber());
+        assertEquals(65535, jitterBuffer.poll(0).getSequenceNumber());
+        assertEquals(0, jitterBuffer.poll(0).getSequenceNumber());
+        assertEquals(1, jitterBuffer.poll(0).getSequenceNumber());
+        assertEquals(0, metrics.getPacketsLost());
+    }
+
+    @Test
+    public void testReleasesEverythingWhenFull() {
+        jitterBuffer = new JitterBuffer(metrics, CLOCK_RATE, DELAY_MS, 2);
+        push(1, 0, 0);
+        assertEquals(1, jitterBuffer.poll(0).getSequenceNumber());
+        push(3, 0, 0);
+        assertNull(jitterBuffer.poll(0));
+        push(4, 0, 0);
+        assertEquals(3, jitterBuffer.poll(0).getSequenceNumber());
+    }
+
+    @Test
+    public void testMeasuresInterarrivalJitter() {
+        //40 ms apart at 90 kHz, the third packet arriving 20 ms late
+        push(1, 0, 0);
+        push(2, 3600, 40);
+        assertEquals(0, jitterBuffer.getJitterMs(), 0.001);
+        push(3, 7200, 100);
+        assertEquals(1.25, jitterBuffer.getJitterMs(), 0.001);
+    }
+}
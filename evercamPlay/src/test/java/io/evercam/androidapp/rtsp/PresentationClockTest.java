@@ -0,0 +1,58 @@
+package io.evercam.androidapp.rtsp;
+
+import org.junit.Test;
+
+import static org.junit.Assert.assertEquals;
+
+public class PresentationClockTest {
+    private final static int CLOCK_RATE = 90000;
+    //One frame at 25 fps
+    private final static long FRAME_TICKS = CLOCK_RATE / 25;
+    private final static long MAX_TIMESTAMP = 0xFFFFFFFFL;
+
+    @Test
+    public void testStartsAtZero() {
+        PresentationClock clock = new PresentationClock(CLOCK_RATE);
+        assertEquals(0, clock.toPresentationTimeUs(123456));
+        assertEquals(40000, clock.toPresentationTimeUs(123456 + FRAME_TICKS));
+    }
+
+    @Test
+    public void testKeepsIncreasingAcrossWrapAround() {
+        PresentationClock clock = new PresentationClock(CLOCK_RATE);
+        long timestamp = MAX_TIMESTAMP - 10 * FRAME_TICKS;
+        for (int frame = 0; frame < 100; frame++) {
+            assertEquals(frame * 40000L, clock.toPresentationTimeUs(timestamp));
+            timestamp = (timestamp + FRAME_TICKS) & MAX_TIMESTAMP;
+        }
+    }
+
+    @Test
+    public void testStartingAtZeroTimestamp() {
+        PresentationClock clock = new PresentationClock(CLOCK_RATE);
+        assertEquals(0, clock.toPresentationTimeUs(0));
+        assertEquals(40000, clock.toPresentationTimeUs(FRAME_TICKS));
+    }
+
+    @Test
+    public void testSurvivesSeveralWrapArounds() {
+        PresentationClock clock = new PresentationClock(CLOCK_RATE);
+        //A quarter of the timestamp range per step, about 3.3 hours at 90 kHz
+        long step = 1L << 30;
+        long timestamp = MAX_TIMESTAMP;
+        for (int index = 0; index <= 12; index++) {
+            assertEquals(index * step * 1000000L / CLOCK_RATE,
+                    clock.toPresentationTimeUs(timestamp));
+            timestamp = (timestamp + step) & MAX_TIMESTAMP;
+        }
+    }
+
+    @Test
+    public void testLateFrameFromBeforeWrapAround() {
+        PresentationClock clock = new PresentationClock(CLOCK_RATE);
+        clock.toPresentationTimeUs(MAX_TIMESTAMP - FRAME_TICKS + 1);
+        assertEquals(80000, clock.toPresentationTimeUs(FRAME_TICKS));
+        assertEquals(40000, clock.toPresentationTimeUs(0));
+        assertEquals(120000, clock.toPresentationTimeUs(2 * FRAME_TICKS));
+    }
+}
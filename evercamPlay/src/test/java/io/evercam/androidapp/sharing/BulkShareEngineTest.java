@@ -0,0 +1,95 @@
+package io.evercam.androidapp.sharing;
+
+import org.junit.Test;
+
+import java.io.IOException;
+import java.util.Arrays;
+import java.util.List;
+import java.util.concurrent.atomic.AtomicInteger;
+
+import io.evercam.CameraShareInterface;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertTrue;
+
+public class BulkShareEngineTest {
+
+    @Test
+    public void testItemsAreCameraAndEmailPairs() {
+        BulkShareEngine engine = new BulkShareEngine(Arrays.asList("front", "back", "front", " "),
+                Arrays.asList("Joe@example.com", "joe@example.com ", "ann@example.com"));
+
+        List<BulkShareEngine.Item> items = engine.getItems();
+        assertEquals(4, items.size());
+        assertEquals("front", items.get(0).getCameraId());
+        assertEquals("joe@example.com", items.get(0).getEmail());
+        assertEquals("back", items.get(3).getCameraId());
+        assertEquals("ann@example.com", items.get(3).getEmail());
+    }
+
+    @Test
+    public void testConcurrencyIsBounded() {
+        final AtomicInteger inFlight = new AtomicInteger(0);
+        final AtomicInteger maxInFlight = new AtomicInteger(0);
+        String[] cameraIds = new String[40];
+        for (int index = 0; index < cameraIds.length; index++) {
+            cameraIds[index] = "camera" + index;
+        }
+
+        List<BulkShareEngine.Item> items = new BulkShareEngine(Arrays.asList(cameraIds),
+                Arrays.asList("joe@example.com")).setConcurrency(3)
+                .run(new BulkShareEngine.Operation() {
+                    @Override
+                    public CameraShareInterface run(BulkShareEngine.Item item) throws Exception {
+                        int current = inFlight.incrementAndGet();
+                        synchronized (maxInFlight) {
+                            maxInFlight.set(Math.max(maxInFlight.get(), current));
+                        }
+                        Thread.sleep(5);
+                        inFlight.decrementAndGet();
+                        return null;
+                    }
+                });
+
+        assertEquals(40, items.size());
+        for (BulkShareEngine.Item item : items) {
+            assertTrue(item.isSucceeded());
+        }
+        assertTrue(maxInFlight.get() <= 3);
+    }
+
+    @Test
+    public void testOnlyTransientFailuresAreRetried() {
+        final AtomicInteger listenerCount = new AtomicInteger(0);
+        List<BulkShareEngine.Item> items = new BulkShareEngine(Arrays.asList("flaky", "broken",
+                "down"), Arrays.asList("joe@example.com")).setMaxAttempts(3).setBackoffMs(1)
+                .setListener(new BulkShareEngine.Listener() {
+                    @Override
+                    public void onItemFinished(BulkShareEngine.Item item, int finishedCount,
+                                               int totalCount) {
+                        listenerCount.incrementAndGet();
+                    }
+                }).run(new BulkShareEngine.Operation() {
+                    @Override
+                    public CameraShareInterface run(BulkShareEngine.Item item) throws Exception {
+                        if (item.getCameraId().equals("flaky") && item.getAttempts() < 2) {
+                            throw new Exception(new IOException("Connection reset"));
+                        } else if (item.getCameraId().equals("broken")) {
+                            throw new Exception("User does not exist");
+                        } else if (item.getCameraId().equals("down")) {
+                            throw new Exception("Evercam internal server error.");
+                        }
+                        return null;
+                    }
+                });
+
+        assertEquals(BulkShareEngine.Status.SUCCEEDED, items.get(0).getStatus());
+        assertEquals(2, items.get(0).getAttempts());
+        assertEquals(BulkShareEngine.Status.FAILED, items.get(1).getStatus());
+        assertEquals(1, items.get(1).getAttempts());
+        assertEquals("User does not exist", items.get(1).getErrorMessage());
+        assertEquals(BulkShareEngine.Status.FAILED, items.get(2).getStatus());
+        assertEquals(3, items.get(2).getAttempts());
+        assertEquals(3, listenerCount.get());
+    }
+}
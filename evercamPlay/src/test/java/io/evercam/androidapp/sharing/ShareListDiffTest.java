@@ -0,0 +1,50 @@
+package io.evercam.androidapp.sharing;
+
+import org.junit.Test;
+
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.List;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertSame;
+
+public class ShareListDiffTest {
+
+    /* "user:rights" entries keyed by user */
+    private static final ShareListDiff.Keys<String> KEYS = new ShareListDiff.Keys<String>() {
+        @Override
+        public String getKey(String item) {
+            return item.split(":")[0];
+        }
+
+        @Override
+        public String getContent(String item) {
+            return item;
+        }
+    };
+
+    @Test
+    public void testUnchangedListIsNotEdited() {
+        String owner = "owner:full";
+        ArrayList<String> current = new ArrayList<>(Arrays.asList(owner, "ann:read", "joe:full"));
+
+        assertEquals(0, ShareListDiff.apply(current, Arrays.asList(new String("owner:full"),
+                "ann:read", "joe:full"), KEYS));
+        assertSame(owner, current.get(0));
+    }
+
+    @Test
+    public void testChangesAreApplied() {
+        ArrayList<String> current = new ArrayList<>(Arrays.asList("owner:full", "ann:read",
+                "joe:full", "bob:read"));
+        List<String> updated = Arrays.asList("owner:full", "joe:read", "ann:read", "eve:full");
+
+        assertEquals(3, ShareListDiff.apply(current, updated, KEYS));
+        assertEquals(updated, current);
+
+        assertEquals(2, ShareListDiff.apply(current, Arrays.asList("owner:full", "joe:read"),
+                KEYS));
+        assertEquals(Arrays.asList("owner:full", "joe:read"), current);
+    }
+}
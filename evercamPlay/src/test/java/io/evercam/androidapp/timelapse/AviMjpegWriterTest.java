@@ -0,0 +1,104 @@
+package io.evercam.androidapp.timelapse;
+
+import org.junit.Rule;
+import org.junit.Test;
+import org.junit.rules.TemporaryFolder;
+
+import java.io.File;
+import java.io.IOException;
+import java.io.RandomAccessFile;
+
+import static org.junit.Assert.assertEquals;
+
+public class AviMjpegWriterTest {
+    @Rule
+    public TemporaryFolder temporaryFolder = new TemporaryFolder();
+
+    @Test
+    public void testWritesIndexedFrames() throws IOException {
+        File file = temporaryFolder.newFile("timelapse.avi");
+        byte[][] frames = {fakeJpeg(101), fakeJpeg(64), fakeJpeg(3)};
+
+        AviMjpegWriter writer = new AviMjpegWriter(file, 640, 480, 10);
+        for (byte[] frame : frames) {
+            writer.addFrame(frame);
+        }
+        writer.close();
+
+        RandomAccessFile avi = new RandomAccessFile(file, "r");
+        try {
+            assertEquals("RIFF", readFourCC(avi, 0));
+            assertEquals(avi.length() - 8, readInt(avi, 4));
+            assertEquals("AVI ", readFourCC(avi, 8));
+            assertEquals("avih", readFourCC(avi, 24));
+            assertEquals(100000, readInt(avi, 32));
+            assertEquals(frames.length, readInt(avi, 48));
+            assertEquals(640, readInt(avi, 64));
+            assertEquals(480, readInt(avi, 68));
+            assertEquals("strh", readFourCC(avi, 100));
+            assertEquals("MJPG", readFourCC(avi, 112));
+            assertEquals(frames.length, readInt(avi, 140));
+            assertEquals("movi", readFourCC(avi, 220));
+
+            long moviSize = readInt(avi, 216);
+            long idx1Offset = 220 + moviSize;
+            assertEquals("idx1", readFourCC(avi, idx1Offset));
+            assertEquals(frames.length * 16, readInt(avi, idx1Offset + 4));
+
+            for (int index = 0; index < frames.length; index++) {
+                long entryOffset = idx1Offset + 8 + index * 16;
+                long chunkOffset = 220 + readInt(avi, entryOffset + 8);
+                assertEquals("00dc", readFourCC(avi, chunkOffset));
+                assertEquals(frames[index].length, readInt(avi, chunkOffset + 4));
+                assertEquals(frames[index].length, readInt(avi, entryOffset + 12));
+
+                byte[] frameData = new byte[frames[index].length];
+                avi.seek(chunkOffset + 8);
+                avi.readFully(frameData);
+                assertEquals(frames[index][frames[index].length - 1],
+                        frameData[frameData.length - 1]);
+            }
+        } finally {
+            avi.close();
+        }
+    }
+
+    @Test
+    public void testEmptyFileIsValid() throws IOException {
+        File file = temporaryFolder.newFile("empty.avi");
+        new AviMjpegWriter(file, 320, 240, 25).close();
+
+        RandomAccessFile avi = new RandomAccessFile(file, "r");
+        try {
+            assertEquals(avi.length() - 8, readInt(avi, 4));
+            assertEquals(0, readInt(avi, 48));
+            assertEquals(4, readInt(avi, 216));
+            assertEquals("idx1", readFourCC(avi, 224));
+        } finally {
+            avi.close();
+        }
+    }
+
+    private static byte[] fakeJpeg(int length) {
+        byte[] data = new byte[length];
+        data[0] = (byte) 0xff;
+        data[1] = (byte) 0xd8;
+        for (int index = 2; index < length; index++) {
+            data[index] = (byte) index;
+        }
+        return data;
+    }
+
+    private static String readFourCC(RandomAccessFile file, long offset) throws IOException {
+        byte[] fourCC = new byte[4];
+        file.seek(offset);
+        file.readFully(fourCC);
+        return new String(fourCC, "US-ASCII");
+    }
+
+    private static long readInt(RandomAccessFile file, long offset) throws IOException {
+        file.seek(offset);
+        return (file.read() & 0xff) | (file.read() & 0xff) << 8 | (file.read() & 0xff) << 16
+                | ((long) (file.read() & 0xff)) << 24;
+    }
+}
@@ -0,0 +1,66 @@
+package io.evercam.androidapp.utils;
+
+import org.junit.Test;
+
+import java.io.ByteArrayInputStream;
+import java.io.ByteArrayOutputStream;
+import java.io.DataOutputStream;
+import java.io.IOException;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertNull;
+import static org.junit.Assert.fail;
+
+public class TimezoneGridTest {
+
+    /**
+     * One cell per degree, every row the same: Dublin from -10 to 0 degrees longitude,
+     * London from 0 to 2, sea elsewhere
+     */
+    private static byte[] buildGrid(int rowCount) throws IOException {
+        ByteArrayOutputStream outputStream = new ByteArrayOutputStream();
+        DataOutputStream dataOutputStream = new DataOutputStream(outputStream);
+        dataOutputStream.writeInt(TimezoneGrid.MAGIC);
+        dataOutputStream.writeInt(1);
+        dataOutputStream.writeInt(2);
+        dataOutputStream.writeUTF("Europe/Dublin");
+        dataOutputStream.writeUTF("Europe/London");
+        for (int row = 0; row < rowCount; row++) {
+            dataOutputStream.writeShort(4);
+            writeRun(dataOutputStream, -1, 170);
+            writeRun(dataOutputStream, 0, 10);
+            writeRun(dataOutputStream, 1, 2);
+            writeRun(dataOutputStream, -1, 178);
+        }
+        dataOutputStream.close();
+        return outputStream.toByteArray();
+    }
+
+    private static void writeRun(DataOutputStream dataOutputStream, int zoneIndex, int cellCount)
+            throws IOException {
+        dataOutputStream.writeShort(zoneIndex);
+        dataOutputStream.writeShort(cellCount);
+    }
+
+    @Test
+    public void testLookup() throws IOException {
+        TimezoneGrid grid = new TimezoneGrid(new ByteArrayInputStream(buildGrid(180)));
+
+        assertEquals("Europe/Dublin", grid.lookup(53.35, -6.26));
+        assertEquals("Europe/London", grid.lookup(51.51, 0.13));
+        assertEquals("Europe/London", grid.lookup(-90, 1.99));
+        assertEquals("Europe/Dublin", grid.lookup(90, 350));
+        assertNull(grid.lookup(40.71, -74.01));
+        assertNull(grid.lookup(0, 180));
+    }
+
+    @Test
+    public void testTruncatedGridIsRejected() throws IOException {
+        try {
+            new TimezoneGrid(new ByteArrayInputStream(buildGrid(179)));
+            fail("Truncated grid was accepted");
+        } catch (IOException e) {
+            //Expected
+        }
+    }
+}